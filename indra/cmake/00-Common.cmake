@@ -43,6 +43,20 @@ add_compile_definitions(BOOST_BIND_GLOBAL_PLACEHOLDERS)
 # https://github.com/g-truc/glm/blob/master/manual.md#section2_10
 add_compile_definitions(GLM_FORCE_DEFAULT_ALIGNED_GENTYPES=1 GLM_FORCE_SSE2=1 GLM_ENABLE_EXPERIMENTAL=1)
 
+# <3T:TommyTheTerrible> Compile LL_DEBUGS sites out of the build
+set(LL_COMPILE_OUT_DEBUG_LOGS OFF CACHE BOOL "Compile out LL_DEBUGS messages; they cannot then be enabled at run time")
+if(LL_COMPILE_OUT_DEBUG_LOGS)
+  add_compile_definitions( LL_COMPILE_OUT_DEBUG_LOGS=1)
+endif()
+# </3T:TommyTheTerrible>
+
+# <3T:TommyTheTerrible> Sampled allocation profiler; replaces operator new unless Tracy's memory profiling does
+set(LL_ALLOCATION_PROFILER ON CACHE BOOL "Let the allocation profiler sample operator new")
+if(LL_ALLOCATION_PROFILER)
+  add_compile_definitions( LL_ALLOCATION_PROFILER=1)
+endif()
+# </3T:TommyTheTerrible>
+
 # Configure crash reporting
 set(RELEASE_CRASH_REPORTING OFF CACHE BOOL "Enable use of crash reporting in release builds")
 set(NON_RELEASE_CRASH_REPORTING OFF CACHE BOOL "Enable use of crash reporting in developer builds")
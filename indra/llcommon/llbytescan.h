@@ -0,0 +1,139 @@
+/**
+ * @file   llbytescan.h
+ * @brief  SSE2 searches for delimiter bytes in text buffers.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLBYTESCAN_H
+#define LL_LLBYTESCAN_H
+
+#include <bit>
+#include <emmintrin.h>
+
+// The text parsers spend most of their time looking for the next byte that
+// means something to them. These compare 16 bytes at a time and never read
+// outside [begin, end), so they work on any buffer, aligned or not.
+
+namespace ll_bytescan_detail
+{
+    inline const char* first_hit(const char* at, __m128i hits)
+    {
+        return at + std::countr_zero(static_cast<unsigned>(_mm_movemask_epi8(hits)));
+    }
+}
+
+// First byte in [begin, end) equal to a or b, or end.
+inline const char* ll_find_first_of(const char* begin, const char* end, char a, char b)
+{
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    for (; end - begin >= 16; begin += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb));
+        if (_mm_movemask_epi8(hits))
+        {
+            return ll_bytescan_detail::first_hit(begin, hits);
+        }
+    }
+    for (; begin < end; ++begin)
+    {
+        if (*begin == a || *begin == b)
+        {
+            return begin;
+        }
+    }
+    return end;
+}
+
+// First byte in [begin, end) equal to a or b, or that is a control character
+// (below ' '), or end. Multibyte UTF-8 passes through, as in JSON strings.
+inline const char* ll_find_first_of_or_control(const char* begin, const char* end, char a, char b)
+{
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i last_control = _mm_set1_epi8(' ' - 1);
+    for (; end - begin >= 16; begin += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        // Unsigned compare: a byte is a control character if clamping it to
+        // ' ' - 1 leaves it unchanged.
+        __m128i hits = _mm_cmpeq_epi8(_mm_min_epu8(chunk, last_control), chunk);
+        hits = _mm_or_si128(hits, _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+        if (_mm_movemask_epi8(hits))
+        {
+            return ll_bytescan_detail::first_hit(begin, hits);
+        }
+    }
+    for (; begin < end; ++begin)
+    {
+        if (*begin == a || *begin == b || static_cast<unsigned char>(*begin) < ' ')
+        {
+            return begin;
+        }
+    }
+    return end;
+}
+
+// First byte in [begin, end) equal to a, b, c or d, or that is not printable
+// ASCII (a control character other than tab and newline, or any byte of a
+// multibyte UTF-8 sequence), or end. For text that has to be checked for
+// control characters and valid UTF-8 on the way, like XML character data.
+inline const char* ll_find_first_of_or_unprintable(const char* begin, const char* end,
+                                                   char a, char b, char c, char d)
+{
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+    const __m128i vd = _mm_set1_epi8(d);
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; end - begin >= 16; begin += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        // Signed compare: bytes from 0x80 up are negative, so this catches
+        // them along with the control characters.
+        __m128i hits = _mm_andnot_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, tab), _mm_cmpeq_epi8(chunk, newline)),
+            _mm_cmplt_epi8(chunk, space));
+        hits = _mm_or_si128(hits, _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+        hits = _mm_or_si128(hits, _mm_or_si128(_mm_cmpeq_epi8(chunk, vc), _mm_cmpeq_epi8(chunk, vd)));
+        if (_mm_movemask_epi8(hits))
+        {
+            return ll_bytescan_detail::first_hit(begin, hits);
+        }
+    }
+    for (; begin < end; ++begin)
+    {
+        const unsigned char byte = static_cast<unsigned char>(*begin);
+        if (*begin == a || *begin == b || *begin == c || *begin == d
+            || byte >= 0x80 || (byte < ' ' && byte != '\t' && byte != '\n'))
+        {
+            return begin;
+        }
+    }
+    return end;
+}
+
+#endif // LL_LLBYTESCAN_H
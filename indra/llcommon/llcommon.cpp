@@ -32,6 +32,7 @@
 #include "lltrace.h"
 #include "lltracethreadrecorder.h"
 #include "llcleanup.h"
+#include "lltraceallocprofiler.h" // <3T:TommyTheTerrible/>
 
 thread_local bool gProfilerEnabled = false;
 
@@ -113,6 +114,53 @@ void tracy_aligned_free(void *memblock)
     ll_aligned_free_fallback(memblock);
 }
 
+// <3T:TommyTheTerrible> Sampled allocation profiler
+#elif LL_ALLOCATION_PROFILER
+// Count every allocation towards LLTrace::AllocationProfiler's next sample.
+
+void* operator new(size_t size)
+{
+    LLTrace::AllocationProfiler::noteAllocation(size);
+    void* ptr = (malloc)(size);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t count)
+{
+    LLTrace::AllocationProfiler::noteAllocation(count);
+    void* ptr = (malloc)(count);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    (free)(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    (free)(ptr);
+}
+
+// the sized forms have to match too, or a library may free with its own
+void operator delete(void* ptr, size_t) noexcept
+{
+    (free)(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    (free)(ptr);
+}
+// </3T:TommyTheTerrible>
 #endif
 
 //static
@@ -0,0 +1,331 @@
+/**
+ * @file   llcompressionservice.cpp
+ * @brief  Implementation of LLCompressionService
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llcompressionservice.h"
+
+#include "llerror.h"
+#include "llprofiler.h"
+#include "workqueue.h"
+
+#ifdef LL_USESYSTEMLIBS
+# include <zlib.h>
+#else
+# include "zlib-ng/zlib.h"
+#endif
+
+#include <limits>
+#include <memory>
+#include <new>
+
+namespace
+{
+    // Smallest output buffer we bother starting with, and the initial
+    // guess at the inflate ratio for LLSD and mesh data.
+    constexpr size_t MIN_INFLATE_BUFFER = 64 * 1024;
+    constexpr size_t INFLATE_RATIO_GUESS = 4;
+
+    // Helpers beyond the calling thread for one batch.
+    constexpr size_t MAX_BATCH_HELPERS = 8;
+
+    // One inflate and one deflate stream per thread, initialized on first
+    // use and reset between blocks.
+    class ThreadInflateStream
+    {
+    public:
+        ~ThreadInflateStream()
+        {
+            if (mReady)
+            {
+                inflateEnd(&mStream);
+            }
+        }
+
+        z_stream* get()
+        {
+            if (mReady)
+            {
+                if (inflateReset(&mStream) == Z_OK)
+                {
+                    return &mStream;
+                }
+                inflateEnd(&mStream);
+                mReady = false;
+            }
+
+            mStream = z_stream();
+            if (inflateInit(&mStream) != Z_OK)
+            {
+                return nullptr;
+            }
+            mReady = true;
+            return &mStream;
+        }
+
+    private:
+        z_stream    mStream{};
+        bool        mReady = false;
+    };
+
+    class ThreadDeflateStream
+    {
+    public:
+        ~ThreadDeflateStream()
+        {
+            if (mReady)
+            {
+                deflateEnd(&mStream);
+            }
+        }
+
+        z_stream* get(S32 level)
+        {
+            if (mReady)
+            {
+                // deflateParams() on a freshly reset stream only swaps the
+                // compression tables, nothing has been written yet.
+                if (deflateReset(&mStream) == Z_OK &&
+                    (level == mLevel || deflateParams(&mStream, level, Z_DEFAULT_STRATEGY) == Z_OK))
+                {
+                    mLevel = level;
+                    return &mStream;
+                }
+                deflateEnd(&mStream);
+                mReady = false;
+            }
+
+            mStream = z_stream();
+            if (deflateInit(&mStream, level) != Z_OK)
+            {
+                return nullptr;
+            }
+            mReady = true;
+            mLevel = level;
+            return &mStream;
+        }
+
+    private:
+        z_stream    mStream{};
+        S32         mLevel = Z_DEFAULT_COMPRESSION;
+        bool        mReady = false;
+    };
+
+    thread_local ThreadInflateStream sInflateStream;
+    thread_local ThreadDeflateStream sDeflateStream;
+
+    U32 run_batch(std::vector<LLCompressionService::Job>& jobs, const std::string& queue_name,
+                  const std::function<void(LLCompressionService::Job&)>& func)
+    {
+        LL::runParallel(jobs.size(), queue_name, [&jobs, &func](size_t idx) { func(jobs[idx]); },
+                        MAX_BATCH_HELPERS);
+
+        U32 failed = 0;
+        for (const LLCompressionService::Job& job : jobs)
+        {
+            failed += (job.mResult != LLCompressionService::OK);
+        }
+        return failed;
+    }
+}
+
+//static
+LLCompressionService::EResult LLCompressionService::inflate(const U8* in, size_t size, buffer_t& out)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    out.clear();
+    if (!in || !size || size > std::numeric_limits<uInt>::max())
+    {
+        return DATA_ERROR;
+    }
+
+    z_stream* strm = sInflateStream.get();
+    if (!strm)
+    {
+        return MEM_ERROR;
+    }
+
+    strm->next_in = const_cast<Bytef*>(in);
+    strm->avail_in = (uInt)size;
+
+    size_t have = 0;
+    try
+    {
+        // Start from a guess for this block and double when it fills up.
+        // A buffer reused across calls keeps its capacity, so this only
+        // allocates once the guess outgrows what earlier blocks needed.
+        out.resize(llmax(size * INFLATE_RATIO_GUESS, MIN_INFLATE_BUFFER));
+        while (true)
+        {
+            if (have == out.size())
+            {
+                out.resize(out.size() * 2);
+            }
+
+            size_t room = llmin(out.size() - have, (size_t)std::numeric_limits<uInt>::max());
+            strm->next_out = out.data() + have;
+            strm->avail_out = (uInt)room;
+
+            S32 ret = ::inflate(strm, Z_NO_FLUSH);
+            have += room - strm->avail_out;
+
+            if (ret == Z_STREAM_END)
+            {
+                break;
+            }
+            if (ret == Z_MEM_ERROR)
+            {
+                out.clear();
+                return MEM_ERROR;
+            }
+            // Z_BUF_ERROR with input left just means the output was full.
+            if (ret != Z_OK && !(ret == Z_BUF_ERROR && strm->avail_in))
+            {
+                out.clear();
+                return DATA_ERROR;
+            }
+            if (ret == Z_OK && !strm->avail_in && strm->avail_out)
+            {
+                // Input ran out before the end of the stream: truncated.
+                out.clear();
+                return DATA_ERROR;
+            }
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        out.clear();
+        return MEM_ERROR;
+    }
+
+    out.resize(have);
+    return OK;
+}
+
+//static
+LLCompressionService::EResult LLCompressionService::deflate(const U8* in, size_t size, buffer_t& out, S32 level)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    out.clear();
+    if ((!in && size) || size > std::numeric_limits<uInt>::max())
+    {
+        return DATA_ERROR;
+    }
+
+    z_stream* strm = sDeflateStream.get(level);
+    if (!strm)
+    {
+        return MEM_ERROR;
+    }
+
+    try
+    {
+        // deflateBound() is enough for a single Z_FINISH call to complete.
+        out.resize(deflateBound(strm, (uLong)size));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return MEM_ERROR;
+    }
+
+    strm->next_in = const_cast<Bytef*>(in);
+    strm->avail_in = (uInt)size;
+    strm->next_out = out.data();
+    strm->avail_out = (uInt)out.size();
+
+    S32 ret = ::deflate(strm, Z_FINISH);
+    if (ret != Z_STREAM_END)
+    {
+        LL_WARNS() << "Failed to compress block of " << size << " bytes: " << ret << LL_ENDL;
+        out.clear();
+        return ret == Z_MEM_ERROR ? MEM_ERROR : DATA_ERROR;
+    }
+
+    out.resize(out.size() - strm->avail_out);
+    return OK;
+}
+
+//static
+U32 LLCompressionService::inflateBatch(std::vector<Job>& jobs, const std::string& queue)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    return run_batch(jobs, queue, [](Job& job) { job.mResult = inflate(job.mIn, job.mSize, job.mOut); });
+}
+
+//static
+U32 LLCompressionService::deflateBatch(std::vector<Job>& jobs, S32 level, const std::string& queue)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    return run_batch(jobs, queue, [level](Job& job) { job.mResult = deflate(job.mIn, job.mSize, job.mOut, level); });
+}
+
+//static
+bool LLCompressionService::postInflate(buffer_t&& in, const completion_t& callback, const std::string& queue)
+{
+    LL::WorkQueue::ptr_t work_queue = LL::WorkQueue::getInstance(queue);
+    if (!work_queue)
+    {
+        return false;
+    }
+
+    auto input = std::make_shared<buffer_t>(std::move(in));
+    bool posted = work_queue->post([input, callback]()
+        {
+            buffer_t out;
+            EResult result = inflate(input->data(), input->size(), out);
+            callback(result, out);
+        });
+    if (!posted)
+    {
+        in = std::move(*input); // give the data back for a synchronous retry
+    }
+    return posted;
+}
+
+//static
+bool LLCompressionService::postDeflate(buffer_t&& in, const completion_t& callback, S32 level, const std::string& queue)
+{
+    LL::WorkQueue::ptr_t work_queue = LL::WorkQueue::getInstance(queue);
+    if (!work_queue)
+    {
+        return false;
+    }
+
+    auto input = std::make_shared<buffer_t>(std::move(in));
+    bool posted = work_queue->post([input, callback, level]()
+        {
+            buffer_t out;
+            EResult result = deflate(input->data(), input->size(), out, level);
+            callback(result, out);
+        });
+    if (!posted)
+    {
+        in = std::move(*input);
+    }
+    return posted;
+}
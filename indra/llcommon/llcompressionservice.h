@@ -0,0 +1,134 @@
+/**
+ * @file   llcompressionservice.h
+ * @brief  Shared zlib inflate/deflate with per-thread stream reuse, batching
+ *         across a worker pool and fire-and-forget async requests.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLCOMPRESSIONSERVICE_H
+#define LL_LLCOMPRESSIONSERVICE_H
+
+#include "stdtypes.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// std::allocator that default-initializes instead of value-initializing, so
+// resize() on a vector of bytes grows it without zeroing memory that is
+// about to be written anyway.
+template <typename T>
+struct LLDefaultInitAllocator : public std::allocator<T>
+{
+    template <typename U>
+    struct rebind { typedef LLDefaultInitAllocator<U> other; };
+
+    LLDefaultInitAllocator() noexcept = default;
+    template <typename U>
+    LLDefaultInitAllocator(const LLDefaultInitAllocator<U>&) noexcept {}
+
+    template <typename U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible<U>::value)
+    {
+        ::new (static_cast<void*>(ptr)) U;
+    }
+    template <typename U, typename... ARGS>
+    void construct(U* ptr, ARGS&&... args)
+    {
+        ::new (static_cast<void*>(ptr)) U(std::forward<ARGS>(args)...);
+    }
+};
+
+/**
+ * LLCompressionService is the one place zlib streams are driven from.
+ *
+ * Each thread keeps its own inflate and deflate stream and resets them
+ * between calls instead of paying for inflateInit()/deflateInit() (and the
+ * window allocation that comes with them) on every block. Output goes
+ * straight into a caller supplied vector that is grown in place, so a
+ * buffer reused across calls stops allocating once it has reached its
+ * working size. Growing it never zero-fills, and inflate() only sizes it
+ * for the block at hand.
+ *
+ * Batches are spread over a named LL::WorkQueue (the viewer's "General"
+ * pool by default) with the calling thread taking part, so a batch never
+ * waits on a queue that is busy with something else. Without that queue
+ * everything runs on the calling thread.
+ *
+ * The streams speak plain zlib format, so data is interchangeable with
+ * zip_llsd()/LLUZipHelper and with the simulator. The library behind it is
+ * zlib-ng, which already provides the accelerated deflate and inflate
+ * paths.
+ */
+class LL_COMMON_API LLCompressionService
+{
+public:
+    // Output buffers grow without zero-filling, see LLDefaultInitAllocator.
+    typedef std::vector<U8, LLDefaultInitAllocator<U8>> buffer_t;
+
+    static constexpr S32 DEFAULT_LEVEL = 9; // Z_BEST_COMPRESSION, matches zip_llsd()
+
+    enum EResult
+    {
+        OK = 0,
+        DATA_ERROR,
+        MEM_ERROR,
+    };
+
+    // Inflate a complete zlib stream into out, replacing its contents.
+    static EResult inflate(const U8* in, size_t size, buffer_t& out);
+
+    // Deflate in into out as a complete zlib stream, replacing its contents.
+    static EResult deflate(const U8* in, size_t size, buffer_t& out, S32 level = DEFAULT_LEVEL);
+
+    struct Job
+    {
+        Job() = default;
+        Job(const U8* in, size_t size) : mIn(in), mSize(size) {}
+
+        const U8*   mIn = nullptr;  // must stay valid until the batch returns
+        size_t      mSize = 0;
+        buffer_t    mOut;
+        EResult     mResult = DATA_ERROR;
+    };
+
+    // Run every job and return once all are done. Returns the number of
+    // jobs that failed.
+    static U32 inflateBatch(std::vector<Job>& jobs, const std::string& queue = "General");
+    static U32 deflateBatch(std::vector<Job>& jobs, S32 level = DEFAULT_LEVEL, const std::string& queue = "General");
+
+    typedef std::function<void(EResult, buffer_t&)> completion_t;
+
+    // Inflate or deflate on the named queue and call back on the worker
+    // thread with the result. Returns false, without calling back, if the
+    // queue does not exist or is closed; the caller should then do the work
+    // itself.
+    static bool postInflate(buffer_t&& in, const completion_t& callback, const std::string& queue = "General");
+    static bool postDeflate(buffer_t&& in, const completion_t& callback, S32 level = DEFAULT_LEVEL,
+                            const std::string& queue = "General");
+};
+
+#endif // LL_LLCOMPRESSIONSERVICE_H
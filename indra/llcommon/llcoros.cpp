@@ -440,7 +440,8 @@ void LLCoros::checkStop()
 }
 
 LLCoros::CoroData::CoroData(const std::string& name):
-    LLInstanceTracker<CoroData, std::string>(name),
+    //LLInstanceTracker<CoroData, std::string>(name),
+    LLInstanceTracker(name), // <3T:TommyTheTerrible/>
     mName(name),
     // don't consume events unless specifically directed
     mConsuming(false),
@@ -454,7 +455,8 @@ LLCoros::CoroData::CoroData(int n):
     // LLInstanceTracker key because LLInstanceTracker's map spans all
     // threads, but we want the default coroutine on each thread to have the
     // empty string as its visible name because some consumers test for that.
-    LLInstanceTracker<CoroData, std::string>("main" + stringize(n)),
+    //LLInstanceTracker<CoroData, std::string>("main" + stringize(n)),
+    LLInstanceTracker("main" + stringize(n)), // <3T:TommyTheTerrible/>
     mName(),
     mConsuming(false),
     mCreationTime(LLTimer::getTotalSeconds())
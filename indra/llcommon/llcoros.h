@@ -345,7 +345,10 @@ private:
     S32 mStackSize;
 
     // coroutine-local storage, as it were: one per coro we track
-    struct CoroData: public LLInstanceTracker<CoroData, std::string>
+    //struct CoroData: public LLInstanceTracker<CoroData, std::string>
+    // <3T:TommyTheTerrible> Every coroutine on every thread makes one of these
+    struct CoroData: public LLInstanceTracker<CoroData, std::string, LLInstanceTrackerErrorOnCollision, LLInstanceTrackerSharded>
+    // </3T:TommyTheTerrible>
     {
         CoroData(const std::string& name);
         CoroData(int n);
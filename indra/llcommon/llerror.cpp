@@ -45,6 +45,13 @@
 #endif // !LL_WINDOWS
 #include <vector>
 #include "string.h"
+// <3T:TommyTheTerrible> Asynchronous logging
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+// </3T:TommyTheTerrible>
 
 #include "llapp.h"
 #include "llapr.h"
@@ -553,7 +560,9 @@ namespace
     public:
         std::string mFatalMessage;
 
-        void addCallSite(LLError::CallSite&);
+        // <3T:TommyTheTerrible> Cached per settings generation
+        //void addCallSite(LLError::CallSite&);
+        // </3T:TommyTheTerrible>
         void invalidateCallSites();
 
         SettingsConfigPtr getSettingsConfig();
@@ -562,13 +571,17 @@ namespace
         LLError::SettingsStoragePtr saveAndResetSettingsConfig();
         void restore(LLError::SettingsStoragePtr pSettingsStorage);
     private:
-        CallSiteVector callSites;
+        // <3T:TommyTheTerrible> Cached per settings generation
+        //CallSiteVector callSites;
+        // </3T:TommyTheTerrible>
         SettingsConfigPtr mSettingsConfig;
     };
 
     Globals::Globals()
         :
-        callSites(),
+        // <3T:TommyTheTerrible> Cached per settings generation
+        //callSites(),
+        // </3T:TommyTheTerrible>
         mSettingsConfig(new SettingsConfig())
     {
     }
@@ -584,20 +597,29 @@ namespace
         return &inst;
     }
 
-    void Globals::addCallSite(LLError::CallSite& site)
-    {
-        callSites.push_back(&site);
-    }
+    // <3T:TommyTheTerrible> Cached per settings generation
+    // Rather than remembering every call site that has been decided and
+    // visiting them all, start a new generation; each site finds out the
+    // next time it is reached. Generation 0 means never decided.
+    //void Globals::addCallSite(LLError::CallSite& site)
+    //{
+    //    callSites.push_back(&site);
+    //}
 
     void Globals::invalidateCallSites()
     {
-        for (LLError::CallSite* site : callSites)
+        //for (LLError::CallSite* site : callSites)
+        //{
+        //    site->invalidate();
+        //}
+
+        //callSites.clear();
+        if (LLError::Log::sSettingsGeneration.fetch_add(1) + 1 == 0)
         {
-            site->invalidate();
+            LLError::Log::sSettingsGeneration.fetch_add(1);
         }
-
-        callSites.clear();
     }
+    // </3T:TommyTheTerrible>
 
     SettingsConfigPtr Globals::getSettingsConfig()
     {
@@ -640,7 +662,10 @@ namespace LLError
         mLine(line),
         mClassInfo(class_info),
         mFunction(function),
-        mCached(false),
+        // <3T:TommyTheTerrible> Cached per settings generation
+        //mCached(false),
+        mCachedGeneration(0),
+        // </3T:TommyTheTerrible>
         mShouldLog(false),
         mPrintOnce(printOnce),
         mTags(new const char* [tag_count]),
@@ -702,7 +727,7 @@ namespace LLError
 
     void CallSite::invalidate()
     {
-        mCached = false;
+        mCachedGeneration = 0; // <3T:TommyTheTerrible/>
     }
 }
 
@@ -1232,6 +1257,16 @@ namespace
 
         std::string escaped_message;
 
+        // <3T:TommyTheTerrible> Lazy message formatting
+        // A recorder's line depends only on the fields it wants, so recorders
+        // that want the same fields share one line, and the time and the
+        // escaped message are only made if some recorder uses them.
+        std::pair<U32, std::string> formatted[4];
+        size_t formatted_count = 0;
+        std::string time_string;
+        bool have_time = false;
+        // </3T:TommyTheTerrible>
+
         std::unique_lock lock(s->mRecorderMutex); LL_PROFILE_MUTEX_LOCK(s->mRecorderMutex);
         for (LLError::RecorderPtr& r : s->mRecorders)
         {
@@ -1242,52 +1277,137 @@ namespace
                 continue;
             }
 
-            std::ostringstream message_stream;
-
-            if (r->wantsTime() && s->mTimeFunction != NULL)
+            // <3T:TommyTheTerrible> Lazy message formatting
+            //std::ostringstream message_stream;
+
+            //if (r->wantsTime() && s->mTimeFunction != NULL)
+            //{
+            //    message_stream << s->mTimeFunction();
+            //}
+            //message_stream << " ";
+
+            //if (r->wantsLevel())
+            //{
+            //    message_stream << site.mLevelString;
+            //}
+            //message_stream << " ";
+
+            //if (r->wantsTags())
+            //{
+            //    message_stream << site.mTagString;
+            //}
+            //message_stream << " ";
+
+            //if (r->wantsLocation() || level == LLError::LEVEL_ERROR)
+            //{
+            //    message_stream << site.mLocationString;
+            //}
+            //message_stream << " ";
+
+            //if (r->wantsFunctionName())
+            //{
+            //    message_stream << site.mFunctionString;
+            //}
+            //message_stream << " : ";
+
+            //if (r->wantsMultiline())
+            //{
+            //    message_stream << message;
+            //}
+            //else
+            //{
+            //    if (escaped_message.empty())
+            //    {
+            //        escaped_message = escapedMessageLines(message);
+            //    }
+            //    message_stream << escaped_message;
+            //}
+
+            //r->recordMessage(level, message_stream.str());
+            enum
+            {
+                FIELD_TIME = 1 << 0,
+                FIELD_LEVEL = 1 << 1,
+                FIELD_TAGS = 1 << 2,
+                FIELD_LOCATION = 1 << 3,
+                FIELD_FUNCTION = 1 << 4,
+                FIELD_MULTILINE = 1 << 5
+            };
+            const U32 fields = ((r->wantsTime() && s->mTimeFunction != NULL) ? FIELD_TIME : 0)
+                             | (r->wantsLevel() ? FIELD_LEVEL : 0)
+                             | (r->wantsTags() ? FIELD_TAGS : 0)
+                             | ((r->wantsLocation() || level == LLError::LEVEL_ERROR) ? FIELD_LOCATION : 0)
+                             | (r->wantsFunctionName() ? FIELD_FUNCTION : 0)
+                             | (r->wantsMultiline() ? FIELD_MULTILINE : 0);
+
+            const std::string* line = nullptr;
+            for (size_t i = 0; i < formatted_count; ++i)
             {
-                message_stream << s->mTimeFunction();
+                if (formatted[i].first == fields)
+                {
+                    line = &formatted[i].second;
+                    break;
+                }
             }
-            message_stream << " ";
-
-            if (r->wantsLevel())
+            if (line)
             {
-                message_stream << site.mLevelString;
+                r->recordMessage(level, *line);
+                continue;
             }
-            message_stream << " ";
 
-            if (r->wantsTags())
+            const std::string* text = &message;
+            if (!(fields & FIELD_MULTILINE))
             {
-                message_stream << site.mTagString;
+                if (escaped_message.empty())
+                {
+                    escaped_message = escapedMessageLines(message);
+                }
+                text = &escaped_message;
             }
-            message_stream << " ";
-
-            if (r->wantsLocation() || level == LLError::LEVEL_ERROR)
+            if ((fields & FIELD_TIME) && !have_time)
             {
-                message_stream << site.mLocationString;
+                time_string = s->mTimeFunction();
+                have_time = true;
             }
-            message_stream << " ";
 
-            if (r->wantsFunctionName())
+            // more distinct recorders than slots is unheard of; format those each time
+            std::string overflow;
+            std::string& out = formatted_count < LL_ARRAY_SIZE(formatted) ? formatted[formatted_count].second : overflow;
+            out.reserve(time_string.size() + site.mTagString.size() + site.mLocationString.size()
+                        + site.mFunctionString.size() + text->size() + 16);
+            if (fields & FIELD_TIME)
             {
-                message_stream << site.mFunctionString;
+                out += time_string;
             }
-            message_stream << " : ";
-
-            if (r->wantsMultiline())
+            out += ' ';
+            if (fields & FIELD_LEVEL)
             {
-                message_stream << message;
+                out += site.mLevelString;
             }
-            else
+            out += ' ';
+            if (fields & FIELD_TAGS)
             {
-                if (escaped_message.empty())
-                {
-                    escaped_message = escapedMessageLines(message);
-                }
-                message_stream << escaped_message;
+                out += site.mTagString;
+            }
+            out += ' ';
+            if (fields & FIELD_LOCATION)
+            {
+                out += site.mLocationString;
+            }
+            out += ' ';
+            if (fields & FIELD_FUNCTION)
+            {
+                out += site.mFunctionString;
             }
+            out += " : ";
+            out += *text;
 
-            r->recordMessage(level, message_stream.str());
+            if (formatted_count < LL_ARRAY_SIZE(formatted))
+            {
+                formatted[formatted_count++].first = fields;
+            }
+            r->recordMessage(level, out);
+            // </3T:TommyTheTerrible>
         }
     }
 }
@@ -1356,16 +1476,347 @@ namespace {
     }
 }
 
+// <3T:TommyTheTerrible> Asynchronous logging
+namespace
+{
+    struct AsyncLogEntry
+    {
+        U64                         mSequence{ 0 };
+        const LLError::CallSite*    mSite{ nullptr };   // call sites are static
+        std::string                 mMessage;
+    };
+
+    // The messages one thread has logged and the writer has not taken yet.
+    // Only the owning thread pushes and only the writer pops, so neither
+    // side locks. A full ring drops what is pushed.
+    class AsyncLogRing
+    {
+    public:
+        static constexpr U32 CAPACITY = 1024; // a power of two
+
+        bool push(AsyncLogEntry& entry)
+        {
+            const U32 head = mHead.load(std::memory_order_relaxed);
+            if (head - mTail.load(std::memory_order_acquire) >= CAPACITY)
+            {
+                return false;
+            }
+            mSlots[head & (CAPACITY - 1)] = std::move(entry);
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        void popAll(std::vector<AsyncLogEntry>& out)
+        {
+            U32 tail = mTail.load(std::memory_order_relaxed);
+            const U32 head = mHead.load(std::memory_order_acquire);
+            for (; tail != head; ++tail)
+            {
+                out.push_back(std::move(mSlots[tail & (CAPACITY - 1)]));
+            }
+            mTail.store(tail, std::memory_order_release);
+        }
+
+        bool empty() const
+        {
+            return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+        }
+
+        // set when the owning thread exits; the writer then drops the ring
+        // once it is empty
+        std::atomic<bool> mThreadGone{ false };
+
+    private:
+        alignas(64) std::atomic<U32> mHead{ 0 };
+        alignas(64) std::atomic<U32> mTail{ 0 };
+        AsyncLogEntry mSlots[CAPACITY];
+    };
+
+    // A thread's ring is created the first time it logs asynchronously. The
+    // plain pointer stays usable while other thread_locals are destroyed.
+    thread_local AsyncLogRing* tAsyncLogRing = nullptr;
+    thread_local bool tAsyncLogRingReleased = false;
+    thread_local bool tIsAsyncLogWriter = false;
+
+    struct AsyncLogRingOwner
+    {
+        std::shared_ptr<AsyncLogRing> mRing;
+
+        ~AsyncLogRingOwner()
+        {
+            if (mRing)
+            {
+                mRing->mThreadGone.store(true, std::memory_order_release);
+            }
+            tAsyncLogRing = nullptr;
+            tAsyncLogRingReleased = true;
+        }
+    };
+    thread_local AsyncLogRingOwner tAsyncLogRingOwner;
+
+    // Takes what the threads have queued, puts it back in the order it was
+    // logged and hands it to the recorders under the log mutex, the same way
+    // Log::flush() would have.
+    class AsyncLogWriter
+    {
+    public:
+        static AsyncLogWriter& instance()
+        {
+            static AsyncLogWriter sInstance;
+            return sInstance;
+        }
+
+        ~AsyncLogWriter()
+        {
+            stop();
+        }
+
+        void start();
+        void stop();
+        bool isRunning() const { return mRunning.load(std::memory_order_acquire); }
+
+        // False if the message was not taken and must be written directly.
+        bool post(const LLError::CallSite& site, std::string& message);
+        void waitWritten();
+        LLError::AsyncLogStats getStats() const;
+
+    private:
+        AsyncLogWriter() = default;
+
+        AsyncLogRing* getThreadRing();
+        void drain(std::vector<AsyncLogEntry>& batch);
+        void run();
+
+        std::mutex                                  mControlMutex;
+        std::thread                                 mThread;
+        std::atomic<bool>                           mRunning{ false };
+
+        std::mutex                                  mRingsMutex;
+        std::vector<std::shared_ptr<AsyncLogRing>>  mRings;
+
+        std::atomic<U64>                            mSequence{ 0 };
+        std::atomic<U64>                            mQueued{ 0 };
+        std::atomic<U64>                            mWritten{ 0 };
+        std::atomic<U64>                            mDropped{ 0 };
+
+        // The writer sleeps only when it has caught up; a thread that queues
+        // a message then wakes it.
+        std::mutex                                  mWakeMutex;
+        std::condition_variable                     mWake;
+        std::condition_variable                     mWrittenCond;
+        std::atomic<bool>                           mWriterIdle{ false };
+        std::atomic<U32>                            mFlushWaiters{ 0 };
+    };
+
+    void AsyncLogWriter::start()
+    {
+        std::lock_guard<std::mutex> lock(mControlMutex);
+        if (mThread.joinable())
+        {
+            return;
+        }
+        mRunning = true;
+        mThread = std::thread([this]() { run(); });
+    }
+
+    void AsyncLogWriter::stop()
+    {
+        std::lock_guard<std::mutex> lock(mControlMutex);
+        if (!mThread.joinable())
+        {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> wake_lock(mWakeMutex);
+            mRunning = false;
+            mWake.notify_one();
+        }
+        // the writer writes out whatever is queued before it returns
+        mThread.join();
+        std::lock_guard<std::mutex> wake_lock(mWakeMutex);
+        mWrittenCond.notify_all();
+    }
+
+    AsyncLogRing* AsyncLogWriter::getThreadRing()
+    {
+        if (tAsyncLogRing || tAsyncLogRingReleased)
+        {
+            return tAsyncLogRing;
+        }
+        std::shared_ptr<AsyncLogRing> ring = std::make_shared<AsyncLogRing>();
+        {
+            std::lock_guard<std::mutex> lock(mRingsMutex);
+            mRings.push_back(ring);
+        }
+        tAsyncLogRingOwner.mRing = ring;
+        tAsyncLogRing = ring.get();
+        return tAsyncLogRing;
+    }
+
+    bool AsyncLogWriter::post(const LLError::CallSite& site, std::string& message)
+    {
+        if (!isRunning())
+        {
+            return false;
+        }
+        AsyncLogRing* ring = getThreadRing();
+        if (!ring)
+        {
+            return false;
+        }
+
+        AsyncLogEntry entry;
+        entry.mSequence = mSequence.fetch_add(1, std::memory_order_relaxed);
+        entry.mSite = &site;
+        entry.mMessage = std::move(message);
+        if (!ring->push(entry))
+        {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        mQueued.fetch_add(1);
+
+        if (mWriterIdle.load())
+        {
+            std::lock_guard<std::mutex> lock(mWakeMutex);
+            mWake.notify_one();
+        }
+        return true;
+    }
+
+    void AsyncLogWriter::waitWritten()
+    {
+        if (!isRunning() || tIsAsyncLogWriter)
+        {
+            return;
+        }
+        const U64 target = mQueued.load();
+        mFlushWaiters.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            mWake.notify_one();
+            mWrittenCond.wait(lock, [this, target]()
+                              {
+                                  return mWritten.load() >= target || !isRunning();
+                              });
+        }
+        mFlushWaiters.fetch_sub(1);
+    }
+
+    LLError::AsyncLogStats AsyncLogWriter::getStats() const
+    {
+        LLError::AsyncLogStats stats;
+        stats.mQueued = mQueued.load();
+        stats.mWritten = mWritten.load();
+        stats.mDropped = mDropped.load();
+        return stats;
+    }
+
+    void AsyncLogWriter::drain(std::vector<AsyncLogEntry>& batch)
+    {
+        std::vector<std::shared_ptr<AsyncLogRing>> rings;
+        {
+            std::lock_guard<std::mutex> lock(mRingsMutex);
+            // nothing more can arrive in the ring of a thread that has gone
+            mRings.erase(std::remove_if(mRings.begin(), mRings.end(),
+                                        [](const std::shared_ptr<AsyncLogRing>& ring)
+                                        {
+                                            return ring->mThreadGone.load(std::memory_order_acquire) && ring->empty();
+                                        }),
+                         mRings.end());
+            rings = mRings;
+        }
+        for (const std::shared_ptr<AsyncLogRing>& ring : rings)
+        {
+            ring->popAll(batch);
+        }
+    }
+
+    void AsyncLogWriter::run()
+    {
+        tIsAsyncLogWriter = true;
+        std::vector<AsyncLogEntry> batch;
+        U64 dropped_reported = mDropped.load();
+        while (true)
+        {
+            batch.clear();
+            drain(batch);
+            if (!batch.empty())
+            {
+                std::sort(batch.begin(), batch.end(),
+                          [](const AsyncLogEntry& a, const AsyncLogEntry& b)
+                          {
+                              return a.mSequence < b.mSequence;
+                          });
+                for (const AsyncLogEntry& entry : batch)
+                {
+                    // one message at a time, so a thread that needs the
+                    // mutex waits for a message rather than a whole batch
+                    std::unique_lock lock(*getLogMutex()); LL_PROFILE_MUTEX_LOCK(*getLogMutex());
+                    writeToRecorders(*entry.mSite, entry.mMessage);
+                }
+                mWritten.fetch_add(batch.size());
+                if (mFlushWaiters.load())
+                {
+                    std::lock_guard<std::mutex> lock(mWakeMutex);
+                    mWrittenCond.notify_all();
+                }
+
+                const U64 dropped = mDropped.load(std::memory_order_relaxed);
+                if (dropped != dropped_reported)
+                {
+                    LL_WARNS("LLError") << (dropped - dropped_reported)
+                                        << " log messages dropped, a thread's log queue was full" << LL_ENDL;
+                    dropped_reported = dropped;
+                }
+                continue;
+            }
+
+            if (!isRunning())
+            {
+                // everything queued before stop() has been written
+                break;
+            }
+
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            mWriterIdle.store(true);
+            mWake.wait_for(lock, std::chrono::milliseconds(100), [this]()
+                           {
+                               return mQueued.load() != mWritten.load() || !isRunning();
+                           });
+            mWriterIdle.store(false);
+        }
+    }
+}
+// </3T:TommyTheTerrible>
+
 namespace LLError
 {
+    std::atomic<U32> Log::sSettingsGeneration{ 1 }; // <3T:TommyTheTerrible/>
 
     bool Log::shouldLog(CallSite& site)
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_LOGGING;
+        // <3T:TommyTheTerrible> Cached per settings generation
+        // Read before the settings, so a change made while this runs is
+        // seen on the next call.
+        const U32 generation = sSettingsGeneration.load();
+        // </3T:TommyTheTerrible>
         std::unique_lock lock(*getLogMutex(), std::try_to_lock); LL_PROFILE_MUTEX_LOCK(*getLogMutex());
         if (!lock)
         {
-            return false;
+            // <3T:TommyTheTerrible> Cached per settings generation
+            // Another thread is logging. A site decided before keeps its
+            // answer until it can ask again, rather than being silenced.
+            // An error, or a site never decided, waits for the mutex.
+            //return false;
+            const bool decided = site.mCachedGeneration.load(std::memory_order_acquire) != 0;
+            if (decided && site.mLevel != LEVEL_ERROR)
+            {
+                return site.mShouldLog.load(std::memory_order_relaxed);
+            }
+            lock.lock();
+            // </3T:TommyTheTerrible>
         }
 
         Globals *g = Globals::getInstance();
@@ -1398,16 +1849,55 @@ namespace LLError
             ? checkLevelMap(s->mTagLevelMap, site.mTags, site.mTagCount, compareLevel)
             : false);
 
-        site.mCached = true;
-        g->addCallSite(site);
-        return site.mShouldLog = site.mLevel >= compareLevel;
+        // <3T:TommyTheTerrible> Cached per settings generation
+        //site.mCached = true;
+        //g->addCallSite(site);
+        //return site.mShouldLog = site.mLevel >= compareLevel;
+        const bool should_log = site.mLevel >= compareLevel;
+        site.mShouldLog.store(should_log, std::memory_order_relaxed);
+        site.mCachedGeneration.store(generation, std::memory_order_release);
+        return should_log;
+        // </3T:TommyTheTerrible>
     }
 
 
     void Log::flush(const std::ostringstream& out, const CallSite& site)
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_LOGGING;
-        std::unique_lock lock(*getLogMutex(), std::try_to_lock); LL_PROFILE_MUTEX_LOCK(*getLogMutex());
+        // <3T:TommyTheTerrible> Asynchronous logging
+        // An ordinary message is queued without the log mutex. ONCE messages
+        // need the map of messages seen, and an error has to be written
+        // before the fatal function runs, so those still come through here.
+        AsyncLogWriter& async_writer = AsyncLogWriter::instance();
+        if (async_writer.isRunning())
+        {
+            if (site.mLevel == LEVEL_ERROR)
+            {
+                async_writer.waitWritten();
+            }
+            else if (!site.mPrintOnce)
+            {
+                std::string message = out.str();
+                if (async_writer.post(site, message))
+                {
+                    return;
+                }
+            }
+        }
+        // An error or a ONCE message waits for whoever is writing, the
+        // writer thread included, instead of being lost.
+        //std::unique_lock lock(*getLogMutex(), std::try_to_lock); LL_PROFILE_MUTEX_LOCK(*getLogMutex());
+        std::unique_lock lock(*getLogMutex(), std::defer_lock);
+        if (site.mLevel == LEVEL_ERROR || site.mPrintOnce)
+        {
+            lock.lock();
+        }
+        else
+        {
+            lock.try_lock();
+        }
+        LL_PROFILE_MUTEX_LOCK(*getLogMutex());
+        // </3T:TommyTheTerrible>
         if (!lock)
         {
             return;
@@ -1445,7 +1935,13 @@ namespace LLError
             message = message_stream.str();
         }
 
-        writeToRecorders(site, message);
+        // <3T:TommyTheTerrible> Asynchronous logging
+        //writeToRecorders(site, message);
+        if (site.mLevel == LEVEL_ERROR || !async_writer.post(site, message))
+        {
+            writeToRecorders(site, message);
+        }
+        // </3T:TommyTheTerrible>
 
         if (site.mLevel == LEVEL_ERROR)
         {
@@ -1460,6 +1956,35 @@ namespace LLError
 
 namespace LLError
 {
+    // <3T:TommyTheTerrible> Asynchronous logging
+    void setAsyncLogging(bool async)
+    {
+        if (async)
+        {
+            AsyncLogWriter::instance().start();
+        }
+        else
+        {
+            AsyncLogWriter::instance().stop();
+        }
+    }
+
+    bool getAsyncLogging()
+    {
+        return AsyncLogWriter::instance().isRunning();
+    }
+
+    void flushAsyncLog()
+    {
+        AsyncLogWriter::instance().waitWritten();
+    }
+
+    AsyncLogStats getAsyncLogStats()
+    {
+        return AsyncLogWriter::instance().getStats();
+    }
+    // </3T:TommyTheTerrible>
+
     SettingsStoragePtr saveAndResetSettings()
     {
         return Globals::getInstance()->saveAndResetSettingsConfig();
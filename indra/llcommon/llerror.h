@@ -28,6 +28,7 @@
 #ifndef LL_LLERROR_H
 #define LL_LLERROR_H
 
+#include <atomic> // <3T:TommyTheTerrible/>
 #include <sstream>
 #include <string>
 #include <typeinfo>
@@ -187,6 +188,11 @@ const int LL_ERR_NOERR = 0;
     #ifdef _DEBUG constructs.  LL_DEBUGS("StringTag") messages are compiled into all builds,
     even release.  Which means you can use them to help debug even when deployed
     to a real grid.
+
+    A build made with LL_COMPILE_OUT_DEBUG_LOGS defined (the CMake option of
+    the same name) is the exception: its LL_DEBUGS and LL_DEBUGS_ONCE
+    messages are still compiled, so they must stay valid code, but can never
+    run and cannot be turned on by logcontrol.xml.
 */
 namespace LLError
 {
@@ -216,6 +222,10 @@ namespace LLError
     class LL_COMMON_API Log
     {
     public:
+        // <3T:TommyTheTerrible> Bumped by every change to the logging
+        // settings; a CallSite decided in an older generation asks again.
+        static std::atomic<U32> sSettingsGeneration;
+        // </3T:TommyTheTerrible>
         static bool shouldLog(CallSite&);
         static void flush(const std::ostringstream&, const CallSite&);
         static std::string demangle(const char* mangled);
@@ -251,9 +261,14 @@ namespace LLError
 #else // LL_LIBRARY_INCLUDE
         bool shouldLog()
         {
-            return mCached
-                    ? mShouldLog
+            // <3T:TommyTheTerrible> Cached per settings generation
+            //return mCached
+            //        ? mShouldLog
+            //        : Log::shouldLog(*this);
+            return mCachedGeneration.load(std::memory_order_acquire) == Log::sSettingsGeneration.load(std::memory_order_relaxed)
+                    ? mShouldLog.load(std::memory_order_relaxed)
                     : Log::shouldLog(*this);
+            // </3T:TommyTheTerrible>
         }
             // this member function needs to be in-line for efficiency
 #endif // LL_LIBRARY_INCLUDE
@@ -273,8 +288,12 @@ namespace LLError
         std::string             mLocationString,
                                 mFunctionString,
                                 mTagString;
-        bool                    mCached,
-                                mShouldLog;
+        // <3T:TommyTheTerrible> Cached per settings generation
+        //bool                    mCached,
+        //                        mShouldLog;
+        std::atomic<U32>        mCachedGeneration;  // 0 until first decided
+        std::atomic<bool>       mShouldLog;
+        // </3T:TommyTheTerrible>
 
         friend class Log;
     };
@@ -411,6 +430,19 @@ typedef LLError::NoClassInfo _LL_CLASS_TO_LOG;
     level, __FILE__, __LINE__, typeid(_LL_CLASS_TO_LOG),    \
     __FUNCTION__, once, &tags[1], LL_ARRAY_SIZE(tags)-1
 
+// <3T:TommyTheTerrible> Compile LL_DEBUGS sites out of the build
+// Same shape as lllog(), so LL_CONT and LL_ENDL still pair up, but nothing
+// in the block can run: the compiler checks the message and drops it.
+#define lllog_compiled_out_(level, once, ...)                           \
+    do {                                                                \
+        if (false)                                                      \
+        {                                                               \
+            const char* tags[] = {"", ##__VA_ARGS__};                   \
+            static LLError::CallSite _site(lllog_site_args_(level, once, tags)); \
+            std::ostringstream _out;                                    \
+            _out
+// </3T:TommyTheTerrible>
+
 //Use this construct if you need to do computation in the middle of a
 //message:
 //
@@ -449,7 +481,14 @@ typedef LLError::NoClassInfo _LL_CLASS_TO_LOG;
 // NEW Macros for debugging, allow the passing of a string tag
 
 // Pass comma separated list of tags (currently only supports up to 0, 1, or 2)
+// <3T:TommyTheTerrible> Compile LL_DEBUGS sites out of the build
+//#define LL_DEBUGS(...)  lllog(LLError::LEVEL_DEBUG, false, ##__VA_ARGS__)
+#ifdef LL_COMPILE_OUT_DEBUG_LOGS
+#define LL_DEBUGS(...)  lllog_compiled_out_(LLError::LEVEL_DEBUG, false, ##__VA_ARGS__)
+#else
 #define LL_DEBUGS(...)  lllog(LLError::LEVEL_DEBUG, false, ##__VA_ARGS__)
+#endif
+// </3T:TommyTheTerrible>
 #define LL_INFOS(...)   lllog(LLError::LEVEL_INFO, false, ##__VA_ARGS__)
 #define LL_WARNS(...)   lllog(LLError::LEVEL_WARN, false, ##__VA_ARGS__)
 #define LL_ERRS(...)    lllog(LLError::LEVEL_ERROR, false, ##__VA_ARGS__)
@@ -464,7 +503,14 @@ typedef LLError::NoClassInfo _LL_CLASS_TO_LOG;
 
 // Only print the log message once (good for warnings or infos that would otherwise
 // spam the log file over and over, such as tighter loops).
+// <3T:TommyTheTerrible> Compile LL_DEBUGS sites out of the build
+//#define LL_DEBUGS_ONCE(...) lllog(LLError::LEVEL_DEBUG, true, ##__VA_ARGS__)
+#ifdef LL_COMPILE_OUT_DEBUG_LOGS
+#define LL_DEBUGS_ONCE(...) lllog_compiled_out_(LLError::LEVEL_DEBUG, true, ##__VA_ARGS__)
+#else
 #define LL_DEBUGS_ONCE(...) lllog(LLError::LEVEL_DEBUG, true, ##__VA_ARGS__)
+#endif
+// </3T:TommyTheTerrible>
 #define LL_INFOS_ONCE(...)  lllog(LLError::LEVEL_INFO, true, ##__VA_ARGS__)
 #define LL_WARNS_ONCE(...)  lllog(LLError::LEVEL_WARN, true, ##__VA_ARGS__)
 
@@ -227,6 +227,32 @@ namespace LLError
     LL_COMMON_API std::string logFileName();
         // returns name of current logging file, empty string if none
 
+    // <3T:TommyTheTerrible> Asynchronous logging
+    /*
+        Asynchronous logging: a message is queued for a background writer
+        thread, which formats it and passes it to the recorders, instead of
+        being written by the thread that logged it.
+    */
+
+    struct AsyncLogStats
+    {
+        U64 mQueued{ 0 };   // messages handed to the writer
+        U64 mWritten{ 0 };  // messages the writer has passed to the recorders
+        U64 mDropped{ 0 };  // messages lost because their thread's queue was full
+    };
+
+    LL_COMMON_API void setAsyncLogging(bool async);
+        // Each thread queues up to a fixed number of messages without
+        // locking; past that they are dropped and counted. LL_ERRS messages
+        // are still written by the thread that logs them, after everything
+        // it queued before. Recorders that want the time get the time the
+        // message is written. Turning it off writes out what is queued.
+    LL_COMMON_API bool getAsyncLogging();
+    LL_COMMON_API void flushAsyncLog();
+        // blocks until the messages queued so far have been written
+    LL_COMMON_API AsyncLogStats getAsyncLogStats();
+    // </3T:TommyTheTerrible>
+
 
     /*
         Utilities for use by the unit tests of LLError itself.
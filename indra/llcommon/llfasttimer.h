@@ -29,6 +29,7 @@
 
 #include "llinstancetracker.h"
 #include "lltrace.h"
+#include "lltraceprofilecapture.h" // <3T:TommyTheTerrible/>
 #include "lltreeiterators.h"
 
 #if LL_WINDOWS
@@ -334,6 +335,13 @@ LL_FORCE_INLINE BlockTimer::~BlockTimer()
     // do this in the destructor in case of recursion to get topmost caller
     accumulator.mLastCaller = mParentTimerData.mTimeBlock;
 
+    // <3T:TommyTheTerrible> Frame profile capture
+    if (LL_UNLIKELY(ProfileCapture::isCapturing()))
+    {
+        ProfileCapture::record(*cur_timer_data->mTimeBlock, mStartTime, total_time);
+    }
+    // </3T:TommyTheTerrible>
+
     // we are only tracking self time, so subtract our total time delta from parents
     mParentTimerData.mChildTime += total_time;
 
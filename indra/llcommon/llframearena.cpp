@@ -0,0 +1,174 @@
+/**
+ * @file   llframearena.cpp
+ * @brief  Per-thread bump allocation of data that lives for one frame.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llframearena.h"
+
+#include "llmemory.h"
+#include "lltrace.h"
+
+#include <cstring>
+#include <new>
+
+namespace
+{
+    LLTrace::CountStatHandle<F64Kilobytes> sFrameArenaServed("frame_arena_served", "memory handed out by LLFrameArena");
+    LLTrace::SampleStatHandle<F64Kilobytes> sFrameArenaUsed("frame_arena_used", "LLFrameArena memory one frame used");
+
+    inline size_t round_up(size_t size, size_t alignment)
+    {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+//static
+LLFrameArena& LLFrameArena::get()
+{
+    static thread_local LLFrameArena sArena;
+    return sArena;
+}
+
+LLFrameArena::LLFrameArena()
+:   mCurrent(0),
+    mNext(nullptr),
+    mEnd(nullptr),
+    mUsed(0),
+    mPeak(0),
+    mCapacity(0),
+    mFrame(0),
+    mQuietFrames(0)
+{
+}
+
+LLFrameArena::~LLFrameArena()
+{
+    freeChunks();
+}
+
+void* LLFrameArena::allocateSlow(size_t size, size_t alignment)
+{
+    llassert((alignment & (alignment - 1)) == 0);
+    // Blocks start ALIGNMENT aligned, so this is enough slack for any
+    // alignment up to that and a bit more than needed beyond it.
+    const size_t needed = size + (alignment > ALIGNMENT ? alignment : 0);
+
+    // Move on to a block left over from an earlier frame if one is big
+    // enough; otherwise put a new one in after the current block.
+    size_t next = mNext ? mCurrent + 1 : 0;
+    if (next >= mChunks.size() || mChunks[next].mSize < needed)
+    {
+        Chunk chunk;
+        chunk.mSize = llmax(round_up(needed, ALIGNMENT), CHUNK_BYTES);
+        chunk.mData = static_cast<char*>(ll_aligned_malloc_16(chunk.mSize));
+        if (!chunk.mData)
+        {
+            // as operator new would; the arena is unchanged
+            throw std::bad_alloc();
+        }
+        mChunks.insert(mChunks.begin() + next, chunk);
+        mCapacity += chunk.mSize;
+    }
+    mCurrent = next;
+    mNext = mChunks[next].mData;
+    mEnd = mNext + mChunks[next].mSize;
+    return allocate(size, alignment);
+}
+
+void LLFrameArena::reset()
+{
+    LL_PROFILE_ZONE_SCOPED;
+    add(sFrameArenaServed, F64Bytes((F64)mUsed));
+    sample(sFrameArenaUsed, F64Bytes((F64)mUsed));
+    mPeak = llmax(mPeak, mUsed);
+
+#ifdef SHOW_ASSERT
+    // make use after reset() show
+    for (size_t i = 0; mNext && i <= mCurrent; ++i)
+    {
+        char* end = (i == mCurrent) ? mNext : mChunks[i].mData + mChunks[i].mSize;
+        memset(mChunks[i].mData, 0xcd, end - mChunks[i].mData);
+    }
+#endif
+
+    if (mNext && mCurrent > 0)
+    {
+        // This frame spilled into more blocks. Next frame, one block.
+        replaceChunks(mCapacity);
+        mQuietFrames = 0;
+    }
+    else if (mCapacity > CHUNK_BYTES && mUsed < mCapacity / 4)
+    {
+        // A burst (teleport, a crowded region) grew the block; once frames
+        // have stayed well below it for a while, give half of it back.
+        if (++mQuietFrames >= QUIET_FRAMES)
+        {
+            replaceChunks(llmax(round_up(mCapacity / 2, ALIGNMENT), CHUNK_BYTES));
+            mQuietFrames = 0;
+        }
+    }
+    else
+    {
+        mQuietFrames = 0;
+    }
+
+    mCurrent = 0;
+    if (!mChunks.empty())
+    {
+        mNext = mChunks[0].mData;
+        mEnd = mNext + mChunks[0].mSize;
+    }
+    mUsed = 0;
+    ++mFrame;
+}
+
+void LLFrameArena::replaceChunks(size_t size)
+{
+    freeChunks();
+    Chunk chunk;
+    chunk.mSize = size;
+    chunk.mData = static_cast<char*>(ll_aligned_malloc_16(chunk.mSize));
+    // If that fails the arena starts the frame empty and allocateSlow()
+    // asks for only what the first allocation needs.
+    if (chunk.mData)
+    {
+        mChunks.push_back(chunk);
+        mCapacity = size;
+    }
+}
+
+void LLFrameArena::freeChunks()
+{
+    for (Chunk& chunk : mChunks)
+    {
+        ll_aligned_free_16(chunk.mData);
+    }
+    mChunks.clear();
+    mCapacity = 0;
+    mCurrent = 0;
+    mNext = nullptr;
+    mEnd = nullptr;
+}
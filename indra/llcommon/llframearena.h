@@ -0,0 +1,159 @@
+/**
+ * @file   llframearena.h
+ * @brief  Per-thread bump allocation of data that lives for one frame.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLFRAMEARENA_H
+#define LL_LLFRAMEARENA_H
+
+#include "stdtypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Each thread has an LLFrameArena that hands out memory by bumping a
+ * pointer through a large block, and takes it all back at once when the
+ * thread calls reset() at the end of its frame. Nothing is freed
+ * individually: scratch data built and thrown away within a frame costs no
+ * heap traffic at all once the arena has grown to the frame's needs.
+ *
+ * Anything allocated here is gone after the owning thread's next reset(),
+ * so use it only for locals and temporaries that cannot survive the frame
+ * -- never for members, statics, or containers that are clear()ed and
+ * reused, since those keep their storage across frames.
+ *
+ * The viewer's main loop resets the main thread's arena at the top of each
+ * frame. Other threads that use theirs must reset it themselves.
+ */
+class LL_COMMON_API LLFrameArena
+{
+public:
+    static constexpr size_t ALIGNMENT = 16;
+    static constexpr size_t CHUNK_BYTES = 256 * 1024;
+    // Frames in a row that use under a quarter of the block before half of
+    // it is given back, down to CHUNK_BYTES.
+    static constexpr U32 QUIET_FRAMES = 120;
+
+    LLFrameArena(const LLFrameArena&) = delete;
+    LLFrameArena& operator=(const LLFrameArena&) = delete;
+
+    // The calling thread's arena.
+    static LLFrameArena& get();
+
+    // alignment must be a power of two.
+    void* allocate(size_t size, size_t alignment = ALIGNMENT);
+
+    // Forget everything allocated since the last reset(). If the frame
+    // needed more than one block, the next frame gets a single block big
+    // enough for all of it; after QUIET_FRAMES frames that needed far less,
+    // the block shrinks again.
+    void reset();
+
+    // Bytes handed out since the last reset().
+    size_t getBytesUsed() const { return mUsed; }
+    // The most any frame has used so far.
+    size_t getPeakBytes() const { return mPeak; }
+    // Bytes held in blocks, used or not.
+    size_t getCapacity() const { return mCapacity; }
+    // Number of reset() calls so far.
+    U32 getFrame() const { return mFrame; }
+
+private:
+    LLFrameArena();
+    ~LLFrameArena();
+
+    void* allocateSlow(size_t size, size_t alignment);
+    // Swap whatever blocks there are for a single one of size bytes.
+    void replaceChunks(size_t size);
+    void freeChunks();
+
+    struct Chunk
+    {
+        char*   mData;
+        size_t  mSize;
+    };
+    std::vector<Chunk>  mChunks;
+    size_t              mCurrent;
+    char*               mNext;
+    char*               mEnd;
+    size_t              mUsed;
+    size_t              mPeak;
+    size_t              mCapacity;
+    U32                 mFrame;
+    U32                 mQuietFrames;
+};
+
+inline void* LLFrameArena::allocate(size_t size, size_t alignment)
+{
+    char* block = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(mNext) + alignment - 1) & ~uintptr_t(alignment - 1));
+    if (!mNext || size > size_t(mEnd - block))
+    {
+        return allocateSlow(size, alignment);
+    }
+    mNext = block + size;
+    mUsed += size;
+    return block;
+}
+
+/**
+ * STL allocator over an LLFrameArena, by default the constructing thread's.
+ * deallocate() does nothing, so a container that grows a lot leaves its
+ * old storage behind until reset(); reserve() where the size is known.
+ */
+template <typename T>
+class LLFrameAllocator
+{
+public:
+    typedef T value_type;
+
+    LLFrameAllocator() noexcept : mArena(&LLFrameArena::get()) {}
+    explicit LLFrameAllocator(LLFrameArena& arena) noexcept : mArena(&arena) {}
+    template <typename U>
+    LLFrameAllocator(const LLFrameAllocator<U>& other) noexcept : mArena(other.getArena()) {}
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(mArena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) noexcept {}
+
+    LLFrameArena* getArena() const { return mArena; }
+
+    template <typename U>
+    bool operator==(const LLFrameAllocator<U>& other) const { return mArena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const LLFrameAllocator<U>& other) const { return mArena != other.getArena(); }
+
+private:
+    LLFrameArena* mArena;
+};
+
+template <typename T>
+using LLFrameVector = std::vector<T, LLFrameAllocator<T>>;
+typedef std::basic_string<char, std::char_traits<char>, LLFrameAllocator<char>> LLFrameString;
+
+#endif // LL_LLFRAMEARENA_H
@@ -28,6 +28,7 @@
 #ifndef LL_LLINSTANCETRACKER_H
 #define LL_LLINSTANCETRACKER_H
 
+#include <array>
 #include <map>
 #include <set>
 #include <vector>
@@ -56,6 +57,72 @@ namespace LLInstanceTrackerPrivate
     };
 
     void logerrs(const char* cls, const std::string&, const std::string&, const std::string&);
+
+    // <3T:TommyTheTerrible> Sharded instance registry
+    // The instances of an LLInstanceTrackerSharded class, spread over SHARDS
+    // containers with a mutex each, so threads creating and destroying
+    // instances only contend when they hash to the same shard.
+    template <typename CONTAINER>
+    struct ShardedData
+    {
+        static constexpr size_t SHARDS = 16;
+
+        // one cache line each, so the shard mutexes don't share lines
+        struct alignas(64) Shard
+        {
+            LL_PROFILE_MUTEX_NAMED(std::mutex, mMutex, "InstanceTracker Shard");
+            CONTAINER mContainer;
+        };
+        typedef std::unique_lock<decltype(Shard::mMutex)> lock_t;
+
+        std::array<Shard, SHARDS> mShards;
+
+        // function-local static for the same reason as LockStatic::getStatic()
+        static ShardedData& get()
+        {
+            static ShardedData sData;
+            return sData;
+        }
+
+        // Fibonacci hashing, since std::hash of a pointer or an integer is
+        // often the value itself and its low bits would all pick one shard.
+        static size_t shardOf(size_t hash)
+        {
+            return (size_t)(((U64)hash * 0x9E3779B97F4A7C15ULL) >> 60);
+        }
+        static_assert(SHARDS == 16, "shardOf() keeps 4 bits");
+
+        // Every shard locked, always in index order, for a snapshot or count
+        // that is consistent across them.
+        class LockAll
+        {
+        public:
+            LockAll():
+                mData(get())
+            {
+                for (Shard& shard : mData.mShards)
+                {
+                    shard.mMutex.lock();
+                    LL_PROFILE_MUTEX_LOCK(shard.mMutex);
+                }
+            }
+            ~LockAll()
+            {
+                for (size_t i = SHARDS; i-- > 0; )
+                {
+                    mData.mShards[i].mMutex.unlock();
+                }
+            }
+            LockAll(const LockAll&) = delete;
+            LockAll& operator=(const LockAll&) = delete;
+
+            std::array<Shard, SHARDS>& shards() { return mData.mShards; }
+
+        private:
+            ShardedData& mData;
+        };
+    };
+    // </3T:TommyTheTerrible>
 } // namespace LLInstanceTrackerPrivate
 
 /*****************************************************************************
@@ -67,12 +134,27 @@ enum EInstanceTrackerAllowKeyCollisions
     LLInstanceTrackerReplaceOnCollision
 };
 
+// <3T:TommyTheTerrible> Sharded instance registry
+// How a tracked class keeps its instances. Classes whose instances come and
+// go on many threads at once can choose LLInstanceTrackerSharded: lookups,
+// construction and destruction lock one of several shards instead of a
+// single mutex, while snapshots and instanceCount() still lock them all and
+// see every instance at one moment. A keyed sharded class needs std::hash
+// of its KEY, and its snapshots are in no particular key order.
+enum EInstanceTrackerRegistry
+{
+    LLInstanceTrackerLocked,
+    LLInstanceTrackerSharded
+};
+// </3T:TommyTheTerrible>
+
 /// This mix-in class adds support for tracking all instances of the specified class parameter T
 /// The (optional) key associates a value of type KEY with a given instance of T, for quick lookup
 /// If KEY is not provided, then instances are stored in a simple set
 /// @NOTE: see explicit specialization below for default KEY==void case
 template<typename T, typename KEY = void,
-         EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR = LLInstanceTrackerErrorOnCollision>
+         EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR = LLInstanceTrackerErrorOnCollision,
+         EInstanceTrackerRegistry REGISTRY = LLInstanceTrackerLocked> // <3T:TommyTheTerrible/>
 class LLInstanceTracker
 {
     typedef std::map<KEY, std::shared_ptr<T>> InstanceMap;
@@ -348,8 +430,12 @@ private:
 
 /// explicit specialization for default case where KEY is void
 /// use a simple std::set<T*>
-template<typename T, EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR>
-class LLInstanceTracker<T, void, KEY_COLLISION_BEHAVIOR>
+//template<typename T, EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR>
+//class LLInstanceTracker<T, void, KEY_COLLISION_BEHAVIOR>
+// <3T:TommyTheTerrible> Sharded instance registry
+template<typename T, EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR, EInstanceTrackerRegistry REGISTRY>
+class LLInstanceTracker<T, void, KEY_COLLISION_BEHAVIOR, REGISTRY>
+// </3T:TommyTheTerrible>
 {
     typedef std::set<std::shared_ptr<T>> InstanceSet;
     struct StaticData: public LLInstanceTrackerPrivate::StaticBase
@@ -512,4 +598,364 @@ private:
     weak_t mSelf;
 };
 
+// <3T:TommyTheTerrible> Sharded instance registry
+/*****************************************************************************
+*   LLInstanceTracker with key, sharded
+*****************************************************************************/
+/// partial specialization for LLInstanceTrackerSharded: the same interface
+/// as above, with instances spread over LLInstanceTrackerPrivate::ShardedData
+template<typename T, typename KEY, EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR>
+class LLInstanceTracker<T, KEY, KEY_COLLISION_BEHAVIOR, LLInstanceTrackerSharded>
+{
+    typedef std::map<KEY, std::shared_ptr<T>> InstanceMap;
+    typedef LLInstanceTrackerPrivate::ShardedData<InstanceMap> Shards;
+    typedef typename Shards::Shard Shard;
+    typedef typename Shards::lock_t lock_t;
+
+    static Shard& shardFor(const KEY& key)
+    {
+        return Shards::get().mShards[Shards::shardOf(std::hash<KEY>()(key))];
+    }
+
+public:
+    using ptr_t  = std::shared_ptr<T>;
+    using weak_t = std::weak_ptr<T>;
+
+    weak_t getWeak()
+    {
+        return mSelf;
+    }
+
+    static size_t instanceCount()
+    {
+        typename Shards::LockAll lock;
+        size_t count = 0;
+        for (Shard& shard : lock.shards())
+        {
+            count += shard.mContainer.size();
+        }
+        return count;
+    }
+
+    // snapshot of std::pair<const KEY, std::shared_ptr<SUBCLASS>> pairs, for
+    // some SUBCLASS derived from T; see the unsharded snapshot_of
+    template <typename SUBCLASS>
+    class snapshot_of
+    {
+        typedef std::vector<std::pair<const KEY, weak_t>> VectorType;
+        typedef std::pair<const KEY, std::shared_ptr<SUBCLASS>> strong_pair;
+        static strong_pair strengthen(typename VectorType::value_type& pair)
+        {
+            return { pair.first, std::dynamic_pointer_cast<SUBCLASS>(pair.second.lock()) };
+        }
+        static bool dead_skipper(const strong_pair& pair)
+        {
+            return bool(pair.second);
+        }
+
+    public:
+        snapshot_of()
+        {
+            // every shard at once, released before we return
+            typename Shards::LockAll lock;
+            for (Shard& shard : lock.shards())
+            {
+                for (const auto& pair : shard.mContainer)
+                {
+                    mData.emplace_back(pair.first, pair.second);
+                }
+            }
+        }
+
+        typedef boost::transform_iterator<decltype(strengthen)*,
+                                          typename VectorType::iterator> strong_iterator;
+        typedef boost::filter_iterator<decltype(dead_skipper)*, strong_iterator> iterator;
+
+        iterator begin() { return make_iterator(mData.begin()); }
+        iterator end()   { return make_iterator(mData.end()); }
+
+    private:
+        iterator make_iterator(typename VectorType::iterator iter)
+        {
+            return iterator(dead_skipper,
+                            strong_iterator(iter, strengthen),
+                            strong_iterator(mData.end(), strengthen));
+        }
+
+        VectorType mData;
+    };
+    using snapshot = snapshot_of<T>;
+
+    // iterate over this for references to each SUBCLASS instance
+    template <typename SUBCLASS>
+    class instance_snapshot_of: public snapshot_of<SUBCLASS>
+    {
+    private:
+        using super = snapshot_of<SUBCLASS>;
+        static T& instance_getter(typename super::iterator::reference pair)
+        {
+            return *pair.second;
+        }
+    public:
+        typedef boost::transform_iterator<decltype(instance_getter)*,
+                                          typename super::iterator> iterator;
+        iterator begin() { return iterator(super::begin(), instance_getter); }
+        iterator end()   { return iterator(super::end(),   instance_getter); }
+
+        void deleteAll()
+        {
+            for (auto it(super::begin()), end(super::end()); it != end; ++it)
+            {
+                delete it->second.get();
+            }
+        }
+    };
+    using instance_snapshot = instance_snapshot_of<T>;
+
+    // iterate over this for each key
+    template <typename SUBCLASS>
+    class key_snapshot_of: public snapshot_of<SUBCLASS>
+    {
+    private:
+        using super = snapshot_of<SUBCLASS>;
+        static KEY key_getter(typename super::iterator::reference pair)
+        {
+            return pair.first;
+        }
+    public:
+        typedef boost::transform_iterator<decltype(key_getter)*,
+                                          typename super::iterator> iterator;
+        iterator begin() { return iterator(super::begin(), key_getter); }
+        iterator end()   { return iterator(super::end(),   key_getter); }
+    };
+    using key_snapshot = key_snapshot_of<T>;
+
+    static ptr_t getInstance(const KEY& k)
+    {
+        Shard& shard = shardFor(k);
+        lock_t lock(shard.mMutex); LL_PROFILE_MUTEX_LOCK(shard.mMutex);
+        typename InstanceMap::const_iterator found = shard.mContainer.find(k);
+        return (found == shard.mContainer.end()) ? NULL : found->second;
+    }
+
+protected:
+    LLInstanceTracker(const KEY& key)
+    {
+        // no-op deleter, as in the unsharded LLInstanceTracker
+        ptr_t ptr(static_cast<T*>(this), [](T*){});
+        mSelf = ptr;
+        Shard& shard = shardFor(key);
+        lock_t lock(shard.mMutex); LL_PROFILE_MUTEX_LOCK(shard.mMutex);
+        add_(shard, key, ptr);
+    }
+public:
+    virtual ~LLInstanceTracker()
+    {
+        Shard& shard = shardFor(mInstanceKey);
+        lock_t lock(shard.mMutex); LL_PROFILE_MUTEX_LOCK(shard.mMutex);
+        remove_(shard);
+    }
+protected:
+    virtual void setKey(KEY key)
+    {
+        // Hold both shards, lower index first like LockAll, so no snapshot
+        // catches the instance missing between them.
+        Shard& from = shardFor(mInstanceKey);
+        Shard& to = shardFor(key);
+        lock_t first((&from < &to) ? from.mMutex : to.mMutex);
+        lock_t second;
+        if (&from != &to)
+        {
+            second = lock_t((&from < &to) ? to.mMutex : from.mMutex);
+        }
+        auto ptr = remove_(from);
+        add_(to, key, ptr);
+    }
+public:
+    virtual const KEY& getKey() const { return mInstanceKey; }
+
+private:
+    LLInstanceTracker( const LLInstanceTracker& ) = delete;
+    LLInstanceTracker& operator=( const LLInstanceTracker& ) = delete;
+
+    // for logging
+    template <typename K>
+    static std::string report(K key) { return stringize(key); }
+    static std::string report(const std::string& key) { return "'" + key + "'"; }
+    static std::string report(const char* key) { return report(std::string(key)); }
+
+    // caller must lock shard
+    void add_(Shard& shard, const KEY& key, const ptr_t& ptr)
+    {
+        mInstanceKey = key;
+        InstanceMap& map = shard.mContainer;
+        switch(KEY_COLLISION_BEHAVIOR)
+        {
+        case LLInstanceTrackerErrorOnCollision:
+        {
+            auto pair = map.emplace(key, ptr);
+            if (! pair.second)
+            {
+                LLInstanceTrackerPrivate::logerrs(typeid(*this).name(), " instance with key ",
+                                                  report(key), " already exists!");
+            }
+            break;
+        }
+        case LLInstanceTrackerReplaceOnCollision:
+            map[key] = ptr;
+            break;
+        default:
+            break;
+        }
+    }
+    ptr_t remove_(Shard& shard)
+    {
+        InstanceMap& map = shard.mContainer;
+        typename InstanceMap::iterator iter = map.find(mInstanceKey);
+        if (iter != map.end())
+        {
+            auto ret = iter->second;
+            map.erase(iter);
+            return ret;
+        }
+        return {};
+    }
+
+private:
+    weak_t mSelf;
+    KEY mInstanceKey;
+};
+
+/*****************************************************************************
+*   LLInstanceTracker without key, sharded
+*****************************************************************************/
+template<typename T, EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR>
+class LLInstanceTracker<T, void, KEY_COLLISION_BEHAVIOR, LLInstanceTrackerSharded>
+{
+    typedef std::set<std::shared_ptr<T>> InstanceSet;
+    typedef LLInstanceTrackerPrivate::ShardedData<InstanceSet> Shards;
+    typedef typename Shards::Shard Shard;
+    typedef typename Shards::lock_t lock_t;
+
+    static Shard& shardFor(const T* instance)
+    {
+        return Shards::get().mShards[Shards::shardOf(std::hash<const T*>()(instance))];
+    }
+
+public:
+    using ptr_t  = std::shared_ptr<T>;
+    using weak_t = std::weak_ptr<T>;
+
+    weak_t getWeak()
+    {
+        return mSelf;
+    }
+
+    static size_t instanceCount()
+    {
+        typename Shards::LockAll lock;
+        size_t count = 0;
+        for (Shard& shard : lock.shards())
+        {
+            count += shard.mContainer.size();
+        }
+        return count;
+    }
+
+    // snapshot of std::shared_ptr<SUBCLASS> pointers
+    template <typename SUBCLASS>
+    class snapshot_of
+    {
+        typedef std::vector<weak_t> VectorType;
+        typedef std::shared_ptr<SUBCLASS> strong_ptr;
+        static strong_ptr strengthen(typename VectorType::value_type& ptr)
+        {
+            return std::dynamic_pointer_cast<SUBCLASS>(ptr.lock());
+        }
+        static bool dead_skipper(const strong_ptr& ptr)
+        {
+            return bool(ptr);
+        }
+
+    public:
+        snapshot_of()
+        {
+            typename Shards::LockAll lock;
+            for (Shard& shard : lock.shards())
+            {
+                mData.insert(mData.end(), shard.mContainer.begin(), shard.mContainer.end());
+            }
+        }
+
+        typedef boost::transform_iterator<decltype(strengthen)*,
+                                          typename VectorType::iterator> strong_iterator;
+        typedef boost::filter_iterator<decltype(dead_skipper)*, strong_iterator> iterator;
+
+        iterator begin() { return make_iterator(mData.begin()); }
+        iterator end()   { return make_iterator(mData.end()); }
+
+    private:
+        iterator make_iterator(typename VectorType::iterator iter)
+        {
+            return iterator(dead_skipper,
+                            strong_iterator(iter, strengthen),
+                            strong_iterator(mData.end(), strengthen));
+        }
+
+        VectorType mData;
+    };
+    using snapshot = snapshot_of<T>;
+
+    // iterate over this for references to each instance
+    template <typename SUBCLASS>
+    class instance_snapshot_of: public snapshot_of<SUBCLASS>
+    {
+    private:
+        using super = snapshot_of<SUBCLASS>;
+
+    public:
+        typedef boost::indirect_iterator<typename super::iterator> iterator;
+        iterator begin() { return iterator(super::begin()); }
+        iterator end()   { return iterator(super::end()); }
+
+        void deleteAll()
+        {
+            for (auto it(super::begin()), end(super::end()); it != end; ++it)
+            {
+                delete it->get();
+            }
+        }
+    };
+    using instance_snapshot = instance_snapshot_of<T>;
+    template <typename SUBCLASS>
+    using key_snapshot_of = instance_snapshot_of<SUBCLASS>;
+
+protected:
+    LLInstanceTracker()
+    {
+        std::shared_ptr<T> ptr(static_cast<T*>(this), [](T*){});
+        mSelf = ptr;
+        Shard& shard = shardFor(ptr.get());
+        lock_t lock(shard.mMutex); LL_PROFILE_MUTEX_LOCK(shard.mMutex);
+        shard.mContainer.emplace(ptr);
+    }
+public:
+    virtual ~LLInstanceTracker()
+    {
+        // the pointer we hashed in the constructor, whatever T has become
+        std::shared_ptr<T> ptr(mSelf.lock());
+        Shard& shard = shardFor(ptr.get());
+        lock_t lock(shard.mMutex); LL_PROFILE_MUTEX_LOCK(shard.mMutex);
+        shard.mContainer.erase(ptr);
+    }
+protected:
+    LLInstanceTracker(const LLInstanceTracker& other):
+        LLInstanceTracker()
+    {}
+
+private:
+    weak_t mSelf;
+};
+// </3T:TommyTheTerrible>
+
 #endif
@@ -34,6 +34,7 @@
 #include "llerror.h"
 #include "../llmath/llmath.h"
 #include "llformat.h"
+#include "llsdarena.h" // <3T:TommyTheTerrible/>
 #include "llsdserialize.h"
 #include "stringize.h"
 
@@ -103,6 +104,11 @@ protected:
     U32 mUseCount;
 
 public:
+    // <3T:TommyTheTerrible> Values built inside an LLSDArena share its chunks
+    static void* operator new(size_t size)      { return LLSDArena::allocate(size); }
+    static void operator delete(void* ptr)      { LLSDArena::deallocate(ptr); }
+    // </3T:TommyTheTerrible>
+
     static void reset(Impl*& var, Impl* impl);
         ///< safely set var to refer to the new impl (possibly shared)
 
@@ -746,6 +752,14 @@ namespace
     }
 }
 
+// <3T:TommyTheTerrible> LLSDArena only guarantees this much alignment
+static_assert(alignof(ImplMap) <= LLSDArena::ALIGNMENT && alignof(ImplArray) <= LLSDArena::ALIGNMENT
+              && alignof(ImplString) <= LLSDArena::ALIGNMENT && alignof(ImplReal) <= LLSDArena::ALIGNMENT
+              && alignof(ImplUUID) <= LLSDArena::ALIGNMENT && alignof(ImplDate) <= LLSDArena::ALIGNMENT
+              && alignof(ImplURI) <= LLSDArena::ALIGNMENT && alignof(ImplBinary) <= LLSDArena::ALIGNMENT,
+              "LLSD::Impl subclass needs more alignment than LLSDArena provides");
+// </3T:TommyTheTerrible>
+
 LLSD::Impl::Impl()
     : mUseCount(0)
 {
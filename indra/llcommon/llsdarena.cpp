@@ -0,0 +1,153 @@
+/**
+ * @file   llsdarena.cpp
+ * @brief  Bump allocation of LLSD values built by a parse.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llsdarena.h"
+
+#include <atomic>
+#include <new>
+
+namespace
+{
+    // Every block starts with the chunk it came from, or null for a heap
+    // block, so deallocate() needs no lookup.
+    constexpr size_t HEADER_SIZE = LLSDArena::ALIGNMENT;
+    static_assert(sizeof(void*) <= HEADER_SIZE, "block header too small");
+
+    // Big enough for a few hundred values, small enough that a value kept
+    // past its tree does not pin much.
+    constexpr size_t CHUNK_BYTES = 32 * 1024;
+
+    thread_local LLSDArena* sCurrentArena = nullptr;
+    std::atomic<bool> sParseArenaEnabled{ false };
+    std::atomic<S32> sLiveChunks{ 0 };
+
+    inline size_t block_size(size_t size)
+    {
+        return HEADER_SIZE + ((size + LLSDArena::ALIGNMENT - 1) & ~(LLSDArena::ALIGNMENT - 1));
+    }
+}
+
+struct LLSDArena::Chunk
+{
+    // One reference for the arena still filling the chunk, one per value.
+    std::atomic<U32>    mRefs{ 1 };
+    size_t              mUsed{ 0 };
+    alignas(ALIGNMENT) char mData[CHUNK_BYTES];
+};
+
+LLSDArena::LLSDArena()
+:   mChunk(nullptr),
+    mPrevious(sCurrentArena)
+{
+    sCurrentArena = this;
+}
+
+LLSDArena::~LLSDArena()
+{
+    llassert(sCurrentArena == this);
+    sCurrentArena = mPrevious;
+    if (mChunk)
+    {
+        release(mChunk);
+    }
+}
+
+//static
+void* LLSDArena::allocate(size_t size)
+{
+    const size_t needed = block_size(size);
+    LLSDArena* arena = sCurrentArena;
+    if (arena && needed <= CHUNK_BYTES)
+    {
+        Chunk* chunk = arena->mChunk;
+        if (!chunk || chunk->mUsed + needed > CHUNK_BYTES)
+        {
+            if (chunk)
+            {
+                release(chunk);
+            }
+            chunk = arena->mChunk = new Chunk;
+            ++sLiveChunks;
+        }
+        char* block = chunk->mData + chunk->mUsed;
+        chunk->mUsed += needed;
+        chunk->mRefs.fetch_add(1, std::memory_order_relaxed);
+        *reinterpret_cast<Chunk**>(block) = chunk;
+        return block + HEADER_SIZE;
+    }
+
+    char* block = static_cast<char*>(::operator new(needed));
+    *reinterpret_cast<Chunk**>(block) = nullptr;
+    return block + HEADER_SIZE;
+}
+
+//static
+void LLSDArena::deallocate(void* ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+    char* block = static_cast<char*>(ptr) - HEADER_SIZE;
+    if (Chunk* chunk = *reinterpret_cast<Chunk**>(block))
+    {
+        release(chunk);
+    }
+    else
+    {
+        ::operator delete(block);
+    }
+}
+
+//static
+void LLSDArena::release(Chunk* chunk)
+{
+    if (chunk->mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete chunk;
+        --sLiveChunks;
+    }
+}
+
+//static
+void LLSDArena::setParseArenaEnabled(bool enabled)
+{
+    sParseArenaEnabled = enabled;
+}
+
+//static
+bool LLSDArena::isParseArenaEnabled()
+{
+    return sParseArenaEnabled.load(std::memory_order_relaxed);
+}
+
+//static
+S32 LLSDArena::getLiveChunkCount()
+{
+    return sLiveChunks;
+}
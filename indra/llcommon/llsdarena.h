@@ -0,0 +1,86 @@
+/**
+ * @file   llsdarena.h
+ * @brief  Bump allocation of LLSD values built by a parse.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLSDARENA_H
+#define LL_LLSDARENA_H
+
+#include "stdtypes.h"
+
+#include <cstddef>
+
+/**
+ * While an LLSDArena is alive on a thread, every LLSD value created on that
+ * thread takes its storage from large chunks by bumping a pointer, instead
+ * of one heap allocation per value. Short strings live inline in their
+ * value (std::string's small buffer), so for most of a parsed tree that is
+ * the only storage it needs.
+ *
+ * Values never belong to the arena: they can be copied, modified, handed
+ * to other threads and outlive it like any other LLSD. Each chunk counts
+ * the values still living in it and is freed when the last one goes, so
+ * destroying a parsed tree returns its memory a chunk at a time. The price
+ * is that a small value kept from a large tree keeps its whole chunk
+ * alive; hold on to copies (asString() and friends), not to subtrees,
+ * when most of a response is thrown away.
+ *
+ * Map nodes, array storage and long strings still come from the heap, as
+ * the LLSD iterator types are part of its interface.
+ *
+ * LLSDParser::parse() opens an arena by itself when setParseArenaEnabled()
+ * is on. Arenas nest; the innermost one is used.
+ */
+class LL_COMMON_API LLSDArena
+{
+public:
+    static constexpr size_t ALIGNMENT = 8;
+
+    LLSDArena();
+    ~LLSDArena();
+
+    LLSDArena(const LLSDArena&) = delete;
+    LLSDArena& operator=(const LLSDArena&) = delete;
+
+    // Storage for one LLSD value, from the calling thread's arena if there
+    // is one, the heap otherwise. Blocks are ALIGNMENT aligned.
+    static void* allocate(size_t size);
+    // Any thread, any block from allocate().
+    static void deallocate(void* ptr);
+
+    static void setParseArenaEnabled(bool enabled);
+    static bool isParseArenaEnabled();
+
+    // Chunks currently holding live values, for stats and tests.
+    static S32 getLiveChunkCount();
+
+private:
+    struct Chunk;
+    static void release(Chunk* chunk);
+
+    Chunk*      mChunk;
+    LLSDArena*  mPrevious;
+};
+
+#endif // LL_LLSDARENA_H
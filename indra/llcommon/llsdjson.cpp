@@ -34,6 +34,19 @@
 #include "llsdutil.h"
 #include "llerror.h"
 #include "../llmath/llmath.h"
+// <3T:TommyTheTerrible> Conversion without a boost::json::value in between
+#include "llbytescan.h"
+#include "llsdarena.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <ostream>
+// </3T:TommyTheTerrible>
 
 #include <boost/json/src.hpp>
 
@@ -141,3 +154,399 @@ boost::json::value LlsdToJson(const LLSD &val)
 
     return result;
 }
+
+// <3T:TommyTheTerrible> Conversion without a boost::json::value in between
+namespace
+{
+    // Handler for boost::json::basic_parser: builds the LLSD that
+    // LlsdFromJson() would build from the value boost::json::parse() returns,
+    // as the parser reports each token.
+    class LLSDJsonBuilder
+    {
+    public:
+        constexpr static std::size_t max_object_size = std::size_t(-1);
+        constexpr static std::size_t max_array_size = std::size_t(-1);
+        constexpr static std::size_t max_key_size = std::size_t(-1);
+        constexpr static std::size_t max_string_size = std::size_t(-1);
+
+        LLSD& result() { return mResult; }
+
+        bool on_document_begin(boost::system::error_code&) { return true; }
+        bool on_document_end(boost::system::error_code&) { return true; }
+
+        bool on_object_begin(boost::system::error_code&)
+        {
+            open(LLSD::emptyMap());
+            return true;
+        }
+        bool on_object_end(std::size_t, boost::system::error_code&)
+        {
+            mOpen.pop_back();
+            return true;
+        }
+        bool on_array_begin(boost::system::error_code&)
+        {
+            open(LLSD::emptyArray());
+            return true;
+        }
+        bool on_array_end(std::size_t, boost::system::error_code&)
+        {
+            mOpen.pop_back();
+            return true;
+        }
+
+        bool on_key_part(boost::json::string_view part, std::size_t, boost::system::error_code&)
+        {
+            mKey.append(part.data(), part.size());
+            return true;
+        }
+        bool on_key(boost::json::string_view part, std::size_t, boost::system::error_code&)
+        {
+            mKey.append(part.data(), part.size());
+            return true;
+        }
+        bool on_string_part(boost::json::string_view part, std::size_t, boost::system::error_code&)
+        {
+            mString.append(part.data(), part.size());
+            return true;
+        }
+        bool on_string(boost::json::string_view part, std::size_t, boost::system::error_code&)
+        {
+            mString.append(part.data(), part.size());
+            slot() = mString;
+            mString.clear();
+            return true;
+        }
+
+        bool on_number_part(boost::json::string_view, boost::system::error_code&) { return true; }
+        bool on_int64(int64_t value, boost::json::string_view, boost::system::error_code&)
+        {
+            slot() = LLSD(value);
+            return true;
+        }
+        bool on_uint64(uint64_t value, boost::json::string_view, boost::system::error_code& ec)
+        {
+            // value::to_number<int64_t>() throws for these.
+            if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+            {
+                ec = boost::json::error::not_exact;
+                return false;
+            }
+            slot() = LLSD(static_cast<int64_t>(value));
+            return true;
+        }
+        bool on_double(double value, boost::json::string_view, boost::system::error_code&)
+        {
+            slot() = LLSD(value);
+            return true;
+        }
+        bool on_bool(bool value, boost::system::error_code&)
+        {
+            slot() = LLSD(value);
+            return true;
+        }
+        bool on_null(boost::system::error_code&)
+        {
+            slot() = LLSD();
+            return true;
+        }
+
+        bool on_comment_part(boost::json::string_view, boost::system::error_code&) { return true; }
+        bool on_comment(boost::json::string_view, boost::system::error_code&) { return true; }
+
+    private:
+        // Where the next value goes. Only the innermost open container grows,
+        // so the pointers to the ones around it stay valid.
+        LLSD& slot()
+        {
+            if (mOpen.empty())
+            {
+                return mResult;
+            }
+            LLSD& container = *mOpen.back();
+            if (container.isMap())
+            {
+                // Assigning over a duplicate key keeps the last, as
+                // boost::json::object does.
+                LLSD& value = container[mKey];
+                mKey.clear();
+                return value;
+            }
+            return container.append(LLSD());
+        }
+
+        void open(const LLSD& container)
+        {
+            LLSD& value = slot();
+            value = container;
+            mOpen.push_back(&value);
+        }
+
+        LLSD                mResult;
+        std::vector<LLSD*>  mOpen;
+        std::string         mKey;
+        std::string         mString;
+    };
+
+    typedef boost::json::basic_parser<LLSDJsonBuilder> llsd_json_parser_t;
+
+    // Writes an LLSD as JSON, converting types as LlsdToJson() does, into a
+    // string, handing full blocks on to the stream when there is one.
+    class LLSDJsonWriter
+    {
+    public:
+        explicit LLSDJsonWriter(std::string& text, std::ostream* out = nullptr)
+        :   mText(text),
+            mOut(out)
+        {
+        }
+
+        void write(const LLSD& val)
+        {
+            switch (val.type())
+            {
+            case LLSD::TypeUndefined:
+                mText += "null";
+                break;
+            case LLSD::TypeBoolean:
+                mText += val.asBoolean() ? "true" : "false";
+                break;
+            case LLSD::TypeInteger:
+                writeInteger(val.asInteger());
+                break;
+            case LLSD::TypeReal:
+                writeReal(val.asReal());
+                break;
+            case LLSD::TypeString:
+                writeString(val.asStringRef());
+                break;
+            case LLSD::TypeURI:
+            case LLSD::TypeDate:
+            case LLSD::TypeUUID:
+                writeString(val.asString());
+                break;
+            case LLSD::TypeMap:
+            {
+                mText += '{';
+                bool first = true;
+                for (const auto& llsd_dat : llsd::inMap(val))
+                {
+                    if (!first)
+                    {
+                        mText += ',';
+                    }
+                    first = false;
+                    writeString(llsd_dat.first);
+                    mText += ':';
+                    write(llsd_dat.second);
+                }
+                mText += '}';
+                break;
+            }
+            case LLSD::TypeArray:
+            {
+                mText += '[';
+                bool first = true;
+                for (const auto& llsd_dat : llsd::inArray(val))
+                {
+                    if (!first)
+                    {
+                        mText += ',';
+                    }
+                    first = false;
+                    write(llsd_dat);
+                }
+                mText += ']';
+                break;
+            }
+            case LLSD::TypeBinary:
+            default:
+                LL_ERRS("LlsdToJson") << "Unsupported conversion to JSON from LLSD type ("
+                                      << val.type() << ")." << LL_ENDL;
+                break;
+            }
+            flushIfFull();
+        }
+
+        void flush()
+        {
+            if (mOut && !mText.empty())
+            {
+                mOut->write(mText.data(), mText.size());
+                mText.clear();
+            }
+        }
+
+    private:
+        static constexpr size_t FLUSH_SIZE = 64 * 1024;
+
+        void flushIfFull()
+        {
+            if (mOut && mText.size() >= FLUSH_SIZE)
+            {
+                flush();
+            }
+        }
+
+        void writeInteger(LLSD::Integer value)
+        {
+            char buffer[16];
+            auto converted = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            mText.append(buffer, converted.ptr);
+        }
+
+        // Spelled differently from boost::json::serialize(), which writes
+        // 1.5 as 1.5E0, but any JSON parser reads back the same double.
+        void writeReal(LLSD::Real value)
+        {
+            if (std::isnan(value))
+            {
+                mText += "null";
+                return;
+            }
+            if (std::isinf(value))
+            {
+                // What boost::json::serialize() writes; it parses as infinity.
+                mText += value < 0 ? "-1e99999" : "1e99999";
+                return;
+            }
+            char buffer[32];
+#if defined(__cpp_lib_to_chars)
+            char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+#else
+            char* end = buffer + std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+#endif
+            mText.append(buffer, end);
+            // Without a fraction or an exponent it would read back as an
+            // integer.
+            if (std::find_if(buffer, end, [](char c) { return c == '.' || c == 'e' || c == 'E'; }) == end)
+            {
+                mText += ".0";
+            }
+        }
+
+        // Escapes what boost::json::serialize() escapes: quote, backslash and
+        // control characters. UTF-8 is written as it is.
+        void writeString(const std::string& value)
+        {
+            static const char HEX[] = "0123456789abcdef";
+            mText += '"';
+            const char* pos = value.data();
+            const char* end = pos + value.size();
+            while (pos < end)
+            {
+                const char* special = ll_find_first_of_or_control(pos, end, '"', '\\');
+                mText.append(pos, special);
+                if (special == end)
+                {
+                    break;
+                }
+                switch (*special)
+                {
+                case '"':  mText += "\\\""; break;
+                case '\\': mText += "\\\\"; break;
+                case '\b': mText += "\\b"; break;
+                case '\f': mText += "\\f"; break;
+                case '\n': mText += "\\n"; break;
+                case '\r': mText += "\\r"; break;
+                case '\t': mText += "\\t"; break;
+                default:
+                {
+                    const unsigned char byte = static_cast<unsigned char>(*special);
+                    const char escape[] = { '\\', 'u', '0', '0', HEX[byte >> 4], HEX[byte & 0xf] };
+                    mText.append(escape, sizeof(escape));
+                    break;
+                }
+                }
+                pos = special + 1;
+            }
+            mText += '"';
+        }
+
+        std::string&    mText;
+        std::ostream*   mOut;
+    };
+}
+
+//=========================================================================
+LLSD LlsdFromJsonString(std::string_view json, boost::system::error_code& ec)
+{
+    std::optional<LLSDArena> arena;
+    if (LLSDArena::isParseArenaEnabled())
+    {
+        arena.emplace();
+    }
+
+    // The same checks boost::json::parser::write() makes.
+    llsd_json_parser_t parser{ boost::json::parse_options() };
+    const size_t used = parser.write_some(false, json.data(), json.size(), ec);
+    if (!ec && used < json.size())
+    {
+        ec = boost::json::error::extra_data;
+    }
+    if (ec)
+    {
+        return LLSD();
+    }
+    return std::move(parser.handler().result());
+}
+
+//=========================================================================
+LLSD LlsdFromJsonStream(std::istream& in, boost::system::error_code& ec)
+{
+    std::optional<LLSDArena> arena;
+    if (LLSDArena::isParseArenaEnabled())
+    {
+        arena.emplace();
+    }
+
+    // Follows boost::json::parse(std::istream&), with the handler in place
+    // of its stream_parser.
+    llsd_json_parser_t parser{ boost::json::parse_options() };
+    char buffer[BOOST_JSON_STACK_BUFFER_SIZE / 2];
+    do
+    {
+        if (in.eof())
+        {
+            parser.write_some(false, nullptr, 0, ec);
+            break;
+        }
+        if (!in)
+        {
+            ec = boost::json::error::input_error;
+            break;
+        }
+        in.read(buffer, sizeof(buffer));
+        const size_t got = static_cast<size_t>(in.gcount());
+        const size_t used = parser.write_some(true, buffer, got, ec);
+        if (!ec && used < got)
+        {
+            ec = boost::json::error::extra_data;
+        }
+    } while (!ec);
+
+    if (ec)
+    {
+        return LLSD();
+    }
+    return std::move(parser.handler().result());
+}
+
+//=========================================================================
+std::string LlsdToJsonString(const LLSD& val)
+{
+    std::string text;
+    LLSDJsonWriter writer(text);
+    writer.write(val);
+    return text;
+}
+
+//=========================================================================
+void LlsdToJsonStream(const LLSD& val, std::ostream& out)
+{
+    std::string text;
+    LLSDJsonWriter writer(text, &out);
+    writer.write(val);
+    writer.flush();
+}
+// </3T:TommyTheTerrible>
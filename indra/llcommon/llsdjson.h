@@ -27,8 +27,10 @@
 #ifndef LL_LLSDJSON_H
 #define LL_LLSDJSON_H
 
+#include <iosfwd> // <3T:TommyTheTerrible/>
 #include <map>
 #include <string>
+#include <string_view> // <3T:TommyTheTerrible/>
 #include <vector>
 
 #include "stdtypes.h"
@@ -74,4 +76,24 @@ LLSD LlsdFromJson(const boost::json::value &val);
 /// TypeBinary    | unsupported
 boost::json::value LlsdToJson(const LLSD &val);
 
+// <3T:TommyTheTerrible> Conversion without a boost::json::value in between
+/// Parse JSON text straight into LLSD, converting types as LlsdFromJson()
+/// does, from the events of boost::json's SAX parser. Nothing but the
+/// result is built, so a large document costs its LLSD and no more. On a
+/// syntax error ec is set and an undefined LLSD is returned.
+LLSD LlsdFromJsonString(std::string_view json, boost::system::error_code &ec);
+
+/// As LlsdFromJsonString(), reading the text from a stream a block at a
+/// time, as boost::json::parse(std::istream&) does.
+LLSD LlsdFromJsonStream(std::istream &in, boost::system::error_code &ec);
+
+/// Write an LLSD as JSON text, converting types as LlsdToJson() does. The
+/// text can differ from boost::json::serialize(LlsdToJson(val)) in how
+/// reals are spelled, but parses to the same value.
+std::string LlsdToJsonString(const LLSD &val);
+
+/// As LlsdToJsonString(), writing to a stream in blocks.
+void LlsdToJsonStream(const LLSD &val, std::ostream &out);
+// </3T:TommyTheTerrible>
+
 #endif // LL_LLSDJSON_H
@@ -29,9 +29,15 @@
 #include "linden_common.h"
 #include "llsdserialize.h"
 #include "llpointer.h"
+#include "llcompressionservice.h" // <3T:TommyTheTerrible/>
+#include "llsdarena.h" // <3T:TommyTheTerrible/>
+#include "llbytescan.h" // <3T:TommyTheTerrible/>
 #include "llstreamtools.h" // for fullread
 
+#include <atomic> // <3T:TommyTheTerrible/>
+#include <charconv> // <3T:TommyTheTerrible/>
 #include <iostream>
+#include <optional> // <3T:TommyTheTerrible/>
 #include "apr_base64.h"
 
 #include <boost/iostreams/device/array.hpp>
@@ -392,6 +398,13 @@ S32 LLSDParser::parse(std::istream& istr, LLSD& data, llssize max_bytes, S32 max
 {
     mCheckLimits = LLSDSerialize::SIZE_UNLIMITED != max_bytes;
     mMaxBytesLeft = max_bytes;
+    // <3T:TommyTheTerrible> Build the tree in an arena
+    std::optional<LLSDArena> arena;
+    if (LLSDArena::isParseArenaEnabled())
+    {
+        arena.emplace();
+    }
+    // </3T:TommyTheTerrible>
     return doParse(istr, data, max_depth);
 }
 
@@ -401,9 +414,57 @@ S32 LLSDParser::parseLines(std::istream& istr, LLSD& data)
 {
     mCheckLimits = false;
     mParseLines = true;
+    // <3T:TommyTheTerrible> Build the tree in an arena
+    std::optional<LLSDArena> arena;
+    if (LLSDArena::isParseArenaEnabled())
+    {
+        arena.emplace();
+    }
+    // </3T:TommyTheTerrible>
     return doParse(istr, data);
 }
 
+// <3T:TommyTheTerrible> Parse straight out of memory
+static std::atomic<bool> sBufferParseEnabled{ true };
+
+//static
+void LLSDParser::setBufferParseEnabled(bool enabled)
+{
+    sBufferParseEnabled = enabled;
+}
+
+//static
+bool LLSDParser::isBufferParseEnabled()
+{
+    return sBufferParseEnabled.load(std::memory_order_relaxed);
+}
+
+S32 LLSDParser::parseBuffer(const char* buffer, size_t size, LLSD& data, S32 max_depth)
+{
+    if (isBufferParseEnabled())
+    {
+        S32 parse_count = PARSE_FAILURE;
+        {
+            std::optional<LLSDArena> arena;
+            if (LLSDArena::isParseArenaEnabled())
+            {
+                arena.emplace();
+            }
+            parse_count = doParseBuffer(buffer, size, data, max_depth);
+        }
+        if (parse_count != PARSE_FAILURE)
+        {
+            return parse_count;
+        }
+        // Let the stream parser decide, and log, whatever the buffer parser
+        // would not take on.
+        reset();
+    }
+    LLMemoryStream stream(reinterpret_cast<const U8*>(buffer), static_cast<S32>(size));
+    return parse(stream, data, static_cast<llssize>(size), max_depth);
+}
+// </3T:TommyTheTerrible>
+
 
 int LLSDParser::get(std::istream& istr) const
 {
@@ -936,6 +997,601 @@ bool LLSDNotationParser::parseBinary(std::istream& istr, LLSD& data) const
 }
 
 
+// <3T:TommyTheTerrible> Notation straight out of memory
+namespace
+{
+    inline bool is_notation_space(int c)
+    {
+        // isspace() in the "C" locale
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    inline bool is_notation_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    inline bool is_notation_alpha(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    inline bool is_notation_quote(int c)
+    {
+        return c == '"' || c == '\'';
+    }
+
+    // The buffer twin of LLSDNotationParser::doParse() and friends, decision
+    // for decision, down to the quirks: a map skips stray bytes between its
+    // entries, a zero length raw string leaves the previous key in place,
+    // and so on. Where the stream parser's behaviour hangs on stream state
+    // (odd length b16 data, raw lengths past the end) this one just fails,
+    // and LLSDParser::parseBuffer() lets the stream parser have its say.
+    class LLSDNotationBufferParser
+    {
+    public:
+        LLSDNotationBufferParser(const char* begin, const char* end)
+        :   mPos(begin),
+            mEnd(end)
+        {
+        }
+
+        S32 parseValue(LLSD& data, S32 max_depth);
+
+    private:
+        // istream::get(): the next byte, or EOF once the buffer is used up.
+        int get()
+        {
+            return mPos < mEnd ? static_cast<unsigned char>(*mPos++) : EOF;
+        }
+        void putback()
+        {
+            --mPos;
+        }
+        // What istream::operator>>() skips first.
+        void skipSpace()
+        {
+            while (mPos < mEnd && is_notation_space(*mPos))
+            {
+                ++mPos;
+            }
+        }
+
+        S32 parseMap(LLSD& map, S32 max_depth);
+        S32 parseArray(LLSD& array, S32 max_depth);
+        bool parseString(std::string& value);
+        bool parseDelimitedString(char delim, std::string& value);
+        bool parseRawString(std::string& value);
+        bool parseBoolean(LLSD& data, const std::string& compare, bool value);
+        bool parseInteger(LLSD& data);
+        bool parseReal(LLSD& data);
+        bool parseUUID(LLSD& data);
+        bool parseBinary(LLSD& data);
+
+        const char* mPos;
+        const char* mEnd;
+    };
+
+    S32 LLSDNotationBufferParser::parseValue(LLSD& data, S32 max_depth)
+    {
+        if (max_depth == 0)
+        {
+            return LLSDParser::PARSE_FAILURE;
+        }
+        skipSpace();
+        if (mPos >= mEnd)
+        {
+            return 0;
+        }
+
+        bool ok = true;
+        S32 parse_count = 1;
+        switch (*mPos)
+        {
+        case '{':
+        {
+            S32 child_count = parseMap(data, max_depth - 1);
+            ok = child_count != LLSDParser::PARSE_FAILURE && !data.isUndefined();
+            parse_count += child_count;
+            break;
+        }
+
+        case '[':
+        {
+            S32 child_count = parseArray(data, max_depth - 1);
+            ok = child_count != LLSDParser::PARSE_FAILURE && !data.isUndefined();
+            parse_count += child_count;
+            break;
+        }
+
+        case '!':
+            ++mPos;
+            data.clear();
+            break;
+
+        case '0':
+            ++mPos;
+            data = false;
+            break;
+
+        case '1':
+            ++mPos;
+            data = true;
+            break;
+
+        case 'F':
+        case 'f':
+            ++mPos;
+            if (mPos < mEnd && is_notation_alpha(*mPos))
+            {
+                ok = parseBoolean(data, NOTATION_FALSE_SERIAL, false);
+            }
+            else
+            {
+                data = false;
+            }
+            break;
+
+        case 'T':
+        case 't':
+            ++mPos;
+            if (mPos < mEnd && is_notation_alpha(*mPos))
+            {
+                ok = parseBoolean(data, NOTATION_TRUE_SERIAL, true);
+            }
+            else
+            {
+                data = true;
+            }
+            break;
+
+        case 'i':
+            ++mPos;
+            ok = parseInteger(data);
+            break;
+
+        case 'r':
+            ++mPos;
+            ok = parseReal(data);
+            break;
+
+        case 'u':
+            ++mPos;
+            ok = parseUUID(data);
+            break;
+
+        case '\"':
+        case '\'':
+        case 's':
+        {
+            std::string value;
+            ok = parseString(value);
+            if (ok)
+            {
+                data = std::move(value);
+            }
+            break;
+        }
+
+        case 'l':
+        case 'd':
+        {
+            const char type = *mPos++;
+            std::string value;
+            ok = mPos < mEnd && parseDelimitedString(*mPos++, value);
+            if (ok)
+            {
+                if (type == 'l')
+                {
+                    data = LLURI(value);
+                }
+                else
+                {
+                    data = LLDate(value);
+                }
+            }
+            break;
+        }
+
+        case 'b':
+            ok = parseBinary(data);
+            break;
+
+        default:
+            ok = false;
+            break;
+        }
+
+        if (!ok)
+        {
+            data.clear();
+            return LLSDParser::PARSE_FAILURE;
+        }
+        return parse_count;
+    }
+
+    S32 LLSDNotationBufferParser::parseMap(LLSD& map, S32 max_depth)
+    {
+        map = LLSD::emptyMap();
+        S32 parse_count = 0;
+        ++mPos; // the '{'
+        bool found_name = false;
+        std::string name;
+        int c = get();
+        while (c != '}' && c != EOF)
+        {
+            if (!found_name)
+            {
+                if (c == '\"' || c == '\'' || c == 's')
+                {
+                    putback();
+                    found_name = true;
+                    if (!parseString(name))
+                    {
+                        return LLSDParser::PARSE_FAILURE;
+                    }
+                }
+                c = get();
+            }
+            else
+            {
+                if (is_notation_space(c) || c == ':')
+                {
+                    c = get();
+                    continue;
+                }
+                putback();
+                LLSD child;
+                S32 count = parseValue(child, max_depth);
+                if (count <= 0)
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+                parse_count += count;
+                map.insert(name, child);
+                found_name = false;
+                c = get();
+            }
+        }
+        if (c != '}')
+        {
+            map.clear();
+            return LLSDParser::PARSE_FAILURE;
+        }
+        return parse_count;
+    }
+
+    S32 LLSDNotationBufferParser::parseArray(LLSD& array, S32 max_depth)
+    {
+        array = LLSD::emptyArray();
+        S32 parse_count = 0;
+        ++mPos; // the '['
+        int c = get();
+        while (c != ']' && c != EOF)
+        {
+            if (is_notation_space(c) || c == ',')
+            {
+                c = get();
+                continue;
+            }
+            putback();
+            LLSD child;
+            S32 count = parseValue(child, max_depth);
+            if (count == LLSDParser::PARSE_FAILURE)
+            {
+                return LLSDParser::PARSE_FAILURE;
+            }
+            parse_count += count;
+            array.append(child);
+            c = get();
+        }
+        if (c != ']')
+        {
+            return LLSDParser::PARSE_FAILURE;
+        }
+        return parse_count;
+    }
+
+    // deserialize_string()
+    bool LLSDNotationBufferParser::parseString(std::string& value)
+    {
+        int c = get();
+        if (is_notation_quote(c))
+        {
+            return parseDelimitedString(static_cast<char>(c), value);
+        }
+        if (c == 's')
+        {
+            return parseRawString(value);
+        }
+        return false;
+    }
+
+    // deserialize_string_delim()
+    bool LLSDNotationBufferParser::parseDelimitedString(char delim, std::string& value)
+    {
+        value.clear();
+        while (true)
+        {
+            const char* run = ll_find_first_of(mPos, mEnd, '\\', delim);
+            value.append(mPos, run);
+            mPos = run;
+            if (mPos >= mEnd)
+            {
+                return false;
+            }
+            if (*mPos++ != '\\')
+            {
+                return true; // the delimiter
+            }
+
+            if (mPos >= mEnd)
+            {
+                return false;
+            }
+            const char escaped = *mPos++;
+            switch (escaped)
+            {
+            case 'x':
+                if (mEnd - mPos < 2)
+                {
+                    return false;
+                }
+                value += static_cast<char>((hex_as_nybble(mPos[0]) << 4) | hex_as_nybble(mPos[1]));
+                mPos += 2;
+                break;
+            case 'a': value += '\a'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case 't': value += '\t'; break;
+            case 'v': value += '\v'; break;
+            default: value += escaped; break;
+            }
+        }
+    }
+
+    // deserialize_string_raw(): s(len)"data"
+    bool LLSDNotationBufferParser::parseRawString(std::string& value)
+    {
+        // istream::get(buf, 19, ')') takes up to 18 bytes
+        const char* length_begin = mPos;
+        while (mPos < mEnd && mPos - length_begin < 18 && *mPos != ')')
+        {
+            ++mPos;
+        }
+        if (mPos == length_begin || mEnd - mPos < 2)
+        {
+            return false;
+        }
+        const std::string length(length_begin, mPos);
+        ++mPos; // the ')', or whatever ended the length
+        if (!is_notation_quote(*mPos++) || length[0] != '(')
+        {
+            return false;
+        }
+        auto len = strtol(length.c_str() + 1, NULL, 0);
+        if (len < 0 || len >= mEnd - mPos)
+        {
+            return false;
+        }
+        if (len)
+        {
+            value.assign(mPos, len);
+            mPos += len;
+        }
+        return is_notation_quote(get());
+    }
+
+    // deserialize_boolean(), with the first letter already read.
+    bool LLSDNotationBufferParser::parseBoolean(LLSD& data, const std::string& compare, bool value)
+    {
+        std::string::size_type ii = 0;
+        while (++ii < compare.size()
+               && mPos < mEnd
+               && LLStringOps::toLower(*mPos) == compare[ii])
+        {
+            ++mPos;
+        }
+        if (compare.size() != ii)
+        {
+            return false;
+        }
+        data = value;
+        return true;
+    }
+
+    // istream >> S32
+    bool LLSDNotationBufferParser::parseInteger(LLSD& data)
+    {
+        skipSpace();
+        bool negative = false;
+        if (mPos < mEnd && (*mPos == '+' || *mPos == '-'))
+        {
+            negative = *mPos++ == '-';
+        }
+        const char* digits = mPos;
+        while (mPos < mEnd && is_notation_digit(*mPos))
+        {
+            ++mPos;
+        }
+        U64 magnitude = 0;
+        auto [ptr, ec] = std::from_chars(digits, mPos, magnitude);
+        if (ec != std::errc() || magnitude > (negative ? 2147483648ULL : 2147483647ULL))
+        {
+            return false;
+        }
+        data = static_cast<LLSD::Integer>(negative ? -static_cast<S64>(magnitude) : static_cast<S64>(magnitude));
+        return true;
+    }
+
+    // istream >> F64: takes the longest run that looks like a number, then
+    // fails unless all of it converts.
+    bool LLSDNotationBufferParser::parseReal(LLSD& data)
+    {
+        skipSpace();
+        const char* begin = mPos;
+        if (mPos < mEnd && (*mPos == '+' || *mPos == '-'))
+        {
+            ++mPos;
+        }
+        bool found_mantissa = false;
+        bool found_decimal = false;
+        bool found_exponent = false;
+        while (mPos < mEnd)
+        {
+            const char c = *mPos;
+            if (is_notation_digit(c))
+            {
+                found_mantissa = true;
+            }
+            else if (c == '.' && !found_decimal && !found_exponent)
+            {
+                found_decimal = true;
+            }
+            else if ((c == 'e' || c == 'E') && !found_exponent && found_mantissa)
+            {
+                found_exponent = true;
+                if (mEnd - mPos > 1 && (mPos[1] == '+' || mPos[1] == '-'))
+                {
+                    ++mPos;
+                }
+            }
+            else
+            {
+                break;
+            }
+            ++mPos;
+        }
+
+        F64 real = 0.0;
+#if defined(__cpp_lib_to_chars)
+        const char* first = (begin < mPos && *begin == '+') ? begin + 1 : begin;
+        auto [ptr, ec] = std::from_chars(first, mPos, real);
+        if (ec == std::errc())
+        {
+            if (ptr != mPos)
+            {
+                return false;
+            }
+            data = real;
+            return true;
+        }
+        if (ec != std::errc::result_out_of_range)
+        {
+            return false;
+        }
+#endif
+        // Overflow and underflow are told apart the way the stream does.
+        std::istringstream number(std::string(begin, mPos));
+        number.imbue(std::locale::classic());
+        number >> real;
+        if (number.fail())
+        {
+            return false;
+        }
+        data = real;
+        return true;
+    }
+
+    // istream >> LLUUID: 36 characters, each after skipping white space.
+    bool LLSDNotationBufferParser::parseUUID(LLSD& data)
+    {
+        char uuid_str[UUID_STR_LENGTH];
+        for (S32 i = 0; i < UUID_STR_LENGTH - 1; ++i)
+        {
+            skipSpace();
+            if (mPos >= mEnd)
+            {
+                return false;
+            }
+            uuid_str[i] = *mPos++;
+        }
+        uuid_str[UUID_STR_LENGTH - 1] = '\0';
+        LLUUID id;
+        id.set(std::string(uuid_str));
+        data = id;
+        return true;
+    }
+
+    // LLSDNotationParser::parseBinary()
+    bool LLSDNotationBufferParser::parseBinary(LLSD& data)
+    {
+        // The header runs to the first '"' within 255 bytes.
+        const char* header_begin = mPos;
+        const char* quote = ll_find_first_of(mPos, mPos + std::min<ptrdiff_t>(mEnd - mPos, 255), '"', '"');
+        if (quote == mEnd || quote - header_begin == 255)
+        {
+            return false;
+        }
+        const std::string header(header_begin, quote);
+        mPos = quote + 1;
+
+        std::vector<U8> value;
+        if (0 == strncmp("b(", header.c_str(), 2))
+        {
+            // b(len)"raw data" and one more byte, whatever it is.
+            auto len = strtol(header.c_str() + 2, NULL, 0);
+            if (len < 0 || len >= mEnd - mPos)
+            {
+                return false;
+            }
+            value.assign(mPos, mPos + len);
+            mPos += len + 1;
+        }
+        else if (0 == strncmp("b64", header.c_str(), 3))
+        {
+            quote = ll_find_first_of(mPos, mEnd, '"', '"');
+            if (quote == mEnd || quote == mPos)
+            {
+                // istream::get() into a streambuf fails if it takes nothing.
+                return false;
+            }
+            const std::string encoded(mPos, quote);
+            mPos = quote + 1;
+            S32 len = apr_base64_decode_len(encoded.c_str());
+            if (len)
+            {
+                value.resize(len);
+                len = apr_base64_decode_binary(&value[0], encoded.c_str());
+                value.resize(len);
+            }
+        }
+        else if (0 == strncmp("b16", header.c_str(), 3))
+        {
+            quote = ll_find_first_of(mPos, mEnd, '"', '"');
+            const size_t hex_len = quote - mPos;
+            if (quote == mEnd || (hex_len & 1) || memchr(mPos, '\0', hex_len))
+            {
+                return false;
+            }
+            value.reserve(hex_len / 2);
+            for (; mPos < quote; mPos += 2)
+            {
+                value.push_back(static_cast<U8>((hex_as_nybble(mPos[0]) << 4) | hex_as_nybble(mPos[1])));
+            }
+            ++mPos;
+        }
+        else
+        {
+            return false;
+        }
+        data = std::move(value);
+        return true;
+    }
+}
+
+// virtual
+S32 LLSDNotationParser::doParseBuffer(const char* buffer, size_t size, LLSD& data, S32 max_depth) const
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_LLSD;
+    LLSDNotationBufferParser parser(buffer, buffer + size);
+    return parser.parseValue(data, max_depth);
+}
+// </3T:TommyTheTerrible>
+
+
 /**
  * LLSDBinaryParser
  */
@@ -2147,6 +2803,29 @@ std::ostream& operator<<(std::ostream& s, const LLSD& llsd)
 }
 
 
+// <3T:TommyTheTerrible>
+// Per-thread zip buffers are kept between calls, but not at the size of
+// the occasional huge block.
+static void trim_zip_buffer(LLCompressionService::buffer_t& buffer)
+{
+    constexpr size_t MAX_RETAINED_ZIP_BUFFER = 4 * 1024 * 1024;
+    if (buffer.capacity() > MAX_RETAINED_ZIP_BUFFER)
+    {
+        LLCompressionService::buffer_t().swap(buffer);
+    }
+}
+
+static LLUZipHelper::EZipRresult to_zip_result(LLCompressionService::EResult result)
+{
+    switch (result)
+    {
+    case LLCompressionService::OK:          return LLUZipHelper::ZR_OK;
+    case LLCompressionService::MEM_ERROR:   return LLUZipHelper::ZR_MEM_ERROR;
+    default:                                return LLUZipHelper::ZR_DATA_ERROR;
+    }
+}
+// </3T:TommyTheTerrible>
+
 //dirty little zippers -- yell at davep if these are horrid
 
 //return a string containing gzipped bytes of binary serialized LLSD
@@ -2157,84 +2836,20 @@ std::string zip_llsd(LLSD& data)
 
     LLSDSerialize::toBinary(data, llsd_strm);
 
-    const U32 CHUNK = 65536;
-
-    z_stream strm;
-    strm.zalloc = Z_NULL;
-    strm.zfree = Z_NULL;
-    strm.opaque = Z_NULL;
+    // <3T:TommyTheTerrible> Use the shared per-thread deflate stream and reusable output buffer.
+    std::string source = llsd_strm.str();
 
-    S32 ret = deflateInit(&strm, Z_BEST_COMPRESSION);
-    if (ret != Z_OK)
+    static thread_local LLCompressionService::buffer_t output;
+    if (LLCompressionService::deflate((const U8*)source.data(), source.size(), output, Z_BEST_COMPRESSION) != LLCompressionService::OK)
     {
         LL_WARNS() << "Failed to compress LLSD block." << LL_ENDL;
         return std::string();
     }
 
-    std::string source = llsd_strm.str();
-
-    U8 out[CHUNK];
-
-    strm.avail_in = narrow<size_t>(source.size());
-    strm.next_in = (U8*) source.data();
-    U8* output = NULL;
-
-    U32 cur_size = 0;
-
-    U32 have = 0;
-
-    do
-    {
-        strm.avail_out = CHUNK;
-        strm.next_out = out;
-
-        ret = deflate(&strm, Z_FINISH);
-        if (ret == Z_OK || ret == Z_STREAM_END)
-        { //copy result into output
-            if (strm.avail_out >= CHUNK)
-            {
-                deflateEnd(&strm);
-                if(output)
-                    free(output);
-                LL_WARNS() << "Failed to compress LLSD block." << LL_ENDL;
-                return std::string();
-            }
-
-            have = CHUNK-strm.avail_out;
-            U8* new_output = (U8*) realloc(output, cur_size+have);
-            if (new_output == NULL)
-            {
-                LL_WARNS() << "Failed to compress LLSD block: can't reallocate memory, current size: " << cur_size << " bytes; requested " << cur_size + have << " bytes." << LL_ENDL;
-                deflateEnd(&strm);
-                if (output)
-                {
-                    free(output);
-                }
-                return std::string();
-            }
-            output = new_output;
-            memcpy(output+cur_size, out, have);
-            cur_size += have;
-        }
-        else
-        {
-            deflateEnd(&strm);
-            if(output)
-                free(output);
-            LL_WARNS() << "Failed to compress LLSD block." << LL_ENDL;
-            return std::string();
-        }
-    }
-    while (ret == Z_OK);
-
-    std::string::size_type size = cur_size;
-
-    std::string result((char*) output, size);
-    deflateEnd(&strm);
-    if(output)
-        free(output);
-
+    std::string result((const char*)output.data(), output.size());
+    trim_zip_buffer(output);
     return result;
+    // </3T:TommyTheTerrible>
 }
 
 //decompress a block of LLSD from provided istream
@@ -2254,108 +2869,35 @@ LLUZipHelper::EZipRresult LLUZipHelper::unzip_llsd(LLSD& data, std::istream& is,
 
 LLUZipHelper::EZipRresult LLUZipHelper::unzip_llsd(LLSD& data, const U8* in, S32 size)
 {
-    U8* result = NULL;
-    llssize cur_size = 0;
-    z_stream strm;
-
-    constexpr U32 CHUNK = 1024 * 512;
-
-    static thread_local std::unique_ptr<U8[]> out;
-    if (!out)
+    // <3T:TommyTheTerrible> Inflate into a per-thread buffer that is reused
+    // from call to call, then parse straight out of it.
+    static thread_local LLCompressionService::buffer_t inflated;
+    EZipRresult ret = to_zip_result(LLCompressionService::inflate(in, size, inflated));
+    if (ret == ZR_OK)
     {
-        out = std::unique_ptr<U8[]>(new(std::nothrow) U8[CHUNK]);
+        ret = parse_llsd(data, inflated.data(), inflated.size());
     }
+    trim_zip_buffer(inflated);
+    return ret;
+    // </3T:TommyTheTerrible>
+}
 
-    strm.zalloc = Z_NULL;
-    strm.zfree = Z_NULL;
-    strm.opaque = Z_NULL;
-    strm.avail_in = size;
-    strm.next_in = const_cast<U8*>(in);
-
-    S32 ret = inflateInit(&strm);
-
-    do
-    {
-        strm.avail_out = CHUNK;
-        strm.next_out = out.get();
-        ret = inflate(&strm, Z_NO_FLUSH);
-        switch (ret)
-        {
-        case Z_NEED_DICT:
-        case Z_DATA_ERROR:
-        {
-            inflateEnd(&strm);
-            // free(result);
-            if( result )
-                free(result);
-            return ZR_DATA_ERROR;
-        }
-        case Z_STREAM_ERROR:
-        case Z_BUF_ERROR:
-        {
-            inflateEnd(&strm);
-            free(result);
-            return ZR_BUFFER_ERROR;
-        }
-
-        case Z_MEM_ERROR:
-        {
-            inflateEnd(&strm);
-            // free(result);
-            if( result )
-                free(result);
-            return ZR_MEM_ERROR;
-        }
-        }
-
-        U32 have = CHUNK-strm.avail_out;
-
-        U8* new_result = (U8*)realloc(result, cur_size + have);
-        if (new_result == NULL)
-        {
-            inflateEnd(&strm);
-            if (result)
-            {
-                free(result);
-            }
-            return ZR_MEM_ERROR;
-        }
-        result = new_result;
-        memcpy(result+cur_size, out.get(), have);
-        cur_size += have;
-
-    } while (ret == Z_OK && ret != Z_STREAM_END);
+// <3T:TommyTheTerrible> Parse stage of unzip_llsd(), input is an inflated binary LLSD block.
+LLUZipHelper::EZipRresult LLUZipHelper::parse_llsd(LLSD& data, U8* in, llssize size)
+{
+    //in now points to the decompressed LLSD block
+    char* result_ptr = strip_deprecated_header((char*)in, size);
 
-    inflateEnd(&strm);
+    boost::iostreams::stream<boost::iostreams::array_source> istrm(result_ptr, size);
 
-    if (ret != Z_STREAM_END)
+    if (!LLSDSerialize::fromBinary(data, istrm, size, UNZIP_LLSD_MAX_DEPTH))
     {
-        // free(result);
-        if( result )
-            free(result);
-        return ZR_DATA_ERROR;
+        return ZR_PARSE_ERROR;
     }
-
-    //result now points to the decompressed LLSD block
-    {
-        char* result_ptr = strip_deprecated_header((char*)result, cur_size);
-
-        boost::iostreams::stream<boost::iostreams::array_source> istrm(result_ptr, cur_size);
-
-        if (!LLSDSerialize::fromBinary(data, istrm, cur_size, UNZIP_LLSD_MAX_DEPTH))
-        {
-            // free(result);
-            if( result )
-                free(result);
-            return ZR_PARSE_ERROR;
-        }
-    }
-
-    // free(result);
-    if( result )
-        free(result);
     return ZR_OK;
 }
+// </3T:TommyTheTerrible>
+
 //This unzip function will only work with a gzip header and trailer - while the contents
 //of the actual compressed data is the same for either format (gzip vs zlib ), the headers
 //and trailers are different for the formats.
@@ -85,6 +85,31 @@ public:
      */
     S32 parseLines(std::istream& istr, LLSD& data);
 
+    // <3T:TommyTheTerrible> Parse straight out of memory
+    /**
+     * @brief Parse one LLSD object out of a complete document in memory.
+     *
+     * Same result as parse() on a stream over the buffer. Parsers that
+     * implement doParseBuffer() skip the stream entirely; whatever that
+     * does not accept, errors included, is handed to parse() so the stream
+     * parser always has the last word.
+     * @param buffer The document. Need not be null terminated.
+     * @param size Size of the document in bytes.
+     * @param data[out] The newly parse structured data.
+     * @param max_depth Max depth parser will check before exiting
+     *  with parse error, -1 - unlimited.
+     * @return Returns the number of LLSD objects parsed into
+     * data. Returns PARSE_FAILURE (-1) on parse failure.
+     */
+    S32 parseBuffer(const char* buffer, size_t size, LLSD& data, S32 max_depth = -1);
+
+    /**
+     * @brief Turns the doParseBuffer() fast path on or off for all parsers.
+     */
+    static void setBufferParseEnabled(bool enabled);
+    static bool isBufferParseEnabled();
+    // </3T:TommyTheTerrible>
+
     /**
      * @brief Resets the parser so parse() or parseLines() can be called again for another <llsd> chunk.
      */
@@ -110,6 +135,21 @@ protected:
      */
     virtual S32 doParse(std::istream& istr, LLSD& data, S32 max_depth = -1) const = 0;
 
+    // <3T:TommyTheTerrible> Parse straight out of memory
+    /**
+     * @brief Virtual default function for parsing a buffer in place.
+     *
+     * Must give exactly what doParse() would for the same bytes, or
+     * PARSE_FAILURE for anything it is not sure of; parseBuffer() then
+     * resets the parser and runs doParse() instead. The default accepts
+     * nothing.
+     */
+    virtual S32 doParseBuffer(const char* buffer, size_t size, LLSD& data, S32 max_depth) const
+    {
+        return PARSE_FAILURE;
+    }
+    // </3T:TommyTheTerrible>
+
     /**
      * @brief Virtual default function for resetting the parser
      */
@@ -250,6 +290,10 @@ protected:
      */
     virtual S32 doParse(std::istream& istr, LLSD& data, S32 max_depth = -1) const;
 
+    // <3T:TommyTheTerrible> Notation straight out of memory
+    S32 doParseBuffer(const char* buffer, size_t size, LLSD& data, S32 max_depth) const override;
+    // </3T:TommyTheTerrible>
+
 private:
     /**
      * @brief Parse a map from the istream
@@ -327,6 +371,10 @@ protected:
      */
     virtual S32 doParse(std::istream& istr, LLSD& data, S32 max_depth = -1) const;
 
+    // <3T:TommyTheTerrible> XML straight out of memory
+    S32 doParseBuffer(const char* buffer, size_t size, LLSD& data, S32 max_depth) const override;
+    // </3T:TommyTheTerrible>
+
     /**
      * @brief Virtual default function for resetting the parser
      */
@@ -790,6 +838,13 @@ public:
         (void)p->parse(str, sd, max_bytes);
         return sd;
     }
+    // <3T:TommyTheTerrible> Same as fromNotation() on a stream over the buffer
+    static S32 fromNotationBuffer(LLSD& sd, const char* buffer, size_t size)
+    {
+        LLPointer<LLSDNotationParser> p = new LLSDNotationParser;
+        return p->parseBuffer(buffer, size, sd);
+    }
+    // </3T:TommyTheTerrible>
 
     /*
      * XML Methods
@@ -825,6 +880,14 @@ public:
         return fromXMLEmbedded(sd, str, emit_errors);
 //      return fromXMLDocument(sd, str, emit_errors);
     }
+    // <3T:TommyTheTerrible> Same as fromXML() on a stream over the buffer,
+    // for whole documents already in memory such as HTTP response bodies.
+    static S32 fromXMLBuffer(LLSD& sd, const char* buffer, size_t size, bool emit_errors=true)
+    {
+        LLPointer<LLSDXMLParser> p = new LLSDXMLParser(emit_errors);
+        return p->parseBuffer(buffer, size, sd);
+    }
+    // </3T:TommyTheTerrible>
 
     /*
      * Binary Methods
@@ -864,6 +927,11 @@ public:
     // return OK or reason for failure
     static EZipRresult unzip_llsd(LLSD& data, std::istream& is, S32 size);
     static EZipRresult unzip_llsd(LLSD& data, const U8* in, S32 size);
+
+    // <3T:TommyTheTerrible> The parse half of unzip_llsd(), for callers that
+    // inflate the block themselves (LLCompressionService::inflate()).
+    static EZipRresult parse_llsd(LLSD& data, U8* in, llssize size);
+    // </3T:TommyTheTerrible>
 };
 
 //dirty little zip functions -- yell at davep
@@ -31,6 +31,7 @@
 #include <deque>
 
 #include "apr_base64.h"
+#include "llbytescan.h" // <3T:TommyTheTerrible/>
 #include <boost/regex.hpp>
 #include <stack>
 
@@ -269,6 +270,7 @@ public:
 
     S32 parse(std::istream& input, LLSD& data);
     S32 parseLines(std::istream& input, LLSD& data);
+    S32 parseBuffer(const char* buffer, size_t size, LLSD& data); // <3T:TommyTheTerrible/>
 
     void parsePart(const char *buf, llssize len);
 
@@ -516,6 +518,485 @@ S32 LLSDXMLParser::Impl::parseLines(std::istream& input, LLSD& data)
     return mParseCount;
 }
 
+// <3T:TommyTheTerrible> XML straight out of memory
+namespace
+{
+    inline bool is_xml_space(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    inline bool is_xml_name_start(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+    }
+
+    inline bool is_xml_name_char(char c)
+    {
+        return is_xml_name_start(c) || (c >= '0' && c <= '9') || c == '.' || c == '-';
+    }
+
+    bool skip_xml_space(const char*& pos, const char* end)
+    {
+        const char* start = pos;
+        while (pos < end && is_xml_space(*pos))
+        {
+            ++pos;
+        }
+        return pos != start;
+    }
+
+    // An ASCII name. Names using anything else are left to expat.
+    std::string_view read_xml_name(const char*& pos, const char* end)
+    {
+        const char* start = pos;
+        if (pos < end && is_xml_name_start(*pos))
+        {
+            do
+            {
+                ++pos;
+            } while (pos < end && is_xml_name_char(*pos));
+        }
+        if (pos < end && static_cast<unsigned char>(*pos) >= 0x80)
+        {
+            return std::string_view();
+        }
+        return std::string_view(start, pos - start);
+    }
+
+    // The declarations LLSD producers write, <?xml version="1.0" ...?>,
+    // given what lies between "<?xml" and "?>".
+    bool is_simple_xml_decl(std::string_view decl)
+    {
+        size_t i = 0;
+        auto skip_space = [&]()
+        {
+            const size_t start = i;
+            while (i < decl.size() && is_xml_space(decl[i]))
+            {
+                ++i;
+            }
+            return i != start;
+        };
+        auto pseudo_attribute = [&](std::string_view name, std::string_view& value)
+        {
+            if (decl.substr(i, name.size()) != name)
+            {
+                return false;
+            }
+            i += name.size();
+            skip_space();
+            if (i >= decl.size() || decl[i] != '=')
+            {
+                return false;
+            }
+            ++i;
+            skip_space();
+            if (i >= decl.size() || (decl[i] != '"' && decl[i] != '\''))
+            {
+                return false;
+            }
+            const size_t close = decl.find(decl[i], i + 1);
+            if (close == std::string_view::npos)
+            {
+                return false;
+            }
+            value = decl.substr(i + 1, close - i - 1);
+            i = close + 1;
+            return true;
+        };
+
+        std::string_view value;
+        if (!skip_space() || !pseudo_attribute("version", value)
+            || value.size() < 3 || value.substr(0, 2) != "1."
+            || value.find_first_not_of("0123456789", 2) != std::string_view::npos)
+        {
+            return false;
+        }
+        size_t mark = i;
+        if (skip_space() && pseudo_attribute("encoding", value))
+        {
+            // the document is read as UTF-8; anything else goes to expat
+            auto is_encoding = [&value](std::string_view name)
+            {
+                return value.size() == name.size()
+                    && std::equal(value.begin(), value.end(), name.begin(),
+                                  [](char c, char upper)
+                                  {
+                                      return toupper(static_cast<unsigned char>(c)) == upper;
+                                  });
+            };
+            if (!is_encoding("UTF-8") && !is_encoding("US-ASCII"))
+            {
+                return false;
+            }
+            mark = i;
+        }
+        i = mark;
+        if (skip_space() && pseudo_attribute("standalone", value))
+        {
+            if (value != "yes" && value != "no")
+            {
+                return false;
+            }
+            mark = i;
+        }
+        i = mark;
+        skip_space();
+        return i == decl.size();
+    }
+
+    // Appends the UTF-8 for a character reference; false for anything
+    // that is not an XML character.
+    bool append_xml_char_ref(std::string_view digits, bool hex, std::string& out)
+    {
+        if (digits.empty() || digits.size() > 8)
+        {
+            return false;
+        }
+        U32 code = 0;
+        for (char c : digits)
+        {
+            U32 nybble;
+            if (c >= '0' && c <= '9')
+            {
+                nybble = c - '0';
+            }
+            else if (hex && c >= 'a' && c <= 'f')
+            {
+                nybble = 10 + c - 'a';
+            }
+            else if (hex && c >= 'A' && c <= 'F')
+            {
+                nybble = 10 + c - 'A';
+            }
+            else
+            {
+                return false;
+            }
+            code = code * (hex ? 16 : 10) + nybble;
+        }
+        if (!(code == 0x9 || code == 0xA || code == 0xD
+              || (code >= 0x20 && code <= 0xD7FF)
+              || (code >= 0xE000 && code <= 0xFFFD)
+              || (code >= 0x10000 && code <= 0x10FFFF)))
+        {
+            return false;
+        }
+        if (code < 0x80)
+        {
+            out += static_cast<char>(code);
+        }
+        else if (code < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        return true;
+    }
+
+    // Length of the well formed UTF-8 XML character at pos, or 0. Like
+    // expat, turns away overlong forms, surrogates, U+FFFE and U+FFFF.
+    size_t xml_utf8_length(const char* pos, const char* end)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(pos);
+        const size_t avail = end - pos;
+        auto cont = [&](size_t n) { return (p[n] & 0xC0) == 0x80; };
+        if (p[0] >= 0xC2 && p[0] <= 0xDF)
+        {
+            return (avail >= 2 && cont(1)) ? 2 : 0;
+        }
+        if (p[0] >= 0xE0 && p[0] <= 0xEF)
+        {
+            if (avail < 3 || !cont(1) || !cont(2)
+                || (p[0] == 0xE0 && p[1] < 0xA0)
+                || (p[0] == 0xED && p[1] > 0x9F)
+                || (p[0] == 0xEF && p[1] == 0xBF && p[2] >= 0xBE))
+            {
+                return 0;
+            }
+            return 3;
+        }
+        if (p[0] >= 0xF0 && p[0] <= 0xF4)
+        {
+            if (avail < 4 || !cont(1) || !cont(2) || !cont(3)
+                || (p[0] == 0xF0 && p[1] < 0x90)
+                || (p[0] == 0xF4 && p[1] > 0x8F))
+            {
+                return 0;
+            }
+            return 4;
+        }
+        return 0;
+    }
+}
+
+// Tokenizes the document itself and drives the same element handlers expat
+// would, so the LLSD built is the same by construction. It takes what the
+// formatters and the grid send: an optional XML declaration, elements with
+// ASCII names and plain attributes, character data with the predefined
+// entities and character references. A DOCTYPE, comments, CDATA, processing
+// instructions, other entities and anything malformed before the closing
+// </llsd> make it give up, and the caller hands the document to expat.
+S32 LLSDXMLParser::Impl::parseBuffer(const char* buffer, size_t size, LLSD& data)
+{
+    const char* pos = buffer;
+    const char* end = buffer + size;
+
+    static const char XML_DECL_START[] = "<?xml";
+    const size_t decl_start_len = sizeof(XML_DECL_START) - 1;
+    if (size > decl_start_len && !strncmp(pos, XML_DECL_START, decl_start_len) && is_xml_space(pos[decl_start_len]))
+    {
+        std::string_view rest(pos + decl_start_len, size - decl_start_len);
+        size_t close = rest.find("?>");
+        if (close == std::string_view::npos || !is_simple_xml_decl(rest.substr(0, close)))
+        {
+            return LLSDParser::PARSE_FAILURE;
+        }
+        pos += decl_start_len + close + 2;
+    }
+
+    std::vector<std::string_view> open_elements;
+    bool root_closed = false;
+    std::string name;
+    std::string entity;
+    std::vector<std::string> attribute_storage;
+    std::vector<const XML_Char*> attributes;
+
+    while (!mGracefullStop && pos < end)
+    {
+        if (*pos != '<')
+        {
+            if (open_elements.empty())
+            {
+                // Only white space around the root element.
+                if (!is_xml_space(*pos))
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+                ++pos;
+                continue;
+            }
+
+            // Character data, handed over in runs as expat would.
+            const char* run = ll_find_first_of_or_unprintable(pos, end, '<', '&', ']', '\r');
+            if (run != pos)
+            {
+                characterDataHandler(pos, static_cast<int>(run - pos));
+                pos = run;
+                continue;
+            }
+            switch (*pos)
+            {
+            case '&':
+            {
+                const char* semicolon = static_cast<const char*>(memchr(pos, ';', std::min<size_t>(end - pos, 12)));
+                if (!semicolon)
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+                std::string_view ref(pos + 1, semicolon - pos - 1);
+                entity.clear();
+                if (ref == "lt")
+                {
+                    entity = "<";
+                }
+                else if (ref == "gt")
+                {
+                    entity = ">";
+                }
+                else if (ref == "amp")
+                {
+                    entity = "&";
+                }
+                else if (ref == "quot")
+                {
+                    entity = "\"";
+                }
+                else if (ref == "apos")
+                {
+                    entity = "'";
+                }
+                else if (ref.size() < 2 || ref[0] != '#'
+                         || !(ref[1] == 'x' ? append_xml_char_ref(ref.substr(2), true, entity)
+                                            : append_xml_char_ref(ref.substr(1), false, entity)))
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+                characterDataHandler(entity.data(), static_cast<int>(entity.size()));
+                pos = semicolon + 1;
+                break;
+            }
+            case ']':
+                // "]]>" may not appear in character data.
+                if (end - pos >= 3 && pos[1] == ']' && pos[2] == '>')
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+                characterDataHandler(pos++, 1);
+                break;
+            case '\r':
+                // Line ends reach the handler as a single '\n'.
+                characterDataHandler("\n", 1);
+                if (++pos < end && *pos == '\n')
+                {
+                    ++pos;
+                }
+                break;
+            default:
+            {
+                // Control characters are never allowed; multibyte UTF-8
+                // must be well formed.
+                const size_t length = xml_utf8_length(pos, end);
+                if (!length)
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+                characterDataHandler(pos, static_cast<int>(length));
+                pos += length;
+                break;
+            }
+            }
+            continue;
+        }
+
+        ++pos; // the '<'
+        if (pos < end && *pos == '/')
+        {
+            ++pos;
+            std::string_view tag = read_xml_name(pos, end);
+            skip_xml_space(pos, end);
+            if (tag.empty() || pos >= end || *pos != '>'
+                || open_elements.empty() || open_elements.back() != tag)
+            {
+                return LLSDParser::PARSE_FAILURE;
+            }
+            ++pos;
+            open_elements.pop_back();
+            root_closed = open_elements.empty();
+            name.assign(tag);
+            endElementHandler(name.c_str());
+            continue;
+        }
+
+        std::string_view tag = read_xml_name(pos, end);
+        if (tag.empty() || root_closed)
+        {
+            // Comments, CDATA, DOCTYPE and processing instructions included.
+            return LLSDParser::PARSE_FAILURE;
+        }
+
+        attribute_storage.clear();
+        bool empty_element = false;
+        while (true)
+        {
+            const bool spaced = skip_xml_space(pos, end);
+            if (pos >= end)
+            {
+                return LLSDParser::PARSE_FAILURE;
+            }
+            if (*pos == '>')
+            {
+                ++pos;
+                break;
+            }
+            if (*pos == '/')
+            {
+                if (end - pos < 2 || pos[1] != '>')
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+                pos += 2;
+                empty_element = true;
+                break;
+            }
+
+            std::string_view attribute = read_xml_name(pos, end);
+            if (!spaced || attribute.empty())
+            {
+                return LLSDParser::PARSE_FAILURE;
+            }
+            skip_xml_space(pos, end);
+            if (pos >= end || *pos != '=')
+            {
+                return LLSDParser::PARSE_FAILURE;
+            }
+            ++pos;
+            skip_xml_space(pos, end);
+            if (pos >= end || (*pos != '"' && *pos != '\''))
+            {
+                return LLSDParser::PARSE_FAILURE;
+            }
+            const char* value_end = static_cast<const char*>(memchr(pos + 1, *pos, end - pos - 1));
+            if (!value_end)
+            {
+                return LLSDParser::PARSE_FAILURE;
+            }
+            // Values needing normalization or entity expansion go to expat.
+            for (const char* c = pos + 1; c < value_end; ++c)
+            {
+                const unsigned char byte = static_cast<unsigned char>(*c);
+                if (byte < 0x20 || byte >= 0x80 || byte == '<' || byte == '&')
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+            }
+            for (size_t i = 0; i < attribute_storage.size(); i += 2)
+            {
+                if (attribute_storage[i] == attribute)
+                {
+                    return LLSDParser::PARSE_FAILURE;
+                }
+            }
+            attribute_storage.emplace_back(attribute);
+            attribute_storage.emplace_back(pos + 1, value_end);
+            pos = value_end + 1;
+        }
+
+        attributes.clear();
+        for (const std::string& text : attribute_storage)
+        {
+            attributes.push_back(text.c_str());
+        }
+        attributes.push_back(NULL);
+
+        name.assign(tag);
+        startElementHandler(name.c_str(), attributes.data());
+        if (empty_element)
+        {
+            root_closed = open_elements.empty();
+            endElementHandler(name.c_str());
+        }
+        else
+        {
+            open_elements.push_back(tag);
+        }
+    }
+
+    // parse() always hands expat one byte past the end of the stream, so
+    // only a document that reaches its closing </llsd> succeeds there.
+    if (!mGracefullStop)
+    {
+        return LLSDParser::PARSE_FAILURE;
+    }
+    data = mResult;
+    return mParseCount;
+}
+// </3T:TommyTheTerrible>
+
 
 void LLSDXMLParser::Impl::reset()
 {
@@ -980,6 +1461,15 @@ S32 LLSDXMLParser::doParse(std::istream& input, LLSD& data, S32 max_depth) const
     return impl.parse(input, data);
 }
 
+// <3T:TommyTheTerrible> XML straight out of memory
+// virtual
+S32 LLSDXMLParser::doParseBuffer(const char* buffer, size_t size, LLSD& data, S32 max_depth) const
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_LLSD;
+    return impl.parseBuffer(buffer, size, data);
+}
+// </3T:TommyTheTerrible>
+
 //  virtual
 void LLSDXMLParser::doReset()
 {
@@ -0,0 +1,388 @@
+/**
+ * @file   lltraceallocprofiler.cpp
+ * @brief  Samples operator new and attributes what it allocates to call
+ *         stacks and block timer zones.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltraceallocprofiler.h"
+
+#include "llfasttimer.h"
+#include "llfile.h"
+#include "llformat.h"
+
+#include <boost/stacktrace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+namespace
+{
+    using LLTrace::AllocationProfiler;
+    using LLTrace::BlockTimerStatHandle;
+
+    // how often a thread looks for a new interval while sampling is off
+    constexpr S64 DISABLED_RECHECK_BYTES = 1024 * 1024;
+
+    // frames of sample() and noteAllocation() at the top of every stack
+    constexpr size_t SKIP_FRAMES = 2;
+
+    std::atomic<U32> sSampleInterval{ 0 };
+    std::atomic<U32> sFrameCount{ 0 };
+
+    struct StackKey
+    {
+        const BlockTimerStatHandle* mZone{ nullptr };
+        U32                         mDepth{ 0 };
+        const void*                 mFrames[AllocationProfiler::MAX_STACK_DEPTH] = {};
+
+        bool operator==(const StackKey& other) const
+        {
+            return mZone == other.mZone && mDepth == other.mDepth
+                && std::equal(mFrames, mFrames + mDepth, other.mFrames);
+        }
+    };
+
+    struct StackKeyHash
+    {
+        size_t operator()(const StackKey& key) const
+        {
+            // FNV-1a over the pointers
+            U64 hash = 14695981039346656037ULL;
+            auto mix = [&hash](const void* ptr)
+            {
+                hash ^= (U64)(uintptr_t)ptr;
+                hash *= 1099511628211ULL;
+            };
+            mix(key.mZone);
+            for (U32 i = 0; i < key.mDepth; ++i)
+            {
+                mix(key.mFrames[i]);
+            }
+            return (size_t)hash;
+        }
+    };
+
+    std::mutex sSamplesMutex;
+    std::unordered_map<StackKey, AllocationProfiler::Totals, StackKeyHash> sSamples;
+
+    thread_local S64  tBytesUntilSample = 0;
+    thread_local U32  tArmedInterval = 0;   // the interval tBytesUntilSample was drawn for
+    thread_local bool tSampling = false;
+    thread_local U64  tRandomState = 0;
+
+    // While the profiler works on a thread, that thread's allocations are
+    // neither sampled nor counted towards its next sample.
+    class NotSampling
+    {
+    public:
+        NotSampling()
+        :   mBytesUntilSample(tBytesUntilSample),
+            mWasSampling(tSampling)
+        {
+            tSampling = true;
+        }
+
+        ~NotSampling()
+        {
+            tBytesUntilSample = mBytesUntilSample;
+            tSampling = mWasSampling;
+        }
+
+    private:
+        const S64   mBytesUntilSample;
+        const bool  mWasSampling;
+    };
+
+    // xorshift64*, seeded per thread; good enough to space samples
+    F64 next_random()
+    {
+        if (!tRandomState)
+        {
+            // splitmix64 of the thread and the time, since xorshift takes a
+            // while to recover from a seed with few bits set
+            U64 seed = (U64)(uintptr_t)&tRandomState ^ LLTrace::BlockTimer::getCPUClockCount64();
+            seed += 0x9e3779b97f4a7c15ULL;
+            seed = (seed ^ (seed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            seed = (seed ^ (seed >> 27)) * 0x94d049bb133111ebULL;
+            tRandomState = (seed ^ (seed >> 31)) | 1;
+        }
+        tRandomState ^= tRandomState >> 12;
+        tRandomState ^= tRandomState << 25;
+        tRandomState ^= tRandomState >> 27;
+        return (F64)((tRandomState * 2685821657736338717ULL) >> 11) / (F64)(1ULL << 53);
+    }
+
+    // Exponentially distributed, so any byte is as likely as any other to
+    // be sampled whatever the sizes around it.
+    S64 next_sample_distance(U32 interval)
+    {
+        return (S64)(-std::log(1.0 - next_random()) * interval) + 1;
+    }
+
+    void add_totals(AllocationProfiler::Totals& to, const AllocationProfiler::Totals& from)
+    {
+        to.mSamples += from.mSamples;
+        to.mBytes += from.mBytes;
+        to.mAllocations += from.mAllocations;
+    }
+
+    std::string frame_name(const void* address)
+    {
+        std::string name = boost::stacktrace::frame(address).name();
+        if (name.empty())
+        {
+            std::ostringstream out;
+            out << address;
+            name = out.str();
+        }
+        return name;
+    }
+}
+
+namespace LLTrace
+{
+
+//static
+bool AllocationProfiler::isAvailable()
+{
+#if LL_ALLOCATION_PROFILER && !((TRACY_ENABLE) && LL_PROFILER_ENABLE_TRACY_MEMORY)
+    return true;
+#else
+    return false;
+#endif
+}
+
+//static
+void AllocationProfiler::setSampleInterval(U32 bytes)
+{
+    U32 previous = sSampleInterval.exchange(bytes);
+    if (previous != bytes)
+    {
+        LL_INFOS("AllocationProfiler") << (bytes ? "Sampling one allocation per " : "Sampling stopped")
+                                       << (bytes ? llformat("%u bytes", bytes) : std::string())
+                                       << (bytes && !isAvailable() ? ", but this build can't sample" : "")
+                                       << LL_ENDL;
+    }
+}
+
+//static
+U32 AllocationProfiler::getSampleInterval()
+{
+    return sSampleInterval.load(std::memory_order_relaxed);
+}
+
+//static
+void AllocationProfiler::reset()
+{
+    std::unordered_map<StackKey, Totals, StackKeyHash> samples;
+    {
+        std::lock_guard<std::mutex> lock(sSamplesMutex);
+        samples.swap(sSamples);
+        sFrameCount = 0;
+    }
+}
+
+//static
+void AllocationProfiler::nextFrame()
+{
+    if (getSampleInterval())
+    {
+        sFrameCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//static
+U32 AllocationProfiler::getFrameCount()
+{
+    return sFrameCount.load(std::memory_order_relaxed);
+}
+
+//static
+void AllocationProfiler::noteAllocation(size_t size)
+{
+    tBytesUntilSample -= (S64)size;
+    if (LL_UNLIKELY(tBytesUntilSample < 0))
+    {
+        sample(size);
+    }
+}
+
+//static
+void AllocationProfiler::sample(size_t size)
+{
+    if (tSampling)
+    {
+        return;
+    }
+
+    const U32 interval = getSampleInterval();
+    if (!interval)
+    {
+        tArmedInterval = 0;
+        tBytesUntilSample = DISABLED_RECHECK_BYTES;
+        return;
+    }
+    if (tArmedInterval != interval)
+    {
+        // This thread's first countdown since the interval changed; what it
+        // counted down for the old one doesn't say anything about this one.
+        tArmedInterval = interval;
+        tBytesUntilSample = next_sample_distance(interval);
+        return;
+    }
+
+    tBytesUntilSample = next_sample_distance(interval);
+    NotSampling not_sampling;
+
+    StackKey key;
+    const void* frames[SKIP_FRAMES + MAX_STACK_DEPTH + 1];
+    size_t depth = boost::stacktrace::safe_dump_to(0, frames, sizeof(frames));
+    // safe_dump_to() ends the frames with a null one when there's room
+    while (depth && !frames[depth - 1])
+    {
+        --depth;
+    }
+    if (depth > SKIP_FRAMES)
+    {
+        key.mDepth = (U32)std::min<size_t>(depth - SKIP_FRAMES, MAX_STACK_DEPTH);
+        std::copy(frames + SKIP_FRAMES, frames + SKIP_FRAMES + key.mDepth, key.mFrames);
+    }
+    BlockTimerStackRecord* timer_data = LLThreadLocalSingletonPointer<BlockTimerStackRecord>::getInstance();
+    key.mZone = timer_data ? timer_data->mTimeBlock : nullptr;
+
+    // An allocation of size bytes is sampled with probability
+    // 1 - exp(-size / interval), so it stands for the reciprocal of that
+    // many allocations like it.
+    const F64 allocations = 1.0 / (1.0 - std::exp(-(F64)size / (F64)interval));
+    {
+        std::lock_guard<std::mutex> lock(sSamplesMutex);
+        Totals& totals = sSamples[key];
+        totals.mSamples++;
+        totals.mBytes += allocations * size;
+        totals.mAllocations += allocations;
+    }
+}
+
+//static
+std::vector<AllocationProfiler::ZoneTotals> AllocationProfiler::getZoneTotals()
+{
+    // sampling while this allocates would need sSamplesMutex
+    NotSampling not_sampling;
+
+    std::unordered_map<const BlockTimerStatHandle*, Totals> zones;
+    {
+        std::lock_guard<std::mutex> lock(sSamplesMutex);
+        for (const auto& [key, totals] : sSamples)
+        {
+            add_totals(zones[key.mZone], totals);
+        }
+    }
+
+    std::vector<ZoneTotals> result;
+    result.reserve(zones.size());
+    for (const auto& [zone, totals] : zones)
+    {
+        ZoneTotals& zone_totals = result.emplace_back();
+        static_cast<Totals&>(zone_totals) = totals;
+        if (zone)
+        {
+            zone_totals.mZone = zone->getName();
+        }
+    }
+    std::sort(result.begin(), result.end(),
+              [](const ZoneTotals& a, const ZoneTotals& b) { return a.mBytes > b.mBytes; });
+    return result;
+}
+
+//static
+void AllocationProfiler::writeReport(std::ostream& out, U32 max_stacks)
+{
+    NotSampling not_sampling;
+    std::vector<ZoneTotals> zones = getZoneTotals();
+
+    std::vector<std::pair<StackKey, Totals>> stacks;
+    {
+        std::lock_guard<std::mutex> lock(sSamplesMutex);
+        stacks.assign(sSamples.begin(), sSamples.end());
+    }
+    std::sort(stacks.begin(), stacks.end(),
+              [](const auto& a, const auto& b) { return a.second.mBytes > b.second.mBytes; });
+    if (stacks.size() > max_stacks)
+    {
+        stacks.resize(max_stacks);
+    }
+
+    const F64 frames = (F64)llmax(getFrameCount(), 1U);
+    Totals all;
+    for (const ZoneTotals& zone : zones)
+    {
+        add_totals(all, zone);
+    }
+
+    out << "Allocation profile: " << getFrameCount() << " frames, " << all.mSamples
+        << " samples, one per " << getSampleInterval() << " bytes\n"
+        << std::fixed << std::setprecision(1)
+        << "Estimated " << all.mBytes / frames / 1024. << " KB and "
+        << all.mAllocations / frames << " allocations per frame\n\n"
+        << "   KB/frame  allocs/frame  samples  zone\n";
+    for (const ZoneTotals& zone : zones)
+    {
+        out << std::setw(11) << zone.mBytes / frames / 1024. << std::setw(14) << zone.mAllocations / frames
+            << std::setw(9) << zone.mSamples << "  " << (zone.mZone.empty() ? "(no timer)" : zone.mZone) << '\n';
+    }
+
+    out << "\nCall stacks allocating most:\n";
+    for (const auto& [key, totals] : stacks)
+    {
+        out << '\n' << std::setw(11) << totals.mBytes / frames / 1024. << std::setw(14) << totals.mAllocations / frames
+            << std::setw(9) << totals.mSamples << "  " << (key.mZone ? key.mZone->getName() : "(no timer)") << '\n';
+        for (U32 i = 0; i < key.mDepth; ++i)
+        {
+            out << "        " << frame_name(key.mFrames[i]) << '\n';
+        }
+    }
+}
+
+//static
+bool AllocationProfiler::writeReport(const std::string& filename, U32 max_stacks)
+{
+    llofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+    if (!out.is_open())
+    {
+        LL_WARNS("AllocationProfiler") << "Could not write " << filename << LL_ENDL;
+        return false;
+    }
+    writeReport(out, max_stacks);
+    LL_INFOS("AllocationProfiler") << "Wrote allocation profile to " << filename << LL_ENDL;
+    return true;
+}
+
+}
@@ -0,0 +1,101 @@
+/**
+ * @file   lltraceallocprofiler.h
+ * @brief  Samples operator new and attributes what it allocates to call
+ *         stacks and block timer zones.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTRACEALLOCPROFILER_H
+#define LL_LLTRACEALLOCPROFILER_H
+
+#include "stdtypes.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace LLTrace
+{
+class BlockTimerStatHandle;
+
+/**
+ * AllocationProfiler finds where allocations churn: which code allocates
+ * how much per frame, whether or not it frees it again. The operator new
+ * in llcommon.cpp reports every allocation; each thread counts down the
+ * bytes to its next sample, a random distance averaging the sample
+ * interval, and only a sampled allocation records its call stack and the
+ * BlockTimer zone it happened in. A sample stands for the allocations it
+ * was drawn from, so the totals are estimates whose error shrinks with the
+ * number of samples.
+ *
+ * Between samples an allocation costs a thread local subtraction. With no
+ * interval set the threads only check for one every megabyte. Builds
+ * without LL_ALLOCATION_PROFILER, or with Tracy's memory profiling (which
+ * has its own operator new), never sample.
+ */
+class LL_COMMON_API AllocationProfiler
+{
+public:
+    static constexpr U32 MAX_STACK_DEPTH = 16;
+
+    struct Totals
+    {
+        U64 mSamples{ 0 };
+        F64 mBytes{ 0. };       // estimated bytes allocated
+        F64 mAllocations{ 0. }; // estimated number of allocations
+    };
+
+    struct ZoneTotals : public Totals
+    {
+        std::string mZone;      // BlockTimer name, or empty outside any timer
+    };
+
+    static bool isAvailable();
+
+    // Mean bytes allocated between samples; 0 stops sampling. What was
+    // sampled is kept until reset().
+    static void setSampleInterval(U32 bytes);
+    static U32 getSampleInterval();
+
+    static void reset();
+
+    // Main thread, once a frame, so the report can give figures per frame.
+    static void nextFrame();
+    static U32 getFrameCount();
+
+    // The totals of each zone, most bytes first.
+    static std::vector<ZoneTotals> getZoneTotals();
+
+    // Zones, then the max_stacks call stacks that allocated most, per frame.
+    static void writeReport(std::ostream& out, U32 max_stacks = 40);
+    static bool writeReport(const std::string& filename, U32 max_stacks = 40);
+
+    // from operator new
+    static void noteAllocation(size_t size);
+
+private:
+    static void sample(size_t size);
+};
+}
+
+#endif // LL_LLTRACEALLOCPROFILER_H
@@ -0,0 +1,394 @@
+/**
+ * @file   lltraceprofilecapture.cpp
+ * @brief  Records every block timer of every thread for a number of frames
+ *         and writes them to a compact binary file.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltraceprofilecapture.h"
+
+#include "llfasttimer.h"
+#include "llfile.h"
+#include "llthread.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace LLTrace
+{
+std::atomic<bool> ProfileCapture::sCapturing{ false };
+}
+
+namespace
+{
+    using LLTrace::BlockTimerStatHandle;
+    using LLTrace::ProfileCapture;
+
+    struct CapturedEvent
+    {
+        const BlockTimerStatHandle* mTimer;
+        U64                         mStart;
+        U64                         mDuration;
+    };
+
+    // One thread's events. Only that thread appends, so the count is the
+    // only thing the two sides share; chunks are allocated as needed and
+    // never move.
+    class ThreadEvents
+    {
+    public:
+        static constexpr U32 CHUNK_EVENTS = 16 * 1024;
+        static constexpr U32 MAX_CHUNKS = ProfileCapture::MAX_THREAD_EVENTS / CHUNK_EVENTS;
+
+        ThreadEvents(U32 thread_number, bool main_thread)
+        :   mThreadNumber(thread_number),
+            mMainThread(main_thread)
+        {
+        }
+
+        ~ThreadEvents()
+        {
+            release();
+        }
+
+        void append(const BlockTimerStatHandle& timer, U64 start, U64 duration)
+        {
+            const U32 index = mCount.load(std::memory_order_relaxed);
+            const U32 chunk = index / CHUNK_EVENTS;
+            if (chunk >= MAX_CHUNKS)
+            {
+                mDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            CapturedEvent* events = mChunks[chunk].load(std::memory_order_relaxed);
+            if (!events)
+            {
+                events = new CapturedEvent[CHUNK_EVENTS];
+                mChunks[chunk].store(events, std::memory_order_relaxed);
+            }
+            events[index % CHUNK_EVENTS] = { &timer, start, duration };
+            mCount.store(index + 1, std::memory_order_release);
+        }
+
+        U32 size() const { return mCount.load(std::memory_order_acquire); }
+
+        const CapturedEvent& at(U32 index) const
+        {
+            return mChunks[index / CHUNK_EVENTS].load(std::memory_order_relaxed)[index % CHUNK_EVENTS];
+        }
+
+        // only once nothing can append any more
+        void release()
+        {
+            for (std::atomic<CapturedEvent*>& chunk : mChunks)
+            {
+                delete[] chunk.exchange(nullptr);
+            }
+            mCount = 0;
+        }
+
+        const U32               mThreadNumber;
+        const bool              mMainThread;
+        std::atomic<U64>        mDropped{ 0 };
+
+        // set while the owning thread appends; see ProfileCapture::stop()
+        std::atomic<bool>       mAppending{ false };
+
+    private:
+        std::atomic<U32>                    mCount{ 0 };
+        std::atomic<CapturedEvent*>         mChunks[MAX_CHUNKS] = {};
+    };
+
+    struct CaptureSession
+    {
+        U32                                         mId{ 0 };
+        std::string                                 mFilename;
+        U32                                         mFramesWanted{ 0 };
+        U64                                         mStartTime{ 0 };
+        std::vector<U64>                            mFrameEnds;
+        std::vector<std::shared_ptr<ThreadEvents>>  mThreads;
+    };
+
+    // guards sSession and each session's thread list
+    std::mutex sSessionMutex;
+    std::shared_ptr<CaptureSession> sSession;
+    std::atomic<U32> sSessionId{ 0 };
+
+    std::string sLastFilename;
+    U64 sLastDropped = 0;
+
+    // The buffer this thread appends to in the session it was made for. A
+    // thread keeps the buffer object past its session, but not the events.
+    thread_local std::shared_ptr<ThreadEvents> tThreadEvents;
+    thread_local U32 tThreadSessionId = 0;
+
+    ThreadEvents* get_thread_events()
+    {
+        const U32 session_id = sSessionId.load(std::memory_order_acquire);
+        if (tThreadSessionId == session_id && tThreadEvents)
+        {
+            return tThreadEvents.get();
+        }
+
+        std::lock_guard<std::mutex> lock(sSessionMutex);
+        if (!sSession || sSession->mId != session_id)
+        {
+            return nullptr;
+        }
+        tThreadEvents = std::make_shared<ThreadEvents>((U32)sSession->mThreads.size(), on_main_thread());
+        tThreadSessionId = session_id;
+        sSession->mThreads.push_back(tThreadEvents);
+        return tThreadEvents.get();
+    }
+
+    void write_varint(std::ostream& out, U64 value)
+    {
+        char bytes[10];
+        size_t count = 0;
+        do
+        {
+            U8 byte = value & 0x7f;
+            value >>= 7;
+            if (value)
+            {
+                byte |= 0x80;
+            }
+            bytes[count++] = (char)byte;
+        } while (value);
+        out.write(bytes, count);
+    }
+
+    void write_zigzag(std::ostream& out, S64 value)
+    {
+        write_varint(out, ((U64)value << 1) ^ (U64)(value >> 63));
+    }
+
+    void write_session(std::ostream& out, const CaptureSession& session, U64& dropped)
+    {
+        out.write("LLPROF1\n", 8);
+        write_varint(out, LLTrace::BlockTimer::countsPerSecond());
+        write_varint(out, session.mStartTime);
+
+        write_varint(out, session.mFrameEnds.size());
+        U64 previous = session.mStartTime;
+        for (U64 frame_end : session.mFrameEnds)
+        {
+            write_varint(out, frame_end - previous);
+            previous = frame_end;
+        }
+
+        // number the timers that were seen, in the order they were first seen
+        std::unordered_map<const BlockTimerStatHandle*, U32> timer_numbers;
+        std::vector<const BlockTimerStatHandle*> timers;
+        for (const std::shared_ptr<ThreadEvents>& thread : session.mThreads)
+        {
+            const U32 count = thread->size();
+            for (U32 i = 0; i < count; ++i)
+            {
+                const BlockTimerStatHandle* timer = thread->at(i).mTimer;
+                if (timer_numbers.emplace(timer, (U32)timers.size()).second)
+                {
+                    timers.push_back(timer);
+                }
+            }
+        }
+        write_varint(out, timers.size());
+        for (const BlockTimerStatHandle* timer : timers)
+        {
+            const std::string& name = timer->getName();
+            write_varint(out, name.size());
+            out.write(name.data(), name.size());
+        }
+
+        dropped = 0;
+        write_varint(out, session.mThreads.size());
+        for (const std::shared_ptr<ThreadEvents>& thread : session.mThreads)
+        {
+            const U32 count = thread->size();
+            write_varint(out, thread->mThreadNumber);
+            write_varint(out, thread->mMainThread ? 1 : 0);
+            write_varint(out, count);
+            U64 previous_start = session.mStartTime;
+            for (U32 i = 0; i < count; ++i)
+            {
+                const CapturedEvent& event = thread->at(i);
+                write_varint(out, timer_numbers[event.mTimer]);
+                write_zigzag(out, (S64)(event.mStart - previous_start));
+                write_varint(out, event.mDuration);
+                previous_start = event.mStart;
+            }
+            dropped += thread->mDropped.load(std::memory_order_relaxed);
+        }
+        write_varint(out, dropped);
+    }
+}
+
+namespace LLTrace
+{
+
+//static
+bool ProfileCapture::start(U32 frames, const std::string& filename)
+{
+    if (!frames || filename.empty())
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sSessionMutex);
+        if (sSession)
+        {
+            return false;
+        }
+        sSession = std::make_shared<CaptureSession>();
+        sSession->mId = sSessionId.load() + 1;
+        sSession->mFilename = filename;
+        sSession->mFramesWanted = frames;
+        sSession->mFrameEnds.reserve(frames);
+        sSession->mStartTime = BlockTimer::getCPUClockCount64();
+        sSessionId.store(sSession->mId, std::memory_order_release);
+        sCapturing.store(true);
+    }
+
+    LL_INFOS("ProfileCapture") << "Capturing " << frames << " frames to " << filename << LL_ENDL;
+    return true;
+}
+
+//static
+bool ProfileCapture::stop()
+{
+    std::shared_ptr<CaptureSession> session;
+    {
+        std::lock_guard<std::mutex> lock(sSessionMutex);
+        session.swap(sSession);
+    }
+    if (!session)
+    {
+        return false;
+    }
+
+    // A thread sets its mAppending before it checks sCapturing, and this
+    // clears sCapturing before it checks mAppending, so each thread has
+    // either finished its last event or will not start one.
+    sCapturing.store(false);
+    for (const std::shared_ptr<ThreadEvents>& thread : session->mThreads)
+    {
+        while (thread->mAppending.load())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool written = false;
+    U64 dropped = 0;
+    llofstream out(session->mFilename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (out.is_open())
+    {
+        write_session(out, *session, dropped);
+        out.close();
+        written = !out.fail();
+    }
+
+    if (written)
+    {
+        LL_INFOS("ProfileCapture") << "Wrote " << session->mFrameEnds.size() << " frames from "
+                                   << session->mThreads.size() << " threads to " << session->mFilename
+                                   << "; " << dropped << " timer calls dropped" << LL_ENDL;
+    }
+    else
+    {
+        LL_WARNS("ProfileCapture") << "Could not write " << session->mFilename << LL_ENDL;
+    }
+
+    for (const std::shared_ptr<ThreadEvents>& thread : session->mThreads)
+    {
+        thread->release();
+    }
+
+    std::lock_guard<std::mutex> lock(sSessionMutex);
+    sLastFilename = session->mFilename;
+    sLastDropped = dropped;
+    return written;
+}
+
+//static
+bool ProfileCapture::nextFrame()
+{
+    if (!isCapturing())
+    {
+        return false;
+    }
+
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(sSessionMutex);
+        if (!sSession)
+        {
+            return false;
+        }
+        sSession->mFrameEnds.push_back(BlockTimer::getCPUClockCount64());
+        done = sSession->mFrameEnds.size() >= sSession->mFramesWanted;
+    }
+    if (done)
+    {
+        stop();
+    }
+    return done;
+}
+
+//static
+std::string ProfileCapture::getLastFilename()
+{
+    std::lock_guard<std::mutex> lock(sSessionMutex);
+    return sLastFilename;
+}
+
+//static
+U64 ProfileCapture::getLastDroppedCount()
+{
+    std::lock_guard<std::mutex> lock(sSessionMutex);
+    return sLastDropped;
+}
+
+//static
+void ProfileCapture::record(const BlockTimerStatHandle& timer, U64 start, U64 duration)
+{
+    ThreadEvents* events = get_thread_events();
+    if (!events)
+    {
+        return;
+    }
+    events->mAppending.store(true);
+    if (sCapturing.load())
+    {
+        events->append(timer, start, duration);
+    }
+    events->mAppending.store(false, std::memory_order_release);
+}
+
+}
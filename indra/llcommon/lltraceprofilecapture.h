@@ -0,0 +1,97 @@
+/**
+ * @file   lltraceprofilecapture.h
+ * @brief  Records every block timer of every thread for a number of frames
+ *         and writes them to a compact binary file.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTRACEPROFILECAPTURE_H
+#define LL_LLTRACEPROFILECAPTURE_H
+
+#include "stdtypes.h"
+
+#include <atomic>
+#include <string>
+
+namespace LLTrace
+{
+class BlockTimerStatHandle;
+
+/**
+ * ProfileCapture keeps every BlockTimer that finishes, on any thread with a
+ * ThreadRecorder, while a capture runs: which timer, when it started and how
+ * long it took. The accumulators behind LLFastTimerView only keep totals; a
+ * capture keeps each call, so the timer tree of every frame can be rebuilt
+ * afterwards without a Tracy build. scripts/perf/profile_capture.py turns a
+ * capture into Chrome trace JSON and profile_cmp.py compares two of them.
+ *
+ * Each thread appends to its own buffer without locking; a thread that has
+ * logged MAX_THREAD_EVENTS stops and counts what it drops. Outside a capture
+ * a BlockTimer pays one relaxed atomic load.
+ *
+ * The file, all integers unsigned LEB128 varints unless noted:
+ *   "LLPROF1\n"                     8 bytes
+ *   clock counts per second
+ *   start time                      BlockTimer clock
+ *   frame count, then each frame's end as a delta from the previous
+ *   one (the first from the start time)
+ *   timer count, then each name as length and bytes
+ *   thread count, then for each thread:
+ *     thread number, flags (1: main thread), event count,
+ *     then each event as timer number, start as a zigzag encoded delta
+ *     from the previous event's start (the first from the start time),
+ *     and duration
+ *   dropped event count
+ * Events are in the order the timers finished, so a child comes before its
+ * parent.
+ */
+class LL_COMMON_API ProfileCapture
+{
+public:
+    static constexpr U32 MAX_THREAD_EVENTS = 4 * 1024 * 1024;
+
+    // Starts capturing the next frames frames, written to filename when
+    // they are done. False if a capture is already running.
+    static bool start(U32 frames, const std::string& filename);
+
+    // Ends a capture early and writes what it has. False if none ran or
+    // the file could not be written.
+    static bool stop();
+
+    static bool isCapturing() { return sCapturing.load(std::memory_order_relaxed); }
+
+    // Main thread, once a frame. True on the frame a capture finishes.
+    static bool nextFrame();
+
+    // The file the last capture went to, and what it dropped.
+    static std::string getLastFilename();
+    static U64 getLastDroppedCount();
+
+    // from ~BlockTimer()
+    static void record(const BlockTimerStatHandle& timer, U64 start, U64 duration);
+
+    static std::atomic<bool> sCapturing;
+};
+}
+
+#endif // LL_LLTRACEPROFILECAPTURE_H
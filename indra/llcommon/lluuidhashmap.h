@@ -0,0 +1,51 @@
+/**
+ * @file   lluuidhashmap.h
+ * @brief  Open addressing hash containers keyed by LLUUID.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLUUIDHASHMAP_H
+#define LL_LLUUIDHASHMAP_H
+
+#include "lluuid.h"
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
+
+// Drop-in replacements for std::map<LLUUID, T> and std::set<LLUUID> where
+// lookups dominate and order does not matter. Entries live in one flat
+// array probed with SIMD groups rather than in a tree of nodes, so a lookup
+// costs about one cache miss instead of log2(n) of them.
+//
+// Unlike std::map, inserting may move entries: do not keep iterators,
+// pointers or references to elements across an insert. Values that must
+// stay put should be held by pointer. erase(iterator) does not return the
+// next iterator either; erase by key, or use erase_if().
+//
+// hash_value(LLUUID) is not avalanching, boost mixes it further itself.
+template <typename T>
+using LLUUIDHashMap = boost::unordered_flat_map<LLUUID, T>;
+
+typedef boost::unordered_flat_set<LLUUID> uuid_hash_set_t;
+
+#endif // LL_LLUUIDHASHMAP_H
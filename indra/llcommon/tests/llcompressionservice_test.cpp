@@ -0,0 +1,346 @@
+/**
+ * @file   llcompressionservice_test.cpp
+ * @brief  Test for llcompressionservice.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llcompressionservice.h"
+// STL headers
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+// other Linden headers
+#include "../test/lltut.h"
+#include "llcond.h"
+#include "llsd.h"
+#include "llsdserialize.h"
+#include "llsdutil.h"
+#include "llstring.h"
+#include "stringize.h"
+#include "threadpool.h"
+
+namespace
+{
+    typedef LLCompressionService::buffer_t buffer_t;
+
+    // Something shaped like a mesh LOD block: a few faces with quantized
+    // positions, normals and texture coordinates plus an index list.
+    buffer_t make_mesh_block(U32 seed, U32 vertices)
+    {
+        LLSD faces = LLSD::emptyArray();
+        for (U32 face = 0; face < 4; ++face)
+        {
+            LLSD::Binary positions(vertices * 6), normals(vertices * 6), tex_coords(vertices * 4), indices(vertices * 6);
+            U32 state = seed * 2654435761u + face;
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                state = state * 1103515245u + 12345u;
+                // smooth-ish data with some noise compresses like real geometry
+                positions[i] = (U8)((i / 6) + ((state >> 16) & 0x7));
+                normals[i] = (U8)(state >> 24);
+            }
+            for (size_t i = 0; i < tex_coords.size(); ++i)
+            {
+                tex_coords[i] = (U8)(i * 3);
+            }
+            for (size_t i = 0; i < indices.size(); ++i)
+            {
+                indices[i] = (U8)((i / 3 + i % 3) & 0xFF);
+            }
+
+            LLSD sd;
+            sd["Position"] = positions;
+            sd["Normal"] = normals;
+            sd["TexCoord0"] = tex_coords;
+            sd["TriangleList"] = indices;
+            sd["PositionDomain"]["Min"] = llsd::array(-0.5, -0.5, -0.5);
+            sd["PositionDomain"]["Max"] = llsd::array(0.5, 0.5, 0.5);
+            faces.append(sd);
+        }
+
+        std::ostringstream strm;
+        LLSDSerialize::toBinary(faces, strm);
+        std::string str = strm.str();
+        return buffer_t(str.begin(), str.end());
+    }
+
+    // Benchmark input: every regular file in dir (point it at a mesh or
+    // asset cache to measure real data), or generated mesh blocks of
+    // assorted sizes if there are none.
+    std::vector<buffer_t> load_bench_inputs(const std::string& dir)
+    {
+        std::vector<buffer_t> inputs;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+        {
+            if (!entry.is_regular_file(ec))
+            {
+                continue;
+            }
+            std::ifstream file(entry.path(), std::ios::binary);
+            buffer_t data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            if (!data.empty())
+            {
+                inputs.push_back(std::move(data));
+            }
+        }
+
+        if (inputs.empty())
+        {
+            for (U32 i = 0; i < 48; ++i)
+            {
+                inputs.push_back(make_mesh_block(i, 256 << (i % 5)));
+            }
+        }
+        return inputs;
+    }
+
+    F64 mb_per_sec(size_t bytes, std::chrono::steady_clock::duration elapsed)
+    {
+        F64 seconds = std::chrono::duration<F64>(elapsed).count();
+        return seconds > 0.0 ? (F64)bytes / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llcompressionservice_data
+    {
+        llcompressionservice_data():
+            pool("CompressionTest", 3)
+        {
+            pool.start();
+        }
+
+        ~llcompressionservice_data()
+        {
+            pool.close();
+        }
+
+        LL::ThreadPool pool;
+    };
+    typedef test_group<llcompressionservice_data> llcompressionservice_group;
+    typedef llcompressionservice_group::object object;
+    llcompressionservice_group llcompressionservicegrp("llcompressionservice");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("round trip");
+        buffer_t source = make_mesh_block(1, 1024);
+        buffer_t deflated, inflated;
+        ensure_equals("deflate", LLCompressionService::deflate(source.data(), source.size(), deflated), LLCompressionService::OK);
+        ensure("deflate did not shrink mesh data", deflated.size() < source.size());
+        ensure_equals("inflate", LLCompressionService::inflate(deflated.data(), deflated.size(), inflated), LLCompressionService::OK);
+        ensure("round trip mismatch", inflated == source);
+
+        // reusing the per-thread streams must not leak state between blocks
+        buffer_t other = make_mesh_block(2, 64);
+        ensure_equals("deflate again", LLCompressionService::deflate(other.data(), other.size(), deflated, 1), LLCompressionService::OK);
+        ensure_equals("inflate again", LLCompressionService::inflate(deflated.data(), deflated.size(), inflated), LLCompressionService::OK);
+        ensure("second round trip mismatch", inflated == other);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("zip_llsd compatibility");
+        LLSD sd;
+        sd["name"] = "compression";
+        sd["values"] = llsd::array(1, 2.5, "three", LLSD::Binary(300, 7));
+
+        std::string zipped = zip_llsd(sd);
+        ensure("zip_llsd failed", !zipped.empty());
+
+        LLSD unzipped;
+        ensure_equals("unzip_llsd", LLUZipHelper::unzip_llsd(unzipped, (const U8*)zipped.data(), (S32)zipped.size()),
+                      LLUZipHelper::ZR_OK);
+        ensure_equals("unzipped name", unzipped["name"].asString(), "compression");
+        ensure_equals("unzipped binary", unzipped["values"][3].asBinary().size(), (size_t)300);
+
+        buffer_t inflated;
+        ensure_equals("service inflates zip_llsd output",
+                      LLCompressionService::inflate((const U8*)zipped.data(), zipped.size(), inflated), LLCompressionService::OK);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("bad input");
+        buffer_t source = make_mesh_block(3, 512);
+        buffer_t deflated, inflated;
+        LLCompressionService::deflate(source.data(), source.size(), deflated);
+
+        ensure_equals("truncated stream",
+                      LLCompressionService::inflate(deflated.data(), deflated.size() / 2, inflated), LLCompressionService::DATA_ERROR);
+        ensure("output left behind on failure", inflated.empty());
+
+        buffer_t garbage(deflated.size(), 0x5A);
+        ensure_equals("garbage stream",
+                      LLCompressionService::inflate(garbage.data(), garbage.size(), inflated), LLCompressionService::DATA_ERROR);
+        ensure_equals("empty stream", LLCompressionService::inflate(nullptr, 0, inflated), LLCompressionService::DATA_ERROR);
+
+        // the stream must still be usable after an error
+        ensure_equals("recovers after error",
+                      LLCompressionService::inflate(deflated.data(), deflated.size(), inflated), LLCompressionService::OK);
+        ensure("recovered round trip mismatch", inflated == source);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("batch");
+        std::vector<buffer_t> sources;
+        for (U32 i = 0; i < 24; ++i)
+        {
+            sources.push_back(make_mesh_block(i, 128 + i * 40));
+        }
+
+        std::vector<LLCompressionService::Job> deflate_jobs;
+        for (const buffer_t& source : sources)
+        {
+            deflate_jobs.emplace_back(source.data(), source.size());
+        }
+        ensure_equals("deflate failures", LLCompressionService::deflateBatch(deflate_jobs, 6, "CompressionTest"), 0U);
+
+        std::vector<LLCompressionService::Job> inflate_jobs;
+        for (const LLCompressionService::Job& job : deflate_jobs)
+        {
+            inflate_jobs.emplace_back(job.mOut.data(), job.mOut.size());
+        }
+        // one corrupt member must not disturb the rest of the batch
+        buffer_t garbage(64, 0x33);
+        inflate_jobs.emplace_back(garbage.data(), garbage.size());
+
+        ensure_equals("inflate failures", LLCompressionService::inflateBatch(inflate_jobs, "CompressionTest"), 1U);
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            ensure(STRINGIZE("batch round trip mismatch at " << i), inflate_jobs[i].mOut == sources[i]);
+        }
+        ensure_equals("corrupt job result", inflate_jobs.back().mResult, LLCompressionService::DATA_ERROR);
+
+        // without a queue the batch still completes on this thread
+        std::vector<LLCompressionService::Job> inline_jobs(1, LLCompressionService::Job(sources[0].data(), sources[0].size()));
+        ensure_equals("inline batch", LLCompressionService::deflateBatch(inline_jobs, 6, "NoSuchQueue"), 0U);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("async");
+        buffer_t source = make_mesh_block(5, 300);
+        buffer_t deflated;
+        LLCompressionService::deflate(source.data(), source.size(), deflated);
+
+        LLScalarCond<S32> done(0);
+        buffer_t result;
+        LLCompressionService::EResult status = LLCompressionService::DATA_ERROR;
+        bool posted = LLCompressionService::postInflate(std::move(deflated),
+            [&](LLCompressionService::EResult res, buffer_t& out)
+            {
+                status = res;
+                result.swap(out);
+                done.set_all(1);
+            },
+            "CompressionTest");
+        ensure("postInflate", posted);
+        ensure("timed out", done.wait_for_equal(F32Milliseconds(5000.f), 1));
+        ensure_equals("async status", status, LLCompressionService::OK);
+        ensure("async round trip mismatch", result == source);
+
+        buffer_t unposted = source;
+        ensure("posted to a missing queue",
+               !LLCompressionService::postDeflate(std::move(unposted), [](LLCompressionService::EResult, buffer_t&) {}, 6, "NoSuchQueue"));
+        ensure("input not handed back", unposted == source);
+    }
+
+    template<> template<>
+    void object::test<6>()
+    {
+        set_test_name("throughput");
+        // Not a pass/fail test: reports sequential against batched deflate
+        // and inflate throughput so changes to the service can be compared.
+        std::string dir = LLStringUtil::getenv("LL_COMPRESSION_BENCH_DIR");
+        if (dir.empty())
+        {
+            skip("set LL_COMPRESSION_BENCH_DIR to run");
+        }
+        std::vector<buffer_t> inputs = load_bench_inputs(dir);
+        size_t total = 0;
+        for (const buffer_t& input : inputs)
+        {
+            total += input.size();
+        }
+
+        using clock = std::chrono::steady_clock;
+        std::vector<buffer_t> deflated(inputs.size());
+
+        auto start = clock::now();
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            LLCompressionService::deflate(inputs[i].data(), inputs[i].size(), deflated[i]);
+        }
+        auto sequential_deflate = clock::now() - start;
+
+        std::vector<LLCompressionService::Job> jobs;
+        for (const buffer_t& input : inputs)
+        {
+            jobs.emplace_back(input.data(), input.size());
+        }
+        start = clock::now();
+        ensure_equals("batch deflate", LLCompressionService::deflateBatch(jobs, LLCompressionService::DEFAULT_LEVEL, "CompressionTest"), 0U);
+        auto batch_deflate = clock::now() - start;
+
+        buffer_t inflated;
+        start = clock::now();
+        for (const buffer_t& block : deflated)
+        {
+            LLCompressionService::inflate(block.data(), block.size(), inflated);
+        }
+        auto sequential_inflate = clock::now() - start;
+
+        std::vector<LLCompressionService::Job> inflate_jobs;
+        for (const buffer_t& block : deflated)
+        {
+            inflate_jobs.emplace_back(block.data(), block.size());
+        }
+        start = clock::now();
+        ensure_equals("batch inflate", LLCompressionService::inflateBatch(inflate_jobs, "CompressionTest"), 0U);
+        auto batch_inflate = clock::now() - start;
+
+        std::cout << "\nllcompressionservice: " << inputs.size() << " blocks, " << total / 1024 << " KB\n"
+                  << "  deflate sequential " << mb_per_sec(total, sequential_deflate) << " MB/s, batched "
+                  << mb_per_sec(total, batch_deflate) << " MB/s\n"
+                  << "  inflate sequential " << mb_per_sec(total, sequential_inflate) << " MB/s, batched "
+                  << mb_per_sec(total, batch_inflate) << " MB/s" << std::endl;
+    }
+} // namespace tut
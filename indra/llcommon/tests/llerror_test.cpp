@@ -25,8 +25,18 @@
  * $/LicenseInfo$
  */
 
+// <3T:TommyTheTerrible> Compile LL_DEBUGS sites out of the build
+// These tests log with LL_DEBUGS whatever the build does.
+#undef LL_COMPILE_OUT_DEBUG_LOGS
+// </3T:TommyTheTerrible>
+
 #include <vector>
 #include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
 
 #include "linden_common.h"
 
@@ -34,6 +44,7 @@
 
 #include "../llerrorcontrol.h"
 #include "../llsd.h"
+#include "../llstring.h"
 
 #include "../test/lltut.h"
 
@@ -150,6 +161,7 @@ namespace tut
 
         ~ErrorTestData()
         {
+            LLError::setAsyncLogging(false);
             LLError::removeRecorder(mRecorder);
             LLError::restoreSettings(mPriorErrorSettings);
         }
@@ -921,6 +933,370 @@ namespace tut
     }
 }
 
+namespace
+{
+    // One call site for every thread, so it only has to be looked up once.
+    void writeAsyncMessage(int thread, int n)
+    {
+        LL_INFOS("AsyncTest") << "thread " << thread << " message " << n << LL_ENDL;
+    }
+
+    // Logs count messages from each of the threads, returning the time the
+    // callers spent in total.
+    F64 writeAsyncMessagesFromThreads(int threads, int count)
+    {
+        std::vector<std::thread> writers;
+        std::atomic<bool> go{ false };
+        for (int t = 0; t < threads; ++t)
+        {
+            writers.emplace_back([t, count, &go]()
+            {
+                while (!go)
+                {
+                    std::this_thread::yield();
+                }
+                for (int n = 0; n < count; ++n)
+                {
+                    writeAsyncMessage(t, n);
+                }
+            });
+        }
+        auto start = std::chrono::steady_clock::now();
+        go = true;
+        for (std::thread& writer : writers)
+        {
+            writer.join();
+        }
+        return std::chrono::duration<F64>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+namespace tut
+{
+    template<> template<>
+    void ErrorTestObject::test<19>()
+        // asynchronous logging keeps every message from each thread, in order
+    {
+        // look the call site up before several threads race for the log mutex
+        writeAsyncMessage(-1, 0);
+        clearMessages();
+
+        LLError::setAsyncLogging(true);
+        ensure("async logging on", LLError::getAsyncLogging());
+        const LLError::AsyncLogStats before = LLError::getAsyncLogStats();
+
+        const int threads = 8;
+        const int count = 500;
+        writeAsyncMessagesFromThreads(threads, count);
+        LLError::flushAsyncLog();
+
+        const LLError::AsyncLogStats after = LLError::getAsyncLogStats();
+        ensure_equals("nothing dropped", after.mDropped - before.mDropped, 0ULL);
+        ensure_message_count(threads * count);
+
+        std::vector<int> next(threads, 0);
+        for (int i = 0; i < threads * count; ++i)
+        {
+            int thread = -1, n = -1;
+            std::string msg = message_field(i, MSG_FIELD);
+            ensure(msg, sscanf(msg.c_str(), "thread %d message %d", &thread, &n) == 2);
+            ensure(msg, thread >= 0 && thread < threads);
+            ensure_equals(msg, n, next[thread]++);
+        }
+
+        // an error is still written, and after what was queued before it
+        writeAsyncMessage(0, count);
+        CATCH(LL_ERRS("AsyncTest"), "after the queue");
+        ensure("fatal callback called", fatalWasCalled);
+        ensure_message_field_equals(threads * count, MSG_FIELD, "thread 0 message 500");
+        ensure_message_field_equals(threads * count + 1, MSG_FIELD, "after the queue");
+
+        LLError::setAsyncLogging(false);
+        ensure("async logging off", !LLError::getAsyncLogging());
+        writeAsyncMessage(0, count + 1);
+        ensure_message_field_equals(threads * count + 2, MSG_FIELD, "thread 0 message 501");
+    }
+
+    template<> template<>
+    void ErrorTestObject::test<20>()
+        // a thread that gets too far ahead of the writer drops and counts
+    {
+        writeAsyncMessage(-1, 0);
+        clearMessages();
+
+        // holds the writer in the first message until released
+        std::atomic<bool> in_gate{ false };
+        std::atomic<bool> open_gate{ false };
+        LLError::RecorderPtr gate = LLError::addGenericRecorder(
+            [&in_gate, &open_gate](LLError::ELevel, const std::string& message)
+            {
+                if (LLStringUtil::endsWith(message, "gate"))
+                {
+                    in_gate = true;
+                    while (!open_gate)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+        LLError::setAsyncLogging(true);
+        const LLError::AsyncLogStats before = LLError::getAsyncLogStats();
+        LL_INFOS("AsyncTest") << "gate" << LL_ENDL;
+        while (!in_gate)
+        {
+            std::this_thread::yield();
+        }
+
+        const int count = 1500;
+        for (int n = 0; n < count; ++n)
+        {
+            writeAsyncMessage(0, n);
+        }
+        open_gate = true;
+        LLError::flushAsyncLog();
+
+        const LLError::AsyncLogStats after = LLError::getAsyncLogStats();
+        // 1024 fit in the thread's queue while the writer was held up
+        ensure_equals("dropped", after.mDropped - before.mDropped, (U64)(count - 1024));
+        // and the writer may have logged a warning about the rest
+        ensure("written", after.mWritten - before.mWritten >= 1025ULL);
+        ensure_message_field_equals(0, MSG_FIELD, "gate");
+        ensure_message_field_equals(1, MSG_FIELD, "thread 0 message 0");
+        ensure_message_field_equals(1024, MSG_FIELD, "thread 0 message 1023");
+
+        LLError::setAsyncLogging(false);
+        LLError::removeRecorder(gate);
+    }
+
+    template<> template<>
+    void ErrorTestObject::test<21>()
+        // logging throughput from several threads, direct and asynchronous
+    {
+        // Not a pass/fail test: how long the logging threads spend per
+        // message when each one is written to a file as it is logged, and
+        // when the writer thread does that instead.
+        std::string env = LLStringUtil::getenv("LL_ERROR_BENCH_MESSAGES");
+        if (env.empty())
+        {
+            skip("set LL_ERROR_BENCH_MESSAGES to run");
+        }
+        int count = llmax(std::stoi(env), 10);
+        const int threads = 8;
+
+        FILE* file = tmpfile();
+        ensure("temporary file", file != nullptr);
+        std::atomic<U64> delivered{ 0 };
+        LLError::removeRecorder(mRecorder);
+        LLError::RecorderPtr file_recorder = LLError::addGenericRecorder(
+            [file, &delivered](LLError::ELevel, const std::string& message)
+            {
+                fputs(message.c_str(), file);
+                fputc('\n', file);
+                fflush(file);
+                ++delivered;
+            });
+        writeAsyncMessage(-1, 0);
+
+        delivered = 0;
+        const F64 sync_seconds = writeAsyncMessagesFromThreads(threads, count);
+        const U64 sync_delivered = delivered;
+
+        LLError::setAsyncLogging(true);
+        const LLError::AsyncLogStats before = LLError::getAsyncLogStats();
+        delivered = 0;
+        const F64 async_seconds = writeAsyncMessagesFromThreads(threads, count);
+        LLError::flushAsyncLog();
+        const U64 async_delivered = delivered;
+        const LLError::AsyncLogStats after = LLError::getAsyncLogStats();
+        LLError::setAsyncLogging(false);
+
+        LLError::removeRecorder(file_recorder);
+        fclose(file);
+        LLError::addRecorder(mRecorder);
+
+        const F64 total = (F64)(threads * count);
+        std::cout << "\nllerror: " << threads << " threads x " << count << " messages to a file\n"
+                  << "  direct: " << sync_seconds * 1e9 / total << " ns per message, "
+                  << sync_delivered << " written (the rest lost to the log mutex)\n"
+                  << "  async:  " << async_seconds * 1e9 / total << " ns per message, "
+                  << async_delivered << " written, " << (after.mDropped - before.mDropped)
+                  << " dropped from full queues" << std::endl;
+    }
+}
+
+namespace
+{
+    void writeCachedSiteMessage(int n)
+    {
+        LL_INFOS("CachedSite") << "cached " << n << LL_ENDL;
+    }
+}
+
+namespace tut
+{
+    template<> template<>
+    void ErrorTestObject::test<22>()
+        // a call site is decided once per change to the settings
+    {
+        LLError::setDefaultLevel(LLError::LEVEL_WARN);
+        const int before = LLError::shouldLogCallCount();
+        for (int n = 0; n < 10; ++n)
+        {
+            writeCachedSiteMessage(n);
+        }
+        ensure_equals("decided once", LLError::shouldLogCallCount() - before, 1);
+        ensure_message_count(0);
+
+        LLError::setTagLevel("CachedSite", LLError::LEVEL_INFO);
+        for (int n = 0; n < 10; ++n)
+        {
+            writeCachedSiteMessage(n);
+        }
+        ensure_equals("decided again after the change", LLError::shouldLogCallCount() - before, 2);
+        ensure_message_count(10);
+        ensure_message_field_equals(9, MSG_FIELD, "cached 9");
+
+        // restoring older settings is a change too
+        LLError::SettingsStoragePtr saved = LLError::saveAndResetSettings();
+        LLError::setDefaultLevel(LLError::LEVEL_WARN);
+        writeCachedSiteMessage(10);
+        LLError::restoreSettings(saved);
+        writeCachedSiteMessage(11);
+        ensure_message_count(11);
+        ensure_message_field_equals(10, MSG_FIELD, "cached 11");
+    }
+
+    template<> template<>
+    void ErrorTestObject::test<23>()
+        // cost of a log call that is off, compiled out, and written
+    {
+        // Not a pass/fail test: nanoseconds per call for a call site that is
+        // turned off, one compiled out as LL_COMPILE_OUT_DEBUG_LOGS does for
+        // LL_DEBUGS, and one that is written to a recorder that does nothing.
+        std::string env = LLStringUtil::getenv("LL_ERROR_BENCH_CALLS");
+        if (env.empty())
+        {
+            skip("set LL_ERROR_BENCH_CALLS to run");
+        }
+        int count = llmax(std::stoi(env), 10);
+
+        LLError::removeRecorder(mRecorder);
+        U64 recorded = 0;
+        LLError::RecorderPtr null_recorder = LLError::addGenericRecorder(
+            [&recorded](LLError::ELevel, const std::string&) { ++recorded; });
+
+        using clock = std::chrono::steady_clock;
+        auto ns_per_call = [](clock::time_point start, int calls)
+        {
+            return std::chrono::duration<F64, std::nano>(clock::now() - start).count() / calls;
+        };
+        volatile int sink = 0;
+
+        LLError::setDefaultLevel(LLError::LEVEL_WARN);
+        auto start = clock::now();
+        for (int n = 0; n < count; ++n)
+        {
+            LL_INFOS("LogBench") << "off " << n << LL_ENDL;
+            sink = n;
+        }
+        const F64 off = ns_per_call(start, count);
+
+        start = clock::now();
+        for (int n = 0; n < count; ++n)
+        {
+            lllog_compiled_out_(LLError::LEVEL_DEBUG, false, "LogBench") << "compiled out " << n << LL_ENDL;
+            sink = n;
+        }
+        const F64 compiled_out = ns_per_call(start, count);
+
+        LLError::setDefaultLevel(LLError::LEVEL_DEBUG);
+        const int written_count = llmax(count / 10, 10);
+        start = clock::now();
+        for (int n = 0; n < written_count; ++n)
+        {
+            LL_INFOS("LogBench") << "written " << n << LL_ENDL;
+            sink = n;
+        }
+        const F64 written = ns_per_call(start, written_count);
+        (void)sink;
+
+        LLError::removeRecorder(null_recorder);
+        LLError::addRecorder(mRecorder);
+        ensure_equals("every enabled call recorded", recorded, (U64)written_count);
+
+        std::cout << "\nllerror: ns per log call\n"
+                  << "  turned off:   " << off << "\n"
+                  << "  compiled out: " << compiled_out << "\n"
+                  << "  written:      " << written << " (to a recorder that does nothing)" << std::endl;
+    }
+
+    template<> template<>
+    void ErrorTestObject::test<24>()
+        // an error waits for a message that is being written
+    {
+        std::atomic<bool> in_gate{ false };
+        std::atomic<bool> open_gate{ false };
+        LLError::RecorderPtr gate = LLError::addGenericRecorder(
+            [&in_gate, &open_gate](LLError::ELevel, const std::string& message)
+            {
+                if (LLStringUtil::endsWith(message, "gate"))
+                {
+                    in_gate = true;
+                    while (!open_gate)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+        LLError::setAsyncLogging(true);
+        clearMessages();
+
+        // the writer thread holds the log mutex while it is in the gate
+        std::thread other([]() { LL_INFOS("AsyncTest") << "writer gate" << LL_ENDL; });
+        while (!in_gate)
+        {
+            std::this_thread::yield();
+        }
+        other.join();
+        std::thread opener([&open_gate]()
+                           {
+                               std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                               open_gate = true;
+                           });
+        CATCH(LL_ERRS("AsyncTest"), "while the writer is busy");
+        opener.join();
+        ensure("fatal callback called", fatalWasCalled);
+        ensure_message_field_equals(0, MSG_FIELD, "writer gate");
+        ensure_message_field_equals(1, MSG_FIELD, "while the writer is busy");
+
+        // and so does a ONCE message
+        in_gate = false;
+        open_gate = false;
+        other = std::thread([]() { LL_INFOS_ONCE("AsyncTest") << "once gate" << LL_ENDL; });
+        while (!in_gate)
+        {
+            std::this_thread::yield();
+        }
+        other.join();
+        opener = std::thread([&open_gate]()
+                             {
+                                 std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                                 open_gate = true;
+                             });
+        LL_INFOS_ONCE("AsyncTest") << "once while busy" << LL_ENDL;
+        opener.join();
+        LLError::flushAsyncLog();
+        ensure_message_count(4);
+        ensure_message_field_equals(2, MSG_FIELD, "ONCE: once gate");
+        ensure_message_field_equals(3, MSG_FIELD, "ONCE: once while busy");
+
+        LLError::setAsyncLogging(false);
+        LLError::removeRecorder(gate);
+    }
+}
+
 /* Tests left:
     handling of classes without LOG_CLASS
 
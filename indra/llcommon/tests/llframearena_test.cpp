@@ -0,0 +1,238 @@
+/**
+ * @file   llframearena_test.cpp
+ * @brief  Test for llframearena.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llframearena.h"
+
+#include "llstring.h"
+#include "../test/lltut.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace tut
+{
+    struct framearena_data
+    {
+        framearena_data()
+        {
+            // start each test from a frame boundary
+            LLFrameArena::get().reset();
+        }
+    };
+    typedef test_group<framearena_data> framearena_group;
+    typedef framearena_group::object object;
+    framearena_group framearenagrp("LLFrameArena");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("alignment and reuse");
+        LLFrameArena& arena = LLFrameArena::get();
+
+        char* first = static_cast<char*>(arena.allocate(3, 1));
+        void* aligned = arena.allocate(8);
+        ensure("default alignment", (reinterpret_cast<uintptr_t>(aligned) % LLFrameArena::ALIGNMENT) == 0);
+        void* wide = arena.allocate(8, 64);
+        ensure("requested alignment", (reinterpret_cast<uintptr_t>(wide) % 64) == 0);
+        ensure_equals("bytes used", arena.getBytesUsed(), 19);
+
+        U32 frame = arena.getFrame();
+        arena.reset();
+        ensure_equals("frame count", arena.getFrame(), frame + 1);
+        ensure_equals("used after reset", arena.getBytesUsed(), 0);
+        ensure_equals("memory reused after reset", static_cast<char*>(arena.allocate(3, 1)), first);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("a frame that spills gets one block next time");
+        LLFrameArena& arena = LLFrameArena::get();
+
+        const size_t frame_bytes = LLFrameArena::CHUNK_BYTES * 3;
+        for (size_t used = 0; used < frame_bytes; used += 1024)
+        {
+            arena.allocate(1024);
+        }
+        // one allocation larger than a block
+        void* big = arena.allocate(LLFrameArena::CHUNK_BYTES * 2);
+        memset(big, 0, LLFrameArena::CHUNK_BYTES * 2);
+        size_t used = arena.getBytesUsed();
+        arena.reset();
+        ensure("peak", arena.getPeakBytes() >= used);
+
+        size_t capacity = arena.getCapacity();
+        ensure("capacity covers the frame", capacity >= used);
+        char* start = static_cast<char*>(arena.allocate(1024));
+        for (size_t again = 1024; again < used - 1024; again += 1024)
+        {
+            arena.allocate(1024);
+        }
+        char* last = static_cast<char*>(arena.allocate(1024));
+        ensure("same frame again is contiguous", last - start < (ptrdiff_t)capacity);
+        ensure_equals("and needs no more blocks", arena.getCapacity(), capacity);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("STL adapters");
+        LLFrameArena& arena = LLFrameArena::get();
+        size_t before = arena.getBytesUsed();
+
+        LLFrameVector<U32> numbers;
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            numbers.push_back(i);
+        }
+        ensure_equals("vector contents", numbers[999], 999);
+        ensure("vector came from the arena", arena.getBytesUsed() >= before + 1000 * sizeof(U32));
+
+        LLFrameString text("a string long enough to leave the small string buffer behind");
+        text += " and then some";
+        ensure("string contents", LLStringUtil::endsWith(std::string(text.c_str()), "and then some"));
+
+        LLFrameVector<U32> copy(numbers);
+        ensure("copy shares the arena", copy.get_allocator() == numbers.get_allocator());
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("each thread has its own arena");
+        LLFrameArena* mine = &LLFrameArena::get();
+        LLFrameArena* theirs = nullptr;
+        size_t their_used = 0;
+        std::thread other([&theirs, &their_used]()
+                          {
+                              LLFrameArena& arena = LLFrameArena::get();
+                              arena.allocate(100);
+                              theirs = &arena;
+                              their_used = arena.getBytesUsed();
+                          });
+        other.join();
+        ensure("different arena", theirs != mine);
+        ensure_equals("other thread's usage", their_used, 100);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("quiet frames give the block back");
+        LLFrameArena& arena = LLFrameArena::get();
+
+        // one burst frame grows the block to eight times the default
+        const size_t burst = LLFrameArena::CHUNK_BYTES * 8;
+        arena.allocate(burst);
+        arena.reset();
+        ensure("grown", arena.getCapacity() >= burst);
+
+        // a busy frame in between starts the count again
+        for (U32 frame = 0; frame + 1 < LLFrameArena::QUIET_FRAMES; ++frame)
+        {
+            arena.allocate(1024);
+            arena.reset();
+        }
+        arena.allocate(arena.getCapacity() / 2);
+        arena.reset();
+        ensure("not shrunk after a busy frame", arena.getCapacity() >= burst);
+
+        size_t capacity = arena.getCapacity();
+        U32 halvings = 0;
+        for (U32 frame = 0; frame < LLFrameArena::QUIET_FRAMES * 8; ++frame)
+        {
+            arena.allocate(1024);
+            arena.reset();
+            if (arena.getCapacity() < capacity)
+            {
+                ensure("halved", arena.getCapacity() <= llmax(capacity / 2 + LLFrameArena::ALIGNMENT, LLFrameArena::CHUNK_BYTES));
+                ensure_equals("after enough quiet frames", (frame + 1) % LLFrameArena::QUIET_FRAMES, 0);
+                capacity = arena.getCapacity();
+                ++halvings;
+            }
+        }
+        ensure("shrank more than once", halvings > 1);
+        ensure_equals("back to one chunk", arena.getCapacity(), LLFrameArena::CHUNK_BYTES);
+        void* block = arena.allocate(1024);
+        ensure("still usable", block != nullptr);
+    }
+
+    template<> template<>
+    void object::test<6>()
+    {
+        set_test_name("scratch vectors: heap vs arena");
+        std::string env = LLStringUtil::getenv("LL_FRAME_ARENA_BENCH_FRAMES");
+        if (env.empty())
+        {
+            skip("set LL_FRAME_ARENA_BENCH_FRAMES to run");
+        }
+        size_t frames = std::stoul(env);
+
+        // per frame, a few hundred short scratch vectors like the point
+        // clouds shadow culling builds
+        const size_t VECTORS = 400, POINTS = 40;
+        U64 checksum[2] = { 0, 0 };
+        auto heap_start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (size_t v = 0; v < VECTORS; ++v)
+            {
+                std::vector<F32> points;
+                for (size_t p = 0; p < POINTS; ++p)
+                {
+                    points.push_back((F32)(p + v));
+                }
+                checksum[0] += (U64)points.back();
+            }
+        }
+        double heap_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - heap_start).count();
+
+        LLFrameArena& arena = LLFrameArena::get();
+        auto arena_start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (size_t v = 0; v < VECTORS; ++v)
+            {
+                LLFrameVector<F32> points;
+                for (size_t p = 0; p < POINTS; ++p)
+                {
+                    points.push_back((F32)(p + v));
+                }
+                checksum[1] += (U64)points.back();
+            }
+            arena.reset();
+        }
+        double arena_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - arena_start).count();
+
+        ensure_equals("same results", checksum[1], checksum[0]);
+        std::cout << "\n" << frames << " frames of " << VECTORS << " scratch vectors: heap " << heap_ms
+                  << " ms, frame arena " << arena_ms << " ms, arena capacity " << arena.getCapacity() / 1024
+                  << " KB" << std::endl;
+    }
+}
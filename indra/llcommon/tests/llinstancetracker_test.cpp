@@ -37,7 +37,13 @@
 #include <algorithm>                // std::sort()
 #include <stdexcept>
 // std headers
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
 // other Linden headers
+#include "llstring.h"
+#include "stringize.h"
 #include "../test/lltut.h"
 
 struct Badness: public std::runtime_error
@@ -69,6 +75,56 @@ struct Unkeyed: public LLInstanceTracker<Unkeyed>
     }
 };
 
+template <EInstanceTrackerRegistry REGISTRY>
+struct KeyedBy: public LLInstanceTracker<KeyedBy<REGISTRY>, std::string, LLInstanceTrackerErrorOnCollision, REGISTRY>
+{
+    using super = LLInstanceTracker<KeyedBy<REGISTRY>, std::string, LLInstanceTrackerErrorOnCollision, REGISTRY>;
+    KeyedBy(const std::string& name):
+        super(name)
+    {}
+    void rename(const std::string& name) { super::setKey(name); }
+};
+typedef KeyedBy<LLInstanceTrackerSharded> ShardedKeyed;
+
+template <EInstanceTrackerRegistry REGISTRY>
+struct UnkeyedBy: public LLInstanceTracker<UnkeyedBy<REGISTRY>, void, LLInstanceTrackerErrorOnCollision, REGISTRY>
+{
+};
+typedef UnkeyedBy<LLInstanceTrackerSharded> ShardedUnkeyed;
+
+namespace
+{
+    // Each of threads threads creates and destroys count tracked objects,
+    // a few alive at a time; returns the wall clock time in ms.
+    template <typename TRACKED>
+    double churn(size_t threads, size_t count, const std::vector<std::vector<std::string>>& keys)
+    {
+        std::atomic<bool> go{ false };
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&go, &keys, t, count]()
+                                 {
+                                     while (!go)
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                     for (size_t i = 0; i + 4 <= count; i += 4)
+                                     {
+                                         TRACKED a(keys[t][i]), b(keys[t][i + 1]), c(keys[t][i + 2]), d(keys[t][i + 3]);
+                                     }
+                                 });
+        }
+        auto start = std::chrono::steady_clock::now();
+        go = true;
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
 /*****************************************************************************
 *   TUT
 *****************************************************************************/
@@ -269,4 +325,122 @@ namespace tut
             ensure("failed to remove instance", existing.find(&ref) != existing.end());
         }
     }
+
+    template<> template<>
+    void object::test<9>()
+    {
+        set_test_name("sharded keyed instances");
+        ensure_equals(ShardedKeyed::instanceCount(), 0);
+        {
+            std::vector<std::unique_ptr<ShardedKeyed>> instances;
+            for (int i = 0; i < 100; ++i)
+            {
+                instances.emplace_back(new ShardedKeyed(stringize("key", i)));
+            }
+            ensure_equals(ShardedKeyed::instanceCount(), 100);
+            ensure_equals("found", ShardedKeyed::getInstance("key42").get(), instances[42].get());
+            ensure("not found", !ShardedKeyed::getInstance("key100"));
+
+            auto snap = ShardedKeyed::key_snapshot();
+            std::set<std::string> keys(snap.begin(), snap.end());
+            ensure_equals("every key once", keys.size(), 100);
+
+            instances[42]->rename("renamed");
+            ensure("old key gone", !ShardedKeyed::getInstance("key42"));
+            ensure_equals("new key", ShardedKeyed::getInstance("renamed").get(), instances[42].get());
+            ensure_equals(ShardedKeyed::instanceCount(), 100);
+
+            auto instance_snap = ShardedKeyed::instance_snapshot();
+            instances.erase(instances.begin(), instances.begin() + 50);
+            size_t alive = std::distance(instance_snap.begin(), instance_snap.end());
+            ensure_equals("snapshot skips deleted instances", alive, 50);
+        }
+        ensure_equals(ShardedKeyed::instanceCount(), 0);
+    }
+
+    template<> template<>
+    void object::test<10>()
+    {
+        set_test_name("sharded unkeyed instances");
+        std::set<ShardedUnkeyed*> expected;
+        {
+            ShardedUnkeyed one, two, three;
+            expected = { &one, &two, &three };
+            ensure_equals(ShardedUnkeyed::instanceCount(), 3);
+            for (auto& ref : ShardedUnkeyed::instance_snapshot())
+            {
+                ensure_equals("spurious instance", expected.erase(&ref), 1);
+            }
+            ensure_equals("unreported instance", expected.size(), 0);
+        }
+        ensure_equals(ShardedUnkeyed::instanceCount(), 0);
+    }
+
+    template<> template<>
+    void object::test<11>()
+    {
+        set_test_name("sharded snapshots while other threads churn");
+        std::vector<std::unique_ptr<ShardedKeyed>> fixed;
+        for (int i = 0; i < 32; ++i)
+        {
+            fixed.emplace_back(new ShardedKeyed(stringize("fixed", i)));
+        }
+        std::atomic<bool> stop{ false };
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t)
+        {
+            workers.emplace_back([&stop, t]()
+                                 {
+                                     for (size_t i = 0; !stop; ++i)
+                                     {
+                                         ShardedKeyed churned(stringize("churn", t, "-", i));
+                                         ShardedUnkeyed unkeyed;
+                                     }
+                                 });
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            size_t seen = 0;
+            for (auto& ref : ShardedKeyed::instance_snapshot())
+            {
+                seen += (ref.getKey().compare(0, 5, "fixed") == 0);
+            }
+            ensure_equals("every long lived instance in every snapshot", seen, 32);
+        }
+        stop = true;
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        ensure_equals(ShardedKeyed::instanceCount(), 32);
+        ensure_equals(ShardedUnkeyed::instanceCount(), 0);
+    }
+
+    template<> template<>
+    void object::test<12>()
+    {
+        set_test_name("contention benchmark");
+        std::string env = LLStringUtil::getenv("LL_INSTANCETRACKER_BENCH_OBJECTS");
+        if (env.empty())
+        {
+            skip("set LL_INSTANCETRACKER_BENCH_OBJECTS to run");
+        }
+        size_t count = std::stoul(env);
+        size_t threads = llmax(4U, std::thread::hardware_concurrency());
+        std::vector<std::vector<std::string>> keys(threads);
+        for (size_t t = 0; t < threads; ++t)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                keys[t].push_back(stringize(t, "-", i));
+            }
+        }
+
+        double locked = churn<KeyedBy<LLInstanceTrackerLocked>>(threads, count, keys);
+        double sharded = churn<KeyedBy<LLInstanceTrackerSharded>>(threads, count, keys);
+        std::cout << "\n" << threads << " threads creating and destroying " << count
+                  << " keyed instances each: locked " << locked << " ms, sharded " << sharded << " ms" << std::endl;
+        ensure_equals(KeyedBy<LLInstanceTrackerLocked>::instanceCount(), 0);
+        ensure_equals(ShardedKeyed::instanceCount(), 0);
+    }
 } // namespace tut
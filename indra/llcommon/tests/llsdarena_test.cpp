@@ -0,0 +1,282 @@
+/**
+ * @file   llsdarena_test.cpp
+ * @brief  Test for llsdarena.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llsdarena.h"
+// STL headers
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+// other Linden headers
+#include "../test/lltut.h"
+#include "llsd.h"
+#include "llsdserialize.h"
+#include "llsdutil.h"
+#include "lluuid.h"
+#include "stringize.h"
+
+namespace
+{
+    LLUUID make_id(U32 seed)
+    {
+        LLUUID id;
+        U32 state = seed * 2654435761u + 0x9E3779B9u;
+        for (U32 i = 0; i < UUID_BYTES; ++i)
+        {
+            state = state * 1103515245u + 12345u;
+            id.mData[i] = (U8)(state >> 24);
+        }
+        return id;
+    }
+
+    // Shaped like an AIS3 recursive category fetch: nested categories with
+    // their items and links embedded.
+    LLSD make_inventory_response(U32 item_count)
+    {
+        const U32 items_per_folder = 25;
+        LLSD categories = LLSD::emptyMap();
+        LLUUID root_id = make_id(0);
+        for (U32 folder = 0; folder * items_per_folder < item_count; ++folder)
+        {
+            LLUUID cat_id = make_id(folder + 1);
+            LLSD items = LLSD::emptyMap();
+            for (U32 i = folder * items_per_folder; i < llmin((folder + 1) * items_per_folder, item_count); ++i)
+            {
+                LLUUID item_id = make_id(1000000 + i);
+                LLSD item;
+                item["item_id"] = item_id;
+                item["parent_id"] = cat_id;
+                item["asset_id"] = make_id(2000000 + i);
+                item["name"] = STRINGIZE("Item " << i);
+                item["desc"] = (i % 3) ? std::string() : STRINGIZE("A somewhat longer description for item " << i);
+                item["type"] = (LLSD::Integer)(i % 20);
+                item["inv_type"] = (LLSD::Integer)(i % 18);
+                item["flags"] = (LLSD::Integer)0;
+                item["created_at"] = (LLSD::Integer)(1700000000 + i);
+                LLSD& perms = item["permissions"];
+                perms["owner_id"] = root_id;
+                perms["creator_id"] = make_id(3000000 + (i % 50));
+                perms["base_mask"] = (LLSD::Integer)0x7fffffff;
+                perms["owner_mask"] = (LLSD::Integer)0x7fffffff;
+                perms["group_mask"] = (LLSD::Integer)0;
+                perms["everyone_mask"] = (LLSD::Integer)0;
+                perms["next_owner_mask"] = (LLSD::Integer)0x82000;
+                LLSD& sale = item["sale_info"];
+                sale["sale_price"] = (LLSD::Integer)10;
+                sale["sale_type"] = (LLSD::Integer)0;
+                items[item_id.asString()] = item;
+            }
+            LLSD cat;
+            cat["category_id"] = cat_id;
+            cat["parent_id"] = root_id;
+            cat["name"] = STRINGIZE("Folder " << folder);
+            cat["type_default"] = (LLSD::Integer)-1;
+            cat["version"] = (LLSD::Integer)(folder + 3);
+            cat["_embedded"]["items"] = items;
+            cat["_embedded"]["links"] = LLSD::emptyMap();
+            categories[cat_id.asString()] = cat;
+        }
+
+        LLSD response;
+        response["category_id"] = root_id;
+        response["name"] = "My Inventory";
+        response["version"] = (LLSD::Integer)42;
+        response["_embedded"]["categories"] = categories;
+        return response;
+    }
+
+    // Shaped like a GetObjectCost reply: a map of object IDs to a handful
+    // of reals.
+    LLSD make_object_cost_response(U32 object_count)
+    {
+        LLSD response = LLSD::emptyMap();
+        for (U32 i = 0; i < object_count; ++i)
+        {
+            LLSD& entry = response[make_id(i).asString()];
+            entry["linked_set_resource_cost"] = 1.5 + i % 7;
+            entry["resource_cost"] = 0.5 + i % 3;
+            entry["physics_cost"] = 0.25 * (i % 5);
+            entry["linked_set_physics_cost"] = 0.1 * (i % 11);
+            entry["resource_limiting_type"] = "legacy";
+        }
+        return response;
+    }
+
+    std::string to_xml(const LLSD& sd)
+    {
+        std::ostringstream out;
+        LLSDSerialize::toXML(sd, out);
+        return out.str();
+    }
+
+    LLSD parse_xml(const std::string& xml, bool use_arena)
+    {
+        LLSDArena::setParseArenaEnabled(use_arena);
+        LLSD result;
+        std::istringstream in(xml);
+        LLSDSerialize::fromXML(result, in);
+        LLSDArena::setParseArenaEnabled(false);
+        return result;
+    }
+}
+
+namespace tut
+{
+    struct llsdarena_data
+    {
+        llsdarena_data()
+        {
+            LLSDArena::setParseArenaEnabled(false);
+        }
+    };
+    typedef test_group<llsdarena_data> llsdarena_group;
+    typedef llsdarena_group::object object;
+    llsdarena_group llsdarenagrp("llsdarena");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("chunks live as long as their values");
+        const S32 baseline = LLSDArena::getLiveChunkCount();
+        LLSD kept;
+        {
+            LLSD tree;
+            {
+                LLSDArena arena;
+                for (S32 i = 0; i < 5000; ++i)
+                {
+                    tree[STRINGIZE("key" << i)] = STRINGIZE("value" << i);
+                }
+                ensure("arena chunks in use", LLSDArena::getLiveChunkCount() > baseline);
+            }
+            ensure("chunks outlive the arena", LLSDArena::getLiveChunkCount() > baseline);
+            kept = tree["key42"];
+        }
+        ensure_equals("kept value", kept.asString(), std::string("value42"));
+        ensure_equals("only the kept value's chunk remains", LLSDArena::getLiveChunkCount(), baseline + 1);
+        kept.clear();
+        ensure_equals("all chunks freed", LLSDArena::getLiveChunkCount(), baseline);
+
+        // Nothing goes to an arena without one open.
+        LLSD heap_only;
+        for (S32 i = 0; i < 100; ++i)
+        {
+            heap_only.append(i);
+        }
+        ensure_equals("no arena, no chunks", LLSDArena::getLiveChunkCount(), baseline);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("same tree with and without arena");
+        LLSD inventory = make_inventory_response(2000);
+        LLSD costs = make_object_cost_response(2000);
+        for (const LLSD& source : { inventory, costs })
+        {
+            std::string xml = to_xml(source);
+            LLSD plain = parse_xml(xml, false);
+            LLSD arena = parse_xml(xml, true);
+            ensure("plain parse matches", llsd_equals(plain, source));
+            ensure("arena parse matches", llsd_equals(arena, plain));
+
+            // Values from an arena are ordinary values afterwards.
+            LLSD& cat = arena["_embedded"]["categories"];
+            cat["added"] = "after the parse";
+            arena.erase("name");
+            ensure_equals("modified", cat["added"].asString(), std::string("after the parse"));
+        }
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("values freed on another thread");
+        const S32 baseline = LLSDArena::getLiveChunkCount();
+        LLSD response = parse_xml(to_xml(make_object_cost_response(3000)), true);
+        ensure("parse used chunks", LLSDArena::getLiveChunkCount() > baseline);
+
+        std::vector<LLSD> halves(2);
+        for (LLSD::map_const_iterator it = response.beginMap(); it != response.endMap(); ++it)
+        {
+            halves[it->first[0] < '8' ? 0 : 1][it->first] = it->second;
+        }
+        response.clear();
+
+        std::thread first([&halves]() { halves[0].clear(); });
+        std::thread second([&halves]() { halves[1].clear(); });
+        first.join();
+        second.join();
+        ensure_equals("all chunks freed", LLSDArena::getLiveChunkCount(), baseline);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("parse benchmark");
+        // Not a pass/fail test: reports the best of several parses of the
+        // same documents with and without the arena, teardown included.
+        std::string env = LLStringUtil::getenv("LL_LLSD_ARENA_BENCH_ITEMS");
+        if (env.empty())
+        {
+            skip("set LL_LLSD_ARENA_BENCH_ITEMS to run");
+        }
+        U32 count = llmax((U32)std::stoul(env), 10U);
+
+        using clock = std::chrono::steady_clock;
+        auto best_of = [](const std::string& xml, bool use_arena)
+        {
+            auto best = clock::duration::max();
+            for (S32 pass = 0; pass < 5; ++pass)
+            {
+                auto start = clock::now();
+                {
+                    LLSD result = parse_xml(xml, use_arena);
+                }
+                best = std::min(best, clock::now() - start);
+            }
+            return std::chrono::duration<F64, std::milli>(best).count();
+        };
+
+        const std::pair<const char*, LLSD> documents[] = {
+            { "inventory", make_inventory_response(count) },
+            { "object cost", make_object_cost_response(count) },
+        };
+        std::cout << "\nllsdarena: " << count << " entries, best of 5 XML parses\n";
+        for (const auto& document : documents)
+        {
+            std::string xml = to_xml(document.second);
+            F64 heap_ms = best_of(xml, false);
+            F64 arena_ms = best_of(xml, true);
+            std::cout << "  " << document.first << " (" << xml.size() / 1024 << " KB): heap "
+                      << heap_ms << " ms, arena " << arena_ms << " ms" << std::endl;
+        }
+    }
+} // namespace tut
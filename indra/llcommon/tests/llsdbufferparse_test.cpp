@@ -0,0 +1,629 @@
+/**
+ * @file   llsdbufferparse_test.cpp
+ * @brief  Test for LLSDParser::parseBuffer() and llbytescan.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llsdserialize.h"
+// STL headers
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+// other Linden headers
+#include "../test/lltut.h"
+#include "llbytescan.h"
+#include "lldate.h"
+#include "llsd.h"
+#include "llsdutil.h"
+#include "lluri.h"
+#include "lluuid.h"
+#include "stringize.h"
+
+namespace
+{
+    // Exposes the buffer parsers on their own, without the fallback to the
+    // stream parsers that parseBuffer() adds.
+    class BufferOnlyNotationParser : public LLSDNotationParser
+    {
+    public:
+        S32 parseOnly(const std::string& doc, LLSD& sd) const
+        {
+            return doParseBuffer(doc.data(), doc.size(), sd, -1);
+        }
+    };
+
+    class BufferOnlyXMLParser : public LLSDXMLParser
+    {
+    public:
+        BufferOnlyXMLParser() : LLSDXMLParser(false) {}
+        S32 parseOnly(const std::string& doc, LLSD& sd) const
+        {
+            return doParseBuffer(doc.data(), doc.size(), sd, -1);
+        }
+    };
+
+    struct Outcome
+    {
+        S32     mCount{ LLSDParser::PARSE_FAILURE };
+        LLSD    mData;
+        bool    mThrew{ false };
+
+        bool operator==(const Outcome& other) const
+        {
+            return mCount == other.mCount && llsd_equals(mData, other.mData);
+        }
+    };
+
+    template<typename PARSE>
+    Outcome run(PARSE parse)
+    {
+        Outcome outcome;
+        try
+        {
+            outcome.mCount = parse(outcome.mData);
+        }
+        catch (const std::exception&)
+        {
+            outcome.mThrew = true;
+        }
+        return outcome;
+    }
+
+    enum EFormat
+    {
+        NOTATION,
+        XML
+    };
+
+    Outcome parse_stream(EFormat format, const std::string& doc)
+    {
+        return run([&](LLSD& sd)
+        {
+            std::istringstream in(doc);
+            return format == NOTATION ? LLSDSerialize::fromNotation(sd, in, doc.size())
+                                      : LLSDSerialize::fromXML(sd, in, false);
+        });
+    }
+
+    Outcome parse_buffer(EFormat format, const std::string& doc)
+    {
+        return run([&](LLSD& sd)
+        {
+            return format == NOTATION ? LLSDSerialize::fromNotationBuffer(sd, doc.data(), doc.size())
+                                      : LLSDSerialize::fromXMLBuffer(sd, doc.data(), doc.size(), false);
+        });
+    }
+
+    Outcome parse_buffer_only(EFormat format, const std::string& doc)
+    {
+        return run([&](LLSD& sd)
+        {
+            if (format == NOTATION)
+            {
+                LLPointer<BufferOnlyNotationParser> parser = new BufferOnlyNotationParser;
+                return parser->parseOnly(doc, sd);
+            }
+            LLPointer<BufferOnlyXMLParser> parser = new BufferOnlyXMLParser;
+            return parser->parseOnly(doc, sd);
+        });
+    }
+
+    // Deterministic, so a failure can be replayed from its seed.
+    class Random
+    {
+    public:
+        explicit Random(U32 seed) : mState(seed * 2654435761u + 1) {}
+        U32 next()
+        {
+            mState = mState * 1103515245u + 12345u;
+            return mState >> 8;
+        }
+        U32 below(U32 n)
+        {
+            return next() % n;
+        }
+
+    private:
+        U32 mState;
+    };
+
+    // Text that exercises both escapers: quotes, backslashes, markup,
+    // entities, line ends and multibyte UTF-8.
+    std::string random_text(Random& random)
+    {
+        static const char* pieces[] = {
+            "a", "Z", "9", " ", "  ", "key", "name", "\"", "'", "\\", "\\x41", "<", ">", "&", "&amp;",
+            "]", "]]>", ":", ",", "{", "}", "[", "]", "\n", "\r", "\r\n", "\t", "\xc3\xa9",
+            "\xe2\x82\xac", "\xf0\x9f\x98\x80", "s(3)", "i42", "r1.5", "?", "!", "0", "1"
+        };
+        std::string text;
+        const U32 count = random.below(12);
+        for (U32 i = 0; i < count; ++i)
+        {
+            text += pieces[random.below(LL_ARRAY_SIZE(pieces))];
+        }
+        return text;
+    }
+
+    LLSD random_llsd(Random& random, S32 depth)
+    {
+        switch (random.below(depth > 0 ? 13 : 11))
+        {
+        case 0:
+            return LLSD();
+        case 1:
+            return LLSD(random.below(2) == 1);
+        case 2:
+        {
+            static const LLSD::Integer edges[] = { 0, 1, -1, 2147483647, -2147483647 - 1 };
+            if (random.below(4) == 0)
+            {
+                return edges[random.below(LL_ARRAY_SIZE(edges))];
+            }
+            return static_cast<LLSD::Integer>(random.next()) - 0x400000;
+        }
+        case 3:
+        {
+            static const LLSD::Real edges[] = { 0.0, -0.0, 1.0, -2.5, 1e-300, 1e300, 3.14159265358979, 0.1 };
+            if (random.below(4) == 0)
+            {
+                return edges[random.below(LL_ARRAY_SIZE(edges))];
+            }
+            return (static_cast<F64>(random.next()) - 0x800000) / (1 + random.below(100000));
+        }
+        case 4:
+        case 5:
+            return random_text(random);
+        case 6:
+        {
+            LLUUID id;
+            for (U32 i = 0; i < UUID_BYTES; ++i)
+            {
+                id.mData[i] = static_cast<U8>(random.next());
+            }
+            return random.below(5) ? LLSD(id) : LLSD(LLUUID::null);
+        }
+        case 7:
+            return LLDate(static_cast<F64>(random.below(2000000000)));
+        case 8:
+            // The notation formatter writes URIs unescaped.
+            return LLURI(STRINGIZE("http://example.com/" << random.next()));
+        case 9:
+        case 10:
+        {
+            // Binary under 16 bytes never spells "b16" when a mutation
+            // drops the '(' of its length; see test 5.
+            LLSD::Binary binary(random.below(16));
+            for (U8& byte : binary)
+            {
+                byte = static_cast<U8>(random.next());
+            }
+            return binary;
+        }
+        case 11:
+        {
+            LLSD map = LLSD::emptyMap();
+            const U32 count = random.below(6);
+            for (U32 i = 0; i < count; ++i)
+            {
+                map[random_text(random)] = random_llsd(random, depth - 1);
+            }
+            return map;
+        }
+        default:
+        {
+            LLSD array = LLSD::emptyArray();
+            const U32 count = random.below(6);
+            for (U32 i = 0; i < count; ++i)
+            {
+                array.append(random_llsd(random, depth - 1));
+            }
+            return array;
+        }
+        }
+    }
+
+    typedef std::function<void(const LLSD&, std::ostream&)> formatter_t;
+    struct Serializer
+    {
+        const char* mName;
+        EFormat     mFormat;
+        formatter_t mFormatter;
+    };
+
+    const Serializer SERIALIZERS[] = {
+        { "notation", NOTATION, [](const LLSD& sd, std::ostream& out) { LLSDSerialize::toNotation(sd, out); } },
+        { "pretty notation", NOTATION, [](const LLSD& sd, std::ostream& out) { LLSDSerialize::toPrettyNotation(sd, out); } },
+        { "pretty binary notation", NOTATION, [](const LLSD& sd, std::ostream& out) { LLSDSerialize::toPrettyBinaryNotation(sd, out); } },
+        { "xml", XML, [](const LLSD& sd, std::ostream& out) { LLSDSerialize::toXML(sd, out); } },
+        { "pretty xml", XML, [](const LLSD& sd, std::ostream& out) { LLSDSerialize::toPrettyXML(sd, out); } },
+    };
+
+    std::string serialize(const Serializer& serializer, const LLSD& sd)
+    {
+        std::ostringstream out;
+        serializer.mFormatter(sd, out);
+        return out.str();
+    }
+
+    LLUUID make_id(U32 seed)
+    {
+        LLUUID id;
+        U32 state = seed * 2654435761u + 0x9E3779B9u;
+        for (U32 i = 0; i < UUID_BYTES; ++i)
+        {
+            state = state * 1103515245u + 12345u;
+            id.mData[i] = (U8)(state >> 24);
+        }
+        return id;
+    }
+
+    // Shaped like an AIS3 recursive category fetch.
+    LLSD make_inventory_response(U32 item_count)
+    {
+        const U32 items_per_folder = 25;
+        LLSD categories = LLSD::emptyMap();
+        LLUUID root_id = make_id(0);
+        for (U32 folder = 0; folder * items_per_folder < item_count; ++folder)
+        {
+            LLUUID cat_id = make_id(folder + 1);
+            LLSD items = LLSD::emptyMap();
+            for (U32 i = folder * items_per_folder; i < llmin((folder + 1) * items_per_folder, item_count); ++i)
+            {
+                LLUUID item_id = make_id(1000000 + i);
+                LLSD item;
+                item["item_id"] = item_id;
+                item["parent_id"] = cat_id;
+                item["asset_id"] = make_id(2000000 + i);
+                item["name"] = STRINGIZE("Item " << i << " & friends");
+                item["desc"] = (i % 3) ? std::string() : STRINGIZE("A somewhat longer description for item " << i);
+                item["type"] = (LLSD::Integer)(i % 20);
+                item["inv_type"] = (LLSD::Integer)(i % 18);
+                item["flags"] = (LLSD::Integer)0;
+                item["created_at"] = (LLSD::Integer)(1700000000 + i);
+                LLSD& perms = item["permissions"];
+                perms["owner_id"] = root_id;
+                perms["creator_id"] = make_id(3000000 + (i % 50));
+                perms["base_mask"] = (LLSD::Integer)0x7fffffff;
+                perms["owner_mask"] = (LLSD::Integer)0x7fffffff;
+                perms["group_mask"] = (LLSD::Integer)0;
+                perms["everyone_mask"] = (LLSD::Integer)0;
+                perms["next_owner_mask"] = (LLSD::Integer)0x82000;
+                LLSD& sale = item["sale_info"];
+                sale["sale_price"] = (LLSD::Real)10.0;
+                sale["sale_type"] = (LLSD::Integer)0;
+                items[item_id.asString()] = item;
+            }
+            LLSD cat;
+            cat["category_id"] = cat_id;
+            cat["parent_id"] = root_id;
+            cat["name"] = STRINGIZE("Folder " << folder);
+            cat["type_default"] = (LLSD::Integer)-1;
+            cat["version"] = (LLSD::Integer)(folder + 3);
+            cat["_embedded"]["items"] = items;
+            cat["_embedded"]["links"] = LLSD::emptyMap();
+            categories[cat_id.asString()] = cat;
+        }
+
+        LLSD response;
+        response["category_id"] = root_id;
+        response["name"] = "My Inventory";
+        response["version"] = (LLSD::Integer)42;
+        response["_embedded"]["categories"] = categories;
+        return response;
+    }
+}
+
+namespace tut
+{
+    struct llsdbufferparse_data
+    {
+        llsdbufferparse_data()
+        {
+            LLSDParser::setBufferParseEnabled(true);
+        }
+
+        void ensure_same(const std::string& what, EFormat format, const std::string& doc)
+        {
+            Outcome stream = parse_stream(format, doc);
+            if (stream.mThrew)
+            {
+                return;
+            }
+            Outcome buffer = parse_buffer(format, doc);
+            ensure(STRINGIZE(what << ": parseBuffer() matches the stream parser"), buffer == stream);
+        }
+    };
+    typedef test_group<llsdbufferparse_data> llsdbufferparse_group;
+    typedef llsdbufferparse_group::object object;
+    llsdbufferparse_group llsdbufferparsegrp("llsdbufferparse");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("byte scans");
+        // Every hit position, both sides of each 16 byte boundary.
+        const char hits[] = { '"', '\\', '<', '&', ']', '\r', '\x01', '\x1f', '\x80', '\xff' };
+        for (size_t length = 0; length < 50; ++length)
+        {
+            for (size_t at = 0; at <= length; ++at)
+            {
+                for (char hit : hits)
+                {
+                    std::string text(length, 'x');
+                    for (size_t i = 0; i < length; i += 7)
+                    {
+                        text[i] = (i % 2) ? '\t' : '\n';
+                    }
+                    if (at < length)
+                    {
+                        text[at] = hit;
+                    }
+                    const char* begin = text.data();
+                    const char* end = begin + length;
+
+                    const char* expected = end;
+                    if (at < length && (hit == '"' || hit == '\\'))
+                    {
+                        expected = begin + at;
+                    }
+                    ensure_equals(STRINGIZE("find_first_of " << length << '/' << at),
+                                  ll_find_first_of(begin, end, '"', '\\') - begin, expected - begin);
+
+                    expected = at < length && hit != '"' && hit != '\\' ? begin + at : end;
+                    ensure_equals(STRINGIZE("find_first_of_or_unprintable " << length << '/' << at),
+                                  ll_find_first_of_or_unprintable(begin, end, '<', '&', ']', '\r') - begin,
+                                  expected - begin);
+                }
+            }
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("hand written documents");
+        // Accepted by the buffer parsers themselves.
+        const char* notation[] = {
+            "", "   ", "!", "0", "1", "t", "TRUE", "f", "false", "i0", "i-2147483648", "i 17", "i+5",
+            "r0", "r-1.5e+10", "r.5", "r1.", "r 1e-400", "u6f1b7c2e-3b8f-4c1a-9d2e-0f1a2b3c4d5e",
+            "'single'", "\"double\"", "'esc\\a\\b\\f\\n\\r\\t\\v\\x41\\q'", "s(5)\"raw\"!\"", "s(0x3)'abc'",
+            "l\"http://example.com/\"", "d\"2026-01-02T03:04:05Z\"", "b(3)\"abc\"", "b64\"YWJj\"",
+            "b16\"616263\"", "b16\"\"", "{}", "[]", "{'a':i1,'b':[i2,'x',!]}", "{ 'a' : i1 , 'a' : i2 }",
+            "{x'a'i1}", "{'a':i1,s(0)\"\":i2}", "[i1 i2,,i3]", "i1 trailing", "{'a':{'b':{'c':[{}]}}}",
+        };
+        for (const char* doc : notation)
+        {
+            Outcome stream = parse_stream(NOTATION, doc);
+            Outcome buffer = parse_buffer_only(NOTATION, doc);
+            ensure(STRINGIZE("notation '" << doc << "' parsed in place"), buffer.mCount != LLSDParser::PARSE_FAILURE);
+            ensure(STRINGIZE("notation '" << doc << "' matches"), buffer == stream);
+        }
+
+        const char* xml[] = {
+            "<llsd><integer>5</integer></llsd>",
+            "<?xml version=\"1.0\" ?>\n<llsd><string>a</string></llsd>",
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n<llsd>\r\n<array><string>x\r\ny\rz</string></array></llsd>\r\n",
+            "<?xml version='1.0' encoding='utf-8'?><llsd><string>\xc3\xa9</string></llsd>",
+            "<?xml version=\"1.0\" encoding=\"US-ASCII\" standalone=\"yes\"?><llsd><integer>1</integer></llsd>",
+            "<llsd><map><key>k&amp;&lt;&gt;&quot;&apos;</key><string>&#65;&#x42;&#xe9;&#x1F600;</string></map></llsd>",
+            "<llsd><binary encoding=\"base64\">YW\n Jj</binary></llsd>",
+            "<llsd><binary encoding='base16'>00</binary></llsd>",
+            "<llsd><map><key>a</key><integer>1</integer><key>a</key><integer>2</integer></map></llsd>",
+            "<llsd><map><integer>1</integer><key>b</key><foo>x</foo></map></llsd>",
+            "<llsd><string>a<b/>c</string></llsd>",
+            "<llsd><boolean>true</boolean></llsd> junk <after",
+            "<llsd><uuid /><undef/><date>2026-01-02T03:04:05Z</date><uri>http://x/</uri></llsd>",
+            "<llsd><string>\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80]]</string></llsd>",
+        };
+        for (const char* doc : xml)
+        {
+            Outcome stream = parse_stream(XML, doc);
+            Outcome buffer = parse_buffer_only(XML, doc);
+            ensure(STRINGIZE("xml '" << doc << "' parsed in place"), buffer.mCount != LLSDParser::PARSE_FAILURE);
+            ensure(STRINGIZE("xml '" << doc << "' matches"), buffer == stream);
+        }
+
+        // Turned down by the buffer parsers; parseBuffer() must still agree
+        // with the stream parsers, failures included.
+        const char* notation_fallback[] = {
+            "{", "[i1", "'open", "i", "i2147483648", "r", "r1e", "r1e999", "u1234", "s(9)'abc'", "b(9)\"abc\"",
+            "b64\"\"", "tru", "x", "{'a'}",
+        };
+        for (const char* doc : notation_fallback)
+        {
+            ensure_same(STRINGIZE("notation '" << doc << "'"), NOTATION, doc);
+        }
+        const char* xml_fallback[] = {
+            "", "<llsd>", "<llsd><integer>1</integer>", "<llsd><string>a</integer></llsd>",
+            "<!-- comment --><llsd><integer>1</integer></llsd>", "<llsd><![CDATA[x]]></llsd>",
+            "<llsd><string>&unknown;</string></llsd>", "<llsd><string>&#0;</string></llsd>",
+            "<llsd><string>\x01</string></llsd>", "<llsd><string>\xc3</string></llsd>",
+            "<llsd><string>]]></string></llsd>", "<a/><llsd><integer>1</integer></llsd>",
+            "<root><llsd><real>1.5</real></llsd>", "\xef\xbb\xbf<llsd><integer>1</integer></llsd>",
+            "<llsd a='1' a='2'><integer>1</integer></llsd>", "<foo/>",
+            "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><llsd><string>\xe9</string></llsd>",
+        };
+        for (const char* doc : xml_fallback)
+        {
+            ensure_same(STRINGIZE("xml '" << doc << "'"), XML, doc);
+        }
+
+        // Declared in something other than UTF-8: left to expat even when the
+        // bytes happen to be valid UTF-8, as \xc3\xa9 is two characters in
+        // ISO-8859-1.
+        const char* xml_other_encoding[] = {
+            "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><llsd><string>\xc3\xa9</string></llsd>",
+            "<?xml version=\"1.0\" encoding=\"windows-1252\"?><llsd><integer>1</integer></llsd>",
+            "<?xml version=\"1.0\" encoding=\"UTF-16\"?><llsd><integer>1</integer></llsd>",
+        };
+        for (const char* doc : xml_other_encoding)
+        {
+            ensure_equals(STRINGIZE("xml '" << doc << "' not parsed in place"), parse_buffer_only(XML, doc).mCount, LLSDParser::PARSE_FAILURE);
+            ensure_same(STRINGIZE("xml '" << doc << "'"), XML, doc);
+        }
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("random documents parse the same");
+        U32 parsed_in_place = 0;
+        U32 total = 0;
+        for (U32 seed = 0; seed < 400; ++seed)
+        {
+            Random random(seed);
+            const LLSD source = random_llsd(random, 4);
+            for (const Serializer& serializer : SERIALIZERS)
+            {
+                const std::string doc = serialize(serializer, source);
+                const std::string what = STRINGIZE(serializer.mName << " seed " << seed);
+                Outcome stream = parse_stream(serializer.mFormat, doc);
+                ensure(what + " stream parse", !stream.mThrew && stream.mCount != LLSDParser::PARSE_FAILURE);
+                Outcome buffer = parse_buffer_only(serializer.mFormat, doc);
+                ensure(what + " matches", buffer.mCount == LLSDParser::PARSE_FAILURE || buffer == stream);
+                ensure(what + " parseBuffer() matches", parse_buffer(serializer.mFormat, doc) == stream);
+                ++total;
+                if (buffer.mCount != LLSDParser::PARSE_FAILURE)
+                {
+                    ++parsed_in_place;
+                }
+            }
+        }
+        // The XML formatter lets some control characters through, which
+        // expat rejects; everything else is taken in place.
+        ensure("most documents parsed in place", parsed_in_place * 10 > total * 9);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("buffer parse off");
+        LLSDParser::setBufferParseEnabled(false);
+        Random random(7);
+        const LLSD source = random_llsd(random, 4);
+        for (const Serializer& serializer : SERIALIZERS)
+        {
+            const std::string doc = serialize(serializer, source);
+            ensure(serializer.mName, parse_buffer(serializer.mFormat, doc) == parse_stream(serializer.mFormat, doc));
+        }
+        LLSDParser::setBufferParseEnabled(true);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("mutated documents parse the same");
+        // Bytes that matter to one format or the other. No digits, so a
+        // mutation cannot grow a binary length into a huge allocation.
+        static const char inserts[] = "{}[]'\":,\\<>/&;#x ]\n\r!tfiru";
+        U32 decided_in_place = 0;
+        U32 total = 0;
+        for (U32 seed = 0; seed < 3000; ++seed)
+        {
+            Random random(seed);
+            const LLSD source = random_llsd(random, 3);
+            const Serializer& serializer = SERIALIZERS[random.below(LL_ARRAY_SIZE(SERIALIZERS))];
+            std::string doc = serialize(serializer, source);
+            const U32 mutations = 1 + random.below(3);
+            for (U32 i = 0; i < mutations && !doc.empty(); ++i)
+            {
+                const size_t at = random.below(static_cast<U32>(doc.size()));
+                switch (random.below(5))
+                {
+                case 0: doc.erase(at, 1); break;
+                case 1: doc.insert(at, 1, doc[at]); break;
+                case 2: doc.insert(at, 1, inserts[random.below(sizeof(inserts) - 1)]); break;
+                case 3: doc[at] = inserts[random.below(sizeof(inserts) - 1)]; break;
+                default: doc.resize(at); break;
+                }
+            }
+            if (serializer.mFormat == NOTATION && doc.find("b16") != std::string::npos)
+            {
+                // Unterminated b16 data loops forever in the stream parser.
+                continue;
+            }
+
+            const std::string what = STRINGIZE(serializer.mName << " mutation seed " << seed);
+            Outcome stream = parse_stream(serializer.mFormat, doc);
+            if (stream.mThrew)
+            {
+                continue;
+            }
+            Outcome buffer = parse_buffer_only(serializer.mFormat, doc);
+            ++total;
+            if (buffer.mCount != LLSDParser::PARSE_FAILURE)
+            {
+                ++decided_in_place;
+                ensure(what + " matches", buffer == stream);
+            }
+            ensure(what + " parseBuffer() matches", parse_buffer(serializer.mFormat, doc) == stream);
+        }
+        std::cout << "\nllsdbufferparse: " << decided_in_place << " of " << total
+                  << " mutated documents parsed in place" << std::endl;
+    }
+
+    template<> template<>
+    void object::test<6>()
+    {
+        set_test_name("parse throughput");
+        // Not a pass/fail test: best of several parses of the same document
+        // through the stream parsers and in place.
+        std::string env = LLStringUtil::getenv("LL_LLSD_BUFFER_PARSE_BENCH_ITEMS");
+        if (env.empty())
+        {
+            skip("set LL_LLSD_BUFFER_PARSE_BENCH_ITEMS to run");
+        }
+        U32 count = llmax((U32)std::stoul(env), 10U);
+
+        using clock = std::chrono::steady_clock;
+        auto best_of = [](const std::function<void()>& parse)
+        {
+            auto best = clock::duration::max();
+            for (S32 pass = 0; pass < 5; ++pass)
+            {
+                auto start = clock::now();
+                parse();
+                best = std::min(best, clock::now() - start);
+            }
+            return std::chrono::duration<F64>(best).count();
+        };
+
+        const LLSD source = make_inventory_response(count);
+        std::cout << "\nllsdbufferparse: " << count << " inventory items, best of 5 parses\n";
+        for (const Serializer& serializer : SERIALIZERS)
+        {
+            const std::string doc = serialize(serializer, source);
+            const F64 stream_secs = best_of([&]() { parse_stream(serializer.mFormat, doc); });
+            const F64 buffer_secs = best_of([&]() { parse_buffer(serializer.mFormat, doc); });
+            const F64 megabytes = doc.size() / (1024.0 * 1024.0);
+            std::cout << "  " << serializer.mName << " (" << doc.size() / 1024 << " KB): stream "
+                      << megabytes / stream_secs << " MB/s, buffer " << megabytes / buffer_secs << " MB/s" << std::endl;
+        }
+    }
+} // namespace tut
@@ -0,0 +1,300 @@
+/**
+ * @file   llsdjson_test.cpp
+ * @brief  Test for llsdjson.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llsdjson.h"
+// STL headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <sstream>
+// other Linden headers
+#include "../test/lltut.h"
+#include "lldate.h"
+#include "llsd.h"
+#include "llsdutil.h"
+#include "lluri.h"
+#include "lluuid.h"
+#include "stringize.h"
+
+namespace
+{
+    LLUUID make_id(U32 seed)
+    {
+        LLUUID id;
+        U32 state = seed * 2654435761u + 0x9E3779B9u;
+        for (U32 i = 0; i < UUID_BYTES; ++i)
+        {
+            state = state * 1103515245u + 12345u;
+            id.mData[i] = (U8)(state >> 24);
+        }
+        return id;
+    }
+
+    // Every type JSON can carry, with the strings that need escaping.
+    LLSD make_sample()
+    {
+        LLSD sample;
+        sample["string"] = "plain text";
+        sample["escapes"] = std::string("quote\" backslash\\ slash/ \b\f\n\r\t \x01\x1f del\x7f") + std::string(1, '\0');
+        sample["utf8"] = "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";
+        sample[""] = "empty key";
+        sample["key \"with\" quotes"] = true;
+        sample["false"] = false;
+        sample["undef"] = LLSD();
+        sample["int"] = 42;
+        sample["int min"] = (LLSD::Integer)(-2147483647 - 1);
+        sample["int max"] = (LLSD::Integer)2147483647;
+        sample["real"] = 0.1;
+        sample["whole real"] = 3.0;
+        sample["negative zero"] = -0.0;
+        sample["tiny"] = 5e-324;
+        sample["huge"] = -1.7976931348623157e308;
+        sample["uuid"] = make_id(7);
+        sample["date"] = LLDate(1700000000.5);
+        sample["uri"] = LLURI("http://example.com/a?b=\"c\"");
+        sample["empty map"] = LLSD::emptyMap();
+        sample["empty array"] = LLSD::emptyArray();
+        LLSD& nested = sample["nested"];
+        for (S32 i = 0; i < 5; ++i)
+        {
+            LLSD entry;
+            entry["index"] = i;
+            entry["list"].append(i * 0.25);
+            entry["list"].append(STRINGIZE("item " << i));
+            nested.append(entry);
+        }
+        return sample;
+    }
+
+    // Shaped like a web profile or search reply: a long array of records.
+    LLSD make_large_payload(U32 count)
+    {
+        LLSD results = LLSD::emptyArray();
+        for (U32 i = 0; i < count; ++i)
+        {
+            LLSD record;
+            record["id"] = make_id(i).asString();
+            record["name"] = STRINGIZE("Resident " << i);
+            record["about"] = (i % 4) ? std::string() : STRINGIZE("Line one\nLine \"two\" of the profile for " << i);
+            record["online"] = (i % 3) == 0;
+            record["created"] = (LLSD::Integer)(1500000000 + i);
+            record["rating"] = (i % 50) / 10.0;
+            record["groups"] = LLSD::emptyArray();
+            for (U32 g = 0; g < i % 4; ++g)
+            {
+                LLSD group;
+                group["id"] = make_id(1000000 + g).asString();
+                group["title"] = STRINGIZE("Group " << g);
+                record["groups"].append(group);
+            }
+            results.append(record);
+        }
+        LLSD payload;
+        payload["total"] = (LLSD::Integer)count;
+        payload["results"] = results;
+        return payload;
+    }
+
+    // Counts what a boost::json::value holds, to report what the DOM path
+    // costs on top of the LLSD.
+    class CountingResource : public boost::json::memory_resource
+    {
+    public:
+        size_t mLive{ 0 };
+        size_t mPeak{ 0 };
+
+    private:
+        void* do_allocate(std::size_t size, std::size_t) override
+        {
+            mLive += size;
+            mPeak = std::max(mPeak, mLive);
+            return ::operator new(size);
+        }
+        void do_deallocate(void* ptr, std::size_t size, std::size_t) override
+        {
+            mLive -= size;
+            ::operator delete(ptr);
+        }
+        bool do_is_equal(const boost::json::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+namespace tut
+{
+    struct llsdjson_data
+    {
+    };
+    typedef test_group<llsdjson_data> llsdjson_group;
+    typedef llsdjson_group::object object;
+    llsdjson_group llsdjsongrp("llsdjson");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("writer matches LlsdToJson");
+        const LLSD sample = make_sample();
+        const std::string text = LlsdToJsonString(sample);
+        boost::system::error_code ec;
+        boost::json::value parsed = boost::json::parse(text, ec);
+        ensure(STRINGIZE("writer output parses: " << ec.message() << '\n' << text), !ec.failed());
+        ensure("same value as LlsdToJson()", parsed == LlsdToJson(sample));
+
+        std::ostringstream out;
+        LlsdToJsonStream(sample, out);
+        ensure_equals("stream writer", out.str(), text);
+
+        // Big enough to be written to the stream in several blocks.
+        const LLSD large = make_large_payload(3000);
+        std::ostringstream large_out;
+        LlsdToJsonStream(large, large_out);
+        ensure("large stream writer", large_out.str() == LlsdToJsonString(large));
+        ensure("large value", boost::json::parse(large_out.str()) == LlsdToJson(large));
+
+        LLSD special = LLSD::emptyArray();
+        special.append(LLSD::Real(HUGE_VAL));
+        special.append(LLSD::Real(-HUGE_VAL));
+        special.append(LLSD::Real(std::nan("")));
+        ensure_equals("non-finite reals", LlsdToJsonString(special),
+                      boost::json::serialize(LlsdToJson(special)));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("reader matches LlsdFromJson");
+        const std::string documents[] = {
+            boost::json::serialize(LlsdToJson(make_sample())),
+            boost::json::serialize(LlsdToJson(make_large_payload(500))),
+            "  42  ", "-7", "1.5e3", "\"text\"", "true", "null", "[]", "{}",
+            "{\"a\":{\"x\":1},\"a\":{\"y\":2}}",
+            "[1, 2.0, -0, 1e2, \"\\u00e9\\ud83d\\ude00\", [[[]]], {\"\":null}]",
+            "{\"long\":\"" + std::string(20000, 'x') + "\\n" + std::string(20000, 'y') + "\"}",
+        };
+        for (const std::string& doc : documents)
+        {
+            boost::system::error_code dom_ec;
+            LLSD expected = LlsdFromJson(boost::json::parse(doc, dom_ec));
+            ensure("DOM parse", !dom_ec.failed());
+
+            boost::system::error_code ec;
+            LLSD direct = LlsdFromJsonString(doc, ec);
+            ensure(STRINGIZE("string parse: " << ec.message()), !ec.failed());
+            ensure(STRINGIZE("same LLSD from " << doc.substr(0, 80)), llsd_equals(direct, expected));
+
+            std::istringstream in(doc);
+            LLSD streamed = LlsdFromJsonStream(in, ec);
+            ensure(STRINGIZE("stream parse: " << ec.message()), !ec.failed());
+            ensure("same LLSD from a stream", llsd_equals(streamed, expected));
+        }
+
+        // Where boost::json::parse() fails, so do these.
+        const char* broken[] = {
+            "", "   ", "{", "[1,]", "[1 2]", "1 2", "{\"a\":1}x", "\"open", "{\"a\"}", "tru", "01",
+            "\"bad \\q escape\"", "\"ctl \x01\"", "[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]",
+        };
+        for (const char* doc : broken)
+        {
+            boost::system::error_code dom_ec;
+            boost::json::parse(doc, dom_ec);
+            ensure(STRINGIZE("DOM parse fails on '" << doc << "'"), dom_ec.failed());
+
+            boost::system::error_code ec;
+            LLSD direct = LlsdFromJsonString(doc, ec);
+            ensure(STRINGIZE("string parse fails on '" << doc << "'"), ec.failed() && direct.isUndefined());
+            std::istringstream in(doc);
+            ec.clear();
+            LLSD streamed = LlsdFromJsonStream(in, ec);
+            ensure(STRINGIZE("stream parse fails on '" << doc << "'"), ec.failed() && streamed.isUndefined());
+        }
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("conversion benchmark");
+        // Not a pass/fail test: best of several conversions of one large
+        // payload, through a boost::json::value and directly, and how much
+        // the boost::json::value holds at its peak.
+        std::string env = LLStringUtil::getenv("LL_LLSD_JSON_BENCH_ITEMS");
+        if (env.empty())
+        {
+            skip("set LL_LLSD_JSON_BENCH_ITEMS to run");
+        }
+        U32 count = llmax((U32)std::stoul(env), 10U);
+
+        using clock = std::chrono::steady_clock;
+        auto best_of = [](const std::function<void()>& convert)
+        {
+            auto best = clock::duration::max();
+            for (S32 pass = 0; pass < 5; ++pass)
+            {
+                auto start = clock::now();
+                convert();
+                best = std::min(best, clock::now() - start);
+            }
+            return std::chrono::duration<F64>(best).count();
+        };
+
+        const LLSD payload = make_large_payload(count);
+        const std::string text = LlsdToJsonString(payload);
+        const F64 megabytes = text.size() / (1024.0 * 1024.0);
+
+        const F64 dom_write = best_of([&]() { boost::json::serialize(LlsdToJson(payload)); });
+        const F64 direct_write = best_of([&]() { LlsdToJsonString(payload); });
+        const F64 dom_read = best_of([&]() { LlsdFromJson(boost::json::parse(text)); });
+        const F64 direct_read = best_of([&]()
+        {
+            boost::system::error_code ec;
+            LlsdFromJsonString(text, ec);
+        });
+
+        CountingResource read_dom;
+        {
+            boost::json::value dom = boost::json::parse(text, boost::json::storage_ptr(&read_dom));
+            LLSD converted = LlsdFromJson(dom);
+        }
+        CountingResource write_dom;
+        {
+            boost::json::value dom(LlsdToJson(payload), boost::json::storage_ptr(&write_dom));
+            boost::json::serialize(dom);
+        }
+
+        std::cout << "\nllsdjson: " << count << " records, " << text.size() / 1024 << " KB of JSON, best of 5\n"
+                  << "  write: boost::json::value " << megabytes / dom_write << " MB/s, direct "
+                  << megabytes / direct_write << " MB/s; value peak " << write_dom.mPeak / 1024 << " KB\n"
+                  << "  read:  boost::json::value " << megabytes / dom_read << " MB/s, direct "
+                  << megabytes / direct_read << " MB/s; value peak " << read_dom.mPeak / 1024 << " KB\n"
+                  << "  (the direct conversions build no value at all)" << std::endl;
+    }
+} // namespace tut
@@ -0,0 +1,140 @@
+/**
+ * @file   lltraceallocprofiler_test.cpp
+ * @brief  Test for lltraceallocprofiler.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltraceallocprofiler.h"
+
+#include "llfasttimer.h"
+#include "lltracethreadrecorder.h"
+#include "../test/lltut.h"
+
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    LLTrace::BlockTimerStatHandle sAllocatingTimer("alloc_profiler_test");
+
+    const size_t ALLOCATIONS = 20000;
+    const size_t ALLOCATION_SIZE = 256;
+
+    void allocate_in_zone()
+    {
+        std::vector<char*> blocks;
+        blocks.reserve(ALLOCATIONS);
+        {
+            LL_RECORD_BLOCK_TIME(sAllocatingTimer);
+            for (size_t i = 0; i < ALLOCATIONS; ++i)
+            {
+                blocks.push_back(new char[ALLOCATION_SIZE]);
+                blocks.back()[0] = (char)i;
+            }
+        }
+        for (char* block : blocks)
+        {
+            delete[] block;
+        }
+    }
+
+    LLTrace::AllocationProfiler::ZoneTotals find_zone(const std::string& name)
+    {
+        for (const auto& zone : LLTrace::AllocationProfiler::getZoneTotals())
+        {
+            if (zone.mZone == name)
+            {
+                return zone;
+            }
+        }
+        return {};
+    }
+}
+
+namespace tut
+{
+    struct allocprofiler_data
+    {
+        LLTrace::ThreadRecorder mRecorder;
+
+        allocprofiler_data()
+        {
+            LLTrace::AllocationProfiler::reset();
+        }
+
+        ~allocprofiler_data()
+        {
+            LLTrace::AllocationProfiler::setSampleInterval(0);
+            LLTrace::AllocationProfiler::reset();
+        }
+    };
+    typedef test_group<allocprofiler_data> allocprofiler_group;
+    typedef allocprofiler_group::object object;
+    allocprofiler_group allocprofilergrp("LLTraceAllocationProfiler");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("estimates what a zone allocates");
+        if (!LLTrace::AllocationProfiler::isAvailable())
+        {
+            skip("this build doesn't sample operator new");
+        }
+
+        LLTrace::AllocationProfiler::setSampleInterval(4096);
+        // While sampling is off a thread only looks for an interval every
+        // megabyte, so it can take that long to start.
+        allocate_in_zone();
+        LLTrace::AllocationProfiler::reset();
+        allocate_in_zone();
+        LLTrace::AllocationProfiler::nextFrame();
+
+        // about 1250 samples, so this is many standard deviations wide
+        const F64 expected = (F64)(ALLOCATIONS * ALLOCATION_SIZE);
+        LLTrace::AllocationProfiler::ZoneTotals zone = find_zone("alloc_profiler_test");
+        ensure("zone was sampled", zone.mSamples > 0);
+        ensure("bytes estimate " + std::to_string(zone.mBytes), zone.mBytes > expected * 0.75 && zone.mBytes < expected * 1.25);
+        ensure("allocation estimate " + std::to_string(zone.mAllocations),
+               zone.mAllocations > ALLOCATIONS * 0.75 && zone.mAllocations < ALLOCATIONS * 1.25);
+        ensure_equals("frames", LLTrace::AllocationProfiler::getFrameCount(), 1);
+
+        std::ostringstream report;
+        LLTrace::AllocationProfiler::writeReport(report);
+        ensure_contains("report names the zone", report.str(), "alloc_profiler_test");
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("nothing sampled while off");
+        LLTrace::AllocationProfiler::setSampleInterval(0);
+        allocate_in_zone();
+        allocate_in_zone();
+        LLTrace::AllocationProfiler::nextFrame();
+
+        ensure("no samples", LLTrace::AllocationProfiler::getZoneTotals().empty());
+        ensure_equals("frames only count while sampling", LLTrace::AllocationProfiler::getFrameCount(), 0);
+    }
+}
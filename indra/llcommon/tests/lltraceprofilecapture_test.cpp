@@ -0,0 +1,230 @@
+/**
+ * @file   lltraceprofilecapture_test.cpp
+ * @brief  Test for lltraceprofilecapture.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltraceprofilecapture.h"
+
+#include "llfasttimer.h"
+#include "llfile.h"
+#include "lltracethreadrecorder.h"
+#include "../test/lltut.h"
+#include "../test/namedtempfile.h"
+
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    LLTrace::BlockTimerStatHandle sOuterTimer("capture_outer");
+    LLTrace::BlockTimerStatHandle sInnerTimer("capture_inner");
+    LLTrace::BlockTimerStatHandle sWorkerTimer("capture_worker");
+
+    void run_frame()
+    {
+        LL_RECORD_BLOCK_TIME(sOuterTimer);
+        for (int i = 0; i < 2; ++i)
+        {
+            LL_RECORD_BLOCK_TIME(sInnerTimer);
+        }
+    }
+
+    // just enough of the file format to check what was written
+    struct Capture
+    {
+        struct Thread
+        {
+            U64 mFlags{ 0 };
+            std::vector<U64> mTimers;  // timer number of each event
+        };
+
+        bool                        mValid{ false };
+        U64                         mFrequency{ 0 };
+        U64                         mFrames{ 0 };
+        std::vector<std::string>    mTimerNames;
+        std::vector<Thread>         mThreads;
+        U64                         mDropped{ 0 };
+
+        Capture(const std::string& filename)
+        {
+            llifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+            mData.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            if (mData.compare(0, 8, "LLPROF1\n") != 0)
+            {
+                return;
+            }
+            mPos = 8;
+
+            mFrequency = varint();
+            varint(); // start time
+            mFrames = varint();
+            for (U64 i = 0; i < mFrames; ++i)
+            {
+                varint();
+            }
+            for (U64 i = 0, count = varint(); i < count; ++i)
+            {
+                U64 length = varint();
+                mTimerNames.push_back(mData.substr(mPos, length));
+                mPos += length;
+            }
+            for (U64 i = 0, count = varint(); i < count; ++i)
+            {
+                Thread thread;
+                varint(); // thread number
+                thread.mFlags = varint();
+                for (U64 j = 0, events = varint(); j < events; ++j)
+                {
+                    thread.mTimers.push_back(varint());
+                    varint(); // start
+                    varint(); // duration
+                }
+                mThreads.push_back(thread);
+            }
+            mDropped = varint();
+            mValid = mPos == mData.size();
+        }
+
+        std::string timerName(U64 number) const
+        {
+            return number < mTimerNames.size() ? mTimerNames[number] : std::string();
+        }
+
+    private:
+        U64 varint()
+        {
+            U64 value = 0;
+            for (U32 shift = 0; mPos < mData.size() && shift < 64; shift += 7)
+            {
+                U8 byte = (U8)mData[mPos++];
+                value |= (U64)(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                {
+                    break;
+                }
+            }
+            return value;
+        }
+
+        std::string mData;
+        size_t      mPos{ 0 };
+    };
+}
+
+namespace tut
+{
+    struct profilecapture_data
+    {
+        LLTrace::ThreadRecorder mRecorder;
+
+        ~profilecapture_data()
+        {
+            LLTrace::ProfileCapture::stop();
+        }
+    };
+    typedef test_group<profilecapture_data> profilecapture_group;
+    typedef profilecapture_group::object object;
+    profilecapture_group profilecapturegrp("LLTraceProfileCapture");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("captures the requested frames");
+        NamedExtTempFile file(".llprof", "");
+
+        run_frame(); // not captured
+        ensure("started", LLTrace::ProfileCapture::start(2, file.getName()));
+        ensure("capturing", LLTrace::ProfileCapture::isCapturing());
+        ensure("only one capture at a time", !LLTrace::ProfileCapture::start(2, file.getName()));
+
+        run_frame();
+        ensure("first frame doesn't finish", !LLTrace::ProfileCapture::nextFrame());
+        run_frame();
+        ensure("second frame finishes", LLTrace::ProfileCapture::nextFrame());
+        ensure("stopped", !LLTrace::ProfileCapture::isCapturing());
+        run_frame(); // not captured
+        ensure_equals("filename", LLTrace::ProfileCapture::getLastFilename(), file.getName());
+
+        Capture capture(file.getName());
+        ensure("file reads back", capture.mValid);
+        ensure("clock rate", capture.mFrequency > 0);
+        ensure_equals("frames", capture.mFrames, 2);
+        ensure_equals("timers", capture.mTimerNames.size(), 2);
+        ensure_equals("threads", capture.mThreads.size(), 1);
+        ensure_equals("dropped", capture.mDropped, 0);
+
+        const Capture::Thread& thread = capture.mThreads[0];
+        ensure_equals("main thread", thread.mFlags, 1);
+        ensure_equals("events", thread.mTimers.size(), 6);
+        // children finish before their parent
+        ensure_equals("first event", capture.timerName(thread.mTimers[0]), "capture_inner");
+        ensure_equals("second event", capture.timerName(thread.mTimers[1]), "capture_inner");
+        ensure_equals("third event", capture.timerName(thread.mTimers[2]), "capture_outer");
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("captures other threads and stops early");
+        NamedExtTempFile file(".llprof", "");
+
+        ensure("nothing to stop", !LLTrace::ProfileCapture::stop());
+        ensure("no frames", !LLTrace::ProfileCapture::start(0, file.getName()));
+        ensure("started", LLTrace::ProfileCapture::start(100, file.getName()));
+
+        run_frame();
+        std::thread worker([this]()
+                           {
+                               LLTrace::ThreadRecorder recorder(mRecorder);
+                               for (int i = 0; i < 3; ++i)
+                               {
+                                   LL_RECORD_BLOCK_TIME(sWorkerTimer);
+                               }
+                           });
+        worker.join();
+        LLTrace::ProfileCapture::nextFrame();
+
+        ensure("stopped early", LLTrace::ProfileCapture::stop());
+        ensure("stopped", !LLTrace::ProfileCapture::isCapturing());
+
+        Capture capture(file.getName());
+        ensure("file reads back", capture.mValid);
+        ensure_equals("frames", capture.mFrames, 1);
+        ensure_equals("threads", capture.mThreads.size(), 2);
+
+        size_t worker_events = 0;
+        for (const Capture::Thread& thread : capture.mThreads)
+        {
+            if (thread.mFlags == 0)
+            {
+                worker_events = thread.mTimers.size();
+                ensure_equals("worker timer", capture.timerName(thread.mTimers[0]), "capture_worker");
+            }
+        }
+        ensure_equals("worker events", worker_events, 3);
+    }
+}
@@ -0,0 +1,297 @@
+/**
+ * @file   lluuidhashmap_test.cpp
+ * @brief  Test for lluuidhashmap.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "lluuidhashmap.h"
+// STL headers
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+// other Linden headers
+#include "../test/lltut.h"
+#include "llpointer.h"
+#include "llrefcount.h"
+#include "llstl.h"
+#include "llstring.h"
+#include "stringize.h"
+
+namespace
+{
+    LLUUID make_id(U32 seed)
+    {
+        // Deterministic but well spread, like server assigned IDs.
+        LLUUID id;
+        U32 state = seed * 2654435761u + 0x9E3779B9u;
+        for (U32 i = 0; i < UUID_BYTES; ++i)
+        {
+            state = state * 1103515245u + 12345u;
+            id.mData[i] = (U8)(state >> 24);
+        }
+        return id;
+    }
+
+    struct Entry : public LLRefCount
+    {
+        LLUUID  mID;
+        LLUUID  mParentID;
+        LLUUID  mTargetID;
+    };
+    typedef std::vector<LLPointer<Entry> > entry_array_t;
+
+    template <typename T> using std_uuid_map = std::map<LLUUID, T>;
+
+    // The shape of LLInventoryModel's indices: objects by ID, and per folder
+    // arrays of children, so the benchmark exercises the same lookups as
+    // collectDescendentsIf() without the viewer around it.
+    template <template <typename> class MAP>
+    struct TreeModel
+    {
+        MAP<LLPointer<Entry> >  mCategories;
+        MAP<LLPointer<Entry> >  mItems;
+        MAP<entry_array_t*>     mChildCategories;
+        MAP<entry_array_t*>     mChildItems;
+
+        ~TreeModel()
+        {
+            for (auto& entry : mChildCategories)
+            {
+                delete entry.second;
+            }
+            for (auto& entry : mChildItems)
+            {
+                delete entry.second;
+            }
+        }
+
+        void addCategory(const LLPointer<Entry>& cat)
+        {
+            mCategories[cat->mID] = cat;
+            mChildCategories[cat->mID] = new entry_array_t;
+            mChildItems[cat->mID] = new entry_array_t;
+            if (entry_array_t* siblings = get_ptr_in_map(mChildCategories, cat->mParentID))
+            {
+                siblings->push_back(cat);
+            }
+        }
+
+        void addItem(const LLPointer<Entry>& item)
+        {
+            mItems[item->mID] = item;
+            if (entry_array_t* siblings = get_ptr_in_map(mChildItems, item->mParentID))
+            {
+                siblings->push_back(item);
+            }
+        }
+
+        // Collects items whose link target resolves, the way link aware
+        // collect functors look each candidate up in the model.
+        void collectDescendents(const LLUUID& id, entry_array_t& cats, entry_array_t& items) const
+        {
+            if (entry_array_t* cat_array = get_ptr_in_map(mChildCategories, id))
+            {
+                for (const LLPointer<Entry>& cat : *cat_array)
+                {
+                    cats.push_back(cat);
+                    collectDescendents(cat->mID, cats, items);
+                }
+            }
+            if (entry_array_t* item_array = get_ptr_in_map(mChildItems, id))
+            {
+                for (const LLPointer<Entry>& item : *item_array)
+                {
+                    if (item->mTargetID.isNull() || mItems.find(item->mTargetID) != mItems.end())
+                    {
+                        items.push_back(item);
+                    }
+                }
+            }
+        }
+    };
+
+    // Roughly the proportions of a large real inventory: a few thousand
+    // folders nested a handful of levels deep, every tenth item a link.
+    template <template <typename> class MAP>
+    void build_tree(TreeModel<MAP>& model, U32 item_count, LLUUID& root_id)
+    {
+        const U32 folder_count = llmax(item_count / 40, 1U);
+        U32 seed = 1;
+        LLPointer<Entry> root = new Entry;
+        root->mID = root_id = make_id(seed++);
+        model.addCategory(root);
+
+        std::vector<LLUUID> folders(1, root_id);
+        folders.reserve(folder_count + 1);
+        for (U32 i = 0; i < folder_count; ++i)
+        {
+            LLPointer<Entry> cat = new Entry;
+            cat->mID = make_id(seed++);
+            cat->mParentID = folders[(i * 7) / 8];
+            model.addCategory(cat);
+            folders.push_back(cat->mID);
+        }
+
+        std::vector<LLUUID> item_ids;
+        item_ids.reserve(item_count);
+        for (U32 i = 0; i < item_count; ++i)
+        {
+            LLPointer<Entry> item = new Entry;
+            item->mID = make_id(seed++);
+            item->mParentID = folders[(i * 2654435761u) % folders.size()];
+            if (i % 10 == 9)
+            {
+                item->mTargetID = item_ids[(i * 40503u) % item_ids.size()];
+            }
+            model.addItem(item);
+            item_ids.push_back(item->mID);
+        }
+    }
+}
+
+namespace tut
+{
+    struct lluuidhashmap_data
+    {
+    };
+    typedef test_group<lluuidhashmap_data> lluuidhashmap_group;
+    typedef lluuidhashmap_group::object object;
+    lluuidhashmap_group lluuidhashmapgrp("lluuidhashmap");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("map semantics");
+        LLUUIDHashMap<S32> map;
+        std_uuid_map<S32> reference;
+        for (U32 i = 0; i < 5000; ++i)
+        {
+            LLUUID id = make_id(i % 4000);
+            map[id] += (S32)i;
+            reference[id] += (S32)i;
+        }
+        ensure_equals("size", map.size(), reference.size());
+        for (const auto& entry : reference)
+        {
+            auto it = map.find(entry.first);
+            ensure("present", it != map.end());
+            ensure_equals("value", it->second, entry.second);
+        }
+        ensure("null absent", !map.contains(LLUUID::null));
+        ensure("missing key", get_ptr_in_map(LLUUIDHashMap<entry_array_t*>(), make_id(1)) == nullptr);
+
+        for (U32 i = 0; i < 4000; i += 2)
+        {
+            ensure_equals("erase", map.erase(make_id(i)), size_t(1));
+        }
+        ensure_equals("erase absent", map.erase(make_id(0)), size_t(0));
+        ensure_equals("size after erase", map.size(), size_t(2000));
+        for (U32 i = 0; i < 4000; ++i)
+        {
+            ensure_equals(STRINGIZE("contains " << i), map.contains(make_id(i)), (i % 2) == 1);
+        }
+
+        uuid_hash_set_t set;
+        set.insert(make_id(3));
+        set.insert(make_id(3));
+        set.insert(LLUUID::null);
+        ensure_equals("set size", set.size(), size_t(2));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("same traversal");
+        TreeModel<std_uuid_map> ordered;
+        TreeModel<LLUUIDHashMap> hashed;
+        LLUUID ordered_root, hashed_root;
+        build_tree(ordered, 20000, ordered_root);
+        build_tree(hashed, 20000, hashed_root);
+        ensure_equals("root", hashed_root, ordered_root);
+
+        entry_array_t ordered_cats, ordered_items, hashed_cats, hashed_items;
+        ordered.collectDescendents(ordered_root, ordered_cats, ordered_items);
+        hashed.collectDescendents(hashed_root, hashed_cats, hashed_items);
+        // Child arrays keep insertion order in both, so the walks match
+        // entry for entry.
+        ensure_equals("category count", hashed_cats.size(), ordered_cats.size());
+        ensure_equals("item count", hashed_items.size(), ordered_items.size());
+        for (size_t i = 0; i < hashed_items.size(); ++i)
+        {
+            ensure_equals("item order", hashed_items[i]->mID, ordered_items[i]->mID);
+        }
+        ensure_equals("every folder reached", hashed_cats.size() + 1, hashed.mCategories.size());
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("collect benchmark");
+        // Not a pass/fail test: reports a full collectDescendentsIf style
+        // walk over std::map and hash indices holding the same tree.
+        std::string env = LLStringUtil::getenv("LL_UUID_MAP_BENCH_ITEMS");
+        if (env.empty())
+        {
+            skip("set LL_UUID_MAP_BENCH_ITEMS to run");
+        }
+        U32 item_count = llmax((U32)std::stoul(env), 10U);
+
+        using clock = std::chrono::steady_clock;
+        auto walk = [](const auto& model, const LLUUID& root_id, size_t& found)
+        {
+            auto best = clock::duration::max();
+            for (S32 pass = 0; pass < 5; ++pass)
+            {
+                entry_array_t cats, items;
+                auto start = clock::now();
+                model.collectDescendents(root_id, cats, items);
+                best = std::min(best, clock::now() - start);
+                found = items.size();
+            }
+            return std::chrono::duration<F64, std::milli>(best).count();
+        };
+
+        LLUUID root_id;
+        size_t ordered_found = 0, hashed_found = 0;
+        F64 ordered_ms, hashed_ms;
+        {
+            TreeModel<std_uuid_map> model;
+            build_tree(model, item_count, root_id);
+            ordered_ms = walk(model, root_id, ordered_found);
+        }
+        {
+            TreeModel<LLUUIDHashMap> model;
+            build_tree(model, item_count, root_id);
+            hashed_ms = walk(model, root_id, hashed_found);
+        }
+        ensure_equals("same result", hashed_found, ordered_found);
+
+        std::cout << "\nlluuidhashmap: " << item_count << " items, best of 5 full walks\n"
+                  << "  std::map " << ordered_ms << " ms, LLUUIDHashMap " << hashed_ms << " ms" << std::endl;
+    }
+} // namespace tut
@@ -0,0 +1,294 @@
+/**
+ * @file   threadpool_test.cpp
+ * @brief  Test for threadpool: WorkStealingThreadPool.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "threadpool.h"
+// STL headers
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+// other Linden headers
+#include "../test/lltut.h"
+#include "llstring.h"
+#include "stringize.h"
+
+using namespace std::literals::chrono_literals; // ms suffix
+
+namespace
+{
+    // wait for other threads to bring count to target
+    bool wait_for(const std::atomic<size_t>& count, size_t target)
+    {
+        auto deadline = std::chrono::steady_clock::now() + 30s;
+        while (count.load() < target)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // a few hundred nanoseconds of arithmetic: about as small as anyone
+    // should make a task
+    U32 tiny_task(size_t seed)
+    {
+        U32 value = (U32)seed;
+        for (int i = 0; i < 64; ++i)
+        {
+            value = value * 1664525 + 1013904223;
+        }
+        return value;
+    }
+
+    // post tasks tiny tasks to pool from this thread; returns ms until
+    // all have run
+    template <typename POOL>
+    double post_tasks(POOL& pool, size_t tasks)
+    {
+        std::atomic<size_t> done{ 0 };
+        std::atomic<U32> sink{ 0 };
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < tasks; ++i)
+        {
+            pool.getQueue().post([i, &done, &sink]()
+                                 {
+                                     sink += tiny_task(i);
+                                     ++done;
+                                 });
+        }
+        tut::ensure("tasks finished", wait_for(done, tasks));
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct threadpool_data
+    {
+        threadpool_data():
+            pool("WorkStealingTest", 4)
+        {
+            pool.start();
+        }
+
+        LL::WorkStealingThreadPool pool;
+    };
+    typedef test_group<threadpool_data> threadpool_group;
+    typedef threadpool_group::object object;
+    threadpool_group threadpoolgrp("threadpool");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("priorities");
+        LL::WorkStealingThreadPool single("WorkStealingSingle", 1);
+        single.start();
+        auto& queue = single.getQueue();
+
+        // hold the only worker while we post
+        std::promise<void> started, release;
+        std::shared_future<void> released(release.get_future());
+        queue.post([&started, released]()
+                   {
+                       started.set_value();
+                       released.wait();
+                   });
+        started.get_future().wait();
+
+        std::mutex mutex;
+        std::vector<std::string> order;
+        std::atomic<size_t> done{ 0 };
+        auto record = [&](const std::string& what)
+        {
+            return [&, what]()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(what);
+                ++done;
+            };
+        };
+        queue.post(record("low 1"), LL::WorkStealingQueue::PRIORITY_LOW);
+        queue.post(record("normal 1"));
+        queue.post(record("high 1"), LL::WorkStealingQueue::PRIORITY_HIGH);
+        queue.post(record("low 2"), LL::WorkStealingQueue::PRIORITY_LOW);
+        queue.post(record("high 2"), LL::WorkStealingQueue::PRIORITY_HIGH);
+        ensure_equals("queued", queue.size(), 5);
+        release.set_value();
+
+        ensure("tasks finished", wait_for(done, 5));
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> expected{ "high 1", "high 2", "normal 1", "low 1", "low 2" };
+        ensure("order", order == expected);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("parallel_for covers each index once");
+        for (size_t grain : { 0, 1, 7, 100000 })
+        {
+            std::vector<std::atomic<int>> visits(10007);
+            pool.parallel_for(0, visits.size(), [&visits](size_t i) { ++visits[i]; }, grain);
+            for (size_t i = 0; i < visits.size(); ++i)
+            {
+                ensure_equals(stringize("grain ", grain, " index ", i), visits[i].load(), 1);
+            }
+        }
+
+        bool called = false;
+        pool.parallel_for(5, 5, [&called](size_t) { called = true; });
+        ensure("empty range", ! called);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("nested parallel_for and exceptions");
+        std::atomic<size_t> total{ 0 };
+        pool.parallel_for(0, 16, [this, &total](size_t)
+                          {
+                              pool.parallel_for(0, 100, [&total](size_t) { ++total; });
+                          }, 1);
+        ensure_equals("nested total", total.load(), 1600);
+
+        std::atomic<size_t> visited{ 0 };
+        std::string threw;
+        try
+        {
+            pool.parallel_for(0, 1000, [&visited](size_t i)
+                              {
+                                  ++visited;
+                                  if (i == 500)
+                                  {
+                                      throw std::runtime_error("chunk 500");
+                                  }
+                              }, 10);
+        }
+        catch (const std::runtime_error& e)
+        {
+            threw = e.what();
+        }
+        ensure_equals("exception reached the caller", threw, "chunk 500");
+        ensure("returned only when all chunks had finished", visited.load() > 500);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("posts from many threads");
+        const size_t THREADS = 8, POSTS = 1000;
+        std::atomic<size_t> done{ 0 };
+        std::vector<std::thread> producers;
+        for (size_t t = 0; t < THREADS; ++t)
+        {
+            producers.emplace_back([this, &done]()
+                                   {
+                                       for (size_t i = 0; i < POSTS; ++i)
+                                       {
+                                           pool.getQueue().post([&done]() { ++done; });
+                                       }
+                                   });
+        }
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+        ensure("tasks finished", wait_for(done, THREADS * POSTS));
+        ensure_equals("drained", pool.getQueue().size(), 0);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("close");
+        std::atomic<size_t> done{ 0 };
+        for (size_t i = 0; i < 100; ++i)
+        {
+            pool.getQueue().post([&done]() { ++done; });
+        }
+        pool.close();
+        ensure_equals("posted work drained before the workers quit", done.load(), 100);
+        ensure("done", pool.getQueue().done());
+        ensure("post after close", ! pool.getQueue().post([]() {}));
+
+        // the caller does all the work itself
+        size_t visited = 0;
+        pool.parallel_for(0, 100, [&visited](size_t) { ++visited; });
+        ensure_equals("parallel_for after close", visited, 100);
+    }
+
+    template<> template<>
+    void object::test<6>()
+    {
+        set_test_name("scaling benchmark");
+        std::string env = LLStringUtil::getenv("LL_THREADPOOL_BENCH_TASKS");
+        if (env.empty())
+        {
+            skip("set LL_THREADPOOL_BENCH_TASKS to run");
+        }
+        size_t tasks = std::stoul(env);
+
+        std::cout << "\n" << tasks << " tiny tasks (ms)\n"
+                  << "threads  ThreadPool post  WorkStealing post  parallel_for\n";
+        for (size_t threads : { 1, 2, 4, 8, 16, 32 })
+        {
+            double shared, stealing, forked;
+            {
+                LL::ThreadPool plain(stringize("BenchShared", threads), threads);
+                plain.start();
+                shared = post_tasks(plain, tasks);
+            }
+            {
+                LL::WorkStealingThreadPool steal(stringize("BenchStealing", threads), threads);
+                steal.start();
+                stealing = post_tasks(steal, tasks);
+
+                std::atomic<U32> sink{ 0 };
+                auto start = std::chrono::steady_clock::now();
+                steal.parallel_for(0, tasks, [&sink](size_t i) { sink += tiny_task(i); });
+                forked = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+            std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2)
+                      << std::setw(17) << shared << std::setw(19) << stealing
+                      << std::setw(14) << forked << "\n";
+        }
+        std::cout << std::flush;
+    }
+} // namespace tut
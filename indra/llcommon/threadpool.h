@@ -140,6 +140,41 @@ namespace LL
     /// ThreadPool is shorthand for using the simpler WorkQueue
     using ThreadPool = ThreadPoolUsing<WorkQueue>;
 
+    // <3T:TommyTheTerrible> Work-stealing thread pool
+    /**
+     * ThreadPoolUsing<WorkStealingQueue> gives each worker thread its own
+     * deques (see WorkStealingQueue) and adds parallel_for(). Its width comes
+     * from "ThreadPoolSizes" like any other ThreadPool's.
+     */
+    template <>
+    struct ThreadPoolUsing<WorkStealingQueue>: public ThreadPoolBase
+    {
+        using queue_t = WorkStealingQueue;
+
+        ThreadPoolUsing(const std::string& name,
+                        size_t threads=1,
+                        size_t capacity=1024*1024,
+                        bool auto_shutdown = true):
+            // the queue needs a deque per thread before ThreadPoolBase
+            // has looked up how many threads there will be
+            ThreadPoolBase(name, threads,
+                           new queue_t(name, getConfiguredWidth(name, threads), capacity),
+                           auto_shutdown)
+        {}
+        ~ThreadPoolUsing() override {}
+
+        queue_t& getQueue() { return static_cast<queue_t&>(*mQueue); }
+
+        /// see WorkStealingQueue::parallel_for()
+        template <typename FUNC>
+        void parallel_for(size_t begin, size_t end, FUNC&& func, size_t grain=0,
+                          queue_t::Priority priority=queue_t::PRIORITY_NORMAL)
+        {
+            getQueue().parallel_for(begin, end, std::forward<FUNC>(func), grain, priority);
+        }
+    };
+    // </3T:TommyTheTerrible>
+
 } // namespace LL
 
 #endif /* ! defined(LL_THREADPOOL_H) */
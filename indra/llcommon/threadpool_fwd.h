@@ -20,6 +20,9 @@ namespace LL
     struct ThreadPoolUsing;
 
     using ThreadPool = ThreadPoolUsing<WorkQueue>;
+    // <3T:TommyTheTerrible> Work-stealing thread pool
+    using WorkStealingThreadPool = ThreadPoolUsing<WorkStealingQueue>;
+    // </3T:TommyTheTerrible>
 } // namespace LL
 
 #endif /* ! defined(LL_THREADPOOL_FWD_H) */
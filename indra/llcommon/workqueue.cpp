@@ -18,6 +18,7 @@
 // external library headers
 // other Linden headers
 #include "llapp.h"
+#include "llcond.h"
 #include "llcoros.h"
 #include LLCOROS_MUTEX_HEADER
 #include "llerror.h"
@@ -361,3 +362,324 @@ bool LL::WorkSchedule::tryPop_(Work& work)
 {
     return mQueue.tryPop(work);
 }
+
+// <3T:TommyTheTerrible> Work-stealing queue
+/*****************************************************************************
+*   WorkStealingQueue
+*****************************************************************************/
+namespace
+{
+    // the WorkStealingQueue this thread works for, and its slot there
+    thread_local const LL::WorkStealingQueue* sWorkerOf = nullptr;
+    thread_local size_t sWorkerSlot = 0;
+}
+
+struct LL::WorkStealingQueue::ForkJoin
+{
+    ForkJoin(ChunkBody body, void* func, size_t begin, size_t end, size_t grain):
+        mBody(body),
+        mFunc(func),
+        mBegin(begin),
+        mEnd(end),
+        mGrain(grain),
+        mChunks((end - begin + grain - 1) / grain)
+    {}
+
+    // Run chunks until none are left to claim. A helper that only starts
+    // after the caller has returned claims nothing, so never touches mFunc.
+    void work()
+    {
+        for (size_t chunk; (chunk = mNext.fetch_add(1)) < mChunks; )
+        {
+            size_t first = mBegin + chunk * mGrain;
+            try
+            {
+                mBody(mFunc, first, std::min(first + mGrain, mEnd));
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (! mError)
+                {
+                    mError = std::current_exception();
+                }
+            }
+            if (mDone.fetch_add(1) + 1 == mChunks)
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mFinished.notify_all();
+            }
+        }
+    }
+
+    // Every chunk has been claimed by now; wait for those still running.
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mFinished.wait(lock, [this]{ return mDone.load() == mChunks; });
+        if (mError)
+        {
+            std::rethrow_exception(mError);
+        }
+    }
+
+    const ChunkBody mBody;
+    void* const mFunc;
+    const size_t mBegin, mEnd, mGrain, mChunks;
+    std::atomic<size_t> mNext{ 0 };
+    std::atomic<size_t> mDone{ 0 };
+    std::mutex mMutex;
+    std::condition_variable mFinished;
+    std::exception_ptr mError;
+};
+
+LL::WorkStealingQueue::WorkStealingQueue(const std::string& name, size_t width, size_t capacity):
+    super(name),
+    mWidth(llmax(width, size_t(1))),
+    mCapacity(capacity),
+    mWorkers(new Worker[mWidth])
+{
+}
+
+void LL::WorkStealingQueue::close()
+{
+    mClosed = true;
+    std::lock_guard<std::mutex> lock(mSleepMutex);
+    mWake.notify_all();
+}
+
+size_t LL::WorkStealingQueue::size()
+{
+    return mSize;
+}
+
+bool LL::WorkStealingQueue::isClosed()
+{
+    return mClosed;
+}
+
+bool LL::WorkStealingQueue::done()
+{
+    return mClosed && mSize == 0;
+}
+
+bool LL::WorkStealingQueue::post(const Work& callable)
+{
+    return post(callable, PRIORITY_NORMAL);
+}
+
+bool LL::WorkStealingQueue::post(const Work& callable, Priority priority)
+{
+    if (mClosed)
+    {
+        return false;
+    }
+    return push(callable, priority);
+}
+
+bool LL::WorkStealingQueue::tryPost(const Work& callable)
+{
+    return tryPost(callable, PRIORITY_NORMAL);
+}
+
+bool LL::WorkStealingQueue::tryPost(const Work& callable, Priority priority)
+{
+    if (mClosed || mSize >= mCapacity)
+    {
+        return false;
+    }
+    return push(callable, priority);
+}
+
+void LL::WorkStealingQueue::forkJoin(ChunkBody body, void* func, size_t begin, size_t end,
+                                     size_t grain, Priority priority)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    if (end <= begin)
+    {
+        return;
+    }
+    if (! grain)
+    {
+        grain = llmax((end - begin) / (mWidth * 4), size_t(1));
+    }
+    auto state = std::make_shared<ForkJoin>(body, func, begin, end, grain);
+    // the caller takes a share itself, so one helper per worker at most
+    size_t helpers = llmin(state->mChunks - 1, mWidth);
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        if (! post([state]() { state->work(); }, priority))
+        {
+            break;
+        }
+    }
+    state->work();
+    state->wait();
+}
+
+LL::WorkStealingQueue::Worker* LL::WorkStealingQueue::self()
+{
+    return (sWorkerOf == this) ? &mWorkers[sWorkerSlot] : nullptr;
+}
+
+LL::WorkStealingQueue::Worker* LL::WorkStealingQueue::registerWorker()
+{
+    if (sWorkerOf != this)
+    {
+        size_t slot = mRegistered.fetch_add(1);
+        if (slot >= mWidth)
+        {
+            // more threads than we were told about: they can still steal
+            return nullptr;
+        }
+        sWorkerOf = this;
+        sWorkerSlot = slot;
+    }
+    return &mWorkers[sWorkerSlot];
+}
+
+bool LL::WorkStealingQueue::push(const Work& callable, Priority priority)
+{
+    Worker* worker = self();
+    if (! worker)
+    {
+        worker = &mWorkers[mNextPost.fetch_add(1, std::memory_order_relaxed) % mWidth];
+    }
+    // Count the item before it can be taken, or take() could decrement
+    // the counters below zero. A worker about to sleep counts itself in
+    // mSleepers before checking mSize, so one of us always sees the other.
+    ++mPending[priority];
+    ++mSize;
+    try
+    {
+        std::lock_guard<std::mutex> lock(worker->mMutex);
+        worker->mWork[priority].push_back(callable);
+    }
+    catch (...)
+    {
+        --mPending[priority];
+        --mSize;
+        throw;
+    }
+    if (mSleepers)
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mWake.notify_one();
+    }
+    return true;
+}
+
+bool LL::WorkStealingQueue::take(Worker* self, Work& work)
+{
+    // own deques first, then the others in turn
+    size_t start = self ? (self - mWorkers.get()) : mNextPost.load(std::memory_order_relaxed);
+    for (size_t priority = 0; priority < PRIORITY_COUNT; ++priority)
+    {
+        if (! mPending[priority])
+        {
+            continue;
+        }
+        for (size_t i = 0; i < mWidth; ++i)
+        {
+            Worker& victim = mWorkers[(start + i) % mWidth];
+            std::lock_guard<std::mutex> lock(victim.mMutex);
+            std::deque<Work>& deque = victim.mWork[priority];
+            if (! deque.empty())
+            {
+                work = std::move(deque.front());
+                deque.pop_front();
+                --mPending[priority];
+                --mSize;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+LL::WorkStealingQueue::Work LL::WorkStealingQueue::pop_()
+{
+    Worker* worker = registerWorker();
+    Work work;
+    for (;;)
+    {
+        if (take(worker, work))
+        {
+            return work;
+        }
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        ++mSleepers;
+        mWake.wait(lock, [this]{ return mSize > 0 || mClosed; });
+        --mSleepers;
+        if (mClosed && mSize == 0)
+        {
+            LLTHROW(LLThreadSafeQueueInterrupt());
+        }
+    }
+}
+
+bool LL::WorkStealingQueue::tryPop_(Work& work)
+{
+    return take(self(), work);
+}
+// </3T:TommyTheTerrible>
+
+// <3T:TommyTheTerrible> Fork/join over any named queue
+namespace
+{
+    // Shared by the caller and the helpers of one runParallel(). Helpers
+    // that start after every index has been claimed find nothing to do and
+    // never touch func, which is only guaranteed to live until the caller
+    // returns.
+    struct ParallelState
+    {
+        ParallelState(size_t count, const std::function<void(size_t)>& func):
+            mCount(count),
+            mFunc(func),
+            mRemaining(count)
+        {}
+
+        void run()
+        {
+            for (size_t idx = mNext++; idx < mCount; idx = mNext++)
+            {
+                mFunc(idx);
+                mRemaining.update_all([](size_t& remaining) { --remaining; });
+            }
+        }
+
+        const size_t mCount;
+        const std::function<void(size_t)>& mFunc;
+        std::atomic<size_t> mNext{ 0 };
+        LLScalarCond<size_t> mRemaining;
+    };
+} // anonymous namespace
+
+void LL::runParallel(size_t count, const std::string& queue_name,
+                     const std::function<void(size_t)>& func, size_t max_helpers)
+{
+    if (!count)
+    {
+        return;
+    }
+
+    auto state = std::make_shared<ParallelState>(count, func);
+    if (count > 1)
+    {
+        if (WorkQueue::ptr_t queue = WorkQueue::getInstance(queue_name))
+        {
+            size_t helpers = llmin(count - 1, max_helpers);
+            for (size_t i = 0; i < helpers; ++i)
+            {
+                if (!queue->tryPost([state]() { state->run(); }))
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    state->run();
+    state->mRemaining.wait_equal(0);
+}
+// </3T:TommyTheTerrible>
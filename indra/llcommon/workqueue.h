@@ -18,6 +18,14 @@
 #include "llinstancetrackersubclass.h"
 #include "threadsafeschedule.h"
 #include "blockingconcurrentqueue.h"
+// <3T:TommyTheTerrible> WorkStealingQueue
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>                   // std::unique_ptr
+#include <mutex>
+// </3T:TommyTheTerrible>
 #include <chrono>
 #include <exception>                // std::current_exception
 #include <functional>               // std::function
@@ -362,6 +370,149 @@ namespace LL
         bool tryPop_(Work&) override;
     };
 
+// <3T:TommyTheTerrible> Work-stealing queue
+/*****************************************************************************
+*   WorkStealingQueue: per-worker deques, priorities and parallel_for()
+*****************************************************************************/
+    /**
+     * WorkStealingQueue gives each of its width worker threads its own
+     * deques, one per Priority, each behind its own small lock. Work posted
+     * by one of those workers goes to its own deques; work posted from any
+     * other thread is dealt round robin across them. A worker takes the
+     * oldest item of the highest Priority waiting anywhere, looking at its
+     * own deques first and stealing from the others only when those are
+     * empty. So many threads posting and taking fine-grained work rarely
+     * touch the same lock.
+     *
+     * Obtain one through WorkStealingThreadPool (threadpool.h), which sizes
+     * it from the same "ThreadPoolSizes" setting as any other ThreadPool.
+     */
+    class WorkStealingQueue: public LLInstanceTrackerSubclass<WorkStealingQueue, WorkQueueBase>
+    {
+    private:
+        using super = LLInstanceTrackerSubclass<WorkStealingQueue, WorkQueueBase>;
+
+    public:
+        enum Priority
+        {
+            PRIORITY_HIGH,
+            PRIORITY_NORMAL,
+            PRIORITY_LOW,
+            PRIORITY_COUNT
+        };
+
+        /**
+         * width is the number of threads that will call runUntilClose(),
+         * each of which gets its own deques. capacity only limits tryPost().
+         */
+        WorkStealingQueue(const std::string& name = std::string(), size_t width=1,
+                          size_t capacity=1024*1024);
+
+        /**
+         * Stop accepting work. Workers finish what was already posted before
+         * runUntilClose() returns.
+         */
+        void close() override;
+
+        /// approximate, for the same reasons as WorkQueue::size()
+        size_t size() override;
+        /// producer end: are we prevented from pushing any additional items?
+        bool isClosed() override;
+        /// consumer end: are we done, is the queue entirely drained?
+        bool done() override;
+
+        /*---------------------- fire and forget API -----------------------*/
+
+        /**
+         * post work at PRIORITY_NORMAL, unless the queue is closed
+         */
+        bool post(const Work& callable) override;
+
+        /**
+         * post work at the given priority, unless the queue is closed
+         */
+        bool post(const Work& callable, Priority priority);
+
+        /**
+         * post work at PRIORITY_NORMAL, unless the queue is closed or full
+         */
+        bool tryPost(const Work& callable) override;
+
+        /**
+         * post work at the given priority, unless the queue is closed or full
+         */
+        bool tryPost(const Work& callable, Priority priority);
+
+        /*------------------------- fork/join API --------------------------*/
+
+        /**
+         * Call func(i) for every i in [begin, end), split into chunks of
+         * grain indices that the workers and the calling thread share out
+         * between them; grain 0 picks about four chunks per worker. Returns
+         * once every chunk has finished, rethrowing the first exception any
+         * of them threw.
+         *
+         * The calling thread works through chunks itself rather than just
+         * waiting, so parallel_for() may be called from one of this queue's
+         * own workers, nested as deep as you like, and still completes if
+         * the queue is closed or every other worker is busy.
+         */
+        template <typename FUNC>
+        void parallel_for(size_t begin, size_t end, FUNC&& func, size_t grain=0,
+                          Priority priority=PRIORITY_NORMAL);
+
+        size_t getWidth() const { return mWidth; }
+
+    private:
+        struct alignas(64) Worker
+        {
+            std::mutex mMutex;
+            std::array<std::deque<Work>, PRIORITY_COUNT> mWork;
+        };
+
+        // state shared by a parallel_for() call and the helpers it posts
+        struct ForkJoin;
+        using ChunkBody = void (*)(void* func, size_t begin, size_t end);
+        void forkJoin(ChunkBody body, void* func, size_t begin, size_t end, size_t grain,
+                      Priority priority);
+
+        // the calling thread's Worker, if it's one of ours
+        Worker* self();
+        // claim a Worker for the calling thread, if any are left
+        Worker* registerWorker();
+        bool push(const Work& callable, Priority priority);
+        bool take(Worker* self, Work& work);
+
+        Work pop_() override;
+        bool tryPop_(Work&) override;
+
+        const size_t mWidth;
+        const size_t mCapacity;
+        std::unique_ptr<Worker[]> mWorkers;
+        std::atomic<size_t> mRegistered{ 0 };
+        std::atomic<size_t> mNextPost{ 0 };
+        std::atomic<size_t> mSize{ 0 };
+        std::array<std::atomic<size_t>, PRIORITY_COUNT> mPending{};
+        std::atomic<bool> mClosed{ false };
+        // idle workers wait here
+        std::mutex mSleepMutex;
+        std::condition_variable mWake;
+        std::atomic<size_t> mSleepers{ 0 };
+    };
+// </3T:TommyTheTerrible>
+
+// <3T:TommyTheTerrible> Fork/join over any named queue
+    /**
+     * Call func(i) for every i in [0, count) and return once all calls have
+     * finished. The calling thread works through indices itself and up to
+     * max_helpers workers of the named WorkQueue help out, so this still
+     * completes when that queue is busy, full, closed or does not exist.
+     * func must not throw.
+     */
+    void runParallel(size_t count, const std::string& queue_name,
+                     const std::function<void(size_t)>& func, size_t max_helpers=8);
+// </3T:TommyTheTerrible>
+
     /**
      * BackJack is, in effect, a hand-rolled lambda, binding a WorkSchedule, a
      * CALLABLE that returns bool, a TimePoint and an interval at which to
@@ -450,6 +601,26 @@ namespace LL
                  getWeak(), TimePoint::clock::now(), interval, std::move(callable)));
     }
 
+    // <3T:TommyTheTerrible> Work-stealing queue
+    template <typename FUNC>
+    void WorkStealingQueue::parallel_for(size_t begin, size_t end, FUNC&& func, size_t grain,
+                                         Priority priority)
+    {
+        using Func = std::remove_reference_t<FUNC>;
+        // func outlives every chunk, so the helpers can borrow it untyped
+        forkJoin([](void* f, size_t first, size_t last)
+                 {
+                     Func& body = *static_cast<Func*>(f);
+                     for (size_t i = first; i < last; ++i)
+                     {
+                         body(i);
+                     }
+                 },
+                 const_cast<void*>(static_cast<const void*>(std::addressof(func))),
+                 begin, end, grain, priority);
+    }
+    // </3T:TommyTheTerrible>
+
     /// general case: arbitrary C++ return type
     template <typename CALLABLE, typename FOLLOWUP, typename RETURNTYPE>
     struct WorkQueueBase::MakeReplyLambda
@@ -0,0 +1,385 @@
+/**
+ * @file   llasyncfilesystem.cpp
+ * @brief  Implementation of LLAsyncFileSystem
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llasyncfilesystem.h"
+
+#include "llfasttimer.h"
+#include "llmath.h"
+#include "lltimer.h"
+#include "lltrace.h"
+#include "threadpool.h"
+
+namespace
+{
+    LLTrace::EventStatHandle<F64Milliseconds> sAsyncFileWait("async_file_wait", "time a coroutine spent suspended on LLAsyncFileSystem");
+
+    bool read_file(const LLUUID& file_id, LLAssetType::EType file_type, LLAsyncFileSystem::buffer_t& data,
+                   S32 offset, S32 bytes)
+    {
+        LL_PROFILE_ZONE_SCOPED;
+        data.clear();
+        LLFileSystem file(file_id, file_type, LLFileSystem::READ);
+        S32 size = file.getSize();
+        if (offset < 0 || offset >= size)
+        {
+            return false;
+        }
+        if (bytes < 0 || bytes > size - offset)
+        {
+            bytes = size - offset;
+        }
+        data.resize(bytes);
+        if (!file.seek(offset, 0) || !file.read(data.data(), bytes))
+        {
+            data.clear();
+            return false;
+        }
+        data.resize(file.getLastBytesRead());
+        return true;
+    }
+
+    bool write_file(const LLUUID& file_id, LLAssetType::EType file_type, const U8* data, S32 bytes, S32 mode)
+    {
+        LL_PROFILE_ZONE_SCOPED;
+        LLFileSystem file(file_id, file_type, mode);
+        return file.write(data, bytes);
+    }
+}
+
+LLAsyncFileStats::LLAsyncFileStats()
+{
+    reset();
+}
+
+void LLAsyncFileStats::reset()
+{
+    for (U32 stage = 0; stage < NUM_STAGES; ++stage)
+    {
+        mCount[stage] = 0;
+        mTotalUsec[stage] = 0;
+        for (U32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+        {
+            mBuckets[stage][bucket] = 0;
+        }
+    }
+    mBatches = 0;
+    mLargestBatch = 0;
+}
+
+void LLAsyncFileStats::record(EStage stage, U64 usec)
+{
+    U32 bucket = 0;
+    while (usec >> bucket && bucket < NUM_BUCKETS - 1)
+    {
+        ++bucket;
+    }
+    mCount[stage].fetch_add(1, std::memory_order_relaxed);
+    mTotalUsec[stage].fetch_add(usec, std::memory_order_relaxed);
+    mBuckets[stage][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LLAsyncFileStats::recordBatch(size_t requests)
+{
+    mBatches.fetch_add(1, std::memory_order_relaxed);
+    U64 largest = mLargestBatch.load(std::memory_order_relaxed);
+    while (requests > largest
+           && !mLargestBatch.compare_exchange_weak(largest, requests, std::memory_order_relaxed))
+    {
+    }
+}
+
+F64 LLAsyncFileStats::getMeanMsec(EStage stage) const
+{
+    U64 count = getCount(stage);
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    return (F64)mTotalUsec[stage].load(std::memory_order_relaxed) / (F64)count / 1000.0;
+}
+
+F64 LLAsyncFileStats::getPercentileMsec(EStage stage, F32 percentile) const
+{
+    U64 count = getCount(stage);
+    if (count == 0)
+    {
+        return 0.0;
+    }
+
+    U64 target = (U64)llceil((F32)count * llclamp(percentile, 0.f, 1.f));
+    U64 seen = 0;
+    for (U32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+    {
+        seen += mBuckets[stage][bucket].load(std::memory_order_relaxed);
+        if (seen >= target)
+        {
+            return (F64)(1ULL << bucket) / 1000.0;
+        }
+    }
+    return (F64)(1ULL << (NUM_BUCKETS - 1)) / 1000.0;
+}
+
+//static
+const char* LLAsyncFileStats::getStageName(EStage stage)
+{
+    switch (stage)
+    {
+    case STAGE_QUEUED:  return "queued";
+    case STAGE_SERVICE: return "service";
+    default:            return "unknown";
+    }
+}
+
+std::string LLAsyncFileStats::asString() const
+{
+    std::string out = llformat("requests %llu batches %llu largest %llu",
+                               (unsigned long long)getCount(STAGE_SERVICE),
+                               (unsigned long long)getBatches(),
+                               (unsigned long long)getLargestBatch());
+    for (U32 i = 0; i < NUM_STAGES; ++i)
+    {
+        EStage stage = (EStage)i;
+        out += llformat("  %s %.2f/%.2f/%.2f",
+                        getStageName(stage),
+                        getMeanMsec(stage),
+                        getPercentileMsec(stage, 0.5f),
+                        getPercentileMsec(stage, 0.95f));
+    }
+    return out;
+}
+
+LLAsyncFileSystem::LLAsyncFileSystem(size_t threads)
+:   mPool(new LL::ThreadPool("FileIO", threads)),
+    mPending(0),
+    mClosed(false)
+{
+    mPool->start();
+    for (size_t i = 0, lanes = llmax(mPool->getWidth(), size_t(1)); i < lanes; ++i)
+    {
+        mLanes.emplace_back(new Lane);
+    }
+}
+
+LLAsyncFileSystem::~LLAsyncFileSystem()
+{
+    close();
+    LL_INFOS("AsyncFile") << "Cache I/O mean/p50/p95 ms: " << mStats.asString() << LL_ENDL;
+}
+
+void LLAsyncFileSystem::close()
+{
+    mClosed = true;
+    for (auto& lane : mLanes)
+    {
+        // wait out any submit() that got in before the flag
+        std::lock_guard<std::mutex> lock(lane->mMutex);
+    }
+    mPool->close();
+
+    // A closed WorkQueue drops whatever it had not handed out yet; finish
+    // those lanes here so every caller gets its answer.
+    for (auto& lane : mLanes)
+    {
+        drain(*lane);
+    }
+}
+
+bool LLAsyncFileSystem::submit(const LLUUID& file_id, work_t&& work)
+{
+    Lane& lane = *mLanes[std::hash<LLUUID>()(file_id) % mLanes.size()];
+    std::lock_guard<std::mutex> lock(lane.mMutex);
+    // the pool also closes itself when the app starts quitting
+    if (mClosed || mPool->getQueue().isClosed())
+    {
+        return false;
+    }
+    lane.mQueue.push_back({ std::move(work), LLTimer::getTotalTime() });
+    if (!lane.mScheduled)
+    {
+        if (!mPool->getQueue().post([this, &lane]() { drain(lane); }))
+        {
+            work = std::move(lane.mQueue.back().mWork);
+            lane.mQueue.pop_back();
+            return false;
+        }
+        lane.mScheduled = true;
+    }
+    ++mPending;
+    return true;
+}
+
+void LLAsyncFileSystem::drain(Lane& lane)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    std::deque<Request> batch;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(lane.mMutex);
+            if (lane.mQueue.empty())
+            {
+                // anything submitted from here on schedules a new drain
+                lane.mScheduled = false;
+                return;
+            }
+            batch.swap(lane.mQueue);
+        }
+
+        mStats.recordBatch(batch.size());
+        for (Request& request : batch)
+        {
+            U64 start = LLTimer::getTotalTime();
+            mStats.record(LLAsyncFileStats::STAGE_QUEUED, start - request.mQueuedAt);
+            request.mWork();
+            mStats.record(LLAsyncFileStats::STAGE_SERVICE, LLTimer::getTotalTime() - start);
+            --mPending;
+        }
+        batch.clear();
+    }
+}
+
+template <typename T, typename FUNC>
+LLCoros::Future<T> LLAsyncFileSystem::post(const LLUUID& file_id, FUNC&& func)
+{
+    auto promise = std::make_shared<LLCoros::Promise<T>>();
+    LLCoros::Future<T> future = LLCoros::getFuture(*promise);
+    work_t work = [promise, func = std::forward<FUNC>(func)]() mutable
+    {
+        try
+        {
+            promise->set_value(func());
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    };
+    if (!submit(file_id, std::move(work)))
+    {
+        // no pool to run it on: do it here
+        work();
+    }
+    return future;
+}
+
+template <typename T, typename FUNC>
+T LLAsyncFileSystem::wait(const LLUUID& file_id, FUNC&& func)
+{
+    if (LLCoros::on_main_coro())
+    {
+        // suspending would stall everything this coroutine is servicing
+        return func();
+    }
+
+    U64 start = LLTimer::getTotalTime();
+    LLCoros::Future<T> future = post<T>(file_id, std::forward<FUNC>(func));
+    LLCoros::TempStatus st("waiting for LLAsyncFileSystem");
+    T result = future.get();
+    record(sAsyncFileWait, F64Microseconds((F64)(LLTimer::getTotalTime() - start)));
+    return result;
+}
+
+bool LLAsyncFileSystem::read(const LLUUID& file_id, LLAssetType::EType file_type, buffer_t& data,
+                             S32 offset, S32 bytes)
+{
+    return wait<bool>(file_id, [file_id, file_type, &data, offset, bytes]()
+                      {
+                          return read_file(file_id, file_type, data, offset, bytes);
+                      });
+}
+
+bool LLAsyncFileSystem::write(const LLUUID& file_id, LLAssetType::EType file_type, const U8* data, S32 bytes,
+                              S32 mode)
+{
+    return wait<bool>(file_id, [file_id, file_type, data, bytes, mode]()
+                      {
+                          return write_file(file_id, file_type, data, bytes, mode);
+                      });
+}
+
+bool LLAsyncFileSystem::exists(const LLUUID& file_id, LLAssetType::EType file_type)
+{
+    return wait<bool>(file_id, [file_id, file_type]()
+                      {
+                          return LLFileSystem::getExists(file_id, file_type);
+                      });
+}
+
+S32 LLAsyncFileSystem::getSize(const LLUUID& file_id, LLAssetType::EType file_type)
+{
+    return wait<S32>(file_id, [file_id, file_type]()
+                     {
+                         return LLFileSystem::getFileSize(file_id, file_type);
+                     });
+}
+
+bool LLAsyncFileSystem::rename(const LLUUID& old_id, LLAssetType::EType old_type,
+                               const LLUUID& new_id, LLAssetType::EType new_type)
+{
+    return wait<bool>(old_id, [old_id, old_type, new_id, new_type]()
+                      {
+                          return LLFileSystem::renameFile(old_id, old_type, new_id, new_type);
+                      });
+}
+
+bool LLAsyncFileSystem::remove(const LLUUID& file_id, LLAssetType::EType file_type)
+{
+    return wait<bool>(file_id, [file_id, file_type]()
+                      {
+                          return LLFileSystem::removeFile(file_id, file_type);
+                      });
+}
+
+LLCoros::Future<LLAsyncFileSystem::buffer_t> LLAsyncFileSystem::readAsync(const LLUUID& file_id,
+                                                                          LLAssetType::EType file_type,
+                                                                          S32 offset, S32 bytes)
+{
+    return post<buffer_t>(file_id, [file_id, file_type, offset, bytes]()
+                          {
+                              buffer_t data;
+                              read_file(file_id, file_type, data, offset, bytes);
+                              return data;
+                          });
+}
+
+LLCoros::Future<bool> LLAsyncFileSystem::writeAsync(const LLUUID& file_id, LLAssetType::EType file_type,
+                                                    buffer_t data, S32 mode)
+{
+    return post<bool>(file_id, [file_id, file_type, data = std::move(data), mode]()
+                      {
+                          return write_file(file_id, file_type, data.data(), (S32)data.size(), mode);
+                      });
+}
+
+LLCoros::Future<bool> LLAsyncFileSystem::existsAsync(const LLUUID& file_id, LLAssetType::EType file_type)
+{
+    return post<bool>(file_id, [file_id, file_type]()
+                      {
+                          return LLFileSystem::getExists(file_id, file_type);
+                      });
+}
@@ -0,0 +1,175 @@
+/**
+ * @file   llasyncfilesystem.h
+ * @brief  Cache file I/O that suspends coroutines instead of threads.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLASYNCFILESYSTEM_H
+#define LL_LLASYNCFILESYSTEM_H
+
+#include "llassettype.h"
+#include "llcoros.h"
+#include "llfilesystem.h"
+#include "llsingleton.h"
+#include "lluuid.h"
+#include "threadpool_fwd.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Lock-free log2 histograms of request latency, written from the FileIO
+ * pool and read by whoever wants to report them.
+ */
+class LLAsyncFileStats
+{
+public:
+    typedef enum e_stage
+    {
+        STAGE_QUEUED = 0,   // submitted -> picked up by a worker
+        STAGE_SERVICE,      // the file operation itself
+        NUM_STAGES
+    } EStage;
+
+    // bucket i holds samples in [2^(i-1), 2^i) microseconds, last bucket is open ended
+    static constexpr U32 NUM_BUCKETS = 24;
+
+    LLAsyncFileStats();
+
+    void record(EStage stage, U64 usec);
+    void recordBatch(size_t requests);
+    void reset();
+
+    U64 getCount(EStage stage) const { return mCount[stage].load(std::memory_order_relaxed); }
+    F64 getMeanMsec(EStage stage) const;
+    // approximate, resolved to the upper bound of the containing bucket
+    F64 getPercentileMsec(EStage stage, F32 percentile) const;
+    U64 getBatches() const { return mBatches.load(std::memory_order_relaxed); }
+    U64 getLargestBatch() const { return mLargestBatch.load(std::memory_order_relaxed); }
+
+    static const char* getStageName(EStage stage);
+    std::string asString() const;
+
+private:
+    std::atomic<U64> mCount[NUM_STAGES];
+    std::atomic<U64> mTotalUsec[NUM_STAGES];
+    std::atomic<U64> mBuckets[NUM_STAGES][NUM_BUCKETS];
+    std::atomic<U64> mBatches;
+    std::atomic<U64> mLargestBatch;
+};
+
+/**
+ * LLAsyncFileSystem runs LLFileSystem operations on cache files on the
+ * "FileIO" thread pool (width from ThreadPoolSizes["FileIO"]).
+ *
+ * The plain calls (read(), write(), ...) suspend the calling coroutine
+ * until the operation is done; other coroutines on that thread keep
+ * running meanwhile. The ...Async() calls return an LLCoros::Future
+ * instead. Called from a thread's main coroutine, or when there is no
+ * instance or its pool has closed, the plain calls do the I/O in place,
+ * exactly as LLFileSystem would.
+ *
+ * Requests are spread over one lane per worker by file id. A lane is
+ * serviced by one worker at a time, which takes everything queued on the
+ * lane in one go, so operations on the same file complete in the order
+ * they were submitted and a burst of small requests costs one wake-up.
+ * rename() is ordered with the old file's requests only.
+ *
+ * Buffers passed to the plain calls must stay valid until they return;
+ * the ...Async() calls take their own copy.
+ */
+class LLAsyncFileSystem : public LLSimpleton<LLAsyncFileSystem>
+{
+public:
+    typedef std::vector<U8> buffer_t;
+
+    LLAsyncFileSystem(size_t threads = 2);
+    ~LLAsyncFileSystem();
+
+    // Stop the workers and finish what is queued. Called by the
+    // destructor; after it, every call runs on the calling thread.
+    void close();
+
+    // Read bytes (-1 = to the end) starting at offset. data holds what
+    // was read; returns false if nothing could be.
+    bool read(const LLUUID& file_id, LLAssetType::EType file_type, buffer_t& data,
+              S32 offset = 0, S32 bytes = -1);
+    // mode is LLFileSystem::WRITE, APPEND or READ_WRITE
+    bool write(const LLUUID& file_id, LLAssetType::EType file_type, const U8* data, S32 bytes,
+               S32 mode = LLFileSystem::WRITE);
+    bool exists(const LLUUID& file_id, LLAssetType::EType file_type);
+    S32  getSize(const LLUUID& file_id, LLAssetType::EType file_type);
+    bool rename(const LLUUID& old_id, LLAssetType::EType old_type,
+                const LLUUID& new_id, LLAssetType::EType new_type);
+    bool remove(const LLUUID& file_id, LLAssetType::EType file_type);
+
+    // An empty buffer means nothing could be read.
+    LLCoros::Future<buffer_t> readAsync(const LLUUID& file_id, LLAssetType::EType file_type,
+                                        S32 offset = 0, S32 bytes = -1);
+    LLCoros::Future<bool> writeAsync(const LLUUID& file_id, LLAssetType::EType file_type, buffer_t data,
+                                     S32 mode = LLFileSystem::WRITE);
+    LLCoros::Future<bool> existsAsync(const LLUUID& file_id, LLAssetType::EType file_type);
+
+    const LLAsyncFileStats& getStats() const { return mStats; }
+    size_t getPending() const { return mPending.load(std::memory_order_relaxed); }
+
+private:
+    typedef std::function<void()> work_t;
+
+    struct Request
+    {
+        work_t  mWork;
+        U64     mQueuedAt;
+    };
+
+    struct Lane
+    {
+        std::mutex              mMutex;
+        std::deque<Request>     mQueue;
+        bool                    mScheduled = false;
+    };
+
+    // Queue work for the file; false if there is nowhere to run it.
+    bool submit(const LLUUID& file_id, work_t&& work);
+    void drain(Lane& lane);
+
+    // Run func on the pool and hand back its result through the future.
+    template <typename T, typename FUNC>
+    LLCoros::Future<T> post(const LLUUID& file_id, FUNC&& func);
+    // Run func on the pool and suspend the calling coroutine until it's done.
+    template <typename T, typename FUNC>
+    T wait(const LLUUID& file_id, FUNC&& func);
+
+    std::unique_ptr<LL::ThreadPool>     mPool;
+    std::vector<std::unique_ptr<Lane>>  mLanes;
+    std::atomic<size_t>                 mPending;
+    std::atomic<bool>                   mClosed;
+    LLAsyncFileStats                    mStats;
+};
+
+#endif // LL_LLASYNCFILESYSTEM_H
@@ -0,0 +1,237 @@
+/**
+ * @file   llasyncfilesystem_test.cpp
+ * @brief  Test for llasyncfilesystem.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llasyncfilesystem.h"
+
+#include "../lldiskcache.h"
+#include "llcoros.h"
+#include "lleventcoro.h"
+#include "lltimer.h"
+#include "../test/lltut.h"
+
+#include <filesystem>
+
+namespace
+{
+    // pump the main coroutine until done is set or we give up
+    bool wait_for(const bool& done)
+    {
+        LLTimer timer;
+        while (!done && timer.getElapsedTimeF32() < 30.f)
+        {
+            llcoro::suspend();
+        }
+        return done;
+    }
+
+    LLAsyncFileSystem::buffer_t make_data(size_t size, U8 seed)
+    {
+        LLAsyncFileSystem::buffer_t data(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = (U8)(seed + i);
+        }
+        return data;
+    }
+}
+
+namespace tut
+{
+    struct asyncfilesystem_data
+    {
+        asyncfilesystem_data()
+        {
+            // the disk cache can only be set up once, so every test shares its
+            // directory; each one makes it afresh and takes it away again
+            static const std::filesystem::path dir = std::filesystem::temp_directory_path()
+                / ("llasyncfilesystem_test_" + std::to_string(LLTimer::getTotalTime().value()));
+            cache_dir = dir;
+            if (!LLDiskCache::instanceExists())
+            {
+                LLDiskCache::initParamSingleton(cache_dir.string(), 64 * 1024 * 1024, false, 95.f, 70.f);
+            }
+            std::filesystem::create_directories(cache_dir);
+            files.reset(new LLAsyncFileSystem(2));
+        }
+
+        ~asyncfilesystem_data()
+        {
+            // finish any queued I/O before its directory goes
+            files.reset();
+            std::error_code ec;
+            std::filesystem::remove_all(cache_dir, ec);
+        }
+
+        std::filesystem::path cache_dir;
+        std::unique_ptr<LLAsyncFileSystem> files;
+    };
+    typedef test_group<asyncfilesystem_data> asyncfilesystem_group;
+    typedef asyncfilesystem_group::object object;
+    asyncfilesystem_group asyncfilesystemgrp("LLAsyncFileSystem");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("round trip from a coroutine");
+        LLUUID id, renamed;
+        id.generate();
+        renamed.generate();
+        const LLAsyncFileSystem::buffer_t data = make_data(10000, 7);
+
+        bool done = false, wrote = false, existed = false, whole = false, part = false, moved = false;
+        S32 size = 0;
+        LLAsyncFileSystem::buffer_t read_back, middle;
+        LLCoros::instance().launch("asyncfilesystem round trip",
+            [&]()
+            {
+                wrote = files->write(id, LLAssetType::AT_OBJECT, data.data(), (S32)data.size());
+                existed = files->exists(id, LLAssetType::AT_OBJECT);
+                size = files->getSize(id, LLAssetType::AT_OBJECT);
+                whole = files->read(id, LLAssetType::AT_OBJECT, read_back);
+                part = files->read(id, LLAssetType::AT_OBJECT, middle, 100, 50);
+                moved = files->rename(id, LLAssetType::AT_OBJECT, renamed, LLAssetType::AT_OBJECT);
+                done = true;
+            });
+        ensure("coroutine finished", wait_for(done));
+        ensure("write", wrote);
+        ensure("exists", existed);
+        ensure_equals("size", size, (S32)data.size());
+        ensure("read", whole);
+        ensure("read back what was written", read_back == data);
+        ensure("partial read", part);
+        ensure("partial read contents",
+               middle == LLAsyncFileSystem::buffer_t(data.begin() + 100, data.begin() + 150));
+        ensure("rename", moved);
+        ensure("old name gone", !LLFileSystem::getExists(id, LLAssetType::AT_OBJECT));
+        ensure("new name there", LLFileSystem::getExists(renamed, LLAssetType::AT_OBJECT));
+
+        // the main coroutine does its I/O in place
+        LLAsyncFileSystem::buffer_t direct;
+        ensure("read on the main coroutine", files->read(renamed, LLAssetType::AT_OBJECT, direct));
+        ensure("same data", direct == data);
+        ensure("remove", files->remove(renamed, LLAssetType::AT_OBJECT));
+        LLAsyncFileSystem::buffer_t missing;
+        ensure("missing file", !files->read(renamed, LLAssetType::AT_OBJECT, missing));
+        ensure("nothing read", missing.empty());
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("futures");
+        const size_t FILES = 20;
+        std::vector<LLUUID> ids(FILES);
+        std::vector<LLCoros::Future<bool>> writes;
+        for (size_t i = 0; i < FILES; ++i)
+        {
+            ids[i].generate();
+            writes.push_back(files->writeAsync(ids[i], LLAssetType::AT_TEXTURE, make_data(1000 + i, (U8)i)));
+        }
+        for (LLCoros::Future<bool>& write : writes)
+        {
+            ensure("write", write.get());
+        }
+
+        std::vector<LLCoros::Future<LLAsyncFileSystem::buffer_t>> reads;
+        std::vector<LLCoros::Future<bool>> exists;
+        for (size_t i = 0; i < FILES; ++i)
+        {
+            reads.push_back(files->readAsync(ids[i], LLAssetType::AT_TEXTURE));
+            exists.push_back(files->existsAsync(ids[i], LLAssetType::AT_TEXTURE));
+        }
+        for (size_t i = 0; i < FILES; ++i)
+        {
+            ensure("read contents", reads[i].get() == make_data(1000 + i, (U8)i));
+            ensure("exists", exists[i].get());
+            LLFileSystem::removeFile(ids[i], LLAssetType::AT_TEXTURE);
+        }
+        files->close();
+        ensure_equals("nothing pending", files->getPending(), 0);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("requests on one file keep their order");
+        LLUUID id;
+        id.generate();
+        const size_t APPENDS = 200;
+        std::vector<LLCoros::Future<bool>> appends;
+        for (size_t i = 0; i < APPENDS; ++i)
+        {
+            appends.push_back(files->writeAsync(id, LLAssetType::AT_SOUND, LLAsyncFileSystem::buffer_t(1, (U8)i),
+                                                LLFileSystem::APPEND));
+        }
+        LLAsyncFileSystem::buffer_t contents = files->readAsync(id, LLAssetType::AT_SOUND).get();
+        for (LLCoros::Future<bool>& append : appends)
+        {
+            ensure("append", append.get());
+        }
+        ensure_equals("everything appended before the read", contents.size(), APPENDS);
+        for (size_t i = 0; i < APPENDS; ++i)
+        {
+            ensure_equals("append order", contents[i], (U8)i);
+        }
+        LLFileSystem::removeFile(id, LLAssetType::AT_SOUND);
+
+        const LLAsyncFileStats& stats = files->getStats();
+        // the read's own timing may land just after its result
+        ensure("every request timed", stats.getCount(LLAsyncFileStats::STAGE_SERVICE) >= APPENDS);
+        // the appends queue up faster than one worker writes them, so it takes
+        // several at a time
+        ensure("batched", stats.getBatches() > 0 && stats.getBatches() < APPENDS);
+        ensure("more than one request in a batch", stats.getLargestBatch() > 1);
+        ensure("p95 no less than p50", stats.getPercentileMsec(LLAsyncFileStats::STAGE_SERVICE, 0.95f)
+               >= stats.getPercentileMsec(LLAsyncFileStats::STAGE_SERVICE, 0.5f));
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("after close the calls run in place");
+        files->close();
+        LLUUID id;
+        id.generate();
+        const LLAsyncFileSystem::buffer_t data = make_data(300, 3);
+
+        bool done = false, wrote = false;
+        LLAsyncFileSystem::buffer_t read_back;
+        LLCoros::instance().launch("asyncfilesystem closed",
+            [&]()
+            {
+                wrote = files->write(id, LLAssetType::AT_OBJECT, data.data(), (S32)data.size());
+                files->read(id, LLAssetType::AT_OBJECT, read_back);
+                done = true;
+            });
+        ensure("coroutine finished", wait_for(done));
+        ensure("write", wrote);
+        ensure("read", read_back == data);
+        ensure("future", files->readAsync(id, LLAssetType::AT_OBJECT).get() == data);
+        LLFileSystem::removeFile(id, LLAssetType::AT_OBJECT);
+    }
+}
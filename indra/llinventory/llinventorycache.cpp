@@ -0,0 +1,551 @@
+/**
+ * @file llinventorycache.cpp
+ * @brief Chunked binary on-disk cache of inventory categories and items.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llinventorycache.h"
+
+#include "llfile.h"
+#include "llpermissionsflags.h"
+#include "llprofiler.h"
+#include "llxorcipher.h"
+#include "workqueue.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace
+{
+    const char FILE_MAGIC[8] = { 'L', 'L', 'I', 'N', 'V', 'B', 'I', 'N' };
+
+    constexpr size_t HEADER_SIZE = sizeof(FILE_MAGIC) + 6 * sizeof(U32);
+    constexpr size_t CHUNK_ENTRY_SIZE = 4 * sizeof(U32);
+
+    constexpr U8 CHUNK_CATEGORIES = 0;
+    constexpr U8 CHUNK_ITEMS = 1;
+
+    // Smallest encoded record of each kind (empty strings), used to check
+    // header counts against the bytes that are supposed to hold them.
+    constexpr size_t MIN_CATEGORY_RECORD = 4 * UUID_BYTES + sizeof(U32) + 3 * sizeof(U16);
+    constexpr size_t MIN_ITEM_RECORD = 8 * UUID_BYTES + 8 * sizeof(U32) + 2 + 4 * sizeof(U16);
+
+    // Upper bound of zlib's compression ratio.
+    constexpr size_t MAX_INFLATE_RATIO = 1032;
+
+    // zlib's default level: the cache is written at logout and read at
+    // login, where level 9 buys a few percent of size for several times
+    // the write time.
+    constexpr S32 CACHE_COMPRESSION_LEVEL = 6;
+
+    // Item record flag: the asset id is stored shadowed, as in
+    // LLInventoryItem::asLLSD().
+    constexpr U8 ITEM_SHADOW_ASSET = 0x01;
+
+    // Same key LLInventoryItem uses for shadow ids.
+    const LLUUID SHADOW_KEY("3c115e51-04f4-523c-9fa6-98aff1034730");
+
+    constexpr size_t MAX_DECODE_HELPERS = 8;
+
+    typedef LLCompressionService::buffer_t buffer_t;
+
+    void put_u8(buffer_t& out, U8 value)
+    {
+        out.push_back(value);
+    }
+
+    void put_u16(buffer_t& out, U16 value)
+    {
+        out.push_back((U8)value);
+        out.push_back((U8)(value >> 8));
+    }
+
+    void put_u32(buffer_t& out, U32 value)
+    {
+        out.push_back((U8)value);
+        out.push_back((U8)(value >> 8));
+        out.push_back((U8)(value >> 16));
+        out.push_back((U8)(value >> 24));
+    }
+
+    void put_uuid(buffer_t& out, const LLUUID& id)
+    {
+        out.insert(out.end(), id.mData, id.mData + UUID_BYTES);
+    }
+
+    void put_string(buffer_t& out, const std::string& str)
+    {
+        size_t len = llmin(str.size(), (size_t)U16_MAX);
+        put_u16(out, (U16)len);
+        out.insert(out.end(), str.data(), str.data() + len);
+    }
+
+    // Bounds checked little endian reader over one decoded chunk. Reads past
+    // the end set the failure flag and return zeros, so a record parser can
+    // read every field and check once.
+    class Cursor
+    {
+    public:
+        Cursor(const U8* data, size_t size) : mData(data), mEnd(data + size) {}
+
+        bool failed() const { return mFailed; }
+        bool atEnd() const { return mData == mEnd; }
+
+        U8 u8()
+        {
+            const U8* p = take(1);
+            return p ? p[0] : 0;
+        }
+
+        U16 u16()
+        {
+            const U8* p = take(2);
+            return p ? (U16)(p[0] | (p[1] << 8)) : 0;
+        }
+
+        U32 u32()
+        {
+            const U8* p = take(4);
+            return p ? ((U32)p[0] | ((U32)p[1] << 8) | ((U32)p[2] << 16) | ((U32)p[3] << 24)) : 0;
+        }
+
+        void uuid(LLUUID& id)
+        {
+            const U8* p = take(UUID_BYTES);
+            if (p)
+            {
+                memcpy(id.mData, p, UUID_BYTES);
+            }
+            else
+            {
+                id.setNull();
+            }
+        }
+
+        void string(std::string& str)
+        {
+            U16 len = u16();
+            const U8* p = take(len);
+            if (p)
+            {
+                str.assign((const char*)p, len);
+            }
+            else
+            {
+                str.clear();
+            }
+        }
+
+    private:
+        const U8* take(size_t count)
+        {
+            if (mFailed || (size_t)(mEnd - mData) < count)
+            {
+                mFailed = true;
+                return nullptr;
+            }
+            const U8* p = mData;
+            mData += count;
+            return p;
+        }
+
+        const U8*   mData;
+        const U8*   mEnd;
+        bool        mFailed = false;
+    };
+
+    bool read_category(Cursor& cursor, LLInventoryCacheFile::CategoryRecord& rec)
+    {
+        cursor.uuid(rec.mID);
+        cursor.uuid(rec.mParentID);
+        cursor.uuid(rec.mOwnerID);
+        cursor.uuid(rec.mThumbnailID);
+        rec.mVersion = (S32)cursor.u32();
+        rec.mType = (LLAssetType::EType)(S16)cursor.u16();
+        rec.mPreferredType = (LLFolderType::EType)(S16)cursor.u16();
+        cursor.string(rec.mName);
+        return !cursor.failed();
+    }
+
+    bool read_item(Cursor& cursor, LLInventoryCacheFile::ItemRecord& rec)
+    {
+        cursor.uuid(rec.mID);
+        cursor.uuid(rec.mParentID);
+        cursor.uuid(rec.mAssetID);
+        cursor.uuid(rec.mThumbnailID);
+
+        LLUUID creator, owner, last_owner, group;
+        cursor.uuid(creator);
+        cursor.uuid(owner);
+        cursor.uuid(last_owner);
+        cursor.uuid(group);
+        rec.mPermissions.init(creator, owner, last_owner, group);
+        rec.mPermissions.setMaskBase(cursor.u32());
+        rec.mPermissions.setMaskOwner(cursor.u32());
+        rec.mPermissions.setMaskGroup(cursor.u32());
+        rec.mPermissions.setMaskEveryone(cursor.u32());
+        rec.mPermissions.setMaskNext(cursor.u32());
+        rec.mPermissions.fix();
+
+        rec.mFlags = cursor.u32();
+        S32 sale_price = (S32)cursor.u32();
+        rec.mCreationDate = (S32)cursor.u32();
+        rec.mType = (LLAssetType::EType)(S16)cursor.u16();
+        rec.mInventoryType = (LLInventoryType::EType)(S16)cursor.u16();
+        LLSaleInfo::EForSale sale_type = (LLSaleInfo::EForSale)cursor.u8();
+        U8 record_flags = cursor.u8();
+        rec.mSaleInfo = LLSaleInfo(sale_type, sale_price);
+        cursor.string(rec.mName);
+        cursor.string(rec.mDescription);
+
+        if (record_flags & ITEM_SHADOW_ASSET)
+        {
+            LLXORCipher cipher(SHADOW_KEY.mData, UUID_BYTES);
+            cipher.decrypt(rec.mAssetID.mData, UUID_BYTES);
+        }
+        return !cursor.failed();
+    }
+}
+
+//============================================================================
+// Writer
+
+LLInventoryCacheFile::Writer::Writer(S32 content_version)
+:   mContentVersion(content_version)
+{
+}
+
+LLInventoryCacheFile::Writer::Chunk& LLInventoryCacheFile::Writer::currentChunk(U8 kind)
+{
+    size_t& open = mOpenChunk[kind];
+    if (open == SIZE_MAX || mChunks[open].mRecords >= RECORDS_PER_CHUNK)
+    {
+        open = mChunks.size();
+        mChunks.emplace_back();
+        mChunks.back().mKind = kind;
+    }
+    return mChunks[open];
+}
+
+void LLInventoryCacheFile::Writer::addCategory(const CategoryRecord& cat)
+{
+    Chunk& chunk = currentChunk(CHUNK_CATEGORIES);
+    buffer_t& out = chunk.mData;
+    put_uuid(out, cat.mID);
+    put_uuid(out, cat.mParentID);
+    put_uuid(out, cat.mOwnerID);
+    put_uuid(out, cat.mThumbnailID);
+    put_u32(out, (U32)cat.mVersion);
+    put_u16(out, (U16)(S16)cat.mType);
+    put_u16(out, (U16)(S16)cat.mPreferredType);
+    put_string(out, cat.mName);
+    ++chunk.mRecords;
+    ++mCategoryCount;
+}
+
+void LLInventoryCacheFile::Writer::addItem(const LLInventoryItem& item)
+{
+    // Qualified calls: a viewer side link item would otherwise report the
+    // fields of the item it points to.
+    const LLPermissions& perm = item.LLInventoryItem::getPermissions();
+    const LLSaleInfo& sale_info = item.LLInventoryItem::getSaleInfo();
+
+    LLUUID asset_id = item.LLInventoryItem::getAssetUUID();
+    U8 record_flags = 0;
+    if ((perm.getMaskBase() & PERM_ITEM_UNRESTRICTED) != PERM_ITEM_UNRESTRICTED && asset_id.notNull())
+    {
+        LLXORCipher cipher(SHADOW_KEY.mData, UUID_BYTES);
+        cipher.encrypt(asset_id.mData, UUID_BYTES);
+        record_flags |= ITEM_SHADOW_ASSET;
+    }
+
+    Chunk& chunk = currentChunk(CHUNK_ITEMS);
+    buffer_t& out = chunk.mData;
+    put_uuid(out, item.LLInventoryObject::getUUID());
+    put_uuid(out, item.getParentUUID());
+    put_uuid(out, asset_id);
+    put_uuid(out, item.LLInventoryObject::getThumbnailUUID());
+    put_uuid(out, perm.getCreator());
+    put_uuid(out, perm.getOwner());
+    put_uuid(out, perm.getLastOwner());
+    put_uuid(out, perm.getGroup());
+    put_u32(out, perm.getMaskBase());
+    put_u32(out, perm.getMaskOwner());
+    put_u32(out, perm.getMaskGroup());
+    put_u32(out, perm.getMaskEveryone());
+    put_u32(out, perm.getMaskNextOwner());
+    put_u32(out, item.LLInventoryItem::getFlags());
+    put_u32(out, (U32)sale_info.getSalePrice());
+    put_u32(out, (U32)(S32)item.LLInventoryItem::getCreationDate());
+    // 16 bits, the type enums use both 255 (AT_UNKNOWN) and -1 (AT_NONE)
+    put_u16(out, (U16)(S16)item.getActualType());
+    put_u16(out, (U16)(S16)item.LLInventoryItem::getInventoryType());
+    put_u8(out, (U8)sale_info.getSaleType());
+    put_u8(out, record_flags);
+    put_string(out, item.LLInventoryObject::getName());
+    put_string(out, item.LLInventoryItem::getActualDescription());
+    ++chunk.mRecords;
+    ++mItemCount;
+}
+
+bool LLInventoryCacheFile::Writer::save(const std::string& filename, const std::string& queue)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    std::vector<LLCompressionService::Job> jobs;
+    jobs.reserve(mChunks.size());
+    for (const Chunk& chunk : mChunks)
+    {
+        jobs.emplace_back(chunk.mData.data(), chunk.mData.size());
+    }
+    if (LLCompressionService::deflateBatch(jobs, CACHE_COMPRESSION_LEVEL, queue))
+    {
+        LL_WARNS("Inventory") << "Failed to compress inventory cache for " << filename << LL_ENDL;
+        return false;
+    }
+
+    buffer_t header;
+    header.reserve(HEADER_SIZE + mChunks.size() * CHUNK_ENTRY_SIZE);
+    header.insert(header.end(), FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+    put_u32(header, FORMAT_VERSION);
+    put_u32(header, (U32)mContentVersion);
+    put_u32(header, mCategoryCount);
+    put_u32(header, mItemCount);
+    put_u32(header, (U32)mChunks.size());
+    put_u32(header, 0); // reserved
+    for (size_t i = 0; i < mChunks.size(); ++i)
+    {
+        put_u32(header, mChunks[i].mKind);
+        put_u32(header, mChunks[i].mRecords);
+        put_u32(header, (U32)mChunks[i].mData.size());
+        put_u32(header, (U32)jobs[i].mOut.size());
+    }
+
+    // Unique, so two viewers or two saves never share a temporary file, and
+    // in the same directory so the rename below replaces the cache in one go.
+    std::string temp_filename = filename + "." + LLUUID::generateNewID().asString() + ".tmp";
+    {
+        llofstream out(temp_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            LL_WARNS("Inventory") << "Unable to open " << temp_filename << " for writing" << LL_ENDL;
+            return false;
+        }
+        out.write((const char*)header.data(), header.size());
+        for (const LLCompressionService::Job& job : jobs)
+        {
+            out.write((const char*)job.mOut.data(), job.mOut.size());
+        }
+        out.close();
+        if (out.fail())
+        {
+            LL_WARNS("Inventory") << "Failed writing " << temp_filename << LL_ENDL;
+            LLFile::remove(temp_filename);
+            return false;
+        }
+    }
+
+    // rename() does not replace an existing file on Windows.
+    LLFile::remove(filename, ENOENT);
+    if (LLFile::rename(temp_filename, filename) != 0)
+    {
+        LL_WARNS("Inventory") << "Unable to move " << temp_filename << " to " << filename << LL_ENDL;
+        LLFile::remove(temp_filename);
+        return false;
+    }
+    return true;
+}
+
+//============================================================================
+// Reader
+
+LLInventoryCacheFile::Reader::EStatus LLInventoryCacheFile::Reader::load(const std::string& filename, S32 content_version,
+                                                                         const std::string& queue)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    mCategories.clear();
+    mItemChunks.clear();
+    mItemCount = 0;
+
+    buffer_t file_data;
+    {
+        llifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!in.is_open())
+        {
+            return NOT_FOUND;
+        }
+        in.seekg(0, std::ios::end);
+        std::streamsize size = in.tellg();
+        in.seekg(0, std::ios::beg);
+        if (size < (std::streamsize)HEADER_SIZE)
+        {
+            return BAD_FORMAT;
+        }
+        file_data.resize((size_t)size);
+        if (!in.read((char*)file_data.data(), size))
+        {
+            return BAD_FORMAT;
+        }
+    }
+
+    if (memcmp(file_data.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        return BAD_FORMAT;
+    }
+
+    Cursor header(file_data.data() + sizeof(FILE_MAGIC), file_data.size() - sizeof(FILE_MAGIC));
+    U32 format_version = header.u32();
+    S32 file_content_version = (S32)header.u32();
+    U32 category_count = header.u32();
+    U32 item_count = header.u32();
+    U32 chunk_count = header.u32();
+    header.u32(); // reserved
+    if (format_version != FORMAT_VERSION)
+    {
+        return OBSOLETE;
+    }
+    if (file_content_version != content_version)
+    {
+        return OBSOLETE;
+    }
+
+    struct ChunkEntry
+    {
+        U32 mKind;
+        U32 mRecords;
+        U32 mRawSize;
+        U32 mPackedSize;
+    };
+    // Nothing is sized from the header until it is known to fit the file,
+    // so a damaged cache is discarded instead of throwing bad_alloc.
+    size_t offset = HEADER_SIZE + (size_t)chunk_count * CHUNK_ENTRY_SIZE;
+    if (offset > file_data.size())
+    {
+        return BAD_FORMAT;
+    }
+    std::vector<ChunkEntry> entries(chunk_count);
+    std::vector<LLCompressionService::Job> jobs;
+    jobs.reserve(chunk_count);
+    U64 categories_seen = 0;
+    U64 items_seen = 0;
+    for (ChunkEntry& entry : entries)
+    {
+        entry.mKind = header.u32();
+        entry.mRecords = header.u32();
+        entry.mRawSize = header.u32();
+        entry.mPackedSize = header.u32();
+        if (header.failed() || entry.mKind > CHUNK_ITEMS || entry.mPackedSize > file_data.size() - offset)
+        {
+            return BAD_FORMAT;
+        }
+        size_t min_record = entry.mKind == CHUNK_ITEMS ? MIN_ITEM_RECORD : MIN_CATEGORY_RECORD;
+        if ((U64)entry.mRecords * min_record > entry.mRawSize
+            || (U64)entry.mRawSize > (U64)entry.mPackedSize * MAX_INFLATE_RATIO)
+        {
+            return BAD_FORMAT;
+        }
+        (entry.mKind == CHUNK_ITEMS ? items_seen : categories_seen) += entry.mRecords;
+        jobs.emplace_back(file_data.data() + offset, entry.mPackedSize);
+        offset += entry.mPackedSize;
+    }
+    if (categories_seen != category_count || items_seen != item_count)
+    {
+        return BAD_FORMAT;
+    }
+
+    if (LLCompressionService::inflateBatch(jobs, queue))
+    {
+        return BAD_FORMAT;
+    }
+
+    mCategories.reserve(category_count);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const ChunkEntry& entry = entries[i];
+        buffer_t& data = jobs[i].mOut;
+        if (data.size() != entry.mRawSize)
+        {
+            mCategories.clear();
+            mItemChunks.clear();
+            return BAD_FORMAT;
+        }
+
+        if (entry.mKind == CHUNK_ITEMS)
+        {
+            mItemChunks.emplace_back();
+            mItemChunks.back().mRecords = entry.mRecords;
+            mItemChunks.back().mData.swap(data);
+            continue;
+        }
+
+        Cursor cursor(data.data(), data.size());
+        for (U32 r = 0; r < entry.mRecords; ++r)
+        {
+            mCategories.emplace_back();
+            if (!read_category(cursor, mCategories.back()))
+            {
+                mCategories.clear();
+                mItemChunks.clear();
+                return BAD_FORMAT;
+            }
+        }
+    }
+
+    mItemCount = item_count;
+    return OK;
+}
+
+bool LLInventoryCacheFile::Reader::decodeItems(const prepare_func_t& prepare, const item_func_t& item,
+                                               const std::string& queue)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    std::atomic<bool> ok{ true };
+    LL::runParallel(mItemChunks.size(), queue,
+        [this, &prepare, &item, &ok](size_t idx)
+        {
+            const Chunk& chunk = mItemChunks[idx];
+            prepare(idx, chunk.mRecords);
+
+            Cursor cursor(chunk.mData.data(), chunk.mData.size());
+            ItemRecord rec;
+            for (U32 r = 0; r < chunk.mRecords; ++r)
+            {
+                if (!read_item(cursor, rec))
+                {
+                    ok = false;
+                    return;
+                }
+                item(idx, rec);
+            }
+            if (!cursor.atEnd())
+            {
+                ok = false;
+            }
+        },
+        MAX_DECODE_HELPERS);
+    return ok;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file llinventorycache.h
+ * @brief Chunked binary on-disk cache of inventory categories and items.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINVENTORYCACHE_H
+#define LL_LLINVENTORYCACHE_H
+
+#include "llinventory.h"
+#include "llcompressionservice.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * LLInventoryCacheFile reads and writes the skeleton cache the viewer keeps
+ * between sessions.
+ *
+ * File layout, all integers little endian:
+ *
+ *   header       magic "LLINVBIN", format version, content version,
+ *                category count, item count, chunk count, reserved
+ *   chunk table  per chunk: kind, record count, raw size, packed size
+ *   chunks       zlib streams, in table order
+ *
+ * A chunk holds up to RECORDS_PER_CHUNK records of a single kind. Chunks
+ * are compressed and decompressed independently, so both directions are
+ * spread over a worker queue (the viewer's "General" pool by default) with
+ * the calling thread taking part. The content version is the caller's own
+ * cache version; a mismatch reports OBSOLETE so the caller can discard the
+ * file exactly as it did with the LLSD cache.
+ */
+class LLInventoryCacheFile
+{
+public:
+    static constexpr U32 FORMAT_VERSION = 2;
+    static constexpr U32 RECORDS_PER_CHUNK = 4096;
+
+    // Categories carry viewer side state (version, owner) the base class
+    // does not know about, so they go through a plain record.
+    struct CategoryRecord
+    {
+        LLUUID              mID;
+        LLUUID              mParentID;
+        LLUUID              mOwnerID;
+        LLUUID              mThumbnailID;
+        std::string         mName;
+        S32                 mVersion = -1;
+        LLAssetType::EType  mType = LLAssetType::AT_CATEGORY;
+        LLFolderType::EType mPreferredType = LLFolderType::FT_NONE;
+    };
+
+    struct ItemRecord
+    {
+        LLUUID                  mID;
+        LLUUID                  mParentID;
+        LLUUID                  mAssetID;
+        LLUUID                  mThumbnailID;
+        LLPermissions           mPermissions;
+        LLSaleInfo              mSaleInfo;
+        std::string             mName;
+        std::string             mDescription;
+        LLAssetType::EType      mType = LLAssetType::AT_NONE;
+        LLInventoryType::EType  mInventoryType = LLInventoryType::IT_NONE;
+        U32                     mFlags = 0;
+        S32                     mCreationDate = 0;
+    };
+
+    class Writer
+    {
+    public:
+        explicit Writer(S32 content_version);
+
+        void addCategory(const CategoryRecord& cat);
+
+        // Stores the item's own fields; links are not followed.
+        void addItem(const LLInventoryItem& item);
+
+        // Compresses every chunk and writes the file through a temporary
+        // next to it, so an interrupted save never leaves a torn cache.
+        bool save(const std::string& filename, const std::string& queue = "General");
+
+        U32 getCategoryCount() const { return mCategoryCount; }
+        U32 getItemCount() const { return mItemCount; }
+
+    private:
+        struct Chunk
+        {
+            U8                              mKind = 0;
+            U32                             mRecords = 0;
+            LLCompressionService::buffer_t  mData;
+        };
+
+        Chunk& currentChunk(U8 kind);
+
+        std::vector<Chunk>  mChunks;
+        S32                 mContentVersion;
+        U32                 mCategoryCount = 0;
+        U32                 mItemCount = 0;
+        size_t              mOpenChunk[2] = { SIZE_MAX, SIZE_MAX };
+    };
+
+    class Reader
+    {
+    public:
+        enum EStatus
+        {
+            OK = 0,
+            NOT_FOUND,
+            BAD_FORMAT,
+            OBSOLETE,
+        };
+
+        // Reads the whole file, inflates every chunk and decodes the
+        // categories. Items stay packed until getItems().
+        EStatus load(const std::string& filename, S32 content_version, const std::string& queue = "General");
+
+        const std::vector<CategoryRecord>& getCategories() const { return mCategories; }
+        U32 getItemCount() const { return mItemCount; }
+
+        // Builds ITEM objects (LLInventoryItem or a subclass with the same
+        // full constructor) from the item chunks, one chunk per task, and
+        // appends them in file order. Items with a null ID are dropped;
+        // items of type AT_UNKNOWN are skipped and their parents reported
+        // through unknown_parents if given.
+        // Returns false if a chunk turned out to be malformed.
+        template<class ITEM>
+        bool getItems(std::vector<LLPointer<ITEM> >& items, std::vector<LLUUID>* unknown_parents = nullptr,
+                      const std::string& queue = "General");
+
+    private:
+        typedef std::function<void(size_t chunk, U32 records)> prepare_func_t;
+        typedef std::function<void(size_t chunk, const ItemRecord& record)> item_func_t;
+
+        // Non-template half of getItems(): calls prepare once per chunk,
+        // then item for every record of that chunk, chunks in parallel.
+        bool decodeItems(const prepare_func_t& prepare, const item_func_t& item, const std::string& queue);
+
+        struct Chunk
+        {
+            U32                             mRecords = 0;
+            LLCompressionService::buffer_t  mData;
+        };
+
+        std::vector<CategoryRecord> mCategories;
+        std::vector<Chunk>          mItemChunks;
+        U32                         mItemCount = 0;
+    };
+};
+
+template<class ITEM>
+bool LLInventoryCacheFile::Reader::getItems(std::vector<LLPointer<ITEM> >& items, std::vector<LLUUID>* unknown_parents,
+                                            const std::string& queue)
+{
+    typedef std::vector<LLPointer<ITEM> > item_vector_t;
+    std::vector<item_vector_t> decoded(mItemChunks.size());
+    std::vector<std::vector<LLUUID> > unknown(mItemChunks.size());
+
+    bool ok = decodeItems(
+        [&decoded](size_t chunk, U32 records)
+        {
+            decoded[chunk].reserve(records);
+        },
+        [&decoded, &unknown](size_t chunk, const ItemRecord& rec)
+        {
+            if (rec.mID.isNull())
+            {
+                return;
+            }
+            if (rec.mType == LLAssetType::AT_UNKNOWN)
+            {
+                unknown[chunk].push_back(rec.mParentID);
+                return;
+            }
+            LLPointer<ITEM> item = new ITEM(rec.mID, rec.mParentID, rec.mPermissions, rec.mAssetID, rec.mType,
+                                            rec.mInventoryType, rec.mName, rec.mDescription, rec.mSaleInfo,
+                                            rec.mFlags, rec.mCreationDate);
+            // The constructor widens the masks of some inventory types,
+            // restore exactly what was saved.
+            item->setPermissions(rec.mPermissions);
+            item->setThumbnailUUID(rec.mThumbnailID);
+            decoded[chunk].push_back(item);
+        },
+        queue);
+
+    size_t total = items.size();
+    for (const item_vector_t& chunk_items : decoded)
+    {
+        total += chunk_items.size();
+    }
+    items.reserve(total);
+    for (size_t i = 0; i < decoded.size(); ++i)
+    {
+        items.insert(items.end(), decoded[i].begin(), decoded[i].end());
+        if (unknown_parents)
+        {
+            unknown_parents->insert(unknown_parents->end(), unknown[i].begin(), unknown[i].end());
+        }
+    }
+    return ok;
+}
+
+#endif // LL_LLINVENTORYCACHE_H
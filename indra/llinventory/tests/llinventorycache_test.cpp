@@ -0,0 +1,433 @@
+/**
+ * @file   llinventorycache_test.cpp
+ * @brief  Test for llinventorycache.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../llinventorycache.h"
+// STL headers
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+// other Linden headers
+#include "../test/lltut.h"
+#include "llfile.h"
+#include "llsd.h"
+#include "llsdserialize.h"
+#include "llstring.h"
+#include "stringize.h"
+#include "threadpool.h"
+
+namespace
+{
+    const S32 CONTENT_VERSION = 3;
+
+    std::string temp_cache_name(const std::string& tag)
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path();
+        path /= STRINGIZE("llinventorycache_test_" << tag << "_" << LLUUID::generateNewID() << ".inv.bin");
+        return path.string();
+    }
+
+    // Deterministic inventory shaped like a large real one: a few thousand
+    // folders, items of assorted types, some no-copy, some with thumbnails.
+    LLPointer<LLInventoryItem> make_item(U32 index, const LLUUID& parent)
+    {
+        static const LLAssetType::EType asset_types[] = {
+            LLAssetType::AT_OBJECT, LLAssetType::AT_TEXTURE, LLAssetType::AT_CLOTHING,
+            LLAssetType::AT_BODYPART, LLAssetType::AT_NOTECARD, LLAssetType::AT_LSL_TEXT };
+        static const LLInventoryType::EType inv_types[] = {
+            LLInventoryType::IT_OBJECT, LLInventoryType::IT_TEXTURE, LLInventoryType::IT_WEARABLE,
+            LLInventoryType::IT_WEARABLE, LLInventoryType::IT_NOTECARD, LLInventoryType::IT_LSL };
+        const size_t kind = index % LL_ARRAY_SIZE(asset_types);
+
+        LLUUID creator = LLUUID::generateNewID(STRINGIZE("creator" << index % 97));
+        LLUUID owner = LLUUID::generateNewID("owner");
+        LLPermissions perm;
+        perm.init(creator, owner, creator, LLUUID::null);
+        U32 owner_mask = (index % 3) ? PERM_ALL : (PERM_MOVE | PERM_TRANSFER | PERM_MODIFY);
+        perm.initMasks(owner_mask, owner_mask, PERM_NONE, PERM_NONE, PERM_MOVE | PERM_TRANSFER);
+
+        LLPointer<LLInventoryItem> item = new LLInventoryItem(
+            LLUUID::generateNewID(STRINGIZE("item" << index)),
+            parent,
+            perm,
+            LLUUID::generateNewID(STRINGIZE("asset" << index)),
+            asset_types[kind],
+            inv_types[kind],
+            STRINGIZE("Item " << index << " (" << LLAssetType::lookup(asset_types[kind]) << ")"),
+            (index % 4) ? std::string() : STRINGIZE("Description of item " << index),
+            LLSaleInfo(LLSaleInfo::FS_NOT, (S32)(index % 500)),
+            index * 7,
+            1600000000 + (S32)index);
+        // the constructor resets the masks of unrestricted types
+        item->setPermissions(perm);
+        if (index % 5 == 0)
+        {
+            item->setThumbnailUUID(LLUUID::generateNewID(STRINGIZE("thumb" << index)));
+        }
+        return item;
+    }
+
+    LLInventoryCacheFile::CategoryRecord make_category(U32 index)
+    {
+        LLInventoryCacheFile::CategoryRecord cat;
+        cat.mID = LLUUID::generateNewID(STRINGIZE("folder" << index));
+        cat.mParentID = index ? LLUUID::generateNewID(STRINGIZE("folder" << (index - 1) / 8)) : LLUUID::null;
+        cat.mOwnerID = LLUUID::generateNewID("owner");
+        cat.mName = STRINGIZE("Folder " << index);
+        cat.mVersion = (S32)index + 1;
+        cat.mPreferredType = index ? LLFolderType::FT_NONE : LLFolderType::FT_ROOT_INVENTORY;
+        if (index % 3 == 0)
+        {
+            cat.mThumbnailID = LLUUID::generateNewID(STRINGIZE("folderthumb" << index));
+        }
+        return cat;
+    }
+
+    struct Inventory
+    {
+        std::vector<LLInventoryCacheFile::CategoryRecord>   mCategories;
+        LLInventoryItem::item_array_t                       mItems;
+    };
+
+    Inventory make_inventory(U32 categories, U32 items)
+    {
+        Inventory inv;
+        inv.mCategories.reserve(categories);
+        for (U32 i = 0; i < categories; ++i)
+        {
+            inv.mCategories.push_back(make_category(i));
+        }
+        inv.mItems.reserve(items);
+        for (U32 i = 0; i < items; ++i)
+        {
+            inv.mItems.push_back(make_item(i, inv.mCategories[i % categories].mID));
+        }
+        return inv;
+    }
+
+    bool save_inventory(const Inventory& inv, const std::string& filename, const std::string& queue)
+    {
+        LLInventoryCacheFile::Writer writer(CONTENT_VERSION);
+        for (const auto& cat : inv.mCategories)
+        {
+            writer.addCategory(cat);
+        }
+        for (const auto& item : inv.mItems)
+        {
+            writer.addItem(*item);
+        }
+        return writer.save(filename, queue);
+    }
+
+    F64 seconds(std::chrono::steady_clock::duration elapsed)
+    {
+        return std::chrono::duration<F64>(elapsed).count();
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llinventorycache_data
+    {
+        llinventorycache_data():
+            pool("InventoryCacheTest", 3)
+        {
+            pool.start();
+        }
+
+        ~llinventorycache_data()
+        {
+            pool.close();
+            for (const std::string& filename : files)
+            {
+                LLFile::remove(filename, ENOENT);
+            }
+        }
+
+        std::string tempFile(const std::string& tag)
+        {
+            files.push_back(temp_cache_name(tag));
+            return files.back();
+        }
+
+        LL::ThreadPool pool;
+        std::vector<std::string> files;
+    };
+    typedef test_group<llinventorycache_data> llinventorycache_group;
+    typedef llinventorycache_group::object object;
+    llinventorycache_group llinventorycachegrp("llinventorycache");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("round trip");
+        // enough items to span several chunks
+        Inventory inv = make_inventory(50, LLInventoryCacheFile::RECORDS_PER_CHUNK * 2 + 17);
+        std::string filename = tempFile("roundtrip");
+        ensure("save", save_inventory(inv, filename, "InventoryCacheTest"));
+
+        LLInventoryCacheFile::Reader reader;
+        ensure_equals("load", reader.load(filename, CONTENT_VERSION, "InventoryCacheTest"), LLInventoryCacheFile::Reader::OK);
+        ensure_equals("category count", reader.getCategories().size(), inv.mCategories.size());
+        for (size_t i = 0; i < inv.mCategories.size(); ++i)
+        {
+            const auto& src = inv.mCategories[i];
+            const auto& dst = reader.getCategories()[i];
+            ensure_equals("category id", dst.mID, src.mID);
+            ensure_equals("category parent", dst.mParentID, src.mParentID);
+            ensure_equals("category owner", dst.mOwnerID, src.mOwnerID);
+            ensure_equals("category thumbnail", dst.mThumbnailID, src.mThumbnailID);
+            ensure_equals("category name", dst.mName, src.mName);
+            ensure_equals("category version", dst.mVersion, src.mVersion);
+            ensure_equals("category preferred type", dst.mPreferredType, src.mPreferredType);
+        }
+
+        LLInventoryItem::item_array_t items;
+        ensure("items", reader.getItems(items, nullptr, "InventoryCacheTest"));
+        ensure_equals("item count", items.size(), inv.mItems.size());
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            const LLInventoryItem* src = inv.mItems[i];
+            const LLInventoryItem* dst = items[i];
+            std::string at = STRINGIZE(" at " << i);
+            ensure_equals("item id" + at, dst->getUUID(), src->getUUID());
+            ensure_equals("parent" + at, dst->getParentUUID(), src->getParentUUID());
+            ensure_equals("asset" + at, dst->getAssetUUID(), src->getAssetUUID());
+            ensure_equals("thumbnail" + at, dst->getThumbnailUUID(), src->getThumbnailUUID());
+            ensure_equals("permissions" + at, dst->getPermissions(), src->getPermissions());
+            ensure_equals("type" + at, dst->getType(), src->getType());
+            ensure_equals("inventory type" + at, dst->getInventoryType(), src->getInventoryType());
+            ensure_equals("name" + at, dst->getName(), src->getName());
+            ensure_equals("description" + at, dst->getDescription(), src->getDescription());
+            ensure_equals("sale type" + at, dst->getSaleInfo().getSaleType(), src->getSaleInfo().getSaleType());
+            ensure_equals("sale price" + at, dst->getSaleInfo().getSalePrice(), src->getSaleInfo().getSalePrice());
+            ensure_equals("flags" + at, dst->getFlags(), src->getFlags());
+            ensure_equals("creation date" + at, dst->getCreationDate(), src->getCreationDate());
+        }
+
+        // without a queue everything runs on this thread with the same result
+        LLInventoryCacheFile::Reader inline_reader;
+        ensure_equals("inline load", inline_reader.load(filename, CONTENT_VERSION, "NoSuchQueue"), LLInventoryCacheFile::Reader::OK);
+        LLInventoryItem::item_array_t inline_items;
+        ensure("inline items", inline_reader.getItems(inline_items, nullptr, "NoSuchQueue"));
+        ensure_equals("inline item count", inline_items.size(), inv.mItems.size());
+        ensure_equals("inline last item", inline_items.back()->getUUID(), inv.mItems.back()->getUUID());
+
+        // two saves of the same cache at once each write their own temporary
+        // file, so what is left is one of them whole
+        Inventory other = make_inventory(20, 100);
+        bool saved[2] = { false, false };
+        std::thread first([&]() { saved[0] = save_inventory(inv, filename, "InventoryCacheTest"); });
+        std::thread second([&]() { saved[1] = save_inventory(other, filename, "InventoryCacheTest"); });
+        first.join();
+        second.join();
+        // on Windows the later rename can lose to the earlier one
+        ensure("saved", saved[0] || saved[1]);
+        LLInventoryCacheFile::Reader again;
+        ensure_equals("load after racing saves", again.load(filename, CONTENT_VERSION), LLInventoryCacheFile::Reader::OK);
+        size_t categories = again.getCategories().size();
+        ensure("one of the two", categories == inv.mCategories.size() || categories == other.mCategories.size());
+
+        const std::filesystem::path cache_path(filename);
+        for (const auto& entry : std::filesystem::directory_iterator(cache_path.parent_path()))
+        {
+            std::string name = entry.path().filename().string();
+            ensure("no temporary file left: " + name,
+                   !(LLStringUtil::startsWith(name, cache_path.filename().string() + ".") && LLStringUtil::endsWith(name, ".tmp")));
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("unknown and null items");
+        Inventory inv = make_inventory(4, 10);
+        LLUUID unknown_parent = inv.mItems[3]->getParentUUID();
+        inv.mItems[3]->setType(LLAssetType::AT_UNKNOWN);
+        inv.mItems[5]->setUUID(LLUUID::null);
+
+        std::string filename = tempFile("unknown");
+        ensure("save", save_inventory(inv, filename, "InventoryCacheTest"));
+
+        LLInventoryCacheFile::Reader reader;
+        ensure_equals("load", reader.load(filename, CONTENT_VERSION), LLInventoryCacheFile::Reader::OK);
+        LLInventoryItem::item_array_t items;
+        std::vector<LLUUID> unknown_parents;
+        ensure("items", reader.getItems(items, &unknown_parents));
+        ensure_equals("skipped items", items.size(), (size_t)8);
+        ensure_equals("unknown parents", unknown_parents.size(), (size_t)1);
+        ensure_equals("unknown parent", unknown_parents[0], unknown_parent);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("missing, obsolete and damaged files");
+        LLInventoryCacheFile::Reader reader;
+        ensure_equals("missing", reader.load(temp_cache_name("missing"), CONTENT_VERSION), LLInventoryCacheFile::Reader::NOT_FOUND);
+
+        Inventory inv = make_inventory(8, 500);
+        std::string filename = tempFile("damaged");
+        ensure("save", save_inventory(inv, filename, "InventoryCacheTest"));
+        ensure_equals("obsolete", reader.load(filename, CONTENT_VERSION + 1), LLInventoryCacheFile::Reader::OBSOLETE);
+
+        std::string contents;
+        {
+            std::ifstream in(filename, std::ios::binary);
+            std::stringstream buffer;
+            buffer << in.rdbuf();
+            contents = buffer.str();
+        }
+
+        std::string truncated = tempFile("truncated");
+        {
+            std::ofstream out(truncated, std::ios::binary);
+            out.write(contents.data(), contents.size() * 2 / 3);
+        }
+        ensure_equals("truncated", reader.load(truncated, CONTENT_VERSION), LLInventoryCacheFile::Reader::BAD_FORMAT);
+        ensure("no categories after failure", reader.getCategories().empty());
+
+        std::string scrambled = tempFile("scrambled");
+        {
+            std::string damaged = contents;
+            for (size_t i = damaged.size() / 2; i < damaged.size(); i += 7)
+            {
+                damaged[i] ^= 0x5A;
+            }
+            std::ofstream out(scrambled, std::ios::binary);
+            out.write(damaged.data(), damaged.size());
+        }
+        ensure_equals("scrambled", reader.load(scrambled, CONTENT_VERSION), LLInventoryCacheFile::Reader::BAD_FORMAT);
+
+        // Counts in the header that the file cannot hold must fail the load
+        // rather than size anything from them.
+        auto patch_u32 = [&](const std::string& tag, size_t offset, U32 value)
+        {
+            std::string damaged = contents;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                damaged[offset + i] = (char)(value >> (8 * i));
+            }
+            std::string name = tempFile(tag);
+            std::ofstream out(name, std::ios::binary);
+            out.write(damaged.data(), damaged.size());
+            return name;
+        };
+        const size_t CHUNK_COUNT_OFFSET = 24;
+        const size_t FIRST_CHUNK_RECORDS_OFFSET = 36;
+        const size_t FIRST_CHUNK_RAW_SIZE_OFFSET = 40;
+        ensure_equals("chunk count", reader.load(patch_u32("chunks", CHUNK_COUNT_OFFSET, 0xFFFFFFF0), CONTENT_VERSION),
+                      LLInventoryCacheFile::Reader::BAD_FORMAT);
+        ensure_equals("record count", reader.load(patch_u32("records", FIRST_CHUNK_RECORDS_OFFSET, 0x7FFFFFFF), CONTENT_VERSION),
+                      LLInventoryCacheFile::Reader::BAD_FORMAT);
+        ensure_equals("raw size", reader.load(patch_u32("raw", FIRST_CHUNK_RAW_SIZE_OFFSET, 0xFFFFFFFF), CONTENT_VERSION),
+                      LLInventoryCacheFile::Reader::BAD_FORMAT);
+
+        std::string legacy = tempFile("legacy");
+        {
+            std::ofstream out(legacy, std::ios::binary);
+            out << "{'inv_cache_version':i3}\n";
+        }
+        ensure_equals("legacy LLSD cache", reader.load(legacy, CONTENT_VERSION), LLInventoryCacheFile::Reader::BAD_FORMAT);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("large inventory load");
+        // Not a pass/fail test: reports save and load times of a synthetic
+        // inventory of LL_INVENTORY_CACHE_BENCH_ITEMS items (300000 is
+        // about a large real one) against the LLSD notation lines it replaces.
+        std::string count_str = LLStringUtil::getenv("LL_INVENTORY_CACHE_BENCH_ITEMS");
+        if (count_str.empty())
+        {
+            skip("set LL_INVENTORY_CACHE_BENCH_ITEMS to run");
+        }
+        U32 item_count = (U32)strtoul(count_str.c_str(), nullptr, 10);
+        Inventory inv = make_inventory(llmax(item_count / 40, 1U), item_count);
+        std::string filename = tempFile("bench");
+
+        using clock = std::chrono::steady_clock;
+        auto start = clock::now();
+        ensure("save", save_inventory(inv, filename, "InventoryCacheTest"));
+        auto binary_save = clock::now() - start;
+
+        start = clock::now();
+        LLInventoryCacheFile::Reader reader;
+        ensure_equals("load", reader.load(filename, CONTENT_VERSION, "InventoryCacheTest"), LLInventoryCacheFile::Reader::OK);
+        LLInventoryItem::item_array_t items;
+        ensure("items", reader.getItems(items, nullptr, "InventoryCacheTest"));
+        auto binary_load = clock::now() - start;
+        ensure_equals("item count", items.size(), inv.mItems.size());
+
+        start = clock::now();
+        LLInventoryCacheFile::Reader inline_reader;
+        inline_reader.load(filename, CONTENT_VERSION, "NoSuchQueue");
+        LLInventoryItem::item_array_t inline_items;
+        inline_reader.getItems(inline_items, nullptr, "NoSuchQueue");
+        auto binary_load_inline = clock::now() - start;
+
+        // The old format: one notation line per record, parsed line by line.
+        std::ostringstream notation;
+        for (const auto& item : inv.mItems)
+        {
+            notation << LLSDOStreamer<LLSDNotationFormatter>(item->asLLSD()) << '\n';
+        }
+        std::string lines = notation.str();
+
+        start = clock::now();
+        std::istringstream in(lines);
+        std::string line;
+        LLPointer<LLSDParser> parser = new LLSDNotationParser();
+        size_t parsed = 0;
+        while (std::getline(in, line))
+        {
+            LLSD sd;
+            std::istringstream iss(line);
+            parser->parse(iss, sd, line.length());
+            LLPointer<LLInventoryItem> item = new LLInventoryItem;
+            parsed += item->fromLLSD(sd);
+        }
+        auto notation_load = clock::now() - start;
+        ensure_equals("notation items", parsed, inv.mItems.size());
+
+        std::cout << "\n" << item_count << " items, " << std::filesystem::file_size(filename)
+                  << " bytes on disk (notation " << lines.size() << " bytes before gzip)\n"
+                  << "  binary save:          " << seconds(binary_save) << " s\n"
+                  << "  binary load, pooled:  " << seconds(binary_load) << " s\n"
+                  << "  binary load, inline:  " << seconds(binary_load_inline) << " s\n"
+                  << "  notation parse only:  " << seconds(notation_load) << " s" << std::endl;
+    }
+} // namespace tut
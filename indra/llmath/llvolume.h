@@ -1127,6 +1127,9 @@ protected:
 public:
     bool unpackVolumeFaces(std::istream& is, S32 size);
     bool unpackVolumeFaces(U8* in_data, S32 size);
+    // <3T:TommyTheTerrible> Build faces from an already inflated and parsed mesh block.
+    bool unpackVolumeFaces(const LLSD& mdl) { return unpackVolumeFacesInternal(mdl); }
+    // </3T:TommyTheTerrible>
 private:
     bool unpackVolumeFacesInternal(const LLSD& mdl);
 
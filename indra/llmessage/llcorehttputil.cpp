@@ -37,6 +37,7 @@
 #include "llsdserialize.h"
 #include "boost/json.hpp" // Boost.Json
 #include "llfilesystem.h"
+#include "llasyncfilesystem.h" // <3T:TommyTheTerrible/>
 
 #include "message.h" // for getting the port
 
@@ -117,9 +118,15 @@ bool responseToLLSD(HttpResponse * response, bool log, LLSD & out_llsd)
         return false;
     }
 
-    LLCore::BufferArrayStream bas(body);
+    // <3T:TommyTheTerrible> Parse in place rather than through a stream
+    //LLCore::BufferArrayStream bas(body);
+    //LLSD body_llsd;
+    //S32 parse_status(LLSDSerialize::fromXML(body_llsd, bas, log));
+    std::vector<char> flat(body->size());
+    body->read(0, flat.data(), flat.size());
     LLSD body_llsd;
-    S32 parse_status(LLSDSerialize::fromXML(body_llsd, bas, log));
+    S32 parse_status(LLSDSerialize::fromXMLBuffer(body_llsd, flat.data(), flat.size(), log));
+    // </3T:TommyTheTerrible>
     if (LLSDParser::PARSE_FAILURE == parse_status){
         return false;
     }
@@ -594,7 +601,10 @@ LLSD HttpCoroJSONHandler::handleSuccess(LLCore::HttpResponse * response, LLCore:
     LLCore::BufferArrayStream bas(body);
 
     boost::system::error_code ec;
-    boost::json::value jsonRoot = boost::json::parse(bas, ec);
+    // <3T:TommyTheTerrible> Build the LLSD as the JSON is parsed
+    //boost::json::value jsonRoot = boost::json::parse(bas, ec);
+    LLSD converted = LlsdFromJsonStream(bas, ec);
+    // </3T:TommyTheTerrible>
     if(ec.failed())
     {   // deserialization failed.  Record the reason and pass back an empty map for markup.
         status = LLCore::HttpStatus(499, std::string(ec.what()));
@@ -602,7 +612,10 @@ LLSD HttpCoroJSONHandler::handleSuccess(LLCore::HttpResponse * response, LLCore:
     }
 
     // Convert the JSON structure to LLSD
-    result = LlsdFromJson(jsonRoot);
+    // <3T:TommyTheTerrible> Already converted
+    //result = LlsdFromJson(jsonRoot);
+    result = converted;
+    // </3T:TommyTheTerrible>
 
     return result;
 }
@@ -619,7 +632,10 @@ LLSD HttpCoroJSONHandler::parseBody(LLCore::HttpResponse *response, bool &succes
     LLCore::BufferArrayStream bas(body);
 
     boost::system::error_code ec;
-    boost::json::value jsonRoot = boost::json::parse(bas, ec);
+    // <3T:TommyTheTerrible> Build the LLSD as the JSON is parsed
+    //boost::json::value jsonRoot = boost::json::parse(bas, ec);
+    LLSD converted = LlsdFromJsonStream(bas, ec);
+    // </3T:TommyTheTerrible>
     if (ec.failed())
     {
         success = false;
@@ -627,7 +643,10 @@ LLSD HttpCoroJSONHandler::parseBody(LLCore::HttpResponse *response, bool &succes
     }
 
     // Convert the JSON structure to LLSD
-    return LlsdFromJson(jsonRoot);
+    // <3T:TommyTheTerrible> Already converted
+    //return LlsdFromJson(jsonRoot);
+    return converted;
+    // </3T:TommyTheTerrible>
 }
 
 //========================================================================
@@ -778,15 +797,30 @@ LLSD HttpCoroutineAdapter::postFileAndSuspend(LLCore::HttpRequest::ptr_t request
     // scoping for our streams so that they go away when we no longer need them.
     {
         LLCore::BufferArrayStream outs(fileData.get());
-        LLFileSystem vfile(assetId, assetType, LLFileSystem::READ);
-
-        S32 fileSize = vfile.getSize();
-        U8* fileBuffer;
-        fileBuffer = new U8[fileSize];
-        vfile.read(fileBuffer, fileSize);
+        // <3T:TommyTheTerrible> Read the cache file without blocking this coroutine's thread
+        //LLFileSystem vfile(assetId, assetType, LLFileSystem::READ);
+
+        //S32 fileSize = vfile.getSize();
+        //U8* fileBuffer;
+        //fileBuffer = new U8[fileSize];
+        //vfile.read(fileBuffer, fileSize);
+
+        //outs.write((char*)fileBuffer, fileSize);
+        //delete[] fileBuffer;
+        LLAsyncFileSystem::buffer_t fileBuffer;
+        if (LLAsyncFileSystem* files = LLAsyncFileSystem::getInstance())
+        {
+            files->read(assetId, assetType, fileBuffer);
+        }
+        else
+        {
+            LLFileSystem vfile(assetId, assetType, LLFileSystem::READ);
+            fileBuffer.resize(vfile.getSize());
+            vfile.read(fileBuffer.data(), (S32)fileBuffer.size());
+        }
 
-        outs.write((char*)fileBuffer, fileSize);
-        delete[] fileBuffer;
+        outs.write((char*)fileBuffer.data(), fileBuffer.size());
+        // </3T:TommyTheTerrible>
     }
 
     return postAndSuspend(request, url, fileData, options, headers);
@@ -803,8 +837,11 @@ LLSD HttpCoroutineAdapter::postJsonAndSuspend(LLCore::HttpRequest::ptr_t request
 
     {
         LLCore::BufferArrayStream outs(rawbody.get());
-        auto root = LlsdToJson(body);
-        std::string value = boost::json::serialize(root);
+        // <3T:TommyTheTerrible> Write the JSON straight from the LLSD
+        //auto root = LlsdToJson(body);
+        //std::string value = boost::json::serialize(root);
+        std::string value = LlsdToJsonString(body);
+        // </3T:TommyTheTerrible>
 
         LL_WARNS("Http::post") << "JSON Generates: \"" << value << "\"" << LL_ENDL;
 
@@ -862,8 +899,11 @@ LLSD HttpCoroutineAdapter::putJsonAndSuspend(LLCore::HttpRequest::ptr_t request,
 
     {
         LLCore::BufferArrayStream outs(rawbody.get());
-        auto root = LlsdToJson(body);
-        std::string value = boost::json::serialize(root);
+        // <3T:TommyTheTerrible> Write the JSON straight from the LLSD
+        //auto root = LlsdToJson(body);
+        //std::string value = boost::json::serialize(root);
+        std::string value = LlsdToJsonString(body);
+        // </3T:TommyTheTerrible>
 
         LL_WARNS("Http::put") << "JSON Generates: \"" << value << "\"" << LL_ENDL;
         outs << value;
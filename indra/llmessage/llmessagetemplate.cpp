@@ -67,6 +67,30 @@ void LLMsgData::addDataFast(char *blockname, char *varname, const void *data, S3
     }
 }
 
+// <3T:TommyTheTerrible> Flat decoding tables
+void LLMessageTemplate::compileDecodeTables()
+{
+    mDecodeTables.mBlocks.clear();
+    mDecodeTables.mVariables.clear();
+    mDecodeTables.mBlocks.reserve(mMemberBlocks.size());
+    for (const LLMessageBlock* block : mMemberBlocks)
+    {
+        LLMessageDecodeBlock decode_block;
+        decode_block.mName = block->mName;
+        decode_block.mType = block->mType;
+        decode_block.mNumber = block->mNumber;
+        decode_block.mFirstVariable = static_cast<S32>(mDecodeTables.mVariables.size());
+        decode_block.mVariableCount = static_cast<S32>(block->mMemberVariables.size());
+        for (const LLMessageVariable* variable : block->mMemberVariables)
+        {
+            mDecodeTables.mVariables.push_back({ variable->getName(), variable->getType(), variable->getSize() });
+        }
+        mDecodeTables.mBlocks.push_back(decode_block);
+    }
+    mDecodeTables.mCompiled = true;
+}
+// </3T:TommyTheTerrible>
+
 // LLMessageVariable functions and friends
 
 std::ostream& operator<<(std::ostream& s, LLMessageVariable &msg)
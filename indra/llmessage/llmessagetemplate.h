@@ -237,6 +237,34 @@ public:
 };
 
 
+// <3T:TommyTheTerrible> Flat decoding tables
+// A message template compiled down to what LLTemplateMessageReader needs to
+// decode a packet: the blocks in wire order, each with its variables in wire
+// order, in two flat arrays. Decoding walks these instead of the name maps.
+struct LLMessageDecodeVariable
+{
+    char*               mName;
+    EMsgVariableType    mType;
+    S32                 mSize;  // the value for a fixed variable, its length prefix for MVT_VARIABLE
+};
+
+struct LLMessageDecodeBlock
+{
+    char*               mName;
+    EMsgBlockType       mType;
+    S32                 mNumber;        // instances of an MBT_MULTIPLE block
+    S32                 mFirstVariable; // into LLMessageDecodeTables::mVariables
+    S32                 mVariableCount;
+};
+
+struct LLMessageDecodeTables
+{
+    std::vector<LLMessageDecodeBlock>       mBlocks;
+    std::vector<LLMessageDecodeVariable>    mVariables;
+    bool                                    mCompiled = false;
+};
+// </3T:TommyTheTerrible>
+
 enum EMsgFrequency
 {
     MFT_NULL    = 0,  // value is size of message number in bytes
@@ -308,6 +336,7 @@ public:
                 << "has already been used as a block name!" << LL_ENDL;
         }
         *member_blockp = blockp;
+        mDecodeTables.mCompiled = false; // <3T:TommyTheTerrible/>
         if (  (mTotalSize != -1)
             &&(blockp->mTotalSize != -1)
             &&(  (blockp->mType == MBT_SINGLE)
@@ -409,6 +438,20 @@ public:
         return iter != mMemberBlocks.end()? *iter : NULL;
     }
 
+    // <3T:TommyTheTerrible> Flat decoding tables
+    // Built when the template is registered, or on first use for templates
+    // that never are; adding a block rebuilds them.
+    void compileDecodeTables();
+    const LLMessageDecodeTables& getDecodeTables()
+    {
+        if (!mDecodeTables.mCompiled)
+        {
+            compileDecodeTables();
+        }
+        return mDecodeTables;
+    }
+    // </3T:TommyTheTerrible>
+
 public:
     typedef LLIndexedVector<LLMessageBlock*, char*, 8> message_block_map_t;
     message_block_map_t                     mMemberBlocks;
@@ -431,6 +474,8 @@ public:
     bool                                    mBanFromUntrusted;
 
 private:
+    LLMessageDecodeTables                   mDecodeTables; // <3T:TommyTheTerrible/>
+
     // message handler function (this is set by each application)
     void                                    (*mHandlerFunc)(LLMessageSystem *msgsystem, void **user_data);
     void                                    **mUserData;
@@ -46,6 +46,18 @@ public:
     void init(S32 hSocket);
     void init(const char* buffer, S32 data_size, const LLHost& host);
 
+    // <3T:TommyTheTerrible> Batched UDP receive
+    // For receiving straight into the buffer: point a datagram at
+    // getReceiveBuffer(), then record what arrived.
+    char*       getReceiveBuffer()              { return mData; }
+    void        setReceived(S32 size, const LLHost& sender, const LLHost& receiving_if)
+    {
+        mSize = size;
+        mHost = sender;
+        mReceivingIF = receiving_if;
+    }
+    // </3T:TommyTheTerrible>
+
 protected:
     char    mData[NET_BUFFER_SIZE]; // packet data       /* Flawfinder : ignore */
     S32     mSize;                  // size of buffer in bytes
@@ -71,6 +71,18 @@ LLPacketRing::~LLPacketRing ()
 S32 LLPacketRing::receivePacket (S32 socket, char *datap)
 {
     bool drop = computeDrop();
+    // <3T:TommyTheTerrible> Batched UDP receive
+    // With the ring empty, take everything that is waiting in one call and
+    // hand it out from the ring, rather than a call per packet.
+    if (mNumBufferedPackets == 0 && useBatchedReceive())
+    {
+        bufferInboundBatch(socket);
+        if (mNumBufferedPackets == 0)
+        {
+            return 0;
+        }
+    }
+    // </3T:TommyTheTerrible>
     return (mNumBufferedPackets > 0) ?
         receiveOrDropBufferedPacket(datap, drop) :
         receiveOrDropPacket(socket, datap, drop);
@@ -141,9 +153,11 @@ S32 LLPacketRing::receiveOrDropPacket(S32 socket, char *datap, bool drop)
     {
         char buffer[NET_BUFFER_SIZE + SOCKS_HEADER_SIZE];   /* Flawfinder ignore */
         packet_size = receive_packet(socket, buffer);
+        ++mReceiveCalls; // <3T:TommyTheTerrible/>
         if (packet_size > 0)
         {
             mActualBytesIn += packet_size;
+            ++mReceivedPackets; // <3T:TommyTheTerrible/>
         }
 
         if (packet_size > SOCKS_HEADER_SIZE)
@@ -171,9 +185,11 @@ S32 LLPacketRing::receiveOrDropPacket(S32 socket, char *datap, bool drop)
     else
     {
         packet_size = receive_packet(socket, datap);
+        ++mReceiveCalls; // <3T:TommyTheTerrible/>
         if (packet_size > 0)
         {
             mActualBytesIn += packet_size;
+            ++mReceivedPackets; // <3T:TommyTheTerrible/>
             if (drop)
             {
                 packet_size = 0;
@@ -233,9 +249,11 @@ S32 LLPacketRing::bufferInboundPacket(S32 socket)
     {
         char buffer[NET_BUFFER_SIZE + SOCKS_HEADER_SIZE];   /* Flawfinder ignore */
         packet_size = receive_packet(socket, buffer);
+        ++mReceiveCalls; // <3T:TommyTheTerrible/>
         if (packet_size > 0)
         {
             mActualBytesIn += packet_size;
+            ++mReceivedPackets; // <3T:TommyTheTerrible/>
             if (packet_size > SOCKS_HEADER_SIZE)
             {
                 // *FIX We are assuming ATYP is 0x01 (IPv4), not 0x03 (hostname) or 0x04 (IPv6)
@@ -268,11 +286,31 @@ S32 LLPacketRing::bufferInboundPacket(S32 socket)
     }
     else
     {
-        packet->init(socket);
-        packet_size = packet->getSize();
+        // <3T:TommyTheTerrible> Batched UDP receive
+        //packet->init(socket);
+        //packet_size = packet->getSize();
+        if (mNumBufferedPackets == mPacketRing.size())
+        {
+            // this slot holds the oldest packet: keep it intact until
+            // something arrives to replace it
+            char buffer[NET_BUFFER_SIZE];   /* Flawfinder ignore */
+            packet_size = receive_packet(socket, buffer);
+            if (packet_size > 0)
+            {
+                packet->init(buffer, packet_size, ::get_sender());
+            }
+        }
+        else
+        {
+            packet->init(socket);
+            packet_size = packet->getSize();
+        }
+        // </3T:TommyTheTerrible>
+        ++mReceiveCalls; // <3T:TommyTheTerrible/>
         if (packet_size > 0)
         {
             mActualBytesIn += packet_size;
+            ++mReceivedPackets; // <3T:TommyTheTerrible/>
 
             mHeadIndex = (mHeadIndex + 1) % (S16)(mPacketRing.size());
             if (mNumBufferedPackets < MAX_BUFFER_RING_SIZE)
@@ -290,18 +328,101 @@ S32 LLPacketRing::bufferInboundPacket(S32 socket)
     return packet_size;
 }
 
+// <3T:TommyTheTerrible> Batched UDP receive
+bool LLPacketRing::useBatchedReceive() const
+{
+    // SOCKS replies need unwrapping one at a time
+    return mBatchedReceive && !LLProxy::isSOCKSProxyEnabled();
+}
+
+S32 LLPacketRing::bufferInboundBatch(S32 socket)
+{
+    if (mNumBufferedPackets == mPacketRing.size() && mNumBufferedPackets < MAX_BUFFER_RING_SIZE)
+    {
+        expandRing();
+    }
+
+    const S16 ring_size = (S16)(mPacketRing.size());
+    const S32 free_slots = ring_size - mNumBufferedPackets;
+    if (free_slots == 0)
+    {
+        // full at the largest size: overwrite the oldest packet, as before
+        return (bufferInboundPacket(socket) > 0) ? 1 : 0;
+    }
+
+    // receive straight into the free packet buffers after mHeadIndex
+    const S16 first_slot = mHeadIndex;
+    LLNetDatagram datagrams[NET_RECEIVE_BATCH_MAX];
+    const S32 max_count = llmin(free_slots, NET_RECEIVE_BATCH_MAX);
+    for (S32 i = 0; i < max_count; ++i)
+    {
+        datagrams[i].mData = mPacketRing[(first_slot + i) % ring_size]->getReceiveBuffer();
+    }
+    S32 receive_calls = 0;
+    S32 count = receive_packets(socket, datagrams, max_count, receive_calls);
+    mReceiveCalls += receive_calls;
+
+    for (S32 i = 0; i < count; ++i)
+    {
+        const LLNetDatagram& datagram = datagrams[i];
+        if (datagram.mSize <= 0)
+        {
+            // nothing to deliver; its buffer stays free
+            continue;
+        }
+        S16 slot = (first_slot + i) % ring_size;
+        S16 head = mHeadIndex;
+        if (slot != head)
+        {
+            // an empty datagram was skipped: close the gap
+            std::swap(mPacketRing[slot], mPacketRing[head]);
+        }
+        mPacketRing[head]->setReceived(datagram.mSize,
+                                       LLHost(datagram.mSenderIP, datagram.mSenderPort),
+                                       LLHost(datagram.mReceivingIFIP, INVALID_PORT));
+        mActualBytesIn += datagram.mSize;
+        ++mReceivedPackets;
+        mHeadIndex = (mHeadIndex + 1) % ring_size;
+        ++mNumBufferedPackets;
+        mNumBufferedBytes += datagram.mSize;
+    }
+    return count;
+}
+
+F32 LLPacketRing::getPacketsPerReceiveCall() const
+{
+    return mReceiveCalls ? (F32)mReceivedPackets / (F32)mReceiveCalls : 0.f;
+}
+// </3T:TommyTheTerrible>
+
 S32 LLPacketRing::drainSocket(S32 socket)
 {
     // drain into buffer
     S32 packet_size = 1;
     S32 num_loops = 0;
     S32 old_num_packets = mNumBufferedPackets;
+    // <3T:TommyTheTerrible> Batched UDP receive
+    S32 num_received = 0;
+    if (useBatchedReceive())
+    {
+        S32 count = 0;
+        while ((count = bufferInboundBatch(socket)) > 0)
+        {
+            num_received += count;
+        }
+    }
+    else
+    {
     while (packet_size > 0)
     {
         packet_size = bufferInboundPacket(socket);
         ++num_loops;
     }
-    S32 num_dropped_packets = (num_loops - 1 + old_num_packets) - mNumBufferedPackets;
+        num_received = num_loops - 1;
+    }
+    //S32 num_dropped_packets = (num_loops - 1 + old_num_packets) - mNumBufferedPackets;
+    S32 num_dropped_packets = (num_received + old_num_packets) - mNumBufferedPackets;
+    // </3T:TommyTheTerrible>
     if (num_dropped_packets > 0)
     {
         // It will eventually be accounted by mDroppedPackets
@@ -360,6 +481,11 @@ void LLPacketRing::dumpPacketRingStats()
                           << "Dropped packets total: " << mNumDroppedPacketsTotal << std::endl
                           << "Dropped packets percentage: " << mDropPercentage << "%" << std::endl
                           << "Actual in bytes: " << mActualBytesIn << std::endl
-                          << "Actual out bytes: " << mActualBytesOut << LL_ENDL;
+                          << "Actual out bytes: " << mActualBytesOut << std::endl
+                          // <3T:TommyTheTerrible> Batched UDP receive
+                          << "Batched receive: " << (useBatchedReceive() ? "on" : "off") << std::endl
+                          << "Receive calls: " << mReceiveCalls << std::endl
+                          << "Packets per receive call: " << getPacketsPerReceiveCall() << LL_ENDL;
+                          // </3T:TommyTheTerrible>
     mNumDroppedPackets = 0;
 }
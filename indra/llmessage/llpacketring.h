@@ -66,6 +66,18 @@ public:
 
     F32 getBufferLoadRate() const; // from 0 to 4 (0 - empty, 1 - default size is full)
     void dumpPacketRingStats();
+
+    // <3T:TommyTheTerrible> Batched UDP receive
+    // Take everything waiting on the socket into the ring in as few calls as
+    // possible (recvmmsg on Linux). Not used through a SOCKS proxy.
+    void setBatchedReceive(bool enabled) { mBatchedReceive = enabled; }
+    bool getBatchedReceive() const { return mBatchedReceive; }
+
+    // Socket receive calls made so far and the packets they returned.
+    U64 getReceiveCallCount() const { return mReceiveCalls; }
+    U64 getReceivedPacketCount() const { return mReceivedPackets; }
+    F32 getPacketsPerReceiveCall() const;
+    // </3T:TommyTheTerrible>
 protected:
     // returns 'true' if we should intentionally drop a packet
     bool computeDrop();
@@ -80,6 +92,12 @@ protected:
     // returns 'true' if ring was expanded
     bool expandRing();
 
+    // <3T:TommyTheTerrible> Batched UDP receive
+    bool useBatchedReceive() const;
+    // returns number of datagrams taken from the socket
+    S32 bufferInboundBatch(S32 socket);
+    // </3T:TommyTheTerrible>
+
 protected:
     std::vector<LLPacketBuffer*> mPacketRing;
     S16 mHeadIndex { 0 };
@@ -93,6 +111,12 @@ protected:
     F32 mDropPercentage { 0.0f };   // % of inbound packets to drop
     U32 mPacketsToDrop { 0 };       // drop next inbound n packets
 
+    // <3T:TommyTheTerrible> Batched UDP receive
+    bool mBatchedReceive { true };
+    U64 mReceiveCalls { 0 };
+    U64 mReceivedPackets { 0 };
+    // </3T:TommyTheTerrible>
+
     // These are the sender and receiving_interface for the last packet delivered by receivePacket()
     LLHost mLastSender;
     LLHost mLastReceivingIF;
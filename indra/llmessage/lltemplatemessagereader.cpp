@@ -44,7 +44,13 @@ LLTemplateMessageReader::LLTemplateMessageReader(message_template_number_map_t&
                                                  number_template_map) :
     mReceiveSize(0),
     mCurrentRMessageTemplate(NULL),
-    mCurrentRMessageData(NULL),
+    // <3T:TommyTheTerrible> Flat decoding tables
+    //mCurrentRMessageData(NULL),
+    mDecodeTables(NULL),
+    mHaveDecodedData(false),
+    mLastBlock(-1),
+    mLastVariable(-1),
+    // </3T:TommyTheTerrible>
     mMessageNumbers(number_template_map)
 {
 }
@@ -52,8 +58,10 @@ LLTemplateMessageReader::LLTemplateMessageReader(message_template_number_map_t&
 //virtual
 LLTemplateMessageReader::~LLTemplateMessageReader()
 {
-    delete mCurrentRMessageData;
-    mCurrentRMessageData = NULL;
+    // <3T:TommyTheTerrible> Flat decoding tables
+    //delete mCurrentRMessageData;
+    //mCurrentRMessageData = NULL;
+    // </3T:TommyTheTerrible>
 }
 
 //virtual
@@ -61,10 +69,67 @@ void LLTemplateMessageReader::clearMessage()
 {
     mReceiveSize = -1;
     mCurrentRMessageTemplate = NULL;
-    delete mCurrentRMessageData;
-    mCurrentRMessageData = NULL;
+    // <3T:TommyTheTerrible> Flat decoding tables
+    // The vectors keep their capacity for the next message.
+    //delete mCurrentRMessageData;
+    //mCurrentRMessageData = NULL;
+    mDecodeTables = NULL;
+    mHaveDecodedData = false;
+    // </3T:TommyTheTerrible>
 }
 
+// <3T:TommyTheTerrible> Flat decoding tables
+// Names are canonical strings, so a pointer compare is enough. Handlers
+// read one block's variables in template order, so start from where the
+// last lookup ended.
+S32 LLTemplateMessageReader::findBlock(const char* blockname)
+{
+    const std::vector<LLMessageDecodeBlock>& blocks = mDecodeTables->mBlocks;
+    if (mLastBlock >= 0 && blocks[mLastBlock].mName == blockname)
+    {
+        return mLastBlock;
+    }
+    for (S32 i = 0; i < (S32)blocks.size(); ++i)
+    {
+        if (blocks[i].mName == blockname)
+        {
+            mLastBlock = i;
+            mLastVariable = -1;
+            return i;
+        }
+    }
+    return -1;
+}
+
+S32 LLTemplateMessageReader::findVariable(S32 block, const char* varname)
+{
+    const LLMessageDecodeBlock& decode_block = mDecodeTables->mBlocks[block];
+    const LLMessageDecodeVariable* variables = &mDecodeTables->mVariables[decode_block.mFirstVariable];
+    const S32 count = decode_block.mVariableCount;
+    S32 index = (block == mLastBlock && mLastVariable >= 0) ? mLastVariable + 1 : 0;
+    for (S32 i = 0; i < count; ++i, ++index)
+    {
+        if (index >= count)
+        {
+            index = 0;
+        }
+        if (variables[index].mName == varname)
+        {
+            mLastBlock = block;
+            mLastVariable = index;
+            return index;
+        }
+    }
+    return -1;
+}
+
+const LLTemplateMessageReader::DecodedVariable& LLTemplateMessageReader::getDecoded(S32 block, S32 blocknum, S32 variable) const
+{
+    const DecodedBlock& decoded = mDecodedBlocks[block];
+    return mDecodedVariables[decoded.mFirstSlot + blocknum * mDecodeTables->mBlocks[block].mVariableCount + variable];
+}
+// </3T:TommyTheTerrible>
+
 void LLTemplateMessageReader::getData(const char *blockname, const char *varname, void *datap, S32 size, S32 blocknum, S32 max_size)
 {
     // is there a message ready to go?
@@ -74,80 +139,81 @@ void LLTemplateMessageReader::getData(const char *blockname, const char *varname
         return;
     }
 
-    if (!mCurrentRMessageData)
+    // <3T:TommyTheTerrible> Flat decoding tables
+    if (!mHaveDecodedData)
     {
-        LL_ERRS() << "Invalid mCurrentMessageData in getData!" << LL_ENDL;
+        LL_ERRS() << "No decoded message data in getData!" << LL_ENDL;
         return;
     }
 
-    char *bnamep = (char *)blockname + blocknum; // this works because it's just a hash.  The bnamep is never derefference
-    char *vnamep = (char *)varname;
-
-    LLMsgData::msg_blk_data_map_t::const_iterator iter = mCurrentRMessageData->mMemberBlocks.find(bnamep);
-
-    if (iter == mCurrentRMessageData->mMemberBlocks.end())
+    S32 block = findBlock(blockname);
+    if (block < 0 || blocknum < 0 || blocknum >= mDecodedBlocks[block].mCount)
     {
         LL_ERRS() << "Block " << blockname << " #" << blocknum
-            << " not in message " << mCurrentRMessageData->mName << LL_ENDL;
+            << " not in message " << mCurrentRMessageTemplate->mName << LL_ENDL;
         return;
     }
 
-    LLMsgBlkData *msg_block_data = iter->second;
-    LLMsgBlkData::msg_var_data_map_t &var_data_map = msg_block_data->mMemberVarData;
-
-    if (var_data_map.find(vnamep) == var_data_map.end())
+    S32 variable = findVariable(block, varname);
+    if (variable < 0)
     {
-        LL_ERRS() << "Variable "<< vnamep << " not in message "
-            << mCurrentRMessageData->mName<< " block " << bnamep << LL_ENDL;
+        LL_ERRS() << "Variable "<< varname << " not in message "
+            << mCurrentRMessageTemplate->mName << " block " << blockname << LL_ENDL;
         return;
     }
 
-    LLMsgVarData& vardata = msg_block_data->mMemberVarData[vnamep];
+    const DecodedVariable& vardata = getDecoded(block, blocknum, variable);
+    const S32 vardata_size = vardata.mSize;
 
-    if (size && size != vardata.getSize())
+    if (size && size != vardata_size)
     {
-        LL_ERRS() << "Msg " << mCurrentRMessageData->mName
-            << " variable " << vnamep
-            << " is size " << vardata.getSize()
+        LL_ERRS() << "Msg " << mCurrentRMessageTemplate->mName
+            << " variable " << varname
+            << " is size " << vardata_size
             << " but copying into buffer of size " << size
             << LL_ENDL;
         return;
     }
 
+    if (!vardata_size)
+    {
+        return;
+    }
 
-    const S32 vardata_size = vardata.getSize();
+    // Values sit back to back in mDecodedBytes, so they are not aligned.
+    const U8* data = &mDecodedBytes[vardata.mOffset];
     if( max_size >= vardata_size )
     {
         switch( vardata_size )
         {
         case 1:
-            *((U8*)datap) = *((U8*)vardata.getData());
+            *((U8*)datap) = *data;
             break;
         case 2:
-            *((U16*)datap) = *((U16*)vardata.getData());
+            memcpy(datap, data, 2);
             break;
         case 4:
-            *((U32*)datap) = *((U32*)vardata.getData());
+            memcpy(datap, data, 4);
             break;
         case 8:
-            ((U32*)datap)[0] = ((U32*)vardata.getData())[0];
-            ((U32*)datap)[1] = ((U32*)vardata.getData())[1];
+            memcpy(datap, data, 8);
             break;
         default:
-            memcpy(datap, vardata.getData(), vardata_size);
+            memcpy(datap, data, vardata_size);
             break;
         }
     }
     else
     {
-        LL_WARNS() << "Msg " << mCurrentRMessageData->mName
-            << " variable " << vnamep
-            << " is size " << vardata.getSize()
+        LL_WARNS() << "Msg " << mCurrentRMessageTemplate->mName
+            << " variable " << varname
+            << " is size " << vardata_size
             << " but truncated to max size of " << max_size
             << LL_ENDL;
 
-        memcpy(datap, vardata.getData(), max_size);
+        memcpy(datap, data, max_size);
     }
+    // </3T:TommyTheTerrible>
 }
 
 S32 LLTemplateMessageReader::getNumberOfBlocks(const char *blockname)
@@ -159,22 +225,21 @@ S32 LLTemplateMessageReader::getNumberOfBlocks(const char *blockname)
         return -1;
     }
 
-    if (!mCurrentRMessageData)
+    // <3T:TommyTheTerrible> Flat decoding tables
+    if (!mHaveDecodedData)
     {
-        LL_ERRS() << "Invalid mCurrentRMessageData in getData!" << LL_ENDL;
+        LL_ERRS() << "No decoded message data in getNumberOfBlocks!" << LL_ENDL;
         return -1;
     }
 
-    char *bnamep = (char *)blockname;
-
-    LLMsgData::msg_blk_data_map_t::const_iterator iter = mCurrentRMessageData->mMemberBlocks.find(bnamep);
-
-    if (iter == mCurrentRMessageData->mMemberBlocks.end())
+    S32 block = findBlock(blockname);
+    if (block < 0)
     {
         return 0;
     }
 
-    return (iter->second)->mBlockNumber;
+    return mDecodedBlocks[block].mCount;
+    // </3T:TommyTheTerrible>
 }
 
 S32 LLTemplateMessageReader::getSize(const char *blockname, const char *varname)
@@ -186,43 +251,38 @@ S32 LLTemplateMessageReader::getSize(const char *blockname, const char *varname)
         return LL_MESSAGE_ERROR;
     }
 
-    if (!mCurrentRMessageData)
+    // <3T:TommyTheTerrible> Flat decoding tables
+    if (!mHaveDecodedData)
     {   // This is a serious error - crash
-        LL_ERRS() << "Invalid mCurrentRMessageData in getData!" << LL_ENDL;
+        LL_ERRS() << "No decoded message data in getSize!" << LL_ENDL;
         return LL_MESSAGE_ERROR;
     }
 
-    char *bnamep = (char *)blockname;
-
-    LLMsgData::msg_blk_data_map_t::const_iterator iter = mCurrentRMessageData->mMemberBlocks.find(bnamep);
-
-    if (iter == mCurrentRMessageData->mMemberBlocks.end())
+    S32 block = findBlock(blockname);
+    if (block < 0 || !mDecodedBlocks[block].mCount)
     {   // don't crash
-        LL_INFOS() << "Block " << bnamep << " not in message "
-            << mCurrentRMessageData->mName << LL_ENDL;
+        LL_INFOS() << "Block " << blockname << " not in message "
+            << mCurrentRMessageTemplate->mName << LL_ENDL;
         return LL_BLOCK_NOT_IN_MESSAGE;
     }
 
-    char *vnamep = (char *)varname;
-
-    LLMsgBlkData* msg_data = iter->second;
-    LLMsgVarData& vardata = msg_data->mMemberVarData[vnamep];
-
-    if (!vardata.getName())
+    S32 variable = findVariable(block, varname);
+    if (variable < 0)
     {   // don't crash
         LL_INFOS() << "Variable " << varname << " not in message "
-            << mCurrentRMessageData->mName << " block " << bnamep << LL_ENDL;
+            << mCurrentRMessageTemplate->mName << " block " << blockname << LL_ENDL;
         return LL_VARIABLE_NOT_IN_BLOCK;
     }
 
-    if (mCurrentRMessageTemplate->mMemberBlocks[bnamep]->mType != MBT_SINGLE)
+    if (mDecodeTables->mBlocks[block].mType != MBT_SINGLE)
     {   // This is a serious error - crash
-        LL_ERRS() << "Block " << bnamep << " isn't type MBT_SINGLE,"
+        LL_ERRS() << "Block " << blockname << " isn't type MBT_SINGLE,"
             " use getSize with blocknum argument!" << LL_ENDL;
         return LL_MESSAGE_ERROR;
     }
 
-    return vardata.getSize();
+    return getDecoded(block, 0, variable).mSize;
+    // </3T:TommyTheTerrible>
 }
 
 S32 LLTemplateMessageReader::getSize(const char *blockname, S32 blocknum, const char *varname)
@@ -234,35 +294,31 @@ S32 LLTemplateMessageReader::getSize(const char *blockname, S32 blocknum, const
         return LL_MESSAGE_ERROR;
     }
 
-    if (!mCurrentRMessageData)
+    // <3T:TommyTheTerrible> Flat decoding tables
+    if (!mHaveDecodedData)
     {   // This is a serious error - crash
-        LL_ERRS() << "Invalid mCurrentRMessageData in getData!" << LL_ENDL;
+        LL_ERRS() << "No decoded message data in getSize!" << LL_ENDL;
         return LL_MESSAGE_ERROR;
     }
 
-    char *bnamep = (char *)blockname + blocknum;
-    char *vnamep = (char *)varname;
-
-    LLMsgData::msg_blk_data_map_t::const_iterator iter = mCurrentRMessageData->mMemberBlocks.find(bnamep);
-
-    if (iter == mCurrentRMessageData->mMemberBlocks.end())
+    S32 block = findBlock(blockname);
+    if (block < 0 || blocknum < 0 || blocknum >= mDecodedBlocks[block].mCount)
     {   // don't crash
-        LL_INFOS() << "Block " << bnamep << " not in message "
-            << mCurrentRMessageData->mName << LL_ENDL;
+        LL_INFOS() << "Block " << blockname << " #" << blocknum << " not in message "
+            << mCurrentRMessageTemplate->mName << LL_ENDL;
         return LL_BLOCK_NOT_IN_MESSAGE;
     }
 
-    LLMsgBlkData* msg_data = iter->second;
-    LLMsgVarData& vardata = msg_data->mMemberVarData[vnamep];
-
-    if (!vardata.getName())
+    S32 variable = findVariable(block, varname);
+    if (variable < 0)
     {   // don't crash
-        LL_INFOS() << "Variable " << vnamep << " not in message "
-            <<  mCurrentRMessageData->mName << " block " << bnamep << LL_ENDL;
+        LL_INFOS() << "Variable " << varname << " not in message "
+            <<  mCurrentRMessageTemplate->mName << " block " << blockname << LL_ENDL;
         return LL_VARIABLE_NOT_IN_BLOCK;
     }
 
-    return vardata.getSize();
+    return getDecoded(block, blocknum, variable).mSize;
+    // </3T:TommyTheTerrible>
 }
 
 void LLTemplateMessageReader::getBinaryData(const char *blockname,
@@ -539,8 +595,11 @@ bool LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
 
     llassert( mReceiveSize >= 0 );
     llassert( mCurrentRMessageTemplate);
-    llassert( !mCurrentRMessageData );
-    delete mCurrentRMessageData; // just to make sure
+    // <3T:TommyTheTerrible> Flat decoding tables
+    //llassert( !mCurrentRMessageData );
+    //delete mCurrentRMessageData; // just to make sure
+    llassert( !mHaveDecodedData );
+    // </3T:TommyTheTerrible>
 	// <FS:Beq> storage for Tracy tag
 	#ifdef TRACY_ENABLE
 	static char msgstr[36];
@@ -552,33 +611,57 @@ bool LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
     U8 offset = buffer[PHL_OFFSET];
     S32 decode_pos = LL_PACKET_ID_SIZE + (S32)(mCurrentRMessageTemplate->mFrequency) + offset;
 
-    // create base working data set
-    mCurrentRMessageData = new LLMsgData(mCurrentRMessageTemplate->mName);
+    // <3T:TommyTheTerrible> Flat decoding tables
+    // Walk the template's precompiled tables and copy each value into one
+    // buffer, instead of allocating a block and a map entry per value.
+    //mCurrentRMessageData = new LLMsgData(mCurrentRMessageTemplate->mName);
+    mDecodeTables = &mCurrentRMessageTemplate->getDecodeTables();
+    const std::vector<LLMessageDecodeBlock>& decode_blocks = mDecodeTables->mBlocks;
+    const std::vector<LLMessageDecodeVariable>& decode_variables = mDecodeTables->mVariables;
+    mDecodedBlocks.resize(decode_blocks.size());
+    mDecodedVariables.clear();
+    mDecodedBytes.clear();
+    mDecodedBytes.reserve(mReceiveSize);
+    mHaveDecodedData = true;
+    mLastBlock = -1;
+    mLastVariable = -1;
+    bool decoded_any_block = false;
+
+    auto add_data = [this](const U8* data, S32 size, EMsgVariableType type)
+    {
+        const S32 data_offset = (S32)mDecodedBytes.size();
+        if (size)
+        {
+            mDecodedBytes.resize(data_offset + size);
+            if (data)
+            {
+                htolememcpy(&mDecodedBytes[data_offset], data, type, size);
+            }
+        }
+        mDecodedVariables.push_back({ data_offset, size });
+    };
 
     // loop through the template building the data structure as we go
-    LLMessageTemplate::message_block_map_t::const_iterator iter;
-    for(iter = mCurrentRMessageTemplate->mMemberBlocks.begin();
-        iter != mCurrentRMessageTemplate->mMemberBlocks.end();
-        ++iter)
+    for (size_t block_index = 0; block_index < decode_blocks.size(); ++block_index)
     {
         LL_PROFILE_ZONE_NAMED_CATEGORY_NETWORK("BuildFromTemplate");
-        LLMessageBlock* mbci = *iter;
+        const LLMessageDecodeBlock& mbci = decode_blocks[block_index];
         U8  repeat_number;
         S32 i;
 
         // how many of this block?
 
-        if (mbci->mType == MBT_SINGLE)
+        if (mbci.mType == MBT_SINGLE)
         {
             // just one
             repeat_number = 1;
         }
-        else if (mbci->mType == MBT_MULTIPLE)
+        else if (mbci.mType == MBT_MULTIPLE)
         {
             // a known number
-            repeat_number = mbci->mNumber;
+            repeat_number = mbci.mNumber;
         }
-        else if (mbci->mType == MBT_VARIABLE)
+        else if (mbci.mType == MBT_VARIABLE)
         {
             // need to read the number from the message
             // repeat number is a single byte
@@ -603,50 +686,34 @@ bool LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
             return false;
         }
 
-        LLMsgBlkData* cur_data_block = NULL;
+        DecodedBlock& decoded_block = mDecodedBlocks[block_index];
+        decoded_block.mCount = repeat_number;
+        decoded_block.mFirstSlot = (S32)mDecodedVariables.size();
+        decoded_any_block |= (repeat_number != 0);
+
         // <FS:Beq> Tracy Message processing
-		LL_DEBUGS("LLMessage") << "Processing " << mbci->mName << " with " << repeat_number << " repetitions" << LL_ENDL;
+		LL_DEBUGS("LLMessage") << "Processing " << mbci.mName << " with " << repeat_number << " repetitions" << LL_ENDL;
 		#ifdef TRACY_ENABLE
-		strncpy(msgstr, mbci->mName, 35);
+		strncpy(msgstr, mbci.mName, 35);
 		LL_PROFILE_ZONE_TEXT(msgstr, 35);
 		#endif        
         // </FS:Beq>
 
         // now loop through the block
+        const LLMessageDecodeVariable* first_variable = decode_variables.data() + mbci.mFirstVariable;
+        const LLMessageDecodeVariable* end_variable = first_variable + mbci.mVariableCount;
         for (i = 0; i < repeat_number; i++)
         {
-            if (i)
-            {
-                // build new name to prevent collisions
-                // TODO: This should really change to a vector
-                cur_data_block = new LLMsgBlkData(mbci->mName, repeat_number);
-                cur_data_block->mName = mbci->mName + i;
-            }
-            else
-            {
-                cur_data_block = new LLMsgBlkData(mbci->mName, repeat_number);
-            }
-
-            // add the block to the message
-            mCurrentRMessageData->addBlock(cur_data_block);
-
             // now read the variables
-            for (LLMessageBlock::message_variable_map_t::const_iterator iter =
-                     mbci->mMemberVariables.begin();
-                 iter != mbci->mMemberVariables.end(); iter++)
+            for (const LLMessageDecodeVariable* variable = first_variable; variable != end_variable; ++variable)
             {
-				LL_PROFILE_ZONE_NAMED_CATEGORY_NETWORK("AddVariables");
-                const LLMessageVariable& mvci = **iter;
-
-                // ok, build out the variables
-                // add variable block
-                cur_data_block->addVariable(mvci.getName(), mvci.getType());
+                const LLMessageDecodeVariable& mvci = *variable;
 
                 // what type of variable?
-                if (mvci.getType() == MVT_VARIABLE)
+                if (mvci.mType == MVT_VARIABLE)
                 {
                     // variable, get the number of bytes to read from the template
-                    S32 data_size = mvci.getSize();
+                    S32 data_size = mvci.mSize;
                     U8 tsizeb = 0;
                     U16 tsizeh = 0;
                     U32 tsize = 0;
@@ -680,42 +747,38 @@ bool LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
                     }
                     decode_pos += data_size;
 
-                    cur_data_block->addData(mvci.getName(), &buffer[decode_pos], tsize, mvci.getType());
+                    add_data(&buffer[decode_pos], tsize, mvci.mType);
                     decode_pos += tsize;
                 }
                 else
                 {
                     // fixed!
                     // so, copy data pointer and set data size to fixed size
-                    if ((decode_pos + mvci.getSize()) > mReceiveSize)
+                    if ((decode_pos + mvci.mSize) > mReceiveSize)
                     {
-                        logRanOffEndOfPacket(sender, decode_pos, mvci.getSize());
+                        logRanOffEndOfPacket(sender, decode_pos, mvci.mSize);
 
                         // default to 0s.
-                        U32 size = mvci.getSize();
-                        std::vector<U8> data(size, 0);
-                        cur_data_block->addData(mvci.getName(), &(data[0]),
-                                                size, mvci.getType());
+                        add_data(NULL, mvci.mSize, mvci.mType);
                     }
                     else
                     {
-                        cur_data_block->addData(mvci.getName(),
-                                                &buffer[decode_pos],
-                                                mvci.getSize(),
-                                                mvci.getType());
+                        add_data(&buffer[decode_pos], mvci.mSize, mvci.mType);
                     }
-                    decode_pos += mvci.getSize();
+                    decode_pos += mvci.mSize;
                 }
             }
         }
     }
 
-    if (mCurrentRMessageData->mMemberBlocks.empty()
+    //if (mCurrentRMessageData->mMemberBlocks.empty()
+    if (!decoded_any_block
         && !mCurrentRMessageTemplate->mMemberBlocks.empty())
     {
         LL_DEBUGS() << "Empty message '" << mCurrentRMessageTemplate->mName << "' (no blocks)" << LL_ENDL;
         return false;
     }
+    // </3T:TommyTheTerrible>
 
     {
         // <FS:Beq> Tracy Message processing
@@ -848,5 +911,36 @@ void LLTemplateMessageReader::copyToBuilder(LLMessageBuilder& builder) const
     {
         return;
     }
-    builder.copyFromMessageData(*mCurrentRMessageData);
+    // <3T:TommyTheTerrible> Flat decoding tables
+    // Rebuild the per-block data the builder copies from. Only forwarded
+    // messages come through here, so this is off the hot path.
+    //builder.copyFromMessageData(*mCurrentRMessageData);
+    LLMsgData message_data(mCurrentRMessageTemplate->mName);
+    if (mHaveDecodedData)
+    {
+        for (size_t block_index = 0; block_index < mDecodedBlocks.size(); ++block_index)
+        {
+            const LLMessageDecodeBlock& decode_block = mDecodeTables->mBlocks[block_index];
+            const S32 count = mDecodedBlocks[block_index].mCount;
+            for (S32 blocknum = 0; blocknum < count; ++blocknum)
+            {
+                // the block number is added to the name to tell repeats apart
+                LLMsgBlkData* block_data = new LLMsgBlkData(decode_block.mName, count);
+                block_data->mName = decode_block.mName + blocknum;
+                message_data.addBlock(block_data);
+                for (S32 variable = 0; variable < decode_block.mVariableCount; ++variable)
+                {
+                    const LLMessageDecodeVariable& decode_variable =
+                        mDecodeTables->mVariables[decode_block.mFirstVariable + variable];
+                    const DecodedVariable& decoded = getDecoded((S32)block_index, blocknum, variable);
+                    block_data->addVariable(decode_variable.mName, decode_variable.mType);
+                    block_data->addData(decode_variable.mName,
+                                        decoded.mSize ? &mDecodedBytes[decoded.mOffset] : NULL,
+                                        decoded.mSize, decode_variable.mType);
+                }
+            }
+        }
+    }
+    builder.copyFromMessageData(message_data);
+    // </3T:TommyTheTerrible>
 }
@@ -30,9 +30,11 @@
 #include "llmessagereader.h"
 
 #include <map>
+#include <vector> // <3T:TommyTheTerrible/>
 
 class LLMessageTemplate;
 class LLMsgData;
+struct LLMessageDecodeTables; // <3T:TommyTheTerrible/>
 
 class LLTemplateMessageReader : public LLMessageReader
 {
@@ -118,9 +120,41 @@ private:
 
     bool decodeData(const U8* buffer, const LLHost& sender );
 
+    // <3T:TommyTheTerrible> Flat decoding tables
+    // Where one variable of one block instance landed in mDecodedBytes.
+    struct DecodedVariable
+    {
+        S32 mOffset;
+        S32 mSize;
+    };
+    // One per template block, in the order of the decode tables.
+    struct DecodedBlock
+    {
+        S32 mCount;     // instances in this message
+        S32 mFirstSlot; // into mDecodedVariables, then mVariableCount per instance
+    };
+
+    // Indexes into the decode tables, or -1 if the template has no such
+    // block or variable.
+    S32 findBlock(const char* blockname);
+    S32 findVariable(S32 block, const char* varname);
+    const DecodedVariable& getDecoded(S32 block, S32 blocknum, S32 variable) const;
+    // </3T:TommyTheTerrible>
+
     S32 mReceiveSize;
     LLMessageTemplate* mCurrentRMessageTemplate;
-    LLMsgData* mCurrentRMessageData;
+    // <3T:TommyTheTerrible> Flat decoding tables
+    //LLMsgData* mCurrentRMessageData;
+    const LLMessageDecodeTables* mDecodeTables;
+    std::vector<DecodedBlock> mDecodedBlocks;
+    std::vector<DecodedVariable> mDecodedVariables;
+    std::vector<U8> mDecodedBytes;
+    bool mHaveDecodedData;
+    // Handlers read a block's variables in order, so the next lookup is
+    // usually the one after the last.
+    S32 mLastBlock;
+    S32 mLastVariable;
+    // </3T:TommyTheTerrible>
     message_template_number_map_t& mMessageNumbers;
 };
 
@@ -2941,6 +2941,7 @@ void LLMessageSystem::addTemplate(LLMessageTemplate *templatep)
     }
     mMessageTemplates[templatep->mName] = templatep;
     mMessageNumbers[templatep->mMessageNumber] = templatep;
+    templatep->compileDecodeTables(); // <3T:TommyTheTerrible/>
 }
 
 
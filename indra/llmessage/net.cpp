@@ -47,6 +47,7 @@
 #include "llhost.h"
 #include "lltimer.h"
 #include "indra_constants.h"
+#include "net.h" // <3T:TommyTheTerrible/>
 
 // Globals
 #if LL_WINDOWS
@@ -562,6 +563,66 @@ static int recvfrom_destip( int socket, void *buf, int len, struct sockaddr *fro
 }
 #endif
 
+// <3T:TommyTheTerrible> Batched UDP receive
+#if LL_LINUX
+S32 receive_packets(int hSocket, LLNetDatagram* datagrams, S32 max_count, S32& receive_calls)
+{
+    receive_calls = 0;
+    max_count = llclamp(max_count, 0, NET_RECEIVE_BATCH_MAX);
+    if (!max_count)
+    {
+        return 0;
+    }
+
+    struct mmsghdr messages[NET_RECEIVE_BATCH_MAX];
+    struct iovec iov[NET_RECEIVE_BATCH_MAX];
+    struct sockaddr_in senders[NET_RECEIVE_BATCH_MAX];
+    char cmsg[NET_RECEIVE_BATCH_MAX][CMSG_SPACE(sizeof(struct in_pktinfo))];
+
+    memset(messages, 0, sizeof(messages[0]) * max_count);
+    for (S32 i = 0; i < max_count; ++i)
+    {
+        iov[i].iov_base = datagrams[i].mData;
+        iov[i].iov_len = NET_BUFFER_SIZE;
+        messages[i].msg_hdr.msg_name = &senders[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+        messages[i].msg_hdr.msg_iov = &iov[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_control = cmsg[i];
+        messages[i].msg_hdr.msg_controllen = sizeof(cmsg[i]);
+    }
+
+    // The socket is non-blocking, so this takes whatever is already queued.
+    int received = recvmmsg(hSocket, messages, max_count, MSG_DONTWAIT, NULL);
+    receive_calls = 1;
+    if (received <= 0)
+    {
+        return 0;
+    }
+
+    for (S32 i = 0; i < received; ++i)
+    {
+        LLNetDatagram& datagram = datagrams[i];
+        datagram.mSize = (S32)messages[i].msg_len;
+        datagram.mSenderIP = senders[i].sin_addr.s_addr;
+        datagram.mSenderPort = ntohs(senders[i].sin_port);
+        datagram.mReceivingIFIP = INVALID_HOST_IP_ADDRESS;
+        for (struct cmsghdr* cmsgptr = CMSG_FIRSTHDR(&messages[i].msg_hdr); cmsgptr != NULL;
+             cmsgptr = CMSG_NXTHDR(&messages[i].msg_hdr, cmsgptr))
+        {
+            if (cmsgptr->cmsg_level == SOL_IP && cmsgptr->cmsg_type == IP_PKTINFO)
+            {
+                // same choice of address as recvfrom_destip()
+                in_pktinfo* pktinfo = (in_pktinfo*)CMSG_DATA(cmsgptr);
+                datagram.mReceivingIFIP = pktinfo->ipi_spec_dst.s_addr;
+            }
+        }
+    }
+    return received;
+}
+#endif
+// </3T:TommyTheTerrible>
+
 int receive_packet(int hSocket, char * receiveBuffer)
 {
     //  Receives data asynchronously from the socket set by initNet().
@@ -654,4 +715,31 @@ bool send_packet(int hSocket, const char * sendBuffer, int size, U32 recipient,
 
 #endif
 
+// <3T:TommyTheTerrible> Batched UDP receive
+#if !LL_LINUX
+// No recvmmsg() here: one receive_packet() per datagram.
+S32 receive_packets(int hSocket, LLNetDatagram* datagrams, S32 max_count, S32& receive_calls)
+{
+    receive_calls = 0;
+    max_count = llclamp(max_count, 0, NET_RECEIVE_BATCH_MAX);
+    S32 count = 0;
+    while (count < max_count)
+    {
+        LLNetDatagram& datagram = datagrams[count];
+        datagram.mSize = receive_packet(hSocket, datagram.mData);
+        ++receive_calls;
+        if (datagram.mSize <= 0)
+        {
+            break;
+        }
+        datagram.mSenderIP = get_sender_ip();
+        datagram.mSenderPort = get_sender_port();
+        datagram.mReceivingIFIP = get_receiving_interface_ip();
+        ++count;
+    }
+    return count;
+}
+#endif
+// </3T:TommyTheTerrible>
+
 //EOF
@@ -45,6 +45,28 @@ S32     receive_packet(int hSocket, char * receiveBuffer);
 
 bool    send_packet(int hSocket, const char *sendBuffer, int size, U32 recipient, int nPort);   // Returns true on success.
 
+// <3T:TommyTheTerrible> Batched UDP receive
+// Most datagrams receive_packets() takes in one call.
+const S32   NET_RECEIVE_BATCH_MAX = 64;
+
+// One datagram for receive_packets(): the caller points mData at a buffer of
+// NET_BUFFER_SIZE bytes, the rest is filled in.
+struct LLNetDatagram
+{
+    char*   mData;
+    S32     mSize;
+    U32     mSenderIP;
+    U32     mSenderPort;
+    U32     mReceivingIFIP;
+};
+
+// Receives up to max_count (at most NET_RECEIVE_BATCH_MAX) waiting datagrams,
+// with a single recvmmsg() on Linux and one receive_packet() each elsewhere.
+// Returns how many were received, zero if none were waiting; receive_calls
+// is set to the number of system calls it took.
+S32     receive_packets(int hSocket, LLNetDatagram* datagrams, S32 max_count, S32& receive_calls);
+// </3T:TommyTheTerrible>
+
 //void  get_sender(char * tmp);
 LLHost  get_sender();
 U32     get_sender_port();
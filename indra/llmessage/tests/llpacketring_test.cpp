@@ -0,0 +1,222 @@
+/**
+ * @file   llpacketring_test.cpp
+ * @brief  Test for llpacketring.h, against a local UDP sender.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llpacketring.h"
+
+#include <string>
+#include <vector>
+
+#include "../net.h"
+#include "stringize.h"
+
+#include "../test/lltut.h"
+
+namespace
+{
+    std::string make_payload(S32 index)
+    {
+        // varying sizes, so a packet landing in the wrong buffer shows
+        return STRINGIZE("packet " << index << ' ' << std::string(index % 37 + 1, 'a' + index % 26));
+    }
+
+    // Receives everything the ring hands out until the socket is empty.
+    std::vector<std::string> receive_all(LLPacketRing& ring, S32 socket)
+    {
+        std::vector<std::string> received;
+        char buffer[NET_BUFFER_SIZE];
+        S32 size;
+        while ((size = ring.receivePacket(socket, buffer)) > 0)
+        {
+            received.emplace_back(buffer, size);
+        }
+        return received;
+    }
+
+    // A dropped packet also comes back as 0, so make a fixed number of calls.
+    std::vector<std::string> receive_calls(LLPacketRing& ring, S32 socket, S32 calls)
+    {
+        std::vector<std::string> received;
+        char buffer[NET_BUFFER_SIZE];
+        for (S32 i = 0; i < calls; ++i)
+        {
+            S32 size = ring.receivePacket(socket, buffer);
+            if (size > 0)
+            {
+                received.emplace_back(buffer, size);
+            }
+        }
+        return received;
+    }
+}
+
+namespace tut
+{
+    struct packetring_data
+    {
+        S32 mReceiver{ -1 };
+        S32 mSender{ -1 };
+        int mReceiverPort{ NET_USE_OS_ASSIGNED_PORT };
+        int mSenderPort{ NET_USE_OS_ASSIGNED_PORT };
+        U32 mLoopback{ ip_string_to_u32("127.0.0.1") };
+
+        packetring_data()
+        {
+            ensure_equals("receiver socket", start_net(mReceiver, mReceiverPort), 0);
+            ensure_equals("sender socket", start_net(mSender, mSenderPort), 0);
+        }
+
+        ~packetring_data()
+        {
+            end_net(mSender);
+            end_net(mReceiver);
+        }
+
+        void send(S32 first, S32 count)
+        {
+            for (S32 i = first; i < first + count; ++i)
+            {
+                const std::string payload = make_payload(i);
+                ensure("send", send_packet(mSender, payload.data(), (int)payload.size(), mLoopback, mReceiverPort));
+            }
+        }
+
+        std::vector<std::string> expected(S32 first, S32 count)
+        {
+            std::vector<std::string> payloads;
+            for (S32 i = first; i < first + count; ++i)
+            {
+                payloads.push_back(make_payload(i));
+            }
+            return payloads;
+        }
+    };
+    typedef test_group<packetring_data> packetring_group;
+    typedef packetring_group::object object;
+    packetring_group packetringgrp("LLPacketRing");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("batched receive");
+        LLPacketRing ring;
+        ring.setBatchedReceive(true);
+        send(0, 200);
+        ensure("everything in order", receive_all(ring, mReceiver) == expected(0, 200));
+        ensure_equals("sender", ring.getLastSender(), LLHost(mLoopback, mSenderPort));
+        ensure_equals("packets counted", ring.getReceivedPacketCount(), 200ULL);
+        ensure_equals("nothing left buffered", ring.getNumBufferedPackets(), 0);
+#if LL_LINUX
+        // one recvmmsg() per NET_RECEIVE_BATCH_MAX, give or take
+        ensure("several packets per call", ring.getPacketsPerReceiveCall() > 4.f);
+#endif
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("unbatched receive");
+        LLPacketRing ring;
+        ring.setBatchedReceive(false);
+        send(0, 50);
+        ensure("everything in order", receive_all(ring, mReceiver) == expected(0, 50));
+        ensure_equals("sender", ring.getLastSender(), LLHost(mLoopback, mSenderPort));
+        // one call per packet, and one more to find the socket empty
+        ensure_equals("receive calls", ring.getReceiveCallCount(), 51ULL);
+        ensure_equals("packets counted", ring.getReceivedPacketCount(), 50ULL);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("dropping packets is unchanged by batching");
+        std::vector<std::string> results[2];
+        for (S32 batched = 0; batched < 2; ++batched)
+        {
+            LLPacketRing ring;
+            ring.setBatchedReceive(batched != 0);
+            send(0, 20);
+            ring.dropPackets(5);
+            results[batched] = receive_calls(ring, mReceiver, 30);
+        }
+        ensure("same packets", results[1] == results[0]);
+        ensure("the first five went", results[0] == expected(5, 15));
+
+        // a random drop percentage draws once per call in both
+        for (S32 batched = 0; batched < 2; ++batched)
+        {
+            LLPacketRing ring;
+            ring.setBatchedReceive(batched != 0);
+            ring.setDropPercentage(100.f);
+            send(0, 20);
+            ensure("all dropped", receive_calls(ring, mReceiver, 20).empty());
+            ring.setDropPercentage(0.f);
+            ensure("none left", receive_all(ring, mReceiver).empty());
+        }
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("drain then receive");
+        for (S32 batched = 0; batched < 2; ++batched)
+        {
+            LLPacketRing ring;
+            ring.setBatchedReceive(batched != 0);
+            send(0, 100);
+            ensure_equals("drained", ring.drainSocket(mReceiver), 100);
+            send(100, 10);
+            // the buffered packets first, then the rest from the socket
+            ensure("everything in order", receive_all(ring, mReceiver) == expected(0, 110));
+            ensure_equals("nothing dropped", ring.getNumDroppedPackets(), 0);
+        }
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("full ring overwrites the oldest");
+        // 1024 buffers at most; the first packets past that are lost either way
+        const S32 count = 1100;
+        std::vector<std::string> results[2];
+        for (S32 batched = 0; batched < 2; ++batched)
+        {
+            LLPacketRing ring;
+            ring.setBatchedReceive(batched != 0);
+            // in pieces the socket's own receive buffer can hold
+            for (S32 first = 0; first < count; first += 220)
+            {
+                send(first, llmin(220, count - first));
+                ring.drainSocket(mReceiver);
+            }
+            results[batched] = receive_all(ring, mReceiver);
+            ensure_equals("dropped", ring.getNumDroppedPackets(), count - (S32)results[batched].size());
+        }
+        ensure("same packets", results[1] == results[0]);
+        ensure("newest kept", !results[0].empty() && results[0].back() == make_payload(count - 1));
+    }
+} // namespace tut
@@ -30,6 +30,7 @@
 #include "llmemory.h"
 #include "llconvexdecomposition.h"
 #include "llsdserialize.h"
+#include "llcompressionservice.h" // <3T:TommyTheTerrible/>
 #include "llvector4a.h"
 #include "hbxxh.h"
 #include "llcontrol.h"
@@ -970,12 +971,61 @@ LLSD LLModel::writeModelToStream(std::ostream& ostr, LLSD& mdl, bool nowrite, bo
         header["material_list"] = mdl["material_list"];
     }
 
-    std::string skin;
+    // <3T:TommyTheTerrible> Serialize every block first, then compress them as
+    // one batch spread over the worker pool instead of one zip_llsd() at a time.
+    constexpr S32 BLOCK_SKIN = MODEL_NAMES_LENGTH;
+    constexpr S32 BLOCK_DECOMPOSITION = MODEL_NAMES_LENGTH + 1;
+    constexpr S32 BLOCK_COUNT = MODEL_NAMES_LENGTH + 2;
+
+    std::string binary[BLOCK_COUNT];
+    std::vector<LLCompressionService::Job> jobs;
+    std::vector<S32> job_blocks;
+    auto add_block = [&](S32 block, const LLSD& data)
+    {
+        std::ostringstream block_strm;
+        LLSDSerialize::toBinary(data, block_strm);
+        binary[block] = block_strm.str();
+        job_blocks.push_back(block);
+    };
 
     if (mdl.has("skin"))
-    { //write out skin block
-        skin = zip_llsd(mdl["skin"]);
+    {
+        add_block(BLOCK_SKIN, mdl["skin"]);
+    }
+    if (mdl.has("physics_convex"))
+    {
+        add_block(BLOCK_DECOMPOSITION, mdl["physics_convex"]);
+    }
+    for (S32 i = 0; i < MODEL_NAMES_LENGTH; i++)
+    {
+        if (mdl.has(model_names[i]))
+        {
+            add_block(i, mdl[model_names[i]]);
+        }
+    }
+
+    // binary[] is complete, so the job inputs stay put from here on.
+    for (S32 block : job_blocks)
+    {
+        jobs.emplace_back((const U8*)binary[block].data(), binary[block].size());
+    }
+    if (LLCompressionService::deflateBatch(jobs) > 0)
+    {
+        LL_WARNS() << "Failed to compress LLSD block." << LL_ENDL;
+    }
+
+    std::string zipped[BLOCK_COUNT];
+    for (size_t job = 0; job < jobs.size(); ++job)
+    {
+        const LLCompressionService::buffer_t& deflated = jobs[job].mOut;
+        zipped[job_blocks[job]].assign((const char*)deflated.data(), deflated.size());
+    }
+    // </3T:TommyTheTerrible>
 
+    std::string& skin = zipped[BLOCK_SKIN];
+
+    if (mdl.has("skin"))
+    { //write out skin block
         U32 size = static_cast<U32>(skin.size());
         if (size > 0)
         {
@@ -985,12 +1035,10 @@ LLSD LLModel::writeModelToStream(std::ostream& ostr, LLSD& mdl, bool nowrite, bo
         }
     }
 
-    std::string decomposition;
+    std::string& decomposition = zipped[BLOCK_DECOMPOSITION];
 
     if (mdl.has("physics_convex"))
     { //write out convex decomposition
-        decomposition = zip_llsd(mdl["physics_convex"]);
-
         U32 size = static_cast<U32>(decomposition.size());
         if (size > 0)
         {
@@ -1005,14 +1053,12 @@ LLSD LLModel::writeModelToStream(std::ostream& ostr, LLSD& mdl, bool nowrite, bo
         header["submodel_id"] = (LLSD::Integer)mdl["submodel_id"];
         }
 
-    std::string out[MODEL_NAMES_LENGTH];
+    std::string* out = zipped;
 
     for (S32 i = 0; i < MODEL_NAMES_LENGTH; i++)
     {
         if (mdl.has(model_names[i]))
         {
-            out[i] = zip_llsd(mdl[model_names[i]]);
-
             U32 size = static_cast<U32>(out[i].size());
 
             header[model_names[i]]["offset"] = (LLSD::Integer) cur_offset;
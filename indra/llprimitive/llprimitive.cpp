@@ -1492,6 +1492,76 @@ S32 LLPrimitive::unpackTEMessage(LLMessageSystem* mesgsys, char const* block_nam
     return applyParsedTEMessage(tec);
 }
 
+// <3T:TommyTheTerrible> Parallel object update decoding
+//static
+S32 LLPrimitive::parseTEMessage(LLDataPacker& dp, LLTEContents& tec)
+{
+    material_id_type material_data[LLTEContents::MAX_TES];
+    memset((void*)tec.scale_s, 0, sizeof(tec.scale_s));
+    memset((void*)tec.scale_t, 0, sizeof(tec.scale_t));
+    memset((void*)tec.offset_s, 0, sizeof(tec.offset_s));
+    memset((void*)tec.offset_t, 0, sizeof(tec.offset_t));
+    memset((void*)tec.image_rot, 0, sizeof(tec.image_rot));
+    memset((void*)tec.bump, 0, sizeof(tec.bump));
+    memset((void*)tec.media_flags, 0, sizeof(tec.media_flags));
+    memset((void*)tec.glow, 0, sizeof(tec.glow));
+    tec.face_count = 0;
+
+    S32 size;
+    if (!dp.unpackBinaryData(tec.packed_buffer, size, "TextureEntry"))
+    {
+        LL_WARNS() << "Bad texture entry block!  Abort!" << LL_ENDL;
+        return TEM_INVALID;
+    }
+
+    if (size == 0)
+    {
+        return 0;
+    }
+    else if (size >= (S32)LLTEContents::MAX_TE_BUFFER)
+    {
+        LL_WARNS("TEXTUREENTRY") << "Excessive buffer size detected in Texture Entry! Truncating." << LL_ENDL;
+        size = LLTEContents::MAX_TE_BUFFER - 1;
+    }
+
+    // The last field is not zero terminated.
+    tec.packed_buffer[size] = 0x00;
+    tec.size = size + 1;
+
+    // Each field is a default and then per-face exceptions, so parsing for
+    // all of them gives the same values for the faces the object has.
+    const U8 face_count = LLTEContents::MAX_TES;
+    U8 *cur_ptr = tec.packed_buffer;
+    U8 *buffer_end = tec.packed_buffer + tec.size;
+
+    if (!(  unpack_TEField<LLUUID>(tec.image_data, face_count, cur_ptr, buffer_end, MVT_LLUUID) &&
+            unpack_TEField<LLColor4U>(tec.colors, face_count, cur_ptr, buffer_end, MVT_U8) &&
+            unpack_TEField<F32>(tec.scale_s, face_count, cur_ptr, buffer_end, MVT_F32) &&
+            unpack_TEField<F32>(tec.scale_t, face_count, cur_ptr, buffer_end, MVT_F32) &&
+            unpack_TEField<S16>(tec.offset_s, face_count, cur_ptr, buffer_end, MVT_S16) &&
+            unpack_TEField<S16>(tec.offset_t, face_count, cur_ptr, buffer_end, MVT_S16) &&
+            unpack_TEField<S16>(tec.image_rot, face_count, cur_ptr, buffer_end, MVT_S16) &&
+            unpack_TEField<U8>(tec.bump, face_count, cur_ptr, buffer_end, MVT_U8) &&
+            unpack_TEField<U8>(tec.media_flags, face_count, cur_ptr, buffer_end, MVT_U8) &&
+            unpack_TEField<U8>(tec.glow, face_count, cur_ptr, buffer_end, MVT_U8)))
+    {
+        LL_WARNS("TEXTUREENTRY") << "Failure parsing Texture Entry Message due to malformed TE Field! Dropping changes on the floor. " << LL_ENDL;
+        return 0;
+    }
+
+    if (cur_ptr >= buffer_end || !unpack_TEField<material_id_type>(material_data, face_count, cur_ptr, buffer_end, MVT_LLUUID))
+    {
+        memset((void*)material_data, 0, sizeof(material_data));
+    }
+
+    for (U32 i = 0; i < face_count; i++)
+    {
+        tec.material_ids[i].set(&(material_data[i]));
+    }
+    return 1;
+}
+// </3T:TommyTheTerrible>
+
 S32 LLPrimitive::unpackTEMessage(LLDataPacker &dp)
 {
     // use a negative block_num to indicate a single-block read (a non-variable block)
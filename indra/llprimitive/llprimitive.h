@@ -511,6 +511,13 @@ public:
     S32 unpackTEMessage(LLDataPacker &dp);
     S32 parseTEMessage(LLMessageSystem* mesgsys, char const* block_name, const S32 block_num, LLTEContents& tec);
     S32 applyParsedTEMessage(LLTEContents& tec);
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    // Parses a TextureEntry packed as binary data, as unpackTEMessage(dp)
+    // does, for every face LLTEContents can hold. Touches no object, so it
+    // can run off the main thread; set tec.face_count before applying.
+    // Returns TEM_INVALID, 0 if there is nothing to apply, or 1.
+    static S32 parseTEMessage(LLDataPacker& dp, LLTEContents& tec);
+    // </3T:TommyTheTerrible>
 
 #ifdef CHECK_FOR_FINITE
     inline void setPosition(const LLVector3& pos);
@@ -404,7 +404,8 @@ void LLTextBase::drawHighlightsBackground(const highlight_list_t& highlights, co
 {
     if (!mLineInfoList.empty())
     {
-        std::vector<LLRect> selection_rects;
+        //std::vector<LLRect> selection_rects;
+        LLFrameVector<LLRect> selection_rects; // <3T:TommyTheTerrible/>
 
         // Skip through the lines we aren't drawing.
         LLRect content_display_rect = getVisibleDocumentRect();
@@ -508,13 +509,17 @@ void LLTextBase::drawHighlightsBackground(const highlight_list_t& highlights, co
 }
 // [/SL:KB]
 
-std::vector<LLRect> LLTextBase::getSelectionRects()
+// <3T:TommyTheTerrible>
+//std::vector<LLRect> LLTextBase::getSelectionRects()
+LLFrameVector<LLRect> LLTextBase::getSelectionRects()
+// </3T:TommyTheTerrible>
 {
     // Nor supposed to be called without selection
     llassert(hasSelection());
     llassert(!mLineInfoList.empty());
 
-    std::vector<LLRect> selection_rects;
+    //std::vector<LLRect> selection_rects;
+    LLFrameVector<LLRect> selection_rects; // <3T:TommyTheTerrible/>
 
     S32 selection_left = llmin(mSelectionStart, mSelectionEnd);
     S32 selection_right = llmax(mSelectionStart, mSelectionEnd);
@@ -605,7 +610,8 @@ void LLTextBase::drawSelectionBackground()
     // Draw selection even if we don't have keyboard focus for search/replace
     if (hasSelection() && !mLineInfoList.empty())
     {
-        std::vector<LLRect> selection_rects = getSelectionRects();
+        //std::vector<LLRect> selection_rects = getSelectionRects();
+        LLFrameVector<LLRect> selection_rects = getSelectionRects(); // <3T:TommyTheTerrible/>
 
         // Draw the selection box (we're using a box instead of reversing the colors on the selected text).
         gGL.getTexUnit(0)->unbind(LLTexUnit::TT_TEXTURE);
@@ -616,7 +622,8 @@ void LLTextBase::drawSelectionBackground()
         LLColor4 selection_color(color.mV[VRED], color.mV[VGREEN], color.mV[VBLUE], alpha);
         LLRect content_display_rect = getVisibleDocumentRect();
 
-        for (std::vector<LLRect>::iterator rect_it = selection_rects.begin();
+        //for (std::vector<LLRect>::iterator rect_it = selection_rects.begin();
+        for (LLFrameVector<LLRect>::iterator rect_it = selection_rects.begin(); // <3T:TommyTheTerrible/>
             rect_it != selection_rects.end();
             ++rect_it)
         {
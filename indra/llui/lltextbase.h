@@ -35,6 +35,7 @@
 #include "llstyle.h"
 #include "llkeywords.h"
 #include "llpanel.h"
+#include "llframearena.h" // <3T:TommyTheTerrible/>
 
 #include <string>
 #include <vector>
@@ -734,7 +735,10 @@ protected:
         // </FS:PP>
     }
 
-    std::vector<LLRect> getSelectionRects();
+    // <3T:TommyTheTerrible> selection rects only live for the draw call
+    //std::vector<LLRect> getSelectionRects();
+    LLFrameVector<LLRect> getSelectionRects();
+    // </3T:TommyTheTerrible>
 
 protected:
     // text segmentation and flow
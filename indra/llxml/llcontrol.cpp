@@ -47,6 +47,7 @@
 #include "llfile.h"
 #include "lltimer.h"
 #include "lldir.h"
+#include "llframetimer.h" // <3T:TommyTheTerrible/>
 
 #if LL_RELEASE_WITH_DEBUG_INFO || LL_DEBUG
 #define CONTROL_ERRS LL_ERRS("ControlErrors")
@@ -169,6 +170,7 @@ LLControlVariable::LLControlVariable(const std::string& name, eControlType type,
     }
     //Push back versus setValue'ing here, since we don't want to call a signal yet
     mValues.push_back(initial);
+    updateScalar(); // <3T:TommyTheTerrible/>
 
     mSanityValues.push_back(sanityValues[0]);
     mSanityValues.push_back(sanityValues[1]);
@@ -262,6 +264,7 @@ void LLControlVariable::setValue(const LLSD& new_value, bool saved_value)
             mValues.push_back(storable_value);
         }
     }
+    updateScalar(); // <3T:TommyTheTerrible/>
 
     if(value_changed)
     {
@@ -282,6 +285,7 @@ void LLControlVariable::setDefaultValue(const LLSD& value)
     bool value_changed = !llsd_compare(original_value, comparable_value);
     resetToDefault(false);
     mValues[0] = comparable_value;
+    updateScalar(); // <3T:TommyTheTerrible/>
     if (value_changed)
     {
         mSanitySignal(this,isSane());
@@ -311,6 +315,41 @@ void LLControlVariable::setComment(const std::string& comment)
     mComment = comment;
 }
 
+// <3T:TommyTheTerrible> Typed settings reads
+void LLControlVariable::updateScalar()
+{
+    const LLSD& value = mValues.back();
+    switch (mType)
+    {
+    case TYPE_U32:
+        mScalar.mU32 = (U32)value.asInteger();
+        break;
+    case TYPE_S32:
+        mScalar.mS32 = value.asInteger();
+        break;
+    case TYPE_F32:
+        mScalar.mF32 = (F32)value.asReal();
+        break;
+    case TYPE_BOOLEAN:
+        mScalar.mBoolean = value.asBoolean();
+        break;
+    default:
+        break;
+    }
+}
+
+void LLControlVariable::countLookup(U32 frame)
+{
+    ++mLookups;
+    if (frame != mLookupFrame)
+    {
+        mLookupFrame = frame;
+        mFrameLookups = 0;
+    }
+    mMaxFrameLookups = llmax(mMaxFrameLookups, ++mFrameLookups);
+}
+// </3T:TommyTheTerrible>
+
 void LLControlVariable::resetToDefault(bool fire_signal)
 {
     //The first setting is always the default
@@ -321,6 +360,7 @@ void LLControlVariable::resetToDefault(bool fire_signal)
     {
         mValues.pop_back();
     }
+    updateScalar(); // <3T:TommyTheTerrible/>
 
     if(fire_signal)
     {
@@ -414,14 +454,72 @@ LLSD LLControlVariable::getSaveValue() const
 
 LLPointer<LLControlVariable> LLControlGroup::getControl(std::string_view name)
 {
-    if (mSettingsProfile)
+    // <3T:TommyTheTerrible> Hashed lookups
+    //if (mSettingsProfile)
+    //{
+    //    incrCount(name);
+    //}
+    //
+    //ctrl_name_table_t::iterator iter = mNameTable.find(name);
+    //return iter == mNameTable.end() ? LLPointer<LLControlVariable>() : iter->second;
+    return findControl(name);
+    // </3T:TommyTheTerrible>
+}
+
+// <3T:TommyTheTerrible> Hashed lookups
+LLControlVariable* LLControlGroup::findControl(std::string_view name)
+{
+    ctrl_name_index_t::const_iterator iter = mNameIndex.find(name);
+    LLControlVariable* control = (iter == mNameIndex.end()) ? nullptr : iter->second;
+    if (LL_UNLIKELY(mSettingsProfile))
+    {
+        if (control)
+        {
+            control->countLookup(LLFrameTimer::getFrameCount());
+        }
+        else
+        {
+            incrCount(name);
+        }
+    }
+    return control;
+}
+
+void LLControlGroup::setSettingsProfile(bool profile)
+{
+    if (profile && !mSettingsProfile)
     {
-        incrCount(name);
+        mProfileStartFrame = LLFrameTimer::getFrameCount();
+        if (0.0 == start_time)
+        {
+            start_time = LLTimer::getTotalSeconds();
+        }
     }
+    mSettingsProfile = profile;
+}
 
-    ctrl_name_table_t::iterator iter = mNameTable.find(name);
-    return iter == mNameTable.end() ? LLPointer<LLControlVariable>() : iter->second;
+std::vector<LLControlGroup::LookupStats> LLControlGroup::getLookupStats()
+{
+    const U32 frames = llmax(LLFrameTimer::getFrameCount() - mProfileStartFrame, 1U);
+    std::vector<LookupStats> stats;
+    for (const auto& [name, control] : mNameTable)
+    {
+        if (control->mLookups)
+        {
+            stats.push_back({ name, control->mLookups, (F32)control->mLookups / (F32)frames, control->mMaxFrameLookups });
+        }
+    }
+    // names that weren't found, from every group
+    for (LLSD::map_const_iterator iter = getCount.beginMap(); iter != getCount.endMap(); ++iter)
+    {
+        U32 lookups = (U32)iter->second.asInteger();
+        stats.push_back({ iter->first, lookups, (F32)lookups / (F32)frames, 0 });
+    }
+    std::sort(stats.begin(), stats.end(),
+              [](const LookupStats& a, const LookupStats& b) { return a.mLookups > b.mLookups; });
+    return stats;
 }
+// </3T:TommyTheTerrible>
 
 
 ////////////////////////////////////////////////////////////////////////////
@@ -454,12 +552,14 @@ const std::string LLControlGroup::mSanityTypeString[SANITY_TYPE_COUNT] = { "None
 
 LLControlGroup::LLControlGroup(const std::string& name)
 :   LLInstanceTracker<LLControlGroup, std::string>(name),
+    mProfileStartFrame(0), // <3T:TommyTheTerrible/>
     mSettingsProfile(false)
 {
 
     if (NULL != getenv("LL_SETTINGS_PROFILE"))
     {
-        mSettingsProfile = true;
+        //mSettingsProfile = true;
+        setSettingsProfile(true); // <3T:TommyTheTerrible/>
     }
 }
 
@@ -468,17 +568,30 @@ LLControlGroup::~LLControlGroup()
     cleanup();
 }
 
-static bool compareRoutine(settings_pair_t lhs, settings_pair_t rhs)
-{
-    return lhs.second > rhs.second;
-};
+// <3T:TommyTheTerrible> getLookupStats() sorts the profile now
+//static bool compareRoutine(settings_pair_t lhs, settings_pair_t rhs)
+//{
+//    return lhs.second > rhs.second;
+//};
+// </3T:TommyTheTerrible>
 
 void LLControlGroup::cleanup()
 {
-    if(mSettingsProfile && getCount.size() != 0)
+    // <3T:TommyTheTerrible> Per control lookup counts; each group adds its own to the file
+    //if(mSettingsProfile && getCount.size() != 0)
+    std::vector<LookupStats> stats;
+    if (mSettingsProfile)
+    {
+        stats = getLookupStats();
+    }
+    static bool profile_started = false;
+    if (!stats.empty())
+    // </3T:TommyTheTerrible>
     {
         std::string file = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, SETTINGS_PROFILE);
-        LLFILE* out = LLFile::fopen(file, "w"); /* Flawfinder: ignore */
+        //LLFILE* out = LLFile::fopen(file, "w"); /* Flawfinder: ignore */
+        LLFILE* out = LLFile::fopen(file, profile_started ? "a" : "w"); /* Flawfinder: ignore */ // <3T:TommyTheTerrible/>
+        profile_started = true; // <3T:TommyTheTerrible/>
         if(!out)
         {
             LL_WARNS("SettingsProfile") << "Error opening " << SETTINGS_PROFILE << LL_ENDL;
@@ -488,7 +601,9 @@ void LLControlGroup::cleanup()
             F64 end_time = LLTimer::getTotalSeconds();
             U32 total_seconds = (U32)(end_time - start_time);
 
-            std::string msg = llformat("Runtime (seconds): %d\n\n No. accesses   Avg. accesses/sec  Name\n", total_seconds);
+            //std::string msg = llformat("Runtime (seconds): %d\n\n No. accesses   Avg. accesses/sec  Name\n", total_seconds);
+            std::string msg = llformat("%s: runtime (seconds): %d\n\n No. accesses   Avg. accesses/sec  Avg./frame  Max/frame  Name\n",
+                                       getKey().c_str(), total_seconds); // <3T:TommyTheTerrible/>
             std::ostringstream data_msg;
 
             data_msg << msg;
@@ -498,23 +613,29 @@ void LLControlGroup::cleanup()
                 LL_WARNS("SettingsProfile") << "Failed to write settings profile header" << LL_ENDL;
             }
 
-            for (LLSD::map_const_iterator iter = getCount.beginMap(); iter != getCount.endMap(); ++iter)
-            {
-                getCount_v.push_back(settings_pair_t(iter->first, iter->second.asInteger()));
-            }
-            sort(getCount_v.begin(), getCount_v.end(), compareRoutine);
-
-            for (settings_vec_t::iterator iter = getCount_v.begin(); iter != getCount_v.end(); ++iter)
+            // <3T:TommyTheTerrible> Per control lookup counts
+            //for (LLSD::map_const_iterator iter = getCount.beginMap(); iter != getCount.endMap(); ++iter)
+            //{
+            //    getCount_v.push_back(settings_pair_t(iter->first, iter->second.asInteger()));
+            //}
+            //sort(getCount_v.begin(), getCount_v.end(), compareRoutine);
+            //
+            //for (settings_vec_t::iterator iter = getCount_v.begin(); iter != getCount_v.end(); ++iter)
+            for (const LookupStats& stat : stats)
+            // </3T:TommyTheTerrible>
             {
                 U32 access_rate = 0;
                 if (total_seconds != 0)
                 {
-                    access_rate = iter->second / total_seconds;
+                    //access_rate = iter->second / total_seconds;
+                    access_rate = stat.mLookups / total_seconds; // <3T:TommyTheTerrible/>
                 }
                 if (access_rate >= 2)
                 {
                     std::ostringstream data_msg;
-                    msg = llformat("%13d        %7d       %s", iter->second, access_rate, iter->first.c_str());
+                    //msg = llformat("%13d        %7d       %s", iter->second, access_rate, iter->first.c_str());
+                    msg = llformat("%13d        %7d     %9.2f  %9d  %s", stat.mLookups, access_rate, stat.mPerFrame,
+                                   stat.mMaxPerFrame, stat.mName.c_str()); // <3T:TommyTheTerrible/>
                     data_msg << msg << "\n";
                     size_t data_size = data_msg.str().size();
                     if (fwrite(data_msg.str().c_str(), 1, data_size, out) != data_size)
@@ -528,6 +649,7 @@ void LLControlGroup::cleanup()
         }
     }
 
+    mNameIndex.clear(); // <3T:TommyTheTerrible/>
     mNameTable.clear();
 }
 
@@ -590,6 +712,7 @@ LLControlVariable* LLControlGroup::declareControl(const std::string& name, eCont
     LLControlVariable* control = new LLControlVariable(name, type, initial_val, comment, sanity_type, sanity_value, sanity_comment, persist, can_backup, hidefromsettingseditor);
     // </FS:Zi>
     mNameTable[name] = control;
+    mNameIndex[control->getName()] = control; // <3T:TommyTheTerrible/>
     return control;
 }
 
@@ -659,27 +782,63 @@ void LLControlGroup::incrCount(std::string_view name)
     {
         start_time = LLTimer::getTotalSeconds();
     }
-    getCount[name.data()] = getCount[name.data()].asInteger() + 1;
+    //getCount[name.data()] = getCount[name.data()].asInteger() + 1;
+    // <3T:TommyTheTerrible> a string_view needn't be terminated
+    std::string key(name);
+    getCount[key] = getCount[key].asInteger() + 1;
+    // </3T:TommyTheTerrible>
 }
 
 bool LLControlGroup::getBOOL(std::string_view name)
 {
-    return get<bool>(name);
+    // <3T:TommyTheTerrible> Typed settings reads
+    //return get<bool>(name);
+    if (LLControlVariable* control = findControl(name))
+    {
+        return control->getBOOL();
+    }
+    LL_WARNS() << "Control " << name << " not found." << LL_ENDL;
+    return false;
+    // </3T:TommyTheTerrible>
 }
 
 S32 LLControlGroup::getS32(std::string_view name)
 {
-    return get<S32>(name);
+    // <3T:TommyTheTerrible> Typed settings reads
+    //return get<S32>(name);
+    if (LLControlVariable* control = findControl(name))
+    {
+        return control->getS32();
+    }
+    LL_WARNS() << "Control " << name << " not found." << LL_ENDL;
+    return 0;
+    // </3T:TommyTheTerrible>
 }
 
 U32 LLControlGroup::getU32(std::string_view name)
 {
-    return get<U32>(name);
+    // <3T:TommyTheTerrible> Typed settings reads
+    //return get<U32>(name);
+    if (LLControlVariable* control = findControl(name))
+    {
+        return control->getU32();
+    }
+    LL_WARNS() << "Control " << name << " not found." << LL_ENDL;
+    return 0;
+    // </3T:TommyTheTerrible>
 }
 
 F32 LLControlGroup::getF32(std::string_view name)
 {
-    return get<F32>(name);
+    // <3T:TommyTheTerrible> Typed settings reads
+    //return get<F32>(name);
+    if (LLControlVariable* control = findControl(name))
+    {
+        return control->getF32();
+    }
+    LL_WARNS() << "Control " << name << " not found." << LL_ENDL;
+    return 0.f;
+    // </3T:TommyTheTerrible>
 }
 
 std::string LLControlGroup::getString(std::string_view name)
@@ -761,8 +920,9 @@ LLSD LLControlGroup::asLLSD(bool diffs_only)
 
 bool LLControlGroup::controlExists(std::string_view name)
 {
-    ctrl_name_table_t::iterator iter = mNameTable.find(name);
-    return iter != mNameTable.end();
+    //ctrl_name_table_t::iterator iter = mNameTable.find(name);
+    //return iter != mNameTable.end();
+    return mNameIndex.find(name) != mNameIndex.end(); // <3T:TommyTheTerrible/>
 }
 
 
@@ -1108,6 +1268,13 @@ U32 LLControlGroup::loadFromFile(const std::string& filename, bool set_default_v
         return loadFromFileLegacy(filename, true, TYPE_STRING);
     }
 
+    // <3T:TommyTheTerrible> Precompiled default settings
+    return loadFromLLSD(settings, filename, set_default_values, save_values);
+}
+
+U32 LLControlGroup::loadFromLLSD(const LLSD& settings, const std::string& filename, bool set_default_values, bool save_values)
+{
+    // </3T:TommyTheTerrible>
     U32 validitems = 0;
     bool hidefromsettingseditor = false;
 
@@ -34,6 +34,7 @@
 #include "llrefcount.h"
 #include "llinstancetracker.h"
 
+#include <unordered_map>
 #include <vector>
 
 #include <boost/bind.hpp>
@@ -111,6 +112,24 @@ private:
     validate_signal_t mValidateSignal;
     sanity_signal_t mSanitySignal;
 
+    // <3T:TommyTheTerrible> Typed settings reads
+    // mValues.back() of a U32, S32, F32 or Boolean control, kept in step by
+    // updateScalar() so the typed getters don't go through LLSD
+    union
+    {
+        bool    mBoolean;
+        S32     mS32;
+        U32     mU32;
+        F32     mF32;
+    } mScalar{};
+
+    // lookups by name, counted while the group's settings profile is on
+    U32 mLookups{ 0 };
+    U32 mFrameLookups{ 0 };
+    U32 mMaxFrameLookups{ 0 };
+    U32 mLookupFrame{ 0 };
+    // </3T:TommyTheTerrible>
+
 public:
     LLControlVariable(const std::string& name, eControlType type,
         LLSD initial, const std::string& comment,
@@ -163,11 +182,22 @@ public:
     void setHiddenFromSettingsEditor(bool hide);
     void setComment(const std::string& comment);
 
+    // <3T:TommyTheTerrible> Typed settings reads
+    // The value of a control of that type, without an LLSD copy. Asking for
+    // the wrong type complains and returns 0, like LLControlGroup::get().
+    bool getBOOL() const;
+    S32 getS32() const;
+    U32 getU32() const;
+    F32 getF32() const;
+    // </3T:TommyTheTerrible>
+
 private:
     void firePropertyChanged(const LLSD &pPreviousValue)
     {
         mCommitSignal(this, mValues.back(), pPreviousValue);
     }
+    void updateScalar(); // <3T:TommyTheTerrible/>
+    void countLookup(U32 frame); // <3T:TommyTheTerrible/>
     LLSD getComparableValue(const LLSD& value);
     bool llsd_compare(const LLSD& a, const LLSD & b);
 };
@@ -204,6 +234,11 @@ class LLControlGroup : public LLInstanceTracker<LLControlGroup, std::string>
 protected:
     typedef std::map<std::string, LLControlVariablePtr, std::less<> > ctrl_name_table_t;
     ctrl_name_table_t mNameTable;
+    // <3T:TommyTheTerrible> Hashed lookups; keyed by each control's own name
+    typedef std::unordered_map<std::string_view, LLControlVariable*> ctrl_name_index_t;
+    ctrl_name_index_t mNameIndex;
+    U32 mProfileStartFrame;
+    // </3T:TommyTheTerrible>
     static const std::string mTypeString[TYPE_COUNT];
     static const std::string mSanityTypeString[SANITY_TYPE_COUNT];
 
@@ -219,6 +254,24 @@ public:
 
     LLControlVariablePtr getControl(std::string_view name);
 
+    // <3T:TommyTheTerrible> Typed settings reads
+    // The control, or null, without taking a reference. A control lives as
+    // long as its group, so code that reads a setting often and can't use
+    // an LLCachedControl can keep this and call its typed getters.
+    LLControlVariable* findControl(std::string_view name);
+
+    struct LookupStats
+    {
+        std::string mName;
+        U32         mLookups;
+        F32         mPerFrame;      // averaged over the frames since profiling began
+        U32         mMaxPerFrame;   // in any one frame; 0 for unknown names
+    };
+    // What mSettingsProfile (LL_SETTINGS_PROFILE) counted, most looked up first
+    std::vector<LookupStats> getLookupStats();
+    void setSettingsProfile(bool profile);
+    // </3T:TommyTheTerrible>
+
     struct ApplyFunctor
     {
         virtual ~ApplyFunctor() {};
@@ -268,7 +321,8 @@ public:
     template<typename T> T get(std::string_view name)
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_LLSD;
-        LLControlVariable* control = getControl(name);
+        //LLControlVariable* control = getControl(name);
+        LLControlVariable* control = findControl(name); // <3T:TommyTheTerrible/>
         LLSD value;
         eControlType type = TYPE_COUNT;
 
@@ -323,6 +377,11 @@ public:
     U32 loadFromFileLegacy(const std::string& filename, bool require_declaration = true, eControlType declare_as = TYPE_STRING);
     U32 saveToFile(const std::string& filename, bool nondefault_only);
     U32 loadFromFile(const std::string& filename, bool default_values = false, bool save_values = true);
+    // <3T:TommyTheTerrible> Precompiled default settings
+    // What loadFromFile() does with the settings it parsed; source names
+    // where they came from in messages.
+    U32 loadFromLLSD(const LLSD& settings, const std::string& source, bool default_values = false, bool save_values = true);
+    // </3T:TommyTheTerrible>
     void    resetToDefaults();
     void    incrCount(std::string_view name);
 
@@ -489,6 +548,28 @@ template<> LLColor3 convert_from_llsd<LLColor3>(const LLSD& sd, eControlType typ
 template<> LLColor4 convert_from_llsd<LLColor4>(const LLSD& sd, eControlType type, std::string_view control_name);
 template<> LLSD convert_from_llsd<LLSD>(const LLSD& sd, eControlType type, std::string_view control_name);
 
+// <3T:TommyTheTerrible> Typed settings reads
+inline bool LLControlVariable::getBOOL() const
+{
+    return mType == TYPE_BOOLEAN ? mScalar.mBoolean : convert_from_llsd<bool>(getValue(), mType, mName);
+}
+
+inline S32 LLControlVariable::getS32() const
+{
+    return mType == TYPE_S32 ? mScalar.mS32 : convert_from_llsd<S32>(getValue(), mType, mName);
+}
+
+inline U32 LLControlVariable::getU32() const
+{
+    return mType == TYPE_U32 ? mScalar.mU32 : convert_from_llsd<U32>(getValue(), mType, mName);
+}
+
+inline F32 LLControlVariable::getF32() const
+{
+    return mType == TYPE_F32 ? mScalar.mF32 : convert_from_llsd<F32>(getValue(), mType, mName);
+}
+// </3T:TommyTheTerrible>
+
 //#define TEST_CACHED_CONTROL 1
 #ifdef TEST_CACHED_CONTROL
 void test_cached_control();
@@ -33,6 +33,8 @@
 #include "../llcontrol.h"
 
 #include "../test/lltut.h"
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <vector>
 
@@ -151,4 +153,118 @@ namespace tut
         ensure("listener fired on changed setting", mListenerFired);
     }
 
+    //typed reads follow every way of changing a value
+    template<> template<>
+    void control_group_t::test<5>()
+    {
+        mCG->loadFromFile(mTestConfigFile.c_str(), true);
+        LLControlVariable* control = mCG->findControl("TestSetting");
+        ensure("found", control != nullptr);
+        ensure("same control by name", control == mCG->getControl("TestSetting").get());
+        ensure_equals("loaded", control->getU32(), 12);
+
+        U32 seen = 0;
+        control->getSignal()->connect([&seen](LLControlVariable* changed, const LLSD&, const LLSD&)
+                                      {
+                                          seen = changed->getU32();
+                                      });
+        mCG->setU32("TestSetting", 13);
+        ensure_equals("set", control->getU32(), 13);
+        ensure_equals("listener sees the new value", seen, 13);
+
+        control->setValue(LLSD(14), false);
+        ensure_equals("unsaved value", mCG->getU32("TestSetting"), 14);
+        control->resetToDefault(true);
+        ensure_equals("reset", control->getU32(), 12);
+        ensure_equals("listener sees the reset", seen, 12);
+        control->setDefaultValue(LLSD(20));
+        ensure_equals("new default", control->getU32(), 20);
+
+        mCG->declareF32("TestF32", 0.5f, "float");
+        mCG->declareBOOL("TestBOOL", true, "bool");
+        mCG->declareS32("TestS32", -3, "signed");
+        ensure_equals("F32", mCG->getF32("TestF32"), 0.5f);
+        ensure("BOOL", mCG->getBOOL("TestBOOL"));
+        ensure_equals("S32", mCG->getS32("TestS32"), -3);
+        ensure("missing", mCG->findControl("NoSuchSetting") == nullptr);
+        ensure("missing reads zero", !mCG->getBOOL("NoSuchSetting"));
+    }
+
+    //lookup profile
+    template<> template<>
+    void control_group_t::test<6>()
+    {
+        mCG->loadFromFile(mTestConfigFile.c_str());
+        mCG->setSettingsProfile(true);
+        for (int i = 0; i < 5; ++i)
+        {
+            mCG->getU32("TestSetting");
+        }
+        std::vector<LLControlGroup::LookupStats> stats = mCG->getLookupStats();
+        mCG->setSettingsProfile(false);
+        ensure("counted", !stats.empty());
+        ensure_equals("name", stats[0].mName, "TestSetting");
+        ensure_equals("lookups", stats[0].mLookups, 5);
+        ensure_equals("most in one frame", stats[0].mMaxPerFrame, 5);
+    }
+
+    //lookup benchmark
+    template<> template<>
+    void control_group_t::test<7>()
+    {
+        std::string env = LLStringUtil::getenv("LL_CONTROL_BENCH_LOOKUPS");
+        if (env.empty())
+        {
+            skip("set LL_CONTROL_BENCH_LOOKUPS to run");
+        }
+        U32 lookups = (U32)std::stoul(env);
+        for (int i = 0; i < 200; ++i)
+        {
+            mCG->declareF32(llformat("BenchSetting%d", i), (F32)i, "benchmark");
+        }
+        LLControlVariable* control = mCG->findControl("BenchSetting100");
+
+        using clock = std::chrono::steady_clock;
+        auto time = [lookups](auto&& read)
+        {
+            F32 sum = 0.f;
+            clock::time_point start = clock::now();
+            for (U32 i = 0; i < lookups; ++i)
+            {
+                sum += read();
+            }
+            F64 usec = std::chrono::duration<F64, std::micro>(clock::now() - start).count();
+            ensure_equals("read the setting", sum, (F32)lookups * 100.f);
+            return usec;
+        };
+        F64 llsd = time([this]() { return (F32)mCG->getLLSD("BenchSetting100").asReal(); });
+        F64 typed = time([this]() { return mCG->getF32("BenchSetting100"); });
+        F64 handle = time([control]() { return control->getF32(); });
+        std::cout << "\n" << lookups << " settings lookups (usec): LLSD " << llsd
+                  << ", typed by name " << typed << ", handle " << handle << std::endl;
+    }
+
+    //defaults loaded from LLSD read like the file they came from
+    template<> template<>
+    void control_group_t::test<8>()
+    {
+        LLSD config;
+        llifstream file(mTestConfigFile.c_str());
+        LLSDSerialize::fromXML(config, file);
+        std::stringstream binary;
+        LLSDSerialize::toBinary(config, binary);
+        LLSD decoded;
+        LLSDSerialize::fromBinary(decoded, binary, LLSDSerialize::SIZE_UNLIMITED);
+
+        LLControlGroup from_llsd("foo4");
+        ensure_equals("loaded", from_llsd.loadFromLLSD(decoded, "compiled", true), 1);
+        mCG->loadFromFile(mTestConfigFile.c_str(), true);
+        LLControlVariable* expected = mCG->findControl("TestSetting");
+        LLControlVariable* control = from_llsd.findControl("TestSetting");
+        ensure("declared", control != nullptr);
+        ensure_equals("value", control->getU32(), expected->getU32());
+        ensure_equals("default", control->getDefault().asInteger(), expected->getDefault().asInteger());
+        ensure_equals("comment", control->getComment(), expected->getComment());
+        ensure_equals("persist", control->isPersisted(), expected->isPersisted());
+    }
 }
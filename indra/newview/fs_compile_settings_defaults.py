@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+# @file fs_compile_settings_defaults.py
+# @brief Compile the default settings files into a binary LLSD blob that
+#        is built into the viewer, so startup doesn't parse their XML.
+#
+# $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+# Phoenix Firestorm Viewer Source Code
+# Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation;
+# version 2.1 of the License only.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+#
+# The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+# http://www.firestormviewer.org
+# $/LicenseInfo$
+
+"""
+Usage: fs_compile_settings_defaults.py OUTPUT.cpp SETTINGS.xml...
+
+Writes OUTPUT.cpp defining gFSSettingsDefaultsBlob, binary LLSD of
+
+    { "<file name>": { "size": <bytes>, "crc": <CRC-32>, "settings": {...} } }
+
+for each settings file. fssettingsdefaults.cpp loads the settings from the
+blob when the installed file still has that size and CRC, and parses the
+installed file otherwise.
+
+The XML is read the way LLSDXMLParser reads it, so the blob decodes to the
+same LLSD the viewer would have parsed.
+"""
+
+import base64
+import os
+import re
+import struct
+import sys
+import uuid
+import zlib
+import xml.etree.ElementTree as ET
+
+INTEGER = re.compile(r'\s*([-+]?\d+)')
+
+
+def parse_value(node):
+    tag = node.tag
+    text = node.text or ''
+    if tag == 'map':
+        result = {}
+        children = list(node)
+        for key, value in zip(children[0::2], children[1::2]):
+            if key.tag != 'key':
+                raise ValueError('expected <key> in <map>, got <%s>' % key.tag)
+            result[key.text or ''] = parse_value(value)
+        return result
+    if tag == 'array':
+        return [parse_value(child) for child in node]
+    if tag == 'undef':
+        return None
+    if tag == 'boolean':
+        return text == 'true' or text == '1'
+    if tag == 'integer':
+        # sscanf("%d")
+        match = INTEGER.match(text)
+        return int(match.group(1)) if match else 0
+    if tag == 'real':
+        try:
+            return float(text)
+        except ValueError:
+            return 0.0
+    if tag == 'string':
+        return text
+    if tag == 'uuid':
+        try:
+            return uuid.UUID(text.strip())
+        except ValueError:
+            return uuid.UUID(int=0)
+    if tag == 'binary':
+        return base64.b64decode(re.sub(r'\s', '', text))
+    # dates and URIs don't appear in settings files; keep them readable
+    # rather than inventing an encoding nobody tests
+    raise ValueError('unsupported LLSD element <%s>' % tag)
+
+
+def parse_file(filename):
+    root = ET.parse(filename).getroot()
+    if root.tag != 'llsd':
+        raise ValueError('%s is not an LLSD document' % filename)
+    children = list(root)
+    return parse_value(children[0]) if children else None
+
+
+def s32(value):
+    # LLSD integers are 32 bit signed
+    value &= 0xffffffff
+    return value - 0x100000000 if value & 0x80000000 else value
+
+
+def encode(value, out):
+    """LLSD binary, as LLSDBinaryParser reads it"""
+    if value is None:
+        out.append(b'!')
+    elif isinstance(value, bool):
+        out.append(b'1' if value else b'0')
+    elif isinstance(value, int):
+        out.append(b'i' + struct.pack('>i', s32(value)))
+    elif isinstance(value, float):
+        out.append(b'r' + struct.pack('>d', value))
+    elif isinstance(value, str):
+        data = value.encode('utf-8')
+        out.append(b's' + struct.pack('>I', len(data)) + data)
+    elif isinstance(value, uuid.UUID):
+        out.append(b'u' + value.bytes)
+    elif isinstance(value, bytes):
+        out.append(b'b' + struct.pack('>I', len(value)) + value)
+    elif isinstance(value, list):
+        out.append(b'[' + struct.pack('>I', len(value)))
+        for item in value:
+            encode(item, out)
+        out.append(b']')
+    elif isinstance(value, dict):
+        out.append(b'{' + struct.pack('>I', len(value)))
+        for key, item in value.items():
+            data = key.encode('utf-8')
+            out.append(b'k' + struct.pack('>I', len(data)) + data)
+            encode(item, out)
+        out.append(b'}')
+    else:
+        raise TypeError('cannot encode %r' % (value,))
+
+
+def compile_defaults(filenames):
+    defaults = {}
+    for filename in filenames:
+        with open(filename, 'rb') as f:
+            contents = f.read()
+        defaults[os.path.basename(filename)] = {
+            'size': len(contents),
+            'crc': s32(zlib.crc32(contents)),
+            'settings': parse_file(filename),
+        }
+    out = []
+    encode(defaults, out)
+    return b''.join(out)
+
+
+def write_source(blob, output, sources):
+    lines = [
+        '// Generated by fs_compile_settings_defaults.py from',
+    ]
+    lines += ['//   %s' % os.path.basename(source) for source in sources]
+    lines += [
+        '// Do not edit.',
+        '',
+        '#include "linden_common.h"',
+        '',
+        'extern const U8 gFSSettingsDefaultsBlob[];',
+        'extern const size_t gFSSettingsDefaultsBlobSize;',
+        '',
+        'const U8 gFSSettingsDefaultsBlob[] =',
+        '{',
+    ]
+    for start in range(0, len(blob), 20):
+        lines.append('    ' + ','.join(str(b) for b in blob[start:start + 20]) + ',')
+    lines += [
+        '};',
+        'const size_t gFSSettingsDefaultsBlobSize = %d;' % len(blob),
+        '',
+    ]
+    text = '\n'.join(lines)
+    # leave the file alone when nothing changed, so it isn't recompiled
+    try:
+        with open(output, 'r') as f:
+            if f.read() == text:
+                return
+    except IOError:
+        pass
+    with open(output, 'w') as f:
+        f.write(text)
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.exit(__doc__)
+    output, sources = argv[1], argv[2:]
+    blob = compile_defaults(sources)
+    write_source(blob, output, sources)
+    print('%s: %d settings files, %d bytes' % (os.path.basename(output), len(sources), len(blob)))
+
+
+if __name__ == '__main__':
+    main(sys.argv)
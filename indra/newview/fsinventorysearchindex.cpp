@@ -0,0 +1,324 @@
+/**
+ * @file fsinventorysearchindex.cpp
+ * @brief Background search index over the agent's inventory items
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fsinventorysearchindex.h"
+
+#include "llinventorymodel.h"
+#include "llviewercontrol.h"
+#include "llviewerinventory.h"
+#include "workqueue.h"
+
+#include <boost/tokenizer.hpp>
+
+namespace
+{
+    // Entries scanned per shared lock, so inventory updates on the main
+    // thread never wait for a whole query.
+    constexpr size_t QUERY_CHUNK = 4096;
+}
+
+FSInventorySearchIndex::FSInventorySearchIndex()
+:   mTable(std::make_shared<Table>())
+{
+    gInventory.addObserver(this);
+}
+
+void FSInventorySearchIndex::cleanupSingleton()
+{
+    if (gInventory.containsObserver(this))
+    {
+        gInventory.removeObserver(this);
+    }
+}
+
+//static
+bool FSInventorySearchIndex::isEnabled()
+{
+    static LLCachedControl<bool> search_index(gSavedSettings, "FSInventorySearchIndex");
+    return search_index;
+}
+
+bool FSInventorySearchIndex::postQuery(const Query& query, const callback_t& callback)
+{
+    if (!isEnabled() || !gInventory.isInventoryUsable())
+    {
+        return false;
+    }
+
+    LL::WorkQueue::ptr_t main_queue = LL::WorkQueue::getInstance("mainloop");
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (!main_queue || !general_queue)
+    {
+        return false;
+    }
+
+    if (mNeedsRebuild)
+    {
+        rebuild();
+    }
+
+    std::shared_ptr<Table> table = mTable;
+    return main_queue->postTo(
+        general_queue,
+        [table, query]() // work done on the general queue
+        {
+            auto result = std::make_shared<Result>();
+            runQuery(*table, query, *result);
+            return result;
+        },
+        [callback](std::shared_ptr<Result> result) // callback to main thread
+        {
+            callback(result);
+        });
+}
+
+bool FSInventorySearchIndex::isUnchangedSince(const LLUUID& id, U64 version) const
+{
+    // Only the main thread writes, so it can read without the lock.
+    const Table& table = *mTable;
+    auto it = table.mSlots.find(id);
+    return it != table.mSlots.end() && table.mEntries[it->second].mVersion <= version;
+}
+
+void FSInventorySearchIndex::changed(U32 mask)
+{
+    if (mNeedsRebuild || !(mask & (ADD | REMOVE | LABEL | INTERNAL | REBUILD)))
+    {
+        // Nothing indexed yet, or nothing that touches indexed fields.
+        return;
+    }
+
+    const LLInventoryModel::changed_items_t& changed_ids = gInventory.getChangedIDs();
+    if (changed_ids.empty())
+    {
+        // A change we cannot attribute; start over on the next query.
+        mNeedsRebuild = true;
+        return;
+    }
+
+    LLExclusiveMutexLock lock(&mTable->mMutex);
+    ++mTable->mVersion;
+    for (const LLUUID& id : changed_ids)
+    {
+        update(id);
+    }
+}
+
+void FSInventorySearchIndex::rebuild()
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    LLInventoryModel::cat_array_t cats;
+    LLInventoryModel::item_array_t items;
+    for (const LLUUID& root_id : { gInventory.getRootFolderID(), gInventory.getLibraryRootFolderID() })
+    {
+        if (root_id.notNull())
+        {
+            gInventory.collectDescendents(root_id, cats, items, LLInventoryModel::INCLUDE_TRASH);
+        }
+    }
+
+    // Build the new table outside the lock, then swap it in.
+    std::vector<Entry> entries;
+    LLUUIDHashMap<U32> slots;
+    entries.reserve(items.size());
+    slots.reserve(items.size());
+
+    LLExclusiveMutexLock lock(&mTable->mMutex);
+    const U64 version = ++mTable->mVersion;
+    lock.unlock();
+
+    for (const LLPointer<LLViewerInventoryItem>& item : items)
+    {
+        if (item && !item->getIsLinkType() && slots.emplace(item->getUUID(), static_cast<U32>(entries.size())).second)
+        {
+            entries.emplace_back();
+            fill(entries.back(), item, version);
+        }
+    }
+
+    lock.lock();
+    mTable->mEntries.swap(entries);
+    mTable->mSlots.swap(slots);
+    mTable->mFreeSlots.clear();
+    lock.unlock();
+
+    mNeedsRebuild = false;
+    LL_DEBUGS("Inventory") << "Search index rebuilt with " << mTable->mEntries.size() << " items" << LL_ENDL;
+}
+
+// Called with the table locked exclusively.
+void FSInventorySearchIndex::update(const LLUUID& id)
+{
+    Table& table = *mTable;
+    const LLViewerInventoryItem* item = gInventory.getItem(id);
+    auto it = table.mSlots.find(id);
+
+    // Links show their target's name, which can change without the link
+    // being notified; leave them to the regular filter path.
+    if (!item || item->getIsLinkType())
+    {
+        if (it != table.mSlots.end())
+        {
+            Entry& entry = table.mEntries[it->second];
+            entry = Entry();
+            table.mFreeSlots.push_back(it->second);
+            table.mSlots.erase(it);
+        }
+        return;
+    }
+
+    if (it != table.mSlots.end())
+    {
+        fill(table.mEntries[it->second], item, table.mVersion);
+        return;
+    }
+
+    U32 slot;
+    if (!table.mFreeSlots.empty())
+    {
+        slot = table.mFreeSlots.back();
+        table.mFreeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<U32>(table.mEntries.size());
+        table.mEntries.emplace_back();
+    }
+    table.mSlots[id] = slot;
+    fill(table.mEntries[slot], item, table.mVersion);
+}
+
+//static
+void FSInventorySearchIndex::fill(Entry& entry, const LLViewerInventoryItem* item, U64 version)
+{
+    // Upper cased the same way LLInvFVBridge builds its searchable strings.
+    entry.mID = item->getUUID();
+    entry.mAssetID = item->getAssetUUID();
+    entry.mName = item->getName();
+    LLStringUtil::toUpper(entry.mName);
+    entry.mDescription = item->getDescription();
+    LLStringUtil::toUpper(entry.mDescription);
+    entry.mVersion = version;
+    entry.mFlags = item->getFlags();
+    entry.mPermissions = item->getPermissionMask();
+    entry.mType = static_cast<S8>(item->getType());
+    entry.mInventoryType = static_cast<S8>(item->getInventoryType());
+}
+
+//static
+void FSInventorySearchIndex::runQuery(Table& table, const Query& query, Result& result)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    size_t next = 0;
+    bool first = true;
+    while (true)
+    {
+        LLSharedMutexLock lock(&table.mMutex);
+        if (first)
+        {
+            result.mVersion = table.mVersion;
+            first = false;
+        }
+
+        const size_t end = llmin(next + QUERY_CHUNK, table.mEntries.size());
+        if (next >= end)
+        {
+            break;
+        }
+        for (; next < end; ++next)
+        {
+            const Entry& entry = table.mEntries[next];
+            if (entry.mID.notNull() && matches(query, entry))
+            {
+                result.mMatches.insert(entry.mID);
+            }
+        }
+    }
+}
+
+//static
+bool FSInventorySearchIndex::matches(const Query& query, const Entry& entry)
+{
+    // Types and permissions only ever narrow the filter down further, so
+    // they can be applied here without changing the outcome.
+    if (entry.mInventoryType >= 0 && entry.mInventoryType < 64 && !(query.mObjectTypes & (1ULL << entry.mInventoryType)))
+    {
+        return false;
+    }
+    if ((entry.mPermissions & query.mPermissions) != query.mPermissions)
+    {
+        return false;
+    }
+
+    switch (query.mField)
+    {
+        case FIELD_DESCRIPTION:
+            return entry.mDescription.find(query.mSubString) != std::string::npos;
+        case FIELD_ASSET_ID:
+        {
+            std::string asset_id = entry.mAssetID.asString();
+            LLStringUtil::toUpper(asset_id);
+            return asset_id.find(query.mSubString) != std::string::npos;
+        }
+        case FIELD_NAME:
+        default:
+            break;
+    }
+
+    if (!query.mExactToken.empty())
+    {
+        typedef boost::tokenizer<boost::char_separator<char> > tokenizer;
+        boost::char_separator<char> sep(" ");
+        tokenizer tokens(entry.mName, sep);
+        for (const auto& token : tokens)
+        {
+            if (token == query.mExactToken)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    if (!query.mTokens.empty())
+    {
+        for (const std::string& token : query.mTokens)
+        {
+            if (entry.mName.find(token) == std::string::npos)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return entry.mName.find(query.mSubString) != std::string::npos;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file fsinventorysearchindex.h
+ * @brief Background search index over the agent's inventory items
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_INVENTORYSEARCHINDEX_H
+#define FS_INVENTORYSEARCHINDEX_H
+
+#include "llinventoryobserver.h"
+#include "llmutex.h"
+#include "llpermissionsflags.h"
+#include "llsingleton.h"
+#include "lluuidhashmap.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class LLViewerInventoryItem;
+
+//
+//  Keeps the searchable fields of every inventory item (upper case name and
+//  description, asset ID, types, flags and the agent's permissions) in a flat
+//  table that a worker thread can scan while the main thread keeps it current
+//  from inventory observer notifications.
+//
+//  A query returns the set of item IDs whose indexed fields match, tagged
+//  with the index version it ran against. LLInventoryFilter uses it to answer
+//  the string part of its check with a hash lookup instead of rebuilding and
+//  searching strings for every folder view item. Anything the index cannot
+//  vouch for (folders, links, items changed since the query) still goes
+//  through the normal filter path, so the filter result does not change.
+//
+class FSInventorySearchIndex : public LLSingleton<FSInventorySearchIndex>, public LLInventoryObserver
+{
+    LLSINGLETON(FSInventorySearchIndex);
+    LOG_CLASS(FSInventorySearchIndex);
+
+public:
+    enum EField
+    {
+        FIELD_NAME,
+        FIELD_DESCRIPTION,
+        FIELD_ASSET_ID
+    };
+
+    // Mirrors LLInventoryFilter's string matching; all strings upper case.
+    struct Query
+    {
+        EField                      mField{ FIELD_NAME };
+        std::string                 mSubString;
+        std::vector<std::string>    mTokens;        // all must match, names only
+        std::string                 mExactToken;    // whole word match, names only
+        U64                         mObjectTypes{ ~0ULL };  // LLInventoryType bits
+        PermissionMask              mPermissions{ PERM_NONE };
+    };
+
+    struct Result
+    {
+        uuid_hash_set_t mMatches;
+        U64             mVersion{ 0 };
+    };
+    typedef std::shared_ptr<const Result> result_ptr_t;
+    typedef std::function<void(const result_ptr_t&)> callback_t;
+
+    static bool isEnabled();
+
+    // Runs the query on the "General" work queue and hands the result to
+    // callback on the main loop. Returns false if the index is disabled or
+    // the queues are not running.
+    bool postQuery(const Query& query, const callback_t& callback);
+
+    // Main thread only. True if the item is indexed and its entry has not
+    // changed since the given result version.
+    bool isUnchangedSince(const LLUUID& id, U64 version) const;
+
+    // LLInventoryObserver
+    void changed(U32 mask) override;
+
+private:
+    void cleanupSingleton() override;
+
+    struct Entry
+    {
+        LLUUID          mID;
+        LLUUID          mAssetID;
+        std::string     mName;
+        std::string     mDescription;
+        U64             mVersion{ 0 };
+        U32             mFlags{ 0 };
+        PermissionMask  mPermissions{ PERM_NONE };
+        S8              mType{ -1 };
+        S8              mInventoryType{ -1 };
+    };
+
+    // Written on the main thread under an exclusive lock, scanned by
+    // workers under a shared one. Entries are addressed by slot so a scan
+    // can drop the lock between chunks. Queries hold the table by pointer
+    // so a scan still running at shutdown never touches a dead singleton.
+    struct Table
+    {
+        std::vector<Entry>  mEntries;
+        std::vector<U32>    mFreeSlots;
+        LLUUIDHashMap<U32>  mSlots;
+        LLSharedMutex       mMutex;
+        U64                 mVersion{ 0 };
+    };
+
+    void rebuild();
+    void update(const LLUUID& id);
+    static void fill(Entry& entry, const LLViewerInventoryItem* item, U64 version);
+    static void runQuery(Table& table, const Query& query, Result& result);
+    static bool matches(const Query& query, const Entry& entry);
+
+    std::shared_ptr<Table>  mTable;
+    bool                    mNeedsRebuild{ true };
+};
+
+#endif // FS_INVENTORYSEARCHINDEX_H
@@ -0,0 +1,169 @@
+/**
+ * @file fsobjectupdatedecoder.cpp
+ * @brief Decodes object update messages on a worker thread
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fsobjectupdatedecoder.h"
+
+#include "lldatapacker.h"
+#include "llviewercontrol.h"
+#include "message.h"
+#include "workqueue.h"
+
+#include <algorithm>
+#include <thread>
+
+void FSDecodedObjectUpdate::capture(LLMessageSystem* msg)
+{
+    msg->getU64Fast(_PREHASH_RegionData, _PREHASH_RegionHandle, mRegionHandle);
+    msg->getU16Fast(_PREHASH_RegionData, _PREHASH_TimeDilation, mTimeDilation);
+    mSender = msg->getSender();
+    mPacketID = msg->getCurrentRecvPacketID();
+
+    S32 num_blocks = msg->getNumberOfBlocksFast(_PREHASH_ObjectData);
+    mBlocks.resize(llmax(num_blocks, 0));
+    for (S32 i = 0; i < num_blocks; ++i)
+    {
+        Block& block = mBlocks[i];
+
+        S32 size = llclamp(msg->getSizeFast(_PREHASH_ObjectData, i, _PREHASH_Data), 0, MAX_DATA_SIZE);
+        block.mData.resize(size);
+        if (size > 0)
+        {
+            msg->getBinaryDataFast(_PREHASH_ObjectData, _PREHASH_Data, block.mData.data(), 0, i, size);
+        }
+
+        size = llclamp(msg->getSizeFast(_PREHASH_ObjectData, i, _PREHASH_TextureEntry), 0, MAX_TEXTURE_ENTRY_SIZE);
+        block.mTextureEntry.resize(size);
+        if (size > 0)
+        {
+            msg->getBinaryDataFast(_PREHASH_ObjectData, _PREHASH_TextureEntry, block.mTextureEntry.data(), 0, i, size);
+        }
+    }
+}
+
+void FSDecodedObjectUpdate::decode(bool parse_texture_entry)
+{
+    S32 expected = PENDING;
+    if (!mState.compare_exchange_strong(expected, DECODING, std::memory_order_acq_rel))
+    {
+        return;
+    }
+
+    for (Block& block : mBlocks)
+    {
+        decodeBlock(block, parse_texture_entry);
+    }
+
+    mState.store(DECODED, std::memory_order_release);
+}
+
+void FSDecodedObjectUpdate::waitDecoded()
+{
+    decode(false);
+    while (!isDecoded())
+    {
+        // a worker is part way through one message
+        std::this_thread::yield();
+    }
+}
+
+// Unpacks what LLViewerObjectList::processObjectUpdate() and the terse branch
+// of LLVOVolume::processUpdateMessage() would, in the same order.
+void FSDecodedObjectUpdate::decodeBlock(Block& block, bool parse_texture_entry) const
+{
+    LLDataPackerBinaryBuffer dp(block.mData.data(), (S32)block.mData.size());
+    dp.unpackU32(block.mLocalID, "LocalID");
+    block.mHeaderSize = dp.getCurrentSize();
+
+    if (parse_texture_entry && !block.mTextureEntry.empty())
+    {
+        U8 tdpbuffer[MAX_TEXTURE_ENTRY_SIZE] = {};
+        memcpy(tdpbuffer, block.mTextureEntry.data(), block.mTextureEntry.size());
+        LLDataPackerBinaryBuffer tdp(tdpbuffer, MAX_TEXTURE_ENTRY_SIZE);
+        block.mTEContents = std::make_unique<LLTEContents>();
+        block.mTextureEntryResult = LLPrimitive::parseTEMessage(tdp, *block.mTEContents);
+    }
+}
+
+//static
+bool FSObjectUpdateDecoder::isEnabled()
+{
+    static LLCachedControl<bool> worker_decode(gSavedSettings, "FSObjectUpdateWorkerDecode", true);
+    return worker_decode;
+}
+
+void FSObjectUpdateDecoder::queue(LLMessageSystem* msg)
+{
+    auto update = std::make_shared<FSDecodedObjectUpdate>();
+    update->capture(msg);
+    mPending.push_back(update);
+    ++mQueuedCount;
+
+    // If the pool is gone or full the update is decoded when it is applied.
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (general_queue)
+    {
+        general_queue->tryPost([update]() { update->decode(); });
+    }
+}
+
+FSObjectUpdateDecoder::update_ptr_t FSObjectUpdateDecoder::popDecoded()
+{
+    if (mPending.empty())
+    {
+        return update_ptr_t();
+    }
+
+    update_ptr_t update = mPending.front();
+    mPending.pop_front();
+    if (update->isDecoded())
+    {
+        ++mDecodedOnWorkerCount;
+    }
+    else
+    {
+        update->waitDecoded();
+    }
+    return update;
+}
+
+void FSObjectUpdateDecoder::discard(U64 region_handle)
+{
+    // A worker may still hold a discarded update; it only decodes it.
+    mPending.erase(std::remove_if(mPending.begin(), mPending.end(),
+                                  [region_handle](const update_ptr_t& update)
+                                  {
+                                      return update->mRegionHandle == region_handle;
+                                  }),
+                   mPending.end());
+}
+
+void FSObjectUpdateDecoder::clear()
+{
+    mPending.clear();
+}
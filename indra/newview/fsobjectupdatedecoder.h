@@ -0,0 +1,147 @@
+/**
+ * @file fsobjectupdatedecoder.h
+ * @brief Decodes object update messages on a worker thread
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_OBJECTUPDATEDECODER_H
+#define FS_OBJECTUPDATEDECODER_H
+
+#include "llhost.h"
+#include "llprimitive.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class LLMessageSystem;
+
+//
+//  One ImprovedTerseObjectUpdate message, copied out of the message system
+//  so it can be decoded after the message is gone.
+//
+//  capture() runs on the main thread while the message is current. decode()
+//  unpacks each object's local ID and parses its TextureEntry; it touches
+//  nothing but this object, so it can run on any thread. Everything that
+//  changes an object is left to LLViewerObjectList on the main thread.
+//
+//  ObjectUpdateCompressed is not queued: past its header the whole payload
+//  is read by processUpdateMessage() or stored as is in the object cache,
+//  so a worker would only save the three header fields and the copy costs
+//  more than that.
+//
+class FSDecodedObjectUpdate
+{
+public:
+    struct Block
+    {
+        std::vector<U8>     mData;          // ObjectData.Data, at most MAX_DATA_SIZE
+        std::vector<U8>     mTextureEntry;  // at most MAX_TEXTURE_ENTRY_SIZE
+
+        // filled in by decode()
+        U32                 mLocalID{ 0 };
+        S32                 mHeaderSize{ 0 };   // where processUpdateMessage() carries on in mData
+        std::unique_ptr<LLTEContents> mTEContents;
+        S32                 mTextureEntryResult{ 0 };   // what LLPrimitive::parseTEMessage() returned
+    };
+
+    // The buffers LLViewerObjectList and LLVOVolume have always read these into.
+    static const S32 MAX_DATA_SIZE = 2048;
+    static const S32 MAX_TEXTURE_ENTRY_SIZE = 1024;
+
+    void capture(LLMessageSystem* msg);
+
+    // Any thread. Does nothing if the update is decoded or being decoded.
+    // Without parse_texture_entry, mTEContents stays empty and the object
+    // unpacks mTextureEntry itself.
+    void decode(bool parse_texture_entry = true);
+
+    // Main thread. Decodes here unless a worker got to it first, in which
+    // case it waits for the worker to finish. Decoding here leaves the
+    // TextureEntry to the object, which parses only the faces it has
+    // rather than all LLTEContents::MAX_TES.
+    void waitDecoded();
+
+    bool isDecoded() const { return mState.load(std::memory_order_acquire) == DECODED; }
+
+    U64                 mRegionHandle{ 0 };
+    U16                 mTimeDilation{ 0 };
+    LLHost              mSender;
+    U32                 mPacketID{ 0 };
+    std::vector<Block>  mBlocks;
+
+private:
+    enum EState
+    {
+        PENDING,
+        DECODING,
+        DECODED
+    };
+
+    void decodeBlock(Block& block, bool parse_texture_entry) const;
+
+    std::atomic<S32>    mState{ PENDING };
+};
+
+//
+//  Queues terse object updates in arrival order and has the "General" thread
+//  pool decode them, so the message loop only copies each message. The
+//  queue is applied (see LLViewerObjectList::applyDecodedObjectUpdates())
+//  once the frame's messages have been read and before any other object
+//  message is handled, so updates still reach the objects in the order they
+//  were received.
+//
+class FSObjectUpdateDecoder
+{
+    LOG_CLASS(FSObjectUpdateDecoder);
+
+public:
+    typedef std::shared_ptr<FSDecodedObjectUpdate> update_ptr_t;
+
+    // FSObjectUpdateWorkerDecode
+    static bool isEnabled();
+
+    // Main thread, from the message handler.
+    void queue(LLMessageSystem* msg);
+
+    bool hasPending() const { return !mPending.empty(); }
+
+    // The oldest queued update, decoded, or null when there is none.
+    update_ptr_t popDecoded();
+
+    // Drops the queued updates of a region that is going away.
+    void discard(U64 region_handle);
+    void clear();
+
+    U64 getQueuedCount() const { return mQueuedCount; }
+    U64 getDecodedOnWorkerCount() const { return mDecodedOnWorkerCount; }
+
+private:
+    std::deque<update_ptr_t>    mPending;
+    U64                         mQueuedCount{ 0 };
+    U64                         mDecodedOnWorkerCount{ 0 };
+};
+
+#endif // FS_OBJECTUPDATEDECODER_H
@@ -0,0 +1,98 @@
+/**
+ * @file fssettingsdefaults.cpp
+ * @brief Default settings compiled into the viewer at build time
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fssettingsdefaults.h"
+
+#include "llcontrol.h"
+#include "llcrc.h"
+#include "llfile.h"
+#include "llsdserialize.h"
+
+// fssettingsdefaults_blob.cpp, generated by fs_compile_settings_defaults.py
+extern const U8 gFSSettingsDefaultsBlob[];
+extern const size_t gFSSettingsDefaultsBlobSize;
+
+namespace
+{
+    LLSD sDefaults;
+    bool sDecoded = false;
+
+    const LLSD& get_defaults()
+    {
+        if (!sDecoded)
+        {
+            sDecoded = true;
+            LLPointer<LLSDBinaryParser> parser = new LLSDBinaryParser;
+            if (parser->parseBuffer((const char*)gFSSettingsDefaultsBlob, gFSSettingsDefaultsBlobSize, sDefaults) == LLSDParser::PARSE_FAILURE
+                || !sDefaults.isMap())
+            {
+                LL_WARNS("Settings") << "Precompiled default settings don't decode; using the XML files." << LL_ENDL;
+                sDefaults.clear();
+            }
+        }
+        return sDefaults;
+    }
+
+    bool is_unchanged(const LLSD& compiled, const std::string& installed_path)
+    {
+        llstat stat_data;
+        if (LLFile::stat(installed_path, &stat_data) != 0
+            || (S64)stat_data.st_size != compiled["size"].asInteger())
+        {
+            return false;
+        }
+        LLCRC crc;
+        crc.update(installed_path);
+        return crc.getCRC() == (U32)compiled["crc"].asInteger();
+    }
+}
+
+// static
+U32 FSSettingsDefaults::load(LLControlGroup& group, const std::string& file_name, const std::string& installed_path)
+{
+    const LLSD& defaults = get_defaults();
+    if (!defaults.has(file_name))
+    {
+        return 0;
+    }
+
+    const LLSD& compiled = defaults[file_name];
+    if (!is_unchanged(compiled, installed_path))
+    {
+        LL_INFOS("Settings") << installed_path << " differs from the one built in; parsing it." << LL_ENDL;
+        return 0;
+    }
+    return group.loadFromLLSD(compiled["settings"], installed_path, true);
+}
+
+// static
+void FSSettingsDefaults::release()
+{
+    sDefaults.clear();
+}
@@ -0,0 +1,56 @@
+/**
+ * @file fssettingsdefaults.h
+ * @brief Default settings compiled into the viewer at build time
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_SETTINGSDEFAULTS_H
+#define FS_SETTINGSDEFAULTS_H
+
+class LLControlGroup;
+
+/**
+ * The build runs fs_compile_settings_defaults.py over the default settings
+ * files in app_settings and links the result in as binary LLSD, which
+ * decodes several times faster than LLSDXMLParser reads the XML. At
+ * startup the defaults come from there and only the user's own files are
+ * parsed.
+ *
+ * The blob stands in for an installed file only while that file still has
+ * the size and CRC it was compiled from, so editing app_settings by hand
+ * still works.
+ */
+class FSSettingsDefaults
+{
+public:
+    // Loads file_name's defaults into group as
+    // group.loadFromFile(installed_path, true) would. Returns the number of
+    // settings loaded, or 0 if the caller must parse installed_path itself.
+    static U32 load(LLControlGroup& group, const std::string& file_name, const std::string& installed_path);
+
+    // Frees the decoded defaults once they are all loaded.
+    static void release();
+};
+
+#endif // FS_SETTINGSDEFAULTS_H
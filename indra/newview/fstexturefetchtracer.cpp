@@ -0,0 +1,206 @@
+/**
+ * @file fstexturefetchtracer.cpp
+ * @brief Per-request texture fetch stage tracer with Chrome trace export
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fstexturefetchtracer.h"
+
+#include "lldir.h"
+#include "llfile.h"
+#include "lltexturefetch.h"
+#include "llthread.h"
+#include "lltimer.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+std::atomic<bool> FSTextureFetchTracer::sEnabled{ false };
+std::atomic<U64> FSTextureFetchTracer::sDropped{ 0 };
+LLMutex FSTextureFetchTracer::sMutex;
+std::vector<FSTextureFetchTracer::Span> FSTextureFetchTracer::sRing;
+size_t FSTextureFetchTracer::sNext = 0;
+bool FSTextureFetchTracer::sWrapped = false;
+
+//static
+void FSTextureFetchTracer::start(U32 capacity)
+{
+    {
+        LLMutexLock lock(&sMutex);
+        sRing.clear();
+        sRing.resize(llmax(capacity, 1024U));
+        sNext = 0;
+        sWrapped = false;
+        sDropped = 0;
+    }
+    sEnabled = true;
+
+    LL_INFOS() << "Texture fetch tracing started, capacity " << sRing.size() << " spans" << LL_ENDL;
+}
+
+//static
+bool FSTextureFetchTracer::stop(const std::string& filename)
+{
+    if (!sEnabled.exchange(false))
+    {
+        return false;
+    }
+
+    std::vector<Span> spans;
+    {
+        LLMutexLock lock(&sMutex);
+        if (sWrapped)
+        {
+            spans.assign(sRing.begin() + sNext, sRing.end());
+        }
+        spans.insert(spans.end(), sRing.begin(), sRing.begin() + sNext);
+        sRing.clear();
+        sRing.shrink_to_fit();
+        sNext = 0;
+        sWrapped = false;
+    }
+
+    if (spans.empty())
+    {
+        LL_INFOS() << "Texture fetch tracing stopped, nothing recorded" << LL_ENDL;
+        return false;
+    }
+
+    std::string out_name(filename);
+    if (out_name.empty())
+    {
+        out_name = gDirUtilp->getExpandedFilename(LL_PATH_LOGS,
+                                                  llformat("texture_fetch_trace_%u.json", (U32)time_corrected()));
+    }
+
+    if (!writeChromeTrace(out_name, spans))
+    {
+        LL_WARNS() << "Unable to write texture fetch trace to " << out_name << LL_ENDL;
+        return false;
+    }
+
+    LL_INFOS() << "Texture fetch tracing stopped, wrote " << spans.size() << " spans to " << out_name
+               << " (" << getDroppedCount() << " dropped)" << LL_ENDL;
+    return true;
+}
+
+//static
+void FSTextureFetchTracer::record(const LLUUID& id, S32 state, U64 start_usec, U64 end_usec, S32 discard)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    static thread_local U32 thread_hash = (U32)std::hash<LLThread::id_t>()(LLThread::currentID());
+
+    LLMutexLock lock(&sMutex);
+    if (sRing.empty())
+    {
+        return;
+    }
+
+    if (sWrapped)
+    {
+        ++sDropped; // overwriting the oldest span
+    }
+
+    Span& span = sRing[sNext];
+    span.mID = id;
+    span.mStart = start_usec;
+    span.mEnd = end_usec;
+    span.mThread = thread_hash;
+    span.mState = state;
+    span.mDiscard = discard;
+
+    if (++sNext == sRing.size())
+    {
+        sNext = 0;
+        sWrapped = true;
+    }
+}
+
+//static
+bool FSTextureFetchTracer::writeChromeTrace(const std::string& filename, const std::vector<Span>& spans)
+{
+    llofstream out(filename.c_str());
+    if (!out.is_open())
+    {
+        return false;
+    }
+
+    // One track (tid) per texture, numbered in order of first appearance so
+    // the earliest requests sort to the top in the trace viewer.
+    std::vector<const Span*> ordered;
+    ordered.reserve(spans.size());
+    for (const Span& span : spans)
+    {
+        ordered.push_back(&span);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [](const Span* lhs, const Span* rhs) { return lhs->mStart < rhs->mStart; });
+
+    const U64 origin = ordered.front()->mStart;
+    std::unordered_map<LLUUID, U32> tracks;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Texture fetch\"}}";
+
+    for (const Span* span : ordered)
+    {
+        auto inserted = tracks.emplace(span->mID, (U32)tracks.size() + 1);
+        const U32 tid = inserted.first->second;
+        if (inserted.second)
+        {
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                << ",\"args\":{\"name\":\"" << span->mID.asString() << "\"}}";
+            out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                << ",\"args\":{\"sort_index\":" << tid << "}}";
+        }
+
+        const U64 ts = span->mStart - origin;
+        if (span->mState == STATE_REQUESTED || span->mState == STATE_FINISHED)
+        {
+            out << ",\n{\"name\":\"" << (span->mState == STATE_REQUESTED ? "REQUESTED" : "DONE")
+                << "\",\"cat\":\"texture\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << tid
+                << ",\"ts\":" << ts
+                << ",\"args\":{\"discard\":" << span->mDiscard << "}}";
+            continue;
+        }
+
+        out << ",\n{\"name\":\"" << LLTextureFetch::getStateString(span->mState)
+            << "\",\"cat\":\"texture\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+            << ",\"ts\":" << ts
+            << ",\"dur\":" << (span->mEnd > span->mStart ? span->mEnd - span->mStart : 0)
+            << ",\"args\":{\"discard\":" << span->mDiscard
+            << ",\"thread\":" << span->mThread << "}}";
+    }
+
+    out << "\n]}\n";
+    out.close();
+    return !out.fail();
+}
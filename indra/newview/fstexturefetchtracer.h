@@ -0,0 +1,95 @@
+/**
+ * @file fstexturefetchtracer.h
+ * @brief Per-request texture fetch stage tracer with Chrome trace export
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_TEXTUREFETCHTRACER_H
+#define FS_TEXTUREFETCHTRACER_H
+
+#include "llmutex.h"
+#include "lluuid.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+//
+//  Opt-in tracer for LLTextureFetchWorker.  Every state a fetch request
+//  passes through (cache read, HTTP, decode, cache write...) is recorded as
+//  a span in a fixed size ring buffer.  stop() writes the buffer out as a
+//  Chrome trace / Perfetto JSON file with one track per texture, so a login
+//  or teleport can be inspected request by request.
+//
+//  Controlled by the FSTextureFetchTrace setting.  When disabled the only
+//  cost on the fetch threads is one relaxed atomic load per state change.
+//
+class FSTextureFetchTracer
+{
+    LOG_CLASS(FSTextureFetchTracer);
+
+public:
+    static constexpr S32 STATE_REQUESTED = -1; // pseudo-state for the instant a request is created
+    static constexpr S32 STATE_FINISHED = -2;  // pseudo-state for the instant a request reaches DONE
+
+    // Start recording into a ring of capacity spans, discarding anything
+    // recorded before.
+    static void start(U32 capacity);
+
+    // Stop recording and write the trace to filename.  An empty filename
+    // picks a timestamped file in the logs directory.  Returns false if
+    // nothing was written.
+    static bool stop(const std::string& filename = std::string());
+
+    static bool isEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    // Record a completed state span [start_usec, end_usec] for texture id.
+    // Threads:  any
+    static void record(const LLUUID& id, S32 state, U64 start_usec, U64 end_usec, S32 discard);
+
+    // Number of spans lost because the ring wrapped.
+    static U64 getDroppedCount() { return sDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Span
+    {
+        LLUUID  mID;
+        U64     mStart;
+        U64     mEnd;
+        U32     mThread;
+        S32     mState;
+        S32     mDiscard;
+    };
+
+    static bool writeChromeTrace(const std::string& filename, const std::vector<Span>& spans);
+
+    static std::atomic<bool> sEnabled;
+    static std::atomic<U64>  sDropped;
+    static LLMutex           sMutex;
+    static std::vector<Span> sRing;     // guarded by sMutex
+    static size_t            sNext;     // guarded by sMutex
+    static bool              sWrapped;  // guarded by sMutex
+};
+
+#endif // FS_TEXTUREFETCHTRACER_H
@@ -0,0 +1,464 @@
+/**
+ * @file fstextureprefetch.cpp
+ * @brief Texture prefetch from the object cache of a teleport destination
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fstextureprefetch.h"
+
+#include "llagent.h"
+#include "llappviewer.h"
+#include "llcallbacklist.h"
+#include "llgltfmateriallist.h"
+#include "llpartdata.h"
+#include "llprimitive.h"
+#include "llstartup.h"
+#include "lltexturecache.h"
+#include "llviewercontrol.h"
+#include "llviewerregion.h"
+#include "llvolumemessage.h"
+
+#include <unordered_set>
+
+namespace
+{
+    constexpr F32 PREFETCH_HOLD_TIME = 20.f;            // seconds to keep unclaimed prefetches alive
+    constexpr F32 PREFETCH_NEAR_AREA = 256.f * 256.f;   // pixel area requested next to the arrival point
+    constexpr F32 PREFETCH_FAR_AREA = 32.f * 32.f;      // pixel area requested at the prefetch radius
+
+    struct CachedPrim
+    {
+        U32                 mParentID{ 0 };
+        LLVector3           mPos;
+        F32                 mRadius{ 0.f };
+        std::vector<LLUUID> mTextures;
+        std::vector<LLUUID> mMaterials;
+    };
+
+    // The first field of a packed TextureEntry is the image ID: a default
+    // value followed by (face bitfield, value) pairs up to a zero bitfield.
+    // Only the set of IDs is needed here, so the faces are not resolved.
+    void collect_te_images(const U8* cur, const U8* end, std::vector<LLUUID>& images)
+    {
+        if (end - cur < UUID_BYTES)
+        {
+            return;
+        }
+
+        LLUUID id;
+        memcpy(id.mData, cur, UUID_BYTES);
+        cur += UUID_BYTES;
+        images.push_back(id);
+
+        while (cur < end)
+        {
+            U64 index_flags = 0;
+            U8 sbit = 0;
+            do
+            {
+                if (cur >= end)
+                {
+                    return;
+                }
+                sbit = *cur++;
+                index_flags = (index_flags << 7) | (sbit & 0x7F);
+            } while (sbit & 0x80);
+
+            if (!index_flags || end - cur < UUID_BYTES)
+            {
+                return;
+            }
+
+            memcpy(id.mData, cur, UUID_BYTES);
+            cur += UUID_BYTES;
+            images.push_back(id);
+        }
+    }
+
+    // Walks a cached OUT_FULL_CACHED update the same way
+    // LLViewerObject::processUpdateMessage() and LLVOVolume::processUpdateMessage()
+    // do, keeping only what is needed to rank and prefetch its textures.
+    // Keep in sync with those when the compressed format changes.
+    bool parse_cached_prim(LLDataPackerBinaryBuffer& dp, std::vector<U8>& scratch, CachedPrim& prim)
+    {
+        LLUUID id;
+        U32 local_id;
+        U8 pcode;
+        if (!dp.unpackUUID(id, "ID") || !dp.unpackU32(local_id, "LocalID") || !dp.unpackU8(pcode, "PCode"))
+        {
+            return false;
+        }
+        if (pcode != LL_PCODE_VOLUME)
+        {
+            return false;
+        }
+
+        U8 state, material, click_action;
+        U32 crc, value;
+        LLVector3 scale, rot;
+        LLUUID owner_id;
+        if (!dp.unpackU8(state, "State") ||
+            !dp.unpackU32(crc, "CRC") ||
+            !dp.unpackU8(material, "Material") ||
+            !dp.unpackU8(click_action, "ClickAction") ||
+            !dp.unpackVector3(scale, "Scale") ||
+            !dp.unpackVector3(prim.mPos, "Pos") ||
+            !dp.unpackVector3(rot, "Rot") ||
+            !dp.unpackU32(value, "SpecialCode") ||
+            !dp.unpackUUID(owner_id, "Owner"))
+        {
+            return false;
+        }
+        prim.mRadius = scale.length() * 0.5f;
+
+        S32 size = 0;
+        if (value & 0x80)
+        {
+            LLVector3 omega;
+            dp.unpackVector3(omega, "Omega");
+        }
+        if (value & 0x20)
+        {
+            dp.unpackU32(prim.mParentID, "ParentID");
+        }
+        if (value & 0x2)
+        {
+            U8 tree_data;
+            dp.unpackU8(tree_data, "TreeData");
+        }
+        else if (value & 0x1)
+        {
+            U32 scratch_size;
+            dp.unpackU32(scratch_size, "ScratchPadSize");
+            if (!dp.unpackBinaryData(scratch.data(), size, "PartData"))
+            {
+                return false;
+            }
+        }
+        if (value & 0x4)
+        {
+            std::string text;
+            U8 color[4];
+            dp.unpackString(text, "Text");
+            dp.unpackBinaryDataFixed(color, 4, "Color");
+        }
+        if (value & 0x200)
+        {
+            std::string media_url;
+            dp.unpackString(media_url, "MediaURL");
+        }
+        if (value & 0x8)
+        {
+            LLPartSysData part_sys;
+            if (!part_sys.unpackLegacy(dp))
+            {
+                return false;
+            }
+        }
+
+        U8 num_parameters = 0;
+        if (!dp.unpackU8(num_parameters, "num_params"))
+        {
+            return false;
+        }
+        for (U8 param = 0; param < num_parameters; ++param)
+        {
+            U16 param_type;
+            dp.unpackU16(param_type, "param_type");
+            if (!dp.unpackBinaryData(scratch.data(), size, "param_data"))
+            {
+                return false;
+            }
+
+            LLDataPackerBinaryBuffer dp2(scratch.data(), size);
+            if (param_type == LLNetworkData::PARAMS_SCULPT)
+            {
+                LLSculptParams sculpt;
+                if (sculpt.unpack(dp2) && (sculpt.getSculptType() & LL_SCULPT_TYPE_MASK) != LL_SCULPT_TYPE_MESH)
+                {
+                    prim.mTextures.push_back(sculpt.getSculptTexture());
+                }
+            }
+            else if (param_type == LLNetworkData::PARAMS_RENDER_MATERIAL)
+            {
+                U8 count = 0;
+                dp2.unpackU8(count, "count");
+                for (U8 i = 0; i < count; ++i)
+                {
+                    U8 te_idx;
+                    LLUUID material_id;
+                    if (!dp2.unpackU8(te_idx, "te_idx") || !dp2.unpackUUID(material_id, "te_id"))
+                    {
+                        break;
+                    }
+                    prim.mMaterials.push_back(material_id);
+                }
+            }
+        }
+
+        if (value & 0x10)
+        {
+            LLUUID sound_uuid;
+            F32 gain, cutoff;
+            U8 sound_flags;
+            dp.unpackUUID(sound_uuid, "SoundUUID");
+            dp.unpackF32(gain, "SoundGain");
+            dp.unpackU8(sound_flags, "SoundFlags");
+            dp.unpackF32(cutoff, "SoundRadius");
+        }
+        if (value & 0x100)
+        {
+            std::string name_value_list;
+            dp.unpackString(name_value_list, "NV");
+        }
+
+        LLVolumeParams volume_params;
+        if (!LLVolumeMessage::unpackVolumeParams(&volume_params, dp))
+        {
+            return false;
+        }
+
+        if (!dp.unpackBinaryData(scratch.data(), size, "TextureEntry"))
+        {
+            return false;
+        }
+        collect_te_images(scratch.data(), scratch.data() + size, prim.mTextures);
+
+        return true;
+    }
+}
+
+void FSTexturePrefetch::onObjectCacheLoaded(LLViewerRegion* regionp, const LLVOCacheEntry::vocache_entry_map_t& cache_map)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_TEXTURE;
+
+    static LLCachedControl<bool> prefetch_enabled(gSavedSettings, "FSTexturePrefetchOnTeleport");
+    if (!prefetch_enabled || !regionp || cache_map.empty())
+    {
+        return;
+    }
+
+    // Only the region we are about to arrive in is of interest: the teleport
+    // destination, or the login region. Neighbours handshake later on.
+    if (gAgent.getTeleportState() == LLAgent::TELEPORT_NONE && LLStartUp::getStartupState() >= STATE_STARTED)
+    {
+        return;
+    }
+
+    // Parse from a private view of each entry's buffer so the read position
+    // of the entry itself is left alone. No value can be larger than the
+    // buffer it came from, so one scratch buffer that size is always enough.
+    std::unordered_map<U32, CachedPrim> prims;
+    prims.reserve(cache_map.size());
+    std::vector<U8> scratch;
+    for (const auto& [local_id, entry] : cache_map)
+    {
+        LLDataPackerBinaryBuffer* src = entry.notNull() ? entry.get()->getDP() : nullptr;
+        if (!src || !src->getBuffer())
+        {
+            continue;
+        }
+
+        if (scratch.size() < (size_t)src->getBufferSize())
+        {
+            scratch.resize(src->getBufferSize());
+        }
+
+        LLDataPackerBinaryBuffer dp(const_cast<U8*>(src->getBuffer()), src->getBufferSize());
+        CachedPrim prim;
+        if (parse_cached_prim(dp, scratch, prim) && (!prim.mTextures.empty() || !prim.mMaterials.empty()))
+        {
+            prims.emplace(local_id, std::move(prim));
+        }
+    }
+
+    // Child prim positions are relative to the root, so rank them by a
+    // sphere around the root that is large enough to contain them.
+    std::vector<Candidate> candidates;
+    for (const auto& [local_id, prim] : prims)
+    {
+        LLVector3 pos = prim.mPos;
+        F32 radius = prim.mRadius;
+        if (prim.mParentID)
+        {
+            auto parent = prims.find(prim.mParentID);
+            if (parent == prims.end())
+            {
+                continue;
+            }
+            pos = parent->second.mPos;
+            radius += prim.mPos.length();
+        }
+
+        for (const LLUUID& id : prim.mTextures)
+        {
+            candidates.push_back({ id, pos, radius, false });
+        }
+        for (const LLUUID& id : prim.mMaterials)
+        {
+            candidates.push_back({ id, pos, radius, true });
+        }
+    }
+
+    LL_DEBUGS("TexturePrefetch") << "Region " << regionp->getName() << ": " << candidates.size()
+                                 << " prefetch candidates from " << cache_map.size() << " cached objects" << LL_ENDL;
+
+    const U64 handle = regionp->getHandle();
+    if (handle == mArrivalHandle)
+    {
+        mArrivalHandle = 0;
+        issue(candidates, mArrivalPos);
+    }
+    else
+    {
+        mPending[handle] = std::move(candidates);
+    }
+}
+
+void FSTexturePrefetch::onAgentArrival(LLViewerRegion* regionp, const LLVector3& pos_region)
+{
+    if (!regionp)
+    {
+        return;
+    }
+
+    const U64 handle = regionp->getHandle();
+    auto pending = mPending.find(handle);
+    if (pending != mPending.end())
+    {
+        std::vector<Candidate> candidates = std::move(pending->second);
+        mPending.clear();
+        mArrivalHandle = 0;
+        issue(candidates, pos_region);
+    }
+    else
+    {
+        // The cache of this region has not been read yet; issue once it is.
+        mPending.clear();
+        mArrivalHandle = handle;
+        mArrivalPos = pos_region;
+    }
+}
+
+void FSTexturePrefetch::issue(const std::vector<Candidate>& candidates, const LLVector3& arrival)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_TEXTURE;
+
+    static LLCachedControl<U32> max_prefetch(gSavedSettings, "FSTexturePrefetchMaxTextures");
+    static LLCachedControl<F32> prefetch_radius(gSavedSettings, "FSTexturePrefetchRadius");
+    static LLCachedControl<bool> use_http(gSavedSettings, "FSTexturePrefetchUseHTTP");
+
+    const F32 radius = llmax((F32)prefetch_radius, 1.f);
+    std::vector<std::pair<F32, const Candidate*>> ranked;
+    ranked.reserve(candidates.size());
+    for (const Candidate& candidate : candidates)
+    {
+        F32 distance = llmax(dist_vec(candidate.mPos, arrival) - candidate.mRadius, 0.f);
+        if (distance <= radius)
+        {
+            ranked.emplace_back(distance, &candidate);
+        }
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    LLTextureCache* texture_cache = LLAppViewer::getTextureCache();
+    std::unordered_set<LLUUID> seen;
+    U32 textures = 0, materials = 0, uncached = 0;
+    for (const auto& [distance, candidate] : ranked)
+    {
+        if (textures + materials >= max_prefetch)
+        {
+            break;
+        }
+        if (candidate->mID.isNull() || !seen.insert(candidate->mID).second)
+        {
+            continue;
+        }
+
+        if (candidate->mMaterial)
+        {
+            // Material assets come from the asset cache first; their
+            // textures are requested by the material once it has loaded.
+            gGLTFMaterialList.getMaterial(candidate->mID);
+            ++materials;
+            continue;
+        }
+
+        if (LLViewerTexture::isInvisiprim(candidate->mID))
+        {
+            continue;
+        }
+        if (!use_http && (!texture_cache || !texture_cache->isInCache(candidate->mID)))
+        {
+            ++uncached;
+            continue;
+        }
+
+        LLViewerFetchedTexture* image = LLViewerTextureManager::getFetchedTexture(candidate->mID, FTT_DEFAULT, true,
+                                                                                  LLGLTexture::BOOST_NONE, LLViewerTexture::LOD_TEXTURE);
+        if (!image)
+        {
+            continue;
+        }
+
+        F32 virtual_size = lerp(PREFETCH_NEAR_AREA, PREFETCH_FAR_AREA, distance / radius);
+        image->addTextureStats(virtual_size);
+        mHeld.push_back({ image, virtual_size });
+        ++textures;
+    }
+
+    LL_INFOS("TexturePrefetch") << "Prefetching " << textures << " textures and " << materials << " materials within "
+                                << radius << "m of arrival (" << uncached << " skipped, not cached)" << LL_ENDL;
+
+    if (!mHeld.empty())
+    {
+        mHoldTimer.reset();
+        if (!mIdleActive)
+        {
+            mIdleActive = true;
+            doOnIdleRepeating([]() { return !FSTexturePrefetch::instanceExists() || FSTexturePrefetch::instance().idle(); });
+        }
+    }
+}
+
+bool FSTexturePrefetch::idle()
+{
+    if (mHoldTimer.getElapsedTimeF32() > PREFETCH_HOLD_TIME)
+    {
+        mHeld.clear();
+    }
+
+    // Once a face uses the texture the texture list takes over its size.
+    std::erase_if(mHeld, [](const Held& held) { return held.mImage->getTotalNumFaces() > 0; });
+    for (const Held& held : mHeld)
+    {
+        held.mImage->addTextureStats(held.mVirtualSize);
+    }
+
+    mIdleActive = !mHeld.empty();
+    return !mIdleActive;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file fstextureprefetch.h
+ * @brief Texture prefetch from the object cache of a teleport destination
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_TEXTUREPREFETCH_H
+#define FS_TEXTUREPREFETCH_H
+
+#include "llframetimer.h"
+#include "llsingleton.h"
+#include "lluuid.h"
+#include "llviewertexture.h"
+#include "llvocache.h"
+#include "v3math.h"
+
+#include <map>
+#include <vector>
+
+class LLViewerRegion;
+
+//
+//  Textures of a teleport destination are normally only requested once the
+//  objects have been instantiated from the object cache and their faces have
+//  a pixel area.  As soon as the destination's cache file has been read this
+//  scans the cached ObjectUpdate data for texture and material IDs, and once
+//  the arrival point is known requests them at a low pixel area, nearest
+//  first, so they are in flight (or already decoded) when the objects show up.
+//
+//  Only textures found in the local texture cache are requested unless
+//  FSTexturePrefetchUseHTTP is set.
+//
+class FSTexturePrefetch : public LLSingleton<FSTexturePrefetch>
+{
+    LLSINGLETON_EMPTY_CTOR(FSTexturePrefetch);
+    LOG_CLASS(FSTexturePrefetch);
+
+public:
+    // Called by LLViewerRegion once its object cache has been read.
+    void onObjectCacheLoaded(LLViewerRegion* regionp, const LLVOCacheEntry::vocache_entry_map_t& cache_map);
+
+    // Called from AgentMovementComplete with the region local arrival point.
+    void onAgentArrival(LLViewerRegion* regionp, const LLVector3& pos_region);
+
+private:
+    struct Candidate
+    {
+        LLUUID      mID;
+        LLVector3   mPos;       // region local
+        F32         mRadius;
+        bool        mMaterial;  // GLTF material asset rather than a texture
+    };
+
+    void issue(const std::vector<Candidate>& candidates, const LLVector3& arrival);
+    bool idle();
+
+    std::map<U64, std::vector<Candidate>> mPending; // by region handle, waiting for the arrival point
+    U64                     mArrivalHandle{ 0 };    // arrival seen before the region's cache was read
+    LLVector3               mArrivalPos;
+
+    // Prefetched textures are held and kept at their prefetch size until an
+    // object face picks them up or the hold time runs out; otherwise the
+    // texture list would reset them to zero size on its next pass.
+    struct Held
+    {
+        LLPointer<LLViewerFetchedTexture>   mImage;
+        F32                                 mVirtualSize;
+    };
+    std::vector<Held>       mHeld;
+    LLFrameTimer            mHoldTimer;
+    bool                    mIdleActive{ false };
+};
+
+#endif // FS_TEXTUREPREFETCH_H
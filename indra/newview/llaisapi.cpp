@@ -32,8 +32,10 @@
 #include "llappviewer.h"
 #include "llcallbacklist.h"
 #include "llinventorymodel.h"
+#include "llinventorymodelbackgroundfetch.h" // <3T:TommyTheTerrible/>
 #include "llinventoryobserver.h"
 #include "llnotificationsutil.h"
+#include "llsdserialize.h" // <3T:TommyTheTerrible/>
 #include "llsdutil.h"
 #include "llviewerregion.h"
 #include "llvoavatar.h"
@@ -41,6 +43,7 @@
 #include "llviewercontrol.h"
 
 #include "llviewernetwork.h"
+#include "workqueue.h" // <3T:TommyTheTerrible/>
 
 ///----------------------------------------------------------------------------
 /// Classes for AISv3 support.
@@ -490,6 +493,10 @@ void AISAPI::FetchCategoryChildren(const LLUUID &catId, ITEM_TYPE type, bool rec
         // _6 -> httpHeaders
         (&LLCoreHttpUtil::HttpCoroutineAdapter::getAndSuspend), _1, _2, _3, _5, _6);
 
+    // <3T:TommyTheTerrible> Recursive fetches return the bulk of the inventory
+    getFn = boost::bind(&AISAPI::getAndParseOffMainThread, _1, _2, _3, _5, _6);
+    // </3T:TommyTheTerrible>
+
     // get doesn't use body, can pass additional data
     LLSD body;
     body["depth"] = depth;
@@ -671,6 +678,10 @@ void AISAPI::FetchCategorySubset(const LLUUID& catId,
         // _6 -> httpHeaders
         (&LLCoreHttpUtil::HttpCoroutineAdapter::getAndSuspend), _1, _2, _3, _5, _6);
 
+    // <3T:TommyTheTerrible> Recursive fetches return the bulk of the inventory
+    getFn = boost::bind(&AISAPI::getAndParseOffMainThread, _1, _2, _3, _5, _6);
+    // </3T:TommyTheTerrible>
+
     // get doesn't use body, can pass additional data
     LLSD body;
     body["depth"] = depth;
@@ -852,6 +863,88 @@ void AISAPI::onUpdateReceived(const LLSD& update, COMMAND_TYPE type, const LLSD&
     LL_DEBUGS("Inventory", "AIS3") << "Elapsed processing: " << timer.getElapsedTimeF32() << LL_ENDL;
 }
 
+// <3T:TommyTheTerrible> Parse fetch responses off the main thread
+/*static*/
+LLSD AISAPI::getAndParseOffMainThread(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t httpAdapter,
+    LLCore::HttpRequest::ptr_t httpRequest, const std::string& url,
+    LLCore::HttpOptions::ptr_t httpOptions, LLCore::HttpHeaders::ptr_t httpHeaders)
+{
+    static LLCachedControl<bool> worker_parse(gSavedSettings, "FSInventoryAISWorkerParse", true);
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (!worker_parse || !general_queue)
+    {
+        return httpAdapter->getAndSuspend(httpRequest, url, httpOptions, httpHeaders);
+    }
+
+    // A recursive fetch can be megabytes of XML. Only the raw body crosses
+    // to the worker; the main thread coroutine waits without blocking the
+    // frame and then continues with the same result getAndSuspend() gives.
+    LLSD raw_result = httpAdapter->getRawAndSuspend(httpRequest, url, httpOptions, httpHeaders);
+    LLSD http_results = raw_result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS];
+    LLCore::HttpStatus status = LLCoreHttpUtil::HttpCoroutineAdapter::getStatusFromLLSD(http_results);
+
+    LLSD result = LLSD::emptyMap();
+    if (!status)
+    {
+        // Errors carry an LLSD body too, small enough to parse here
+        const std::string error_body = http_results["error_body"].asString();
+        if (!error_body.empty())
+        {
+            LLSD body;
+            std::istringstream error_stream(error_body);
+            if (LLSDSerialize::fromXML(body, error_stream) != LLSDParser::PARSE_FAILURE && body.isMap())
+            {
+                result = body;
+            }
+        }
+        result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS] = http_results;
+        return result;
+    }
+
+    if (raw_result.has(LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_RAW))
+    {
+        const LLSD::Binary& raw = raw_result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_RAW].asBinary();
+        bool parsed = false;
+        try
+        {
+            result = general_queue->waitForResult(
+                [&raw, &parsed]()
+                {
+                    LL_PROFILE_ZONE_NAMED("AIS parse response");
+                    LLSD body;
+                    parsed = LLSDSerialize::fromXMLBuffer(body, reinterpret_cast<const char*>(raw.data()), raw.size())
+                        != LLSDParser::PARSE_FAILURE;
+                    return body;
+                });
+        }
+        catch (const LL::WorkQueue::Closed&)
+        {
+            // Shutting down, nothing will use the result
+            parsed = false;
+        }
+
+        if (!parsed)
+        {
+            status = LLCore::HttpStatus(499, "Failed to deserialize LLSD.");
+            http_results[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_SUCCESS] = false;
+            http_results[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_TYPE] = (LLSD::Integer)status.getType();
+            http_results[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_STATUS] = (LLSD::Integer)status.getStatus();
+            http_results[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_MESSAGE] = status.getMessage();
+            result = LLSD::emptyMap();
+        }
+        else if (!result.isMap())
+        {
+            LLSD content = result;
+            result = LLSD::emptyMap();
+            result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_CONTENT] = content;
+        }
+    }
+
+    result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS] = http_results;
+    return result;
+}
+// </3T:TommyTheTerrible>
+
 /*static*/
 void AISAPI::InvokeAISCommandCoro(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t httpAdapter,
         invokationFn_t invoke, std::string url,
@@ -1616,6 +1709,13 @@ void AISUpdate::doUpdate()
 {
     checkTimeout();
 
+    // <3T:TommyTheTerrible> Fetch throughput reporting
+    if (mFetch)
+    {
+        LLInventoryModelBackgroundFetch::instance().addFetchedFolders((S32)(mCategoriesCreated.size() + mCategoriesUpdated.size()));
+    }
+    // </3T:TommyTheTerrible>
+
     // Do version/descendant accounting.
     for (std::map<LLUUID,size_t>::const_iterator catit = mCatDescendentDeltas.begin();
          catit != mCatDescendentDeltas.end(); ++catit)
@@ -102,6 +102,11 @@ private:
     static void InvokeAISCommandCoro(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t httpAdapter,
         invokationFn_t invoke, std::string url, LLUUID targetId, LLSD body,
         completion_t callback, COMMAND_TYPE type);
+    // <3T:TommyTheTerrible> GET for large fetch responses, parsed on a worker thread
+    static LLSD getAndParseOffMainThread(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t httpAdapter,
+        LLCore::HttpRequest::ptr_t httpRequest, const std::string& url,
+        LLCore::HttpOptions::ptr_t httpOptions, LLCore::HttpHeaders::ptr_t httpHeaders);
+    // </3T:TommyTheTerrible>
 
     typedef std::pair<std::string, LLCoprocedureManager::CoProcedure_t> ais_query_item_t;
     static std::list<ais_query_item_t> sPostponedQuery;
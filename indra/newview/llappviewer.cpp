@@ -101,6 +101,7 @@
 #include "llprogressview.h"
 #include "llvocache.h"
 #include "lldiskcache.h"
+#include "llasyncfilesystem.h" // <3T:TommyTheTerrible/>
 #include "llvopartgroup.h"
 // [SL:KB] - Patch: Appearance-Misc | Checked: 2013-02-12 (Catznip-3.4)
 #include "llappearancemgr.h"
@@ -294,6 +295,10 @@ using namespace LL;
 
 #include "fsradar.h"
 #include "fsassetblacklist.h"
+#include "fstexturefetchtracer.h" // <3T:TommyTheTerrible/>
+#include "fssettingsdefaults.h" // <3T:TommyTheTerrible/>
+#include "lltraceallocprofiler.h" // <3T:TommyTheTerrible/>
+#include "llframearena.h" // <3T:TommyTheTerrible/>
 #include "bugsplatattributes.h"
 // #include "fstelemetry.h" // <FS:Beq> Tracy profiler support
 
@@ -1609,7 +1614,17 @@ bool LLAppViewer::doFrame()
                 LLTrace::BlockTimer::processTimes();
             }
 
+            // <3T:TommyTheTerrible> Hand back last frame's scratch memory; before nextPeriod so its stats land in that frame
+            LLFrameArena::get().reset();
+            // </3T:TommyTheTerrible>
             LLTrace::get_frame_recording().nextPeriod();
+            // <3T:TommyTheTerrible> Block timer profile capture
+            if (LLTrace::ProfileCapture::nextFrame())
+            {
+                gSavedSettings.setU32("FSProfileCaptureFrames", 0);
+            }
+            LLTrace::AllocationProfiler::nextFrame();
+            // </3T:TommyTheTerrible>
             LLTrace::BlockTimer::logStats();
         }
 
@@ -2406,6 +2421,15 @@ bool LLAppViewer::cleanup()
     // Delete workers first
     // shotdown all worker threads before deleting them in case of co-dependencies
     mAppCoreHttp.requestStop();
+    FSTextureFetchTracer::stop(); // <3T:TommyTheTerrible> Flush a running fetch trace
+    LLTrace::ProfileCapture::stop(); // <3T:TommyTheTerrible> Write a running block timer capture
+    // <3T:TommyTheTerrible> Sampled allocation profiler
+    if (LLTrace::AllocationProfiler::getSampleInterval())
+    {
+        LLTrace::AllocationProfiler::setSampleInterval(0);
+        LLTrace::AllocationProfiler::writeReport(gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "allocation_profile.txt"));
+    }
+    // </3T:TommyTheTerrible>
     sTextureFetch->shutdown();
     sTextureCache->shutdown();
     sImageDecodeThread->shutdown();
@@ -2414,6 +2438,7 @@ bool LLAppViewer::cleanup()
     {
         mGeneralThreadPool->close();
     }
+    LLAsyncFileSystem::deleteSingleton(); // <3T:TommyTheTerrible/> finishes queued cache I/O
 
     sTextureFetch->shutDownTextureCacheThread() ;
     LLLFSThread::sLocal->shutdown();
@@ -2530,6 +2555,8 @@ bool LLAppViewer::cleanup()
 
     LL_INFOS() << "Goodbye!" << LL_ENDL;
 
+    LLError::setAsyncLogging(false); // <3T:TommyTheTerrible/> write out what is queued
+
     removeDumpDir();
 
     // return 0;
@@ -2587,6 +2614,14 @@ bool LLAppViewer::initThreads()
     }
     // <FS:Ansariel>
     threadCounts["ImageDecode"] = image_decode_count;
+    // <3T:TommyTheTerrible> Mesh decode worker pool
+    S32 mesh_decode_count = llclamp(cores / 4, 2, 8);
+    if (auto max_mesh_decodes = gSavedSettings.getU32("FSMeshDecodeThreads"); max_mesh_decodes > 0)
+    {
+        mesh_decode_count = llclamp((S32)max_mesh_decodes, 1, 16);
+    }
+    threadCounts["MeshLodProcessing"] = mesh_decode_count;
+    // </3T:TommyTheTerrible>
     gSavedSettings.setLLSD("ThreadPoolSizes", threadCounts);
 
     // Image decoding
@@ -2856,7 +2891,16 @@ bool LLAppViewer::loadSettingsFromDirectory(const std::string& location_key,
                 full_settings_path = gDirUtilp->getExpandedFilename((ELLPath)path_index, file.file_name());
             }
 
-            if(settings_group->loadFromFile(full_settings_path, set_defaults, file.persistent))
+            // <3T:TommyTheTerrible> Precompiled default settings
+            //if(settings_group->loadFromFile(full_settings_path, set_defaults, file.persistent))
+            bool precompiled = set_defaults && location_key == "Default"
+                && FSSettingsDefaults::load(*settings_group, file.file_name(), full_settings_path) > 0;
+            if (precompiled)
+            {
+                LL_INFOS("Settings") << "Loaded built-in defaults for " << full_settings_path << LL_ENDL;
+            }
+            else if(settings_group->loadFromFile(full_settings_path, set_defaults, file.persistent))
+            // </3T:TommyTheTerrible>
             {   // success!
                 LL_INFOS("Settings") << "Loaded settings file " << full_settings_path << LL_ENDL;
             }
@@ -3003,7 +3047,15 @@ bool LLAppViewer::initConfiguration()
 
     // - load defaults
     bool set_defaults = true;
-    if (!loadSettingsFromDirectory("Default", set_defaults))
+    //if (!loadSettingsFromDirectory("Default", set_defaults))
+    // <3T:TommyTheTerrible> Precompiled default settings
+    LLTimer settings_timer;
+    bool defaults_loaded = loadSettingsFromDirectory("Default", set_defaults);
+    FSSettingsDefaults::release();
+    F32 defaults_time = settings_timer.getElapsedTimeF32();
+    LLViewerStats::PhaseMap::recordPhaseStat("settings_defaults", defaults_time);
+    if (!defaults_loaded)
+    // </3T:TommyTheTerrible>
     {
         OSMessageBox(
             "Unable to load default settings file. The installation may be corrupted.",
@@ -3108,7 +3160,14 @@ bool LLAppViewer::initConfiguration()
 
 
     // - load overrides from user_settings
+    settings_timer.reset(); // <3T:TommyTheTerrible/>
     loadSettingsFromDirectory("User");
+    // <3T:TommyTheTerrible> Precompiled default settings
+    F32 user_time = settings_timer.getElapsedTimeF32();
+    LLViewerStats::PhaseMap::recordPhaseStat("settings_user", user_time);
+    LL_INFOS("Settings") << "Settings initialized in " << (defaults_time + user_time) * 1000.f << " ms: defaults "
+                         << defaults_time * 1000.f << " ms, user settings " << user_time * 1000.f << " ms" << LL_ENDL;
+    // </3T:TommyTheTerrible>
 
     if (gSavedSettings.getBOOL("FirstRunThisInstall"))
     {
@@ -5217,6 +5276,12 @@ bool LLAppViewer::initCache()
         }
     }
     LLAppViewer::getPurgeDiskCacheThread()->start();
+    // <3T:TommyTheTerrible> Cache I/O for coroutines, width from ThreadPoolSizes["FileIO"]
+    if (!LLAsyncFileSystem::instanceExists())
+    {
+        LLAsyncFileSystem::createInstance();
+    }
+    // </3T:TommyTheTerrible>
 
     // <FS:Ansariel> FIRE-13066
     if (!mPurgeCache && mPurgeTextures && !read_only) // <FS:Beq> no need to purge textures if we already purged the cache above
@@ -6366,6 +6431,11 @@ void LLAppViewer::idleNetwork()
                     break;
                 }
             }
+            // <3T:TommyTheTerrible> Parallel object update decoding
+            // Object updates queued above have been decoding on the workers
+            // while the rest of the messages were read.
+            apply_decoded_object_updates();
+            // </3T:TommyTheTerrible>
             if (needs_drain || gMessageSystem->mPacketRing.getNumBufferedPackets() > 0)
             {
                 // Rather than allow packets to silently backup on the socket
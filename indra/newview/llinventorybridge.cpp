@@ -4041,6 +4041,7 @@ void LLFolderBridge::openItem()
         return;
     }
     panel->onFolderOpening(mUUID);
+    LLInventoryModelBackgroundFetch::instance().prioritizeFolder(mUUID); // <3T:TommyTheTerrible/>
     bool fetching_inventory = model->fetchDescendentsOf(mUUID);
     // Only change folder type if we have the folder contents.
     if (!fetching_inventory)
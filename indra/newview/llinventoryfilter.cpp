@@ -55,6 +55,7 @@
 #endif
 
 #include "llinventorydefines.h"     // <FS:Zi> FIRE-31369: Add inventory filter for coalesced objects
+#include "fsinventorysearchindex.h" // <3T:TommyTheTerrible/>
 
 LLInventoryFilter::FilterOps::FilterOps(const Params& p)
 :   mFilterObjectTypes(p.object_types),
@@ -111,33 +112,53 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
         return true;
     }
 
-    std::string desc = listener->getSearchableCreatorName();
-    switch (mSearchType)
+    // <3T:TommyTheTerrible> Answer the string checks from the background search index when it can
+    const ESearchIndexMatch index_match = checkAgainstSearchIndex(listener);
+    if (index_match == INDEX_NO_MATCH)
     {
-        case SEARCHTYPE_CREATOR:
-            desc = listener->getSearchableCreatorName();
-            break;
-        case SEARCHTYPE_DESCRIPTION:
-            desc = listener->getSearchableDescription();
-            break;
-        case SEARCHTYPE_UUID:
-            desc = listener->getSearchableUUIDString();
-            break;
-        // <FS:Ansariel> Allow searching by all
-        case SEARCHTYPE_ALL:
-            desc = listener->getSearchableAll();
-            break;
-        // </FS:Ansariel>
-        case SEARCHTYPE_NAME:
-        default:
-            desc = listener->getSearchableName();
-            break;
+        return false;
     }
+    const bool string_passed = (index_match == INDEX_MATCH);
+
+    //std::string desc = listener->getSearchableCreatorName();
+    std::string desc;
+    if (!string_passed) // no need to build the searchable strings
+    {
+        switch (mSearchType)
+        {
+            case SEARCHTYPE_CREATOR:
+                desc = listener->getSearchableCreatorName();
+                break;
+            case SEARCHTYPE_DESCRIPTION:
+                desc = listener->getSearchableDescription();
+                break;
+            case SEARCHTYPE_UUID:
+                desc = listener->getSearchableUUIDString();
+                break;
+            // <FS:Ansariel> Allow searching by all
+            case SEARCHTYPE_ALL:
+                desc = listener->getSearchableAll();
+                break;
+            // </FS:Ansariel>
+            case SEARCHTYPE_NAME:
+            default:
+                desc = listener->getSearchableName();
+                break;
+        }
+    }
+    // </3T:TommyTheTerrible>
 
     bool passed = true;
     // <FS:Ansariel> Allow searching by all
     //if (!mExactToken.empty() && (mSearchType == SEARCHTYPE_NAME))
-    if (!mExactToken.empty() && ((mSearchType == SEARCHTYPE_NAME) || (mSearchType == SEARCHTYPE_ALL)))
+    // <3T:TommyTheTerrible> Background search index
+    //if (!mExactToken.empty() && ((mSearchType == SEARCHTYPE_NAME) || (mSearchType == SEARCHTYPE_ALL)))
+    if (string_passed)
+    {
+        // already answered by the search index
+    }
+    else if (!mExactToken.empty() && ((mSearchType == SEARCHTYPE_NAME) || (mSearchType == SEARCHTYPE_ALL)))
+    // </3T:TommyTheTerrible>
     // </FS:Ansariel>
     {
         passed = false;
@@ -587,6 +608,116 @@ bool LLInventoryFilter::checkAgainstFilterType(const LLInventoryItem* item) cons
 
 // Items and folders that are on the clipboard or, recursively, in a folder which
 // is on the clipboard must be filtered out if the clipboard is in the "cut" mode.
+// <3T:TommyTheTerrible> Background search index
+struct LLInventoryFilter::SearchIndexState
+{
+    std::string                             mSubString;
+    ESearchType                             mSearchType;
+    U64                                     mObjectTypes;
+    PermissionMask                          mPermissions;
+    FSInventorySearchIndex::result_ptr_t    mResult;
+};
+
+void LLInventoryFilter::requestSearchIndexQuery()
+{
+    mSearchIndexState.reset();
+    if (mFilterSubString.empty() || !FSInventorySearchIndex::isEnabled())
+    {
+        return;
+    }
+
+    FSInventorySearchIndex::Query query;
+    switch (mSearchType)
+    {
+        case SEARCHTYPE_NAME:
+            query.mField = FSInventorySearchIndex::FIELD_NAME;
+            query.mTokens = mFilterTokens;
+            query.mExactToken = mExactToken;
+            break;
+        case SEARCHTYPE_DESCRIPTION:
+            query.mField = FSInventorySearchIndex::FIELD_DESCRIPTION;
+            break;
+        case SEARCHTYPE_UUID:
+            query.mField = FSInventorySearchIndex::FIELD_ASSET_ID;
+            break;
+        default:
+            // Creator names come from the name cache and are not indexed.
+            return;
+    }
+    query.mSubString = mFilterSubString;
+    query.mObjectTypes = (mFilterOps.mFilterTypes & FILTERTYPE_OBJECT) ? mFilterOps.mFilterObjectTypes : ~0ULL;
+    query.mPermissions = mFilterOps.mPermissions;
+
+    auto state = std::make_shared<SearchIndexState>();
+    state->mSubString = mFilterSubString;
+    state->mSearchType = mSearchType;
+    state->mObjectTypes = query.mObjectTypes;
+    state->mPermissions = query.mPermissions;
+
+    // The filter may be gone by the time the result arrives.
+    std::weak_ptr<SearchIndexState> weak_state = state;
+    if (FSInventorySearchIndex::instance().postQuery(query,
+            [weak_state](const FSInventorySearchIndex::result_ptr_t& result)
+            {
+                if (auto state = weak_state.lock())
+                {
+                    state->mResult = result;
+                }
+            }))
+    {
+        mSearchIndexState = state;
+    }
+}
+
+LLInventoryFilter::ESearchIndexMatch LLInventoryFilter::checkAgainstSearchIndex(const LLFolderViewModelItemInventory* listener)
+{
+    if (!mSearchIndexState || !mSearchIndexState->mResult)
+    {
+        return INDEX_UNKNOWN;
+    }
+
+    const SearchIndexState& state = *mSearchIndexState;
+    if (state.mSearchType != mSearchType || state.mSubString != mFilterSubString)
+    {
+        return INDEX_UNKNOWN;
+    }
+    const U64 object_types = (mFilterOps.mFilterTypes & FILTERTYPE_OBJECT) ? mFilterOps.mFilterObjectTypes : ~0ULL;
+    if (state.mObjectTypes != object_types || state.mPermissions != mFilterOps.mPermissions)
+    {
+        // Filter options changed under the query, ask again.
+        requestSearchIndexQuery();
+        return INDEX_UNKNOWN;
+    }
+
+    // Folders, links and anything changed since the query are not vouched for.
+    if (listener->getInventoryType() == LLInventoryType::IT_CATEGORY)
+    {
+        return INDEX_UNKNOWN;
+    }
+    const LLUUID& id = listener->getUUID();
+    if (!FSInventorySearchIndex::instance().isUnchangedSince(id, state.mResult->mVersion))
+    {
+        return INDEX_UNKNOWN;
+    }
+    if (state.mResult->mMatches.contains(id))
+    {
+        return INDEX_MATCH;
+    }
+
+    // Searchable names carry label suffixes (worn, no copy, link...) that
+    // the index knows nothing about; the search string may be found there.
+    if (mSearchType == SEARCHTYPE_NAME)
+    {
+        const size_t name_length = listener->getDisplayName().size();
+        if (listener->getSearchableName().size() != name_length)
+        {
+            return INDEX_UNKNOWN;
+        }
+    }
+    return INDEX_NO_MATCH;
+}
+// </3T:TommyTheTerrible>
+
 bool LLInventoryFilter::checkAgainstClipboard(const LLUUID& object_id) const
 {
     if (LLClipboard::instance().isCutMode())
@@ -827,6 +958,7 @@ void LLInventoryFilter::setSearchType(ESearchType type)
     {
         mSearchType = type;
         setModified();
+        requestSearchIndexQuery(); // <3T:TommyTheTerrible/>
     }
 }
 
@@ -1093,6 +1225,7 @@ void LLInventoryFilter::setFilterSubString(const std::string& string)
             && !filter_sub_string_new.substr(0, mFilterSubString.size()).compare(mFilterSubString);
 
         mFilterSubString = filter_sub_string_new;
+        requestSearchIndexQuery(); // <3T:TommyTheTerrible/>
         if (exact_token_changed)
         {
             setModified(FILTER_RESTART);
@@ -31,6 +31,8 @@
 #include "llpermissionsflags.h"
 #include "llfolderviewmodel.h"
 
+#include <memory> // <3T:TommyTheTerrible/>
+
 class LLFolderViewItem;
 class LLFolderViewFolder;
 class LLInventoryItem;
@@ -374,6 +376,18 @@ private:
     bool                checkAgainstSearchVisibility(const class LLFolderViewModelItemInventory* listener) const;
     bool                checkAgainstClipboard(const LLUUID& object_id) const;
 
+    // <3T:TommyTheTerrible> Background search index
+    enum ESearchIndexMatch
+    {
+        INDEX_UNKNOWN,      // run the regular string checks
+        INDEX_MATCH,        // string checks pass
+        INDEX_NO_MATCH      // item fails the filter
+    };
+    struct SearchIndexState;
+    void                requestSearchIndexQuery();
+    ESearchIndexMatch   checkAgainstSearchIndex(const class LLFolderViewModelItemInventory* listener);
+    // </3T:TommyTheTerrible>
+
     FilterOps               mFilterOps;
     FilterOps               mDefaultFilterOps;
     FilterOps               mBackupFilterOps; // for backup purposes when leaving 'search link' mode
@@ -403,6 +417,8 @@ private:
     std::vector<std::string> mFilterTokens;
     std::string              mExactToken;
 
+    std::shared_ptr<SearchIndexState> mSearchIndexState; // <3T:TommyTheTerrible/> Background search index
+
     bool mSingleFolderMode;
 };
 
@@ -40,6 +40,7 @@
 #include "lldispatcher.h"
 #include "llinventorypanel.h"
 #include "llinventorybridge.h"
+#include "llinventorycache.h" // <3T:TommyTheTerrible/> Binary inventory cache
 #include "llinventoryfunctions.h"
 #include "llinventorymodelbackgroundfetch.h"
 #include "llinventoryobserver.h"
@@ -1877,7 +1878,8 @@ void LLInventoryModel::moveObject(const LLUUID& object_id, const LLUUID& cat_id)
         return;
     }
 
-    if((object_id == cat_id) || !is_in_map(mCategoryMap, cat_id))
+    //if((object_id == cat_id) || !is_in_map(mCategoryMap, cat_id))
+    if((object_id == cat_id) || !mCategoryMap.contains(cat_id)) // <3T:TommyTheTerrible/>
     {
         LL_WARNS(LOG_INV) << "Could not move inventory object " << object_id << " to "
                           << cat_id << LL_ENDL;
@@ -2536,6 +2538,23 @@ std::string LLInventoryModel::getInvCacheAddres(const LLUUID& owner_id)
     return inventory_addr;
 }
 
+// <3T:TommyTheTerrible> Binary inventory cache
+//static
+std::string LLInventoryModel::getInvBinaryCacheAddres(const LLUUID& owner_id)
+{
+    // Same name as the LLSD cache with ".bin" in place of ".llsd".
+    std::string inventory_addr = getInvCacheAddres(owner_id);
+    const std::string llsd_ext(".llsd");
+    if (inventory_addr.size() >= llsd_ext.size() &&
+        inventory_addr.compare(inventory_addr.size() - llsd_ext.size(), llsd_ext.size(), llsd_ext) == 0)
+    {
+        inventory_addr.resize(inventory_addr.size() - llsd_ext.size());
+    }
+    inventory_addr.append(".bin");
+    return inventory_addr;
+}
+// </3T:TommyTheTerrible>
+
 void LLInventoryModel::cache(
     const LLUUID& parent_folder_id,
     const LLUUID& agent_id)
@@ -2556,6 +2575,24 @@ void LLInventoryModel::cache(
         items,
         INCLUDE_TRASH,
         can_cache);
+
+    // <3T:TommyTheTerrible> Binary inventory cache
+    static LLCachedControl<bool> binary_cache(gSavedSettings, "FSInventoryBinaryCache", true);
+    std::string binary_filename = getInvBinaryCacheAddres(agent_id);
+    if (binary_cache)
+    {
+        if (saveToBinaryFile(binary_filename, categories, items))
+        {
+            // Don't leave an older LLSD cache behind for a later session
+            // with the binary cache turned off.
+            LLFile::remove(getInvCacheAddres(agent_id) + ".gz", ENOENT);
+            return;
+        }
+        LL_WARNS(LOG_INV) << "Unable to write binary inventory cache, falling back to LLSD" << LL_ENDL;
+    }
+    LLFile::remove(binary_filename, ENOENT);
+    // </3T:TommyTheTerrible>
+
     // Use temporary file to avoid potential conflicts with other
     // instances (even a 'read only' instance unzips into a file)
     std::string temp_file = gDirUtilp->getTempFilename();
@@ -2879,6 +2916,17 @@ bool LLInventoryModel::loadSkeleton(
     {
         LL_INFOS("LLInventoryModel") << "Clear inventory cache marker found: " << delete_cache_marker << LL_ENDL;
 
+        // <3T:TommyTheTerrible> Binary inventory cache
+        for (const std::string& binary_filename : { getInvBinaryCacheAddres(owner_id), getInvBinaryCacheAddres(gInventory.getLibraryOwnerID()) })
+        {
+            if (LLFile::isfile(binary_filename))
+            {
+                LL_INFOS("LLInventoryModel") << "Purging inventory cache file: " << binary_filename << LL_ENDL;
+                LLFile::remove(binary_filename);
+            }
+        }
+        // </3T:TommyTheTerrible>
+
         std::string inventory_filename = getInvCacheAddres(owner_id);
         if (LLFile::isfile(inventory_filename))
         {
@@ -2973,7 +3021,14 @@ bool LLInventoryModel::loadSkeleton(
         const S32 NO_VERSION = LLViewerInventoryCategory::VERSION_UNKNOWN;
         std::string gzip_filename(inventory_filename);
         gzip_filename.append(".gz");
-        LLFILE* fp = LLFile::fopen(gzip_filename, "rb");
+        // <3T:TommyTheTerrible> Binary inventory cache, read in place
+        // without the gunzip round trip.
+        static LLCachedControl<bool> binary_cache(gSavedSettings, "FSInventoryBinaryCache", true);
+        std::string binary_filename = getInvBinaryCacheAddres(owner_id);
+        bool use_binary_cache = binary_cache && LLFile::isfile(binary_filename);
+        //LLFILE* fp = LLFile::fopen(gzip_filename, "rb");
+        LLFILE* fp = use_binary_cache ? NULL : LLFile::fopen(gzip_filename, "rb");
+        // </3T:TommyTheTerrible>
         bool remove_inventory_file = false;
         if (LLAppViewer::instance()->isSecondInstance())
         {
@@ -3003,7 +3058,13 @@ bool LLInventoryModel::loadSkeleton(
             }
         }
         bool is_cache_obsolete = false;
-        if (loadFromFile(inventory_filename, categories, items, categories_to_update, is_cache_obsolete))
+        // <3T:TommyTheTerrible> Binary inventory cache
+        //if (loadFromFile(inventory_filename, categories, items, categories_to_update, is_cache_obsolete))
+        bool cache_loaded = use_binary_cache ?
+            loadFromBinaryFile(binary_filename, categories, items, categories_to_update, is_cache_obsolete) :
+            loadFromFile(inventory_filename, categories, items, categories_to_update, is_cache_obsolete);
+        if (cache_loaded)
+        // </3T:TommyTheTerrible>
         {
             // We were able to find a cache of files. So, use what we
             // found to generate a set of categories we should add. We
@@ -3197,6 +3258,7 @@ bool LLInventoryModel::loadSkeleton(
             // If out of date, remove the gzipped file too.
             LL_WARNS(LOG_INV) << "Inv cache out of date, removing" << LL_ENDL;
             LLFile::remove(gzip_filename);
+            LLFile::remove(binary_filename, ENOENT); // <3T:TommyTheTerrible/> Binary inventory cache
         }
         categories.clear(); // will unref and delete entries
     }
@@ -3817,6 +3879,110 @@ bool LLInventoryModel::saveToFile(const std::string& filename,
     return true;
 }
 
+// <3T:TommyTheTerrible> Binary inventory cache
+// static
+bool LLInventoryModel::loadFromBinaryFile(const std::string& filename,
+                                          LLInventoryModel::cat_array_t& categories,
+                                          LLInventoryModel::item_array_t& items,
+                                          LLInventoryModel::changed_items_t& cats_to_update,
+                                          bool& is_cache_obsolete)
+{
+    LL_PROFILE_ZONE_NAMED("inventory load from binary file");
+    LL_INFOS(LOG_INV) << "loading inventory from: (" << filename << ")" << LL_ENDL;
+
+    is_cache_obsolete = true; // Obsolete until proven current
+
+    LLInventoryCacheFile::Reader reader;
+    switch (reader.load(filename, sCurrentInvCacheVersion))
+    {
+    case LLInventoryCacheFile::Reader::OK:
+        break;
+    case LLInventoryCacheFile::Reader::NOT_FOUND:
+        LL_INFOS(LOG_INV) << "unable to load inventory from: " << filename << LL_ENDL;
+        is_cache_obsolete = false;
+        return false;
+    case LLInventoryCacheFile::Reader::OBSOLETE:
+        LL_WARNS(LOG_INV) << "Inventory cache is out of date" << LL_ENDL;
+        return false;
+    default:
+        LL_WARNS(LOG_INV) << "Inventory cache is damaged" << LL_ENDL;
+        return false;
+    }
+
+    categories.reserve(categories.size() + reader.getCategories().size());
+    for (const LLInventoryCacheFile::CategoryRecord& rec : reader.getCategories())
+    {
+        LLPointer<LLViewerInventoryCategory> inv_cat = new LLViewerInventoryCategory(rec.mOwnerID);
+        inv_cat->setUUID(rec.mID);
+        inv_cat->setParent(rec.mParentID);
+        inv_cat->setType(rec.mType);
+        inv_cat->setPreferredType(rec.mPreferredType);
+        inv_cat->rename(rec.mName);
+        inv_cat->setThumbnailUUID(rec.mThumbnailID);
+        inv_cat->setVersion(rec.mVersion);
+        categories.push_back(inv_cat);
+    }
+
+    // Items are built on the general pool, one chunk per task.
+    std::vector<LLUUID> unknown_parents;
+    if (!reader.getItems(items, &unknown_parents))
+    {
+        LL_WARNS(LOG_INV) << "Inventory cache is damaged" << LL_ENDL;
+        categories.clear();
+        items.clear();
+        return false;
+    }
+    cats_to_update.insert(unknown_parents.begin(), unknown_parents.end());
+
+    is_cache_obsolete = false;
+    return true;
+}
+
+// static
+bool LLInventoryModel::saveToBinaryFile(const std::string& filename,
+                                        const cat_array_t& categories,
+                                        const item_array_t& items)
+{
+    if (filename.empty())
+    {
+        LL_ERRS(LOG_INV) << "Filename is Null!" << LL_ENDL;
+        return false;
+    }
+
+    LL_INFOS(LOG_INV) << "saving inventory to: (" << filename << ")" << LL_ENDL;
+
+    LLInventoryCacheFile::Writer writer(sCurrentInvCacheVersion);
+    for (auto& cat : categories)
+    {
+        if (cat->getVersion() != LLViewerInventoryCategory::VERSION_UNKNOWN)
+        {
+            LLInventoryCacheFile::CategoryRecord rec;
+            rec.mID = cat->getUUID();
+            rec.mParentID = cat->getParentUUID();
+            rec.mOwnerID = cat->getOwnerID();
+            rec.mThumbnailID = cat->getThumbnailUUID();
+            rec.mName = cat->getName();
+            rec.mVersion = cat->getVersion();
+            rec.mType = cat->getType();
+            rec.mPreferredType = cat->getPreferredType();
+            writer.addCategory(rec);
+        }
+    }
+    for (auto& item : items)
+    {
+        writer.addItem(*item);
+    }
+
+    if (!writer.save(filename))
+    {
+        return false;
+    }
+
+    LL_INFOS(LOG_INV) << "Inventory saved: " << writer.getCategoryCount() << " categories, " << writer.getItemCount() << " items." << LL_ENDL;
+    return true;
+}
+// </3T:TommyTheTerrible>
+
 // message handling functionality
 // static
 void LLInventoryModel::registerCallbacks(LLMessageSystem* msg)
@@ -36,6 +36,7 @@
 #include "llfoldertype.h"
 #include "llframetimer.h"
 #include "lluuid.h"
+#include "lluuidhashmap.h" // <3T:TommyTheTerrible/>
 #include "llpermissionsflags.h"
 #include "llviewerinventory.h"
 #include "llstring.h"
@@ -204,6 +205,7 @@ public:
     void createCommonSystemCategories();
 
     static std::string getInvCacheAddres(const LLUUID& owner_id);
+    static std::string getInvBinaryCacheAddres(const LLUUID& owner_id); // <3T:TommyTheTerrible/> Binary inventory cache
 
     // Call on logout to save a terse representation.
     void cache(const LLUUID& parent_folder_id, const LLUUID& agent_id);
@@ -213,13 +215,22 @@ private:
     // the inventory using several different identifiers.
     // mInventory member data is the 'master' list of inventory, and
     // mCategoryMap and mItemMap store uuid->object mappings.
-    typedef std::map<LLUUID, LLPointer<LLViewerInventoryCategory> > cat_map_t;
-    typedef std::map<LLUUID, LLPointer<LLViewerInventoryItem> > item_map_t;
+    // <3T:TommyTheTerrible> Hash indexed storage, lookups are the hot path
+    //typedef std::map<LLUUID, LLPointer<LLViewerInventoryCategory> > cat_map_t;
+    //typedef std::map<LLUUID, LLPointer<LLViewerInventoryItem> > item_map_t;
+    typedef LLUUIDHashMap<LLPointer<LLViewerInventoryCategory> > cat_map_t;
+    typedef LLUUIDHashMap<LLPointer<LLViewerInventoryItem> > item_map_t;
+    // </3T:TommyTheTerrible>
     cat_map_t mCategoryMap;
     item_map_t mItemMap;
     // This last set of indices is used to map parents to children.
-    typedef std::map<LLUUID, cat_array_t*> parent_cat_map_t;
-    typedef std::map<LLUUID, item_array_t*> parent_item_map_t;
+    // <3T:TommyTheTerrible> The child arrays stay heap allocated so pointers
+    // handed out by getDirectDescendentsOf() survive rehashing.
+    //typedef std::map<LLUUID, cat_array_t*> parent_cat_map_t;
+    //typedef std::map<LLUUID, item_array_t*> parent_item_map_t;
+    typedef LLUUIDHashMap<cat_array_t*> parent_cat_map_t;
+    typedef LLUUIDHashMap<item_array_t*> parent_item_map_t;
+    // </3T:TommyTheTerrible>
     parent_cat_map_t mParentChildCategoryTree;
     parent_item_map_t mParentChildItemTree;
 
@@ -732,6 +743,16 @@ protected:
     static bool saveToFile(const std::string& filename,
                            const cat_array_t& categories,
                            const item_array_t& items);
+    // <3T:TommyTheTerrible> Binary inventory cache
+    static bool loadFromBinaryFile(const std::string& filename,
+                                   cat_array_t& categories,
+                                   item_array_t& items,
+                                   changed_items_t& cats_to_update,
+                                   bool& is_cache_obsolete);
+    static bool saveToBinaryFile(const std::string& filename,
+                                 const cat_array_t& categories,
+                                 const item_array_t& items);
+    // </3T:TommyTheTerrible>
 
     //--------------------------------------------------------------------
     // Message handling functionality
@@ -765,8 +786,12 @@ protected:
     cat_array_t* getUnlockedCatArray(const LLUUID& id);
     item_array_t* getUnlockedItemArray(const LLUUID& id);
 private:
-    std::map<LLUUID, bool> mCategoryLock;
-    std::map<LLUUID, bool> mItemLock;
+    // <3T:TommyTheTerrible> Hash indexed storage
+    //std::map<LLUUID, bool> mCategoryLock;
+    //std::map<LLUUID, bool> mItemLock;
+    LLUUIDHashMap<bool> mCategoryLock;
+    LLUUIDHashMap<bool> mItemLock;
+    // </3T:TommyTheTerrible>
 
     //--------------------------------------------------------------------
     // Debugging
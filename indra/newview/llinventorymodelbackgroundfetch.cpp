@@ -201,7 +201,9 @@ LLInventoryModelBackgroundFetch::LLInventoryModelBackgroundFetch():
     mRecursiveInventoryFetchStarted(false),
     mRecursiveLibraryFetchStarted(false),
     mRecursiveMarketplaceFetchStarted(false),
-    mMinTimeBetweenFetches(0.3f)
+    mMinTimeBetweenFetches(0.3f),
+    mFetchStartTime(0.0), // <3T:TommyTheTerrible/>
+    mFoldersFetched(0) // <3T:TommyTheTerrible/>
 {}
 
 LLInventoryModelBackgroundFetch::~LLInventoryModelBackgroundFetch()
@@ -211,12 +213,14 @@ LLInventoryModelBackgroundFetch::~LLInventoryModelBackgroundFetch()
 
 bool LLInventoryModelBackgroundFetch::isBulkFetchProcessingComplete() const
 {
-    return mFetchFolderQueue.empty() && mFetchItemQueue.empty() && mFetchCount <= 0;
+    //return mFetchFolderQueue.empty() && mFetchItemQueue.empty() && mFetchCount <= 0;
+    return mFetchPriorityQueue.empty() && mFetchFolderQueue.empty() && mFetchItemQueue.empty() && mFetchCount <= 0; // <3T:TommyTheTerrible/>
 }
 
 bool LLInventoryModelBackgroundFetch::isFolderFetchProcessingComplete() const
 {
-    return mFetchFolderQueue.empty() && mFetchFolderCount <= 0;
+    //return mFetchFolderQueue.empty() && mFetchFolderCount <= 0;
+    return mFetchPriorityQueue.empty() && mFetchFolderQueue.empty() && mFetchFolderCount <= 0; // <3T:TommyTheTerrible/>
 }
 
 bool LLInventoryModelBackgroundFetch::libraryFetchStarted() const
@@ -308,6 +312,13 @@ void LLInventoryModelBackgroundFetch::start(const LLUUID& id, bool recursive)
                     // most system folders will be requested independently
                     // so request root folder and content separately
                     mFetchFolderQueue.emplace_front(gInventory.getRootFolderID(), FT_FOLDER_AND_CONTENT);
+
+                    // <3T:TommyTheTerrible> Outfits are needed first, for appearance and the outfit floaters
+                    prioritizeFolder(gInventory.findCategoryUUIDForType(LLFolderType::FT_CURRENT_OUTFIT));
+                    prioritizeFolder(gInventory.findCategoryUUIDForType(LLFolderType::FT_MY_OUTFITS));
+                    mFetchStartTime = LLTimer::getTotalSeconds();
+                    mFoldersFetched = 0;
+                    // </3T:TommyTheTerrible>
                 }
                 else
                 {
@@ -379,7 +390,11 @@ void LLInventoryModelBackgroundFetch::start(const LLUUID& id, bool recursive)
 
 void LLInventoryModelBackgroundFetch::scheduleFolderFetch(const LLUUID& cat_id, bool forced)
 {
-    if (mFetchFolderQueue.empty() || mFetchFolderQueue.front().mUUID != cat_id)
+    // <3T:TommyTheTerrible> Folders the user opened jump ahead of the background fetch
+    fetch_queue_t& queue = isPriorityFolder(cat_id) ? mFetchPriorityQueue : mFetchFolderQueue;
+    // </3T:TommyTheTerrible>
+    //if (mFetchFolderQueue.empty() || mFetchFolderQueue.front().mUUID != cat_id)
+    if (queue.empty() || queue.front().mUUID != cat_id) // <3T:TommyTheTerrible/>
     {
         mBackgroundFetchActive = true;
         mFolderFetchActive = true;
@@ -390,14 +405,16 @@ void LLInventoryModelBackgroundFetch::scheduleFolderFetch(const LLUUID& cat_id,
             if (mForceFetchSet.find(cat_id) == mForceFetchSet.end())
             {
                 mForceFetchSet.emplace(cat_id);
-                mFetchFolderQueue.emplace_front(cat_id, FT_FORCED);
+                //mFetchFolderQueue.emplace_front(cat_id, FT_FORCED);
+                queue.emplace_front(cat_id, FT_FORCED); // <3T:TommyTheTerrible/>
             }
         }
         else
         {
             // Specific folder requests go to front of queue.
             // version presence acts as duplicate prevention for normal fetches
-            mFetchFolderQueue.emplace_front(cat_id, FT_DEFAULT);
+            //mFetchFolderQueue.emplace_front(cat_id, FT_DEFAULT);
+            queue.emplace_front(cat_id, FT_DEFAULT); // <3T:TommyTheTerrible/>
         }
 
         gIdleCallbacks.addFunction(&LLInventoryModelBackgroundFetch::backgroundFetchCB, nullptr);
@@ -526,9 +543,113 @@ void LLInventoryModelBackgroundFetch::setAllFoldersFetched()
     // For now only informs about initial fetch being done
     mFoldersFetchedSignal();
 
-    LL_INFOS(LOG_INV) << "Inventory background fetch completed" << LL_ENDL;
+    //LL_INFOS(LOG_INV) << "Inventory background fetch completed" << LL_ENDL;
+    // <3T:TommyTheTerrible> Report fetch throughput
+    if (mFetchStartTime > 0.0)
+    {
+        LL_INFOS(LOG_INV) << "Inventory background fetch completed, " << mFoldersFetched << " folders in "
+            << (LLTimer::getTotalSeconds() - mFetchStartTime) << " seconds (" << getFoldersPerSecond() << " folders/s)" << LL_ENDL;
+        mFetchStartTime = 0.0;
+    }
+    else
+    {
+        LL_INFOS(LOG_INV) << "Inventory background fetch completed" << LL_ENDL;
+    }
+    if (mAllRecursiveFoldersFetched)
+    {
+        mPriorityFolderIds.clear();
+    }
+    // </3T:TommyTheTerrible>
+}
+
+// <3T:TommyTheTerrible> Fetch scheduling
+void LLInventoryModelBackgroundFetch::prioritizeFolder(const LLUUID& cat_id)
+{
+    static LLCachedControl<bool> fetch_priority(gSavedSettings, "FSInventoryFetchPriority", true);
+    if (!fetch_priority || cat_id.isNull() || isEverythingFetched() || !AISAPI::isAvailable())
+    {
+        return;
+    }
+    if (!mPriorityFolderIds.insert(cat_id).second)
+    {
+        return;
+    }
+
+    // Pull requests already queued for this part of the tree forward
+    for (fetch_queue_t::iterator it = mFetchFolderQueue.begin(); it != mFetchFolderQueue.end(); )
+    {
+        if (it->mUUID.notNull() && (it->mUUID == cat_id || gInventory.isObjectDescendentOf(it->mUUID, cat_id)))
+        {
+            mFetchPriorityQueue.push_back(*it);
+            it = mFetchFolderQueue.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (!mFetchPriorityQueue.empty())
+    {
+        mBackgroundFetchActive = true;
+        mFolderFetchActive = true;
+        gIdleCallbacks.addFunction(&LLInventoryModelBackgroundFetch::backgroundFetchCB, nullptr);
+    }
+}
+
+bool LLInventoryModelBackgroundFetch::isPriorityFolder(const LLUUID& cat_id) const
+{
+    if (mPriorityFolderIds.empty())
+    {
+        return false;
+    }
+
+    LLUUID id = cat_id;
+    // Depth cap guards against a parent loop in a damaged inventory
+    for (S32 depth = 0; depth < 64 && id.notNull(); ++depth)
+    {
+        if (mPriorityFolderIds.find(id) != mPriorityFolderIds.end())
+        {
+            return true;
+        }
+        const LLViewerInventoryCategory* cat = gInventory.getCategory(id);
+        if (!cat)
+        {
+            break;
+        }
+        id = cat->getParentUUID();
+    }
+    return false;
+}
+
+void LLInventoryModelBackgroundFetch::queueFolderFetch(const LLUUID& cat_id, EFetchType fetch_type)
+{
+    if (isPriorityFolder(cat_id))
+    {
+        mFetchPriorityQueue.emplace_back(cat_id, fetch_type);
+    }
+    else
+    {
+        mFetchFolderQueue.emplace_back(cat_id, fetch_type);
+    }
 }
 
+void LLInventoryModelBackgroundFetch::addFetchedFolders(S32 count)
+{
+    mFoldersFetched += count;
+}
+
+F32 LLInventoryModelBackgroundFetch::getFoldersPerSecond() const
+{
+    if (mFetchStartTime <= 0.0)
+    {
+        return 0.f;
+    }
+    const F64 elapsed = LLTimer::getTotalSeconds() - mFetchStartTime;
+    return elapsed > 0.0 ? (F32)(mFoldersFetched / elapsed) : 0.f;
+}
+// </3T:TommyTheTerrible>
+
 boost::signals2::connection LLInventoryModelBackgroundFetch::setFetchCompletionCallback(folders_fetched_callback_t cb)
 {
     return mFoldersFetchedSignal.connect(cb);
@@ -769,7 +890,11 @@ void LLInventoryModelBackgroundFetch::onAISContentCalback(
         if (response_id.isNull())
         {
             // Failed to fetch, get it individually
-            mFetchFolderQueue.emplace_back(*folder_iter, FT_RECURSIVE);
+            //mFetchFolderQueue.emplace_back(*folder_iter, FT_RECURSIVE);
+            // <3T:TommyTheTerrible> A failed sibling batch falls back the way a single
+            // recursive request would, so it is not batched again
+            queueFolderFetch(*folder_iter, fetch_type == FT_RECURSIVE ? FT_FOLDER_AND_CONTENT : FT_RECURSIVE);
+            // </3T:TommyTheTerrible>
         }
         else
         {
@@ -783,7 +908,8 @@ void LLInventoryModelBackgroundFetch::onAISContentCalback(
                      it != categories->end();
                      ++it)
                 {
-                    mFetchFolderQueue.emplace_back((*it)->getUUID(), FT_RECURSIVE);
+                    //mFetchFolderQueue.emplace_back((*it)->getUUID(), FT_RECURSIVE);
+                    queueFolderFetch((*it)->getUUID(), FT_RECURSIVE); // <3T:TommyTheTerrible/>
                 }
             }
         }
@@ -791,7 +917,8 @@ void LLInventoryModelBackgroundFetch::onAISContentCalback(
         folder_iter++;
     }
 
-    if (!mFetchFolderQueue.empty())
+    //if (!mFetchFolderQueue.empty())
+    if (!mFetchFolderQueue.empty() || !mFetchPriorityQueue.empty()) // <3T:TommyTheTerrible/>
     {
         mBackgroundFetchActive = true;
         mFolderFetchActive = true;
@@ -829,12 +956,14 @@ void LLInventoryModelBackgroundFetch::onAISFolderCalback(const LLUUID& request_i
         {
             // A full recursive request failed.
             // Try requesting folder and nested content separately
-            mFetchFolderQueue.emplace_back(request_id, FT_FOLDER_AND_CONTENT);
+            //mFetchFolderQueue.emplace_back(request_id, FT_FOLDER_AND_CONTENT);
+            queueFolderFetch(request_id, FT_FOLDER_AND_CONTENT); // <3T:TommyTheTerrible/>
         }
         else if (fetch_type == FT_FOLDER_AND_CONTENT)
         {
             LL_WARNS() << "Failed to download folder: " << request_id << " Requesting known content separately" << LL_ENDL;
-            mFetchFolderQueue.emplace_back(request_id, FT_CONTENT_RECURSIVE);
+            //mFetchFolderQueue.emplace_back(request_id, FT_CONTENT_RECURSIVE);
+            queueFolderFetch(request_id, FT_CONTENT_RECURSIVE); // <3T:TommyTheTerrible/>
 
             // set folder's version to prevent viewer from trying to request folder indefinetely
             LLViewerInventoryCategory* cat(gInventory.getCategory(request_id));
@@ -860,7 +989,17 @@ void LLInventoryModelBackgroundFetch::onAISFolderCalback(const LLUUID& request_i
         else if (fetch_type == FT_FOLDER_AND_CONTENT)
         {
             // read folder for content request
-            mFetchFolderQueue.emplace_front(request_id, FT_CONTENT_RECURSIVE);
+            //mFetchFolderQueue.emplace_front(request_id, FT_CONTENT_RECURSIVE);
+            // <3T:TommyTheTerrible> Fetch scheduling
+            if (isPriorityFolder(request_id))
+            {
+                mFetchPriorityQueue.emplace_front(request_id, FT_CONTENT_RECURSIVE);
+            }
+            else
+            {
+                mFetchFolderQueue.emplace_front(request_id, FT_CONTENT_RECURSIVE);
+            }
+            // </3T:TommyTheTerrible>
         }
         else
         {
@@ -880,12 +1019,14 @@ void LLInventoryModelBackgroundFetch::onAISFolderCalback(const LLUUID& request_i
                  it != categories->end();
                  ++it)
             {
-                mFetchFolderQueue.emplace_back((*it)->getUUID(), FT_RECURSIVE);
+                //mFetchFolderQueue.emplace_back((*it)->getUUID(), FT_RECURSIVE);
+                queueFolderFetch((*it)->getUUID(), FT_RECURSIVE); // <3T:TommyTheTerrible/>
             }
         }
     }
 
-    if (!mFetchFolderQueue.empty())
+    //if (!mFetchFolderQueue.empty())
+    if (!mFetchFolderQueue.empty() || !mFetchPriorityQueue.empty()) // <3T:TommyTheTerrible/>
     {
         mBackgroundFetchActive = true;
         mFolderFetchActive = true;
@@ -929,11 +1070,33 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis()
     const F64 end_time = curent_time + max_time;
     S32 last_fetch_count = mFetchCount;
 
+    // <3T:TommyTheTerrible> Folders the user is looking at go first. Entries are
+    // copied and popped before processing, since processing can queue more.
+    while (!mFetchPriorityQueue.empty() && (U32)mFetchCount < max_concurrent_fetches && curent_time < end_time)
+    {
+        const FetchQueueInfo fetch_info(mFetchPriorityQueue.front());
+        mFetchPriorityQueue.pop_front();
+        if (!bulkFetchSiblingsViaAis(fetch_info, mFetchPriorityQueue))
+        {
+            bulkFetchViaAis(fetch_info);
+        }
+        curent_time = LLTimer::getTotalSeconds();
+    }
+    // </3T:TommyTheTerrible>
+
     while (!mFetchFolderQueue.empty() && (U32)mFetchCount < max_concurrent_fetches && curent_time < end_time)
     {
-        const FetchQueueInfo& fetch_info(mFetchFolderQueue.front());
-        bulkFetchViaAis(fetch_info);
+        //const FetchQueueInfo& fetch_info(mFetchFolderQueue.front());
+        //bulkFetchViaAis(fetch_info);
+        //mFetchFolderQueue.pop_front();
+        // <3T:TommyTheTerrible> Fetch scheduling
+        const FetchQueueInfo fetch_info(mFetchFolderQueue.front());
         mFetchFolderQueue.pop_front();
+        if (!bulkFetchSiblingsViaAis(fetch_info, mFetchFolderQueue))
+        {
+            bulkFetchViaAis(fetch_info);
+        }
+        // </3T:TommyTheTerrible>
         curent_time = LLTimer::getTotalSeconds();
     }
 
@@ -953,7 +1116,9 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis()
     {
         LL_DEBUGS(LOG_INV , "AIS3") << "Total active fetches: " << mLastFetchCount << "->" << last_fetch_count << "->" << mFetchCount
             << ", scheduled folder fetches: " << (S32)mFetchFolderQueue.size()
+            << ", scheduled priority fetches: " << (S32)mFetchPriorityQueue.size() // <3T:TommyTheTerrible/>
             << ", scheduled item fetches: " << (S32)mFetchItemQueue.size()
+            << ", folders/s: " << getFoldersPerSecond() // <3T:TommyTheTerrible/>
             << LL_ENDL;
         mLastFetchCount = mFetchCount;
 
@@ -1051,6 +1216,20 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
                     static LLCachedControl<S32> ais_batch(gSavedSettings, "BatchSizeAIS3", 20);
                     S32 batch_limit = llclamp(ais_batch(), 1, 40);
 
+                    // <3T:TommyTheTerrible> Prioritized children take the first batch slots
+                    LLInventoryModel::cat_array_t ordered_categories;
+                    if (!mPriorityFolderIds.empty())
+                    {
+                        ordered_categories = *categories;
+                        std::stable_partition(ordered_categories.begin(), ordered_categories.end(),
+                            [this](const LLPointer<LLViewerInventoryCategory>& child_cat)
+                            {
+                                return mPriorityFolderIds.find(child_cat->getUUID()) != mPriorityFolderIds.end();
+                            });
+                        categories = &ordered_categories;
+                    }
+                    // </3T:TommyTheTerrible>
+
                     for (LLInventoryModel::cat_array_t::iterator it = categories->begin();
                          it != categories->end();
                          ++it)
@@ -1112,14 +1291,16 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
                             LLViewerInventoryCategory* child_cat = (*it);
                             if (LLViewerInventoryCategory::VERSION_UNKNOWN != child_cat->getVersion())
                             {
-                                mFetchFolderQueue.emplace_back(child_cat->getUUID(), FT_RECURSIVE);
+                                //mFetchFolderQueue.emplace_back(child_cat->getUUID(), FT_RECURSIVE);
+                                queueFolderFetch(child_cat->getUUID(), FT_RECURSIVE); // <3T:TommyTheTerrible/>
                             }
                         }
                     }
                     else
                     {
                         // send it back to get the rest
-                        mFetchFolderQueue.emplace_back(cat_id, FT_CONTENT_RECURSIVE);
+                        //mFetchFolderQueue.emplace_back(cat_id, FT_CONTENT_RECURSIVE);
+                        queueFolderFetch(cat_id, FT_CONTENT_RECURSIVE); // <3T:TommyTheTerrible/>
                     }
                 }
                 else if (LLViewerInventoryCategory::VERSION_UNKNOWN == cat->getVersion()
@@ -1168,7 +1349,8 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
                             ++it)
                         {
                             // not emplace_front to not cause an infinite loop
-                            mFetchFolderQueue.emplace_back((*it)->getUUID(), FT_RECURSIVE);
+                            //mFetchFolderQueue.emplace_back((*it)->getUUID(), FT_RECURSIVE);
+                            queueFolderFetch((*it)->getUUID(), FT_RECURSIVE); // <3T:TommyTheTerrible/>
                         }
                     }
                 }
@@ -1208,6 +1390,92 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
     }
 }
 
+// <3T:TommyTheTerrible> Fetch scheduling
+// Recursive requests are queued one per folder, usually a whole set of
+// siblings in a row. AIS3 can return several children of one parent in a
+// single subset request, so send unfetched siblings at the front of the
+// queue together instead of one request each. AIS has no request that
+// spans parents, so batches stop at the first entry with another parent.
+bool LLInventoryModelBackgroundFetch::bulkFetchSiblingsViaAis(const FetchQueueInfo& fetch_info, fetch_queue_t& queue)
+{
+    auto can_batch = [](const FetchQueueInfo& info) -> LLViewerInventoryCategory*
+    {
+        if (!info.mIsCategory || info.mFetchType != FT_RECURSIVE || info.mUUID.isNull())
+        {
+            return nullptr;
+        }
+        LLViewerInventoryCategory* cat = gInventory.getCategory(info.mUUID);
+        if (!cat
+            || cat->getVersion() != LLViewerInventoryCategory::VERSION_UNKNOWN
+            || cat->getFetching() >= LLViewerInventoryCategory::FETCH_RECURSIVE
+            || cat->getPreferredType() == LLFolderType::FT_MARKETPLACE_LISTINGS)
+        {
+            return nullptr;
+        }
+        return cat;
+    };
+
+    LLViewerInventoryCategory* first_cat = can_batch(fetch_info);
+    if (!first_cat || queue.empty())
+    {
+        return false;
+    }
+    const LLUUID parent_id = first_cat->getParentUUID();
+    const LLViewerInventoryCategory* parent_cat = gInventory.getCategory(parent_id);
+    if (!parent_cat)
+    {
+        return false;
+    }
+
+    static LLCachedControl<S32> ais_batch(gSavedSettings, "BatchSizeAIS3", 20);
+    const size_t batch_limit = llclamp(ais_batch(), 1, 40);
+
+    std::vector<LLViewerInventoryCategory*> batch(1, first_cat);
+    while (!queue.empty() && batch.size() < batch_limit)
+    {
+        LLViewerInventoryCategory* cat = can_batch(queue.front());
+        if (!cat || cat->getParentUUID() != parent_id || std::find(batch.begin(), batch.end(), cat) != batch.end())
+        {
+            break;
+        }
+        batch.push_back(cat);
+        queue.pop_front();
+    }
+
+    if (batch.size() == 1)
+    {
+        return false;
+    }
+
+    uuid_vec_t children;
+    children.reserve(batch.size());
+    for (LLViewerInventoryCategory* cat : batch)
+    {
+        children.emplace_back(cat->getUUID());
+        mExpectedFolderIds.emplace_back(cat->getUUID());
+        cat->setFetching(LLViewerInventoryCategory::FETCH_RECURSIVE);
+    }
+
+    // increment before call in case of immediate callback
+    incrFetchFolderCount(1);
+
+    AISAPI::completion_t cb = [parent_id, children](const LLUUID& response_id)
+    {
+        LLInventoryModelBackgroundFetch::instance().onAISContentCalback(parent_id, children, response_id, FT_RECURSIVE);
+    };
+
+    AISAPI::ITEM_TYPE item_type = AISAPI::INVENTORY;
+    if (ALEXANDRIA_LINDEN_ID == parent_cat->getOwnerID())
+    {
+        item_type = AISAPI::LIBRARY;
+    }
+
+    LL_DEBUGS(LOG_INV, "AIS3") << "Fetching " << children.size() << " folders of " << parent_id << " in one request" << LL_ENDL;
+    AISAPI::FetchCategorySubset(parent_id, children, item_type, true, cb, 0);
+    return true;
+}
+// </3T:TommyTheTerrible>
+
 // Bundle up a bunch of requests to send all at once.
 void LLInventoryModelBackgroundFetch::bulkFetch()
 {
@@ -1228,6 +1496,14 @@ void LLInventoryModelBackgroundFetch::bulkFetch()
     static const U32 max_batch_size(10);
     static const S32 max_concurrent_fetches(12);        // Outstanding requests, not connections
 
+    // <3T:TommyTheTerrible> Only the AIS3 path drains the priority queue
+    if (!mFetchPriorityQueue.empty())
+    {
+        mFetchFolderQueue.insert(mFetchFolderQueue.begin(), mFetchPriorityQueue.begin(), mFetchPriorityQueue.end());
+        mFetchPriorityQueue.clear();
+    }
+    // </3T:TommyTheTerrible>
+
     if (mFetchCount)
     {
         // Process completed background HTTP requests
@@ -1442,6 +1718,13 @@ void LLInventoryModelBackgroundFetch::bulkFetch()
 
 bool LLInventoryModelBackgroundFetch::fetchQueueContainsNoDescendentsOf(const LLUUID& cat_id) const
 {
+    // <3T:TommyTheTerrible> Fetch scheduling
+    for (const FetchQueueInfo& info : mFetchPriorityQueue)
+    {
+        if (gInventory.isObjectDescendentOf(info.mUUID, cat_id))
+            return false;
+    }
+    // </3T:TommyTheTerrible>
     for (fetch_queue_t::const_iterator it = mFetchFolderQueue.begin();
          it != mFetchFolderQueue.end();
          ++it)
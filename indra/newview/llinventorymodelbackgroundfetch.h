@@ -84,6 +84,15 @@ public:
     void addRequestAtFront(const LLUUID& id, bool recursive, bool is_category);
     void addRequestAtBack(const LLUUID& id, bool recursive, bool is_category);
 
+    // <3T:TommyTheTerrible> Fetch scheduling
+    // AIS3 only. Moves a folder and everything below it ahead of the rest of
+    // the background fetch, for folders the user is looking at.
+    void prioritizeFolder(const LLUUID& cat_id);
+    // Folders received by fetch responses, for throughput reporting
+    void addFetchedFolders(S32 count);
+    F32 getFoldersPerSecond() const;
+    // </3T:TommyTheTerrible>
+
 protected:
     bool isFolderFetchProcessingComplete() const;
 
@@ -112,6 +121,11 @@ protected:
     void onAISFolderCalback(const LLUUID& request_id, const LLUUID& response_id, EFetchType fetch_type);
     void bulkFetchViaAis();
     void bulkFetchViaAis(const FetchQueueInfo& fetch_info);
+    // <3T:TommyTheTerrible> Fetch scheduling
+    bool bulkFetchSiblingsViaAis(const FetchQueueInfo& fetch_info, fetch_queue_t& queue);
+    bool isPriorityFolder(const LLUUID& cat_id) const;
+    void queueFolderFetch(const LLUUID& cat_id, EFetchType fetch_type);
+    // </3T:TommyTheTerrible>
     void bulkFetch();
 
     void backgroundFetch();
@@ -137,6 +151,12 @@ private:
     F32 mMinTimeBetweenFetches;
     fetch_queue_t mFetchFolderQueue;
     fetch_queue_t mFetchItemQueue;
+    // <3T:TommyTheTerrible> Fetch scheduling
+    fetch_queue_t mFetchPriorityQueue; // AIS3, drained before mFetchFolderQueue
+    uuid_set_t mPriorityFolderIds;
+    F64 mFetchStartTime;
+    S32 mFoldersFetched;
+    // </3T:TommyTheTerrible>
     uuid_set_t mForceFetchSet;
     std::list<LLUUID> mExpectedFolderIds; // for debug, should this track time?
     // <FS:ND> For legacy inventory
@@ -48,6 +48,7 @@
 #include "llsd.h"
 #include "llsdutil_math.h"
 #include "llsdserialize.h"
+#include "llcompressionservice.h" // <3T:TommyTheTerrible/>
 #include "llthread.h"
 #include "llfilesystem.h"
 #include "llviewercontrol.h"
@@ -411,6 +412,7 @@ U32 LLMeshRepository::sCacheBytesDecomps = 0;
 U32 LLMeshRepository::sCacheReads = 0;
 std::atomic<U32> LLMeshRepository::sCacheWrites = 0;
 U32 LLMeshRepository::sMaxLockHoldoffs = 0;
+LLMeshDecodeStats LLMeshRepository::sDecodeStats; // <3T:TommyTheTerrible> Mesh decode worker pool
 
 LLDeadmanTimer LLMeshRepository::sQuiescentTimer(15.0, false);  // true -> gather cpu metrics
 
@@ -573,6 +575,10 @@ U32 LLMeshRepoThread::sMaxConcurrentRequests = 1;
 S32 LLMeshRepoThread::sRequestLowWater = REQUEST2_LOW_WATER_MIN;
 S32 LLMeshRepoThread::sRequestHighWater = REQUEST2_HIGH_WATER_MIN;
 S32 LLMeshRepoThread::sRequestWaterLevel = 0;
+// <3T:TommyTheTerrible> Mesh decode worker pool
+std::atomic<S32> LLMeshRepoThread::sDecodeQueueDepth{ 0 };
+std::atomic<U32> LLMeshRepoThread::sDecodeQueueLimit{ 256 };
+// </3T:TommyTheTerrible>
 
 // Base handler class for all mesh users of llcorehttp.
 // This is roughly equivalent to a Responder class in
@@ -740,6 +746,7 @@ protected:
 public:
     virtual void processData(LLCore::BufferArray * body, S32 body_offset, U8 * data, S32 data_size);
     virtual void processFailure(LLCore::HttpStatus status);
+    void processDecomposition(U8* data, S32 data_size); // <3T:TommyTheTerrible> Mesh decode worker pool
 
 public:
     LLUUID mMeshID;
@@ -766,6 +773,7 @@ protected:
 public:
     virtual void processData(LLCore::BufferArray * body, S32 body_offset, U8 * data, S32 data_size);
     virtual void processFailure(LLCore::HttpStatus status);
+    void processPhysicsShape(U8* data, S32 data_size); // <3T:TommyTheTerrible> Mesh decode worker pool
 
 public:
     LLUUID mMeshID;
@@ -864,6 +872,124 @@ void log_upload_error(LLCore::HttpStatus status, const LLSD& content,
     gMeshRepo.uploadError(args);
 }
 
+// <3T:TommyTheTerrible> Mesh decode worker pool
+LLMeshDecodeStats::LLMeshDecodeStats()
+{
+    reset();
+}
+
+void LLMeshDecodeStats::reset()
+{
+    for (U32 stage = 0; stage < NUM_STAGES; ++stage)
+    {
+        mCount[stage] = 0;
+        mTotalUsec[stage] = 0;
+        for (U32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+        {
+            mBuckets[stage][bucket] = 0;
+        }
+    }
+}
+
+void LLMeshDecodeStats::record(EStage stage, U64 usec)
+{
+    U32 bucket = 0;
+    while (usec >> bucket && bucket < NUM_BUCKETS - 1)
+    {
+        ++bucket;
+    }
+    mCount[stage].fetch_add(1, std::memory_order_relaxed);
+    mTotalUsec[stage].fetch_add(usec, std::memory_order_relaxed);
+    mBuckets[stage][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+F64 LLMeshDecodeStats::getMeanMsec(EStage stage) const
+{
+    U64 count = getCount(stage);
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    return (F64)mTotalUsec[stage].load(std::memory_order_relaxed) / (F64)count / 1000.0;
+}
+
+F64 LLMeshDecodeStats::getPercentileMsec(EStage stage, F32 percentile) const
+{
+    U64 count = getCount(stage);
+    if (count == 0)
+    {
+        return 0.0;
+    }
+
+    U64 target = (U64)llceil((F32)count * llclamp(percentile, 0.f, 1.f));
+    U64 seen = 0;
+    for (U32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+    {
+        seen += mBuckets[stage][bucket].load(std::memory_order_relaxed);
+        if (seen >= target)
+        {
+            return (F64)(1ULL << bucket) / 1000.0;
+        }
+    }
+    return (F64)(1ULL << (NUM_BUCKETS - 1)) / 1000.0;
+}
+
+//static
+const char* LLMeshDecodeStats::getStageName(EStage stage)
+{
+    switch (stage)
+    {
+    case STAGE_QUEUED:  return "queued";
+    case STAGE_INFLATE: return "inflate";
+    case STAGE_PARSE:   return "parse";
+    case STAGE_BUILD:   return "build";
+    default:            return "unknown";
+    }
+}
+
+std::string LLMeshDecodeStats::asString() const
+{
+    std::string out;
+    for (U32 i = 0; i < NUM_STAGES; ++i)
+    {
+        EStage stage = (EStage)i;
+        out += llformat("%s%s %.2f/%.2f/%.2f",
+                        out.empty() ? "" : "  ",
+                        getStageName(stage),
+                        getMeanMsec(stage),
+                        getPercentileMsec(stage, 0.5f),
+                        getPercentileMsec(stage, 0.95f));
+    }
+    return out;
+}
+
+// Inflate and parse a compressed LLSD mesh block, timing both stages.
+// The inflate buffer belongs to the decode thread and is reused for every block.
+static LLUZipHelper::EZipRresult decode_mesh_block(LLSD& data, const U8* in, S32 size)
+{
+    static thread_local LLCompressionService::buffer_t inflated;
+
+    U64 start = LLTimer::getTotalTime();
+    LLCompressionService::EResult inflate_result = LLCompressionService::inflate(in, size, inflated);
+    U64 inflated_at = LLTimer::getTotalTime();
+    LLMeshRepository::sDecodeStats.record(LLMeshDecodeStats::STAGE_INFLATE, inflated_at - start);
+    if (inflate_result != LLCompressionService::OK)
+    {
+        return inflate_result == LLCompressionService::MEM_ERROR ? LLUZipHelper::ZR_MEM_ERROR : LLUZipHelper::ZR_DATA_ERROR;
+    }
+
+    LLUZipHelper::EZipRresult result = LLUZipHelper::parse_llsd(data, inflated.data(), inflated.size());
+    LLMeshRepository::sDecodeStats.record(LLMeshDecodeStats::STAGE_PARSE, LLTimer::getTotalTime() - inflated_at);
+
+    constexpr size_t MAX_RETAINED_INFLATE_BUFFER = 8 * 1024 * 1024;
+    if (inflated.capacity() > MAX_RETAINED_INFLATE_BUFFER)
+    {
+        LLCompressionService::buffer_t().swap(inflated);
+    }
+    return result;
+}
+// </3T:TommyTheTerrible>
+
 void write_preamble(LLFileSystem &file, S32 header_bytes, S32 flags)
 {
     LLMeshRepository::sCacheBytesWritten += CACHE_PREAMBLE_SIZE;
@@ -909,6 +1035,8 @@ LLMeshRepoThread::LLMeshRepoThread()
 
     // Lod processing is expensive due to the number of requests
     // and a need to do expensive cacheOptimize().
+    // <3T:TommyTheTerrible> Skin and physics decoding run here too, width comes from
+    // ThreadPoolSizes["MeshLodProcessing"] (FSMeshDecodeThreads).
     mMeshThreadPool.reset(new LL::ThreadPool("MeshLodProcessing", 2));
     mMeshThreadPool->start();
 }
@@ -920,6 +1048,8 @@ LLMeshRepoThread::~LLMeshRepoThread()
                        << ", Large GETs issued:  " << LLMeshRepository::sHTTPLargeRequestCount
                        << ", Max Lock Holdoffs:  " << LLMeshRepository::sMaxLockHoldoffs
                        << LL_ENDL;
+    // <3T:TommyTheTerrible> Mesh decode worker pool
+    LL_INFOS(LOG_MESH) << "Decode latency mean/p50/p95 ms:  " << LLMeshRepository::sDecodeStats.asString() << LL_ENDL;
 
     mHttpRequestSet.clear();
     mHttpHeaders.reset();
@@ -996,6 +1126,15 @@ void LLMeshRepoThread::run()
         }
         sRequestWaterLevel = static_cast<S32>(mHttpRequestSet.size());            // Stats data update
 
+        // <3T:TommyTheTerrible> Mesh decode worker pool back-pressure.  Keep servicing
+        // http completions above, but don't start new fetches (cache reads post
+        // decodes directly) until the decode workers drain below the limit.
+        if (isDecodeBackedUp())
+        {
+            continue;
+        }
+        // </3T:TommyTheTerrible>
+
         // NOTE: order of queue processing intentionally favors LOD and Skin requests over header requests
         // Todo: we are processing mLODReqQ, mHeaderReqQ, mSkinRequests, mDecompositionRequests and mPhysicsShapeRequests
         // in relatively similar manners, remake code to simplify/unify the process,
@@ -1243,6 +1382,34 @@ void LLMeshRepoThread::run()
     }
 }
 
+// <3T:TommyTheTerrible> Mesh decode worker pool
+bool LLMeshRepoThread::postDecode(const LL::WorkQueue::Work& work)
+{
+    const U64 queued_at = LLTimer::getTotalTime();
+    ++sDecodeQueueDepth;
+    bool posted = mMeshThreadPool->getQueue().post(
+        [work, queued_at]()
+    {
+        --sDecodeQueueDepth;
+        LLMeshRepository::sDecodeStats.record(LLMeshDecodeStats::STAGE_QUEUED, LLTimer::getTotalTime() - queued_at);
+        work();
+    });
+
+    if (!posted)
+    {
+        --sDecodeQueueDepth;
+    }
+    return posted;
+}
+
+//static
+bool LLMeshRepoThread::isDecodeBackedUp()
+{
+    const U32 limit = sDecodeQueueLimit.load();
+    return limit > 0 && sDecodeQueueDepth.load() >= (S32)limit;
+}
+// </3T:TommyTheTerrible>
+
 // Mutex:  LLMeshRepoThread::mMutex must be held on entry
 void LLMeshRepoThread::loadMeshSkinInfo(const LLUUID& mesh_id)
 {
@@ -1561,7 +1728,7 @@ bool LLMeshRepoThread::fetchMeshSkinInfo(const LLUUID& mesh_id)
                 if (!zero)
                 {
                     //attempt to parse
-                    bool posted = mMeshThreadPool->getQueue().post(
+                    bool posted = postDecode( // <3T:TommyTheTerrible> Mesh decode worker pool
                         [mesh_id, buffer, size]
                         ()
                     {
@@ -1711,7 +1878,10 @@ bool LLMeshRepoThread::fetchMeshDecomposition(const LLUUID& mesh_id)
             LLFileSystem file(mesh_id, LLAssetType::AT_MESH);
             if (in_cache && file.getSize() >= disk_ofset + size)
             {
-                U8* buffer = getDiskCacheBuffer(size);
+                // <3T:TommyTheTerrible> Mesh decode worker pool, decode gets its own buffer
+                //U8* buffer = getDiskCacheBuffer(size);
+                U8* buffer = new(std::nothrow) U8[size];
+                // </3T:TommyTheTerrible>
                 if (!buffer)
                 {
                     return true;
@@ -1731,11 +1901,40 @@ bool LLMeshRepoThread::fetchMeshDecomposition(const LLUUID& mesh_id)
 
                 if (!zero)
                 { //attempt to parse
-                    if (decompositionReceived(mesh_id, buffer, size))
+                    // <3T:TommyTheTerrible> Mesh decode worker pool
+                    bool posted = postDecode(
+                        [mesh_id, buffer, size]
+                        ()
+                    {
+                        if (!gMeshRepo.mThread->decompositionReceived(mesh_id, buffer, size))
+                        {
+                            // cache is faulty, stop trusting it and fetch from sim
+                            {
+                                LLMutexLock lock(gMeshRepo.mThread->mHeaderMutex);
+                                auto header_it = gMeshRepo.mThread->mMeshHeader.find(mesh_id);
+                                if (header_it != gMeshRepo.mThread->mMeshHeader.end())
+                                {
+                                    header_it->second.mPhysicsConvexInCache = false;
+                                }
+                            }
+                            LLMutexLock lock(gMeshRepo.mThread->mMutex);
+                            gMeshRepo.mThread->mDecompositionRequests.insert(UUIDBasedRequest(mesh_id));
+                        }
+                        delete[] buffer;
+                    });
+                    if (posted)
                     {
+                        // lambda owns buffer
+                        return true;
+                    }
+                    else if (decompositionReceived(mesh_id, buffer, size))
+                    {
+                        delete[] buffer;
                         return true;
                     }
+                    // </3T:TommyTheTerrible>
                 }
+                delete[] buffer; // <3T:TommyTheTerrible>
             }
 
             //reading from cache failed for whatever reason, fetch from sim
@@ -1820,7 +2019,10 @@ bool LLMeshRepoThread::fetchMeshPhysicsShape(const LLUUID& mesh_id)
                 LLMeshRepository::sCacheBytesRead += size;
                 ++LLMeshRepository::sCacheReads;
 
-                U8* buffer = getDiskCacheBuffer(size);
+                // <3T:TommyTheTerrible> Mesh decode worker pool, decode gets its own buffer
+                //U8* buffer = getDiskCacheBuffer(size);
+                U8* buffer = new(std::nothrow) U8[size];
+                // </3T:TommyTheTerrible>
                 if (!buffer)
                 {
                     return true;
@@ -1837,11 +2039,40 @@ bool LLMeshRepoThread::fetchMeshPhysicsShape(const LLUUID& mesh_id)
 
                 if (!zero)
                 { //attempt to parse
-                    if (physicsShapeReceived(mesh_id, buffer, size) == MESH_OK)
+                    // <3T:TommyTheTerrible> Mesh decode worker pool
+                    bool posted = postDecode(
+                        [mesh_id, buffer, size]
+                        ()
+                    {
+                        if (gMeshRepo.mThread->physicsShapeReceived(mesh_id, buffer, size) != MESH_OK)
+                        {
+                            // cache is faulty, stop trusting it and fetch from sim
+                            {
+                                LLMutexLock lock(gMeshRepo.mThread->mHeaderMutex);
+                                auto header_it = gMeshRepo.mThread->mMeshHeader.find(mesh_id);
+                                if (header_it != gMeshRepo.mThread->mMeshHeader.end())
+                                {
+                                    header_it->second.mPhysicsMeshInCache = false;
+                                }
+                            }
+                            LLMutexLock lock(gMeshRepo.mThread->mMutex);
+                            gMeshRepo.mThread->mPhysicsShapeRequests.insert(UUIDBasedRequest(mesh_id));
+                        }
+                        delete[] buffer;
+                    });
+                    if (posted)
                     {
+                        // lambda owns buffer
                         return true;
                     }
+                    else if (physicsShapeReceived(mesh_id, buffer, size) == MESH_OK)
+                    {
+                        delete[] buffer;
+                        return true;
+                    }
+                    // </3T:TommyTheTerrible>
                 }
+                delete[] buffer; // <3T:TommyTheTerrible>
             }
 
             //reading from cache failed for whatever reason, fetch from sim
@@ -2083,7 +2314,7 @@ bool LLMeshRepoThread::fetchMeshLOD(const LLVolumeParams& mesh_params, S32 lod)
                 {
                     //attempt to parse
                     const LLVolumeParams params(mesh_params);
-                    bool posted = mMeshThreadPool->getQueue().post(
+                    bool posted = postDecode( // <3T:TommyTheTerrible> Mesh decode worker pool
                         [params, mesh_id, lod, buffer, size]
                         ()
                     {
@@ -2390,8 +2621,23 @@ EMeshProcessingResult LLMeshRepoThread::lodReceived(const LLVolumeParams& mesh_p
         return MESH_NO_DATA;
     }
 
+    // <3T:TommyTheTerrible> Mesh decode worker pool, stage timing
+    //LLPointer<LLVolume> volume = new LLVolume(mesh_params, LLVolumeLODGroup::getVolumeScaleFromDetail(lod));
+    //if (volume->unpackVolumeFaces(data, data_size))
+    LLSD mdl;
+    U32 uzip_result = decode_mesh_block(mdl, data, data_size);
+    if (uzip_result != LLUZipHelper::ZR_OK)
+    {
+        LL_DEBUGS("MeshStreaming") << "Failed to unzip LLSD blob for LoD with code " << uzip_result << " , will probably fetch from sim again." << LL_ENDL;
+        return MESH_PARSE_FAILURE;
+    }
+
+    const U64 build_start = LLTimer::getTotalTime();
     LLPointer<LLVolume> volume = new LLVolume(mesh_params, LLVolumeLODGroup::getVolumeScaleFromDetail(lod));
-    if (volume->unpackVolumeFaces(data, data_size))
+    bool unpacked = volume->unpackVolumeFaces(mdl);
+    LLMeshRepository::sDecodeStats.record(LLMeshDecodeStats::STAGE_BUILD, LLTimer::getTotalTime() - build_start);
+    if (unpacked)
+    // </3T:TommyTheTerrible>
     {
         if (volume->getNumFaces() > 0)
         {
@@ -2442,7 +2688,7 @@ bool LLMeshRepoThread::skinInfoReceived(const LLUUID& mesh_id, U8* data, S32 dat
     {
         try
         {
-            U32 uzip_result = LLUZipHelper::unzip_llsd(skin, data, data_size);
+            U32 uzip_result = decode_mesh_block(skin, data, data_size); // <3T:TommyTheTerrible> Mesh decode worker pool, stage timing
             if (uzip_result != LLUZipHelper::ZR_OK)
             {
                 LL_WARNS(LOG_MESH) << "Mesh skin info parse error.  Not a valid mesh asset!  ID:  " << mesh_id
@@ -2459,6 +2705,7 @@ bool LLMeshRepoThread::skinInfoReceived(const LLUUID& mesh_id, U8* data, S32 dat
     }
 
     {
+        const U64 build_start = LLTimer::getTotalTime(); // <3T:TommyTheTerrible> Mesh decode worker pool, stage timing
         LLPointer<LLMeshSkinInfo> info = nullptr;
         info = new LLMeshSkinInfo(mesh_id, skin);
 
@@ -2467,6 +2714,7 @@ bool LLMeshRepoThread::skinInfoReceived(const LLUUID& mesh_id, U8* data, S32 dat
             // generate a map of mesh joint numbers to LLVOAvatar joint numbers
             LLSkinningUtil::initJointNums(info, gAgentAvatarp);
         }
+        LLMeshRepository::sDecodeStats.record(LLMeshDecodeStats::STAGE_BUILD, LLTimer::getTotalTime() - build_start); // <3T:TommyTheTerrible>
 
         // copy the skin info for the background thread so we can use it
         // to calculate per-joint bounding boxes when volumes are loaded
@@ -2495,7 +2743,7 @@ bool LLMeshRepoThread::decompositionReceived(const LLUUID& mesh_id, U8* data, S3
     {
         try
         {
-            U32 uzip_result = LLUZipHelper::unzip_llsd(decomp, data, data_size);
+            U32 uzip_result = decode_mesh_block(decomp, data, data_size); // <3T:TommyTheTerrible> Mesh decode worker pool, stage timing
             if (uzip_result != LLUZipHelper::ZR_OK)
             {
                 LL_WARNS(LOG_MESH) << "Mesh decomposition parse error.  Not a valid mesh asset!  ID:  " << mesh_id
@@ -2512,8 +2760,10 @@ bool LLMeshRepoThread::decompositionReceived(const LLUUID& mesh_id, U8* data, S3
     }
 
     {
+        const U64 build_start = LLTimer::getTotalTime(); // <3T:TommyTheTerrible> Mesh decode worker pool, stage timing
         LLModel::Decomposition* d = new LLModel::Decomposition(decomp);
         d->mMeshID = mesh_id;
+        LLMeshRepository::sDecodeStats.record(LLMeshDecodeStats::STAGE_BUILD, LLTimer::getTotalTime() - build_start); // <3T:TommyTheTerrible>
         {
             LLMutexLock lock(mLoadedMutex);
             mDecompositionQ.push_back(d);
@@ -2542,7 +2792,13 @@ EMeshProcessingResult LLMeshRepoThread::physicsShapeReceived(const LLUUID& mesh_
         volume_params.setSculptID(mesh_id, LL_SCULPT_TYPE_MESH);
         LLPointer<LLVolume> volume = new LLVolume(volume_params,0);
 
-        if (volume->unpackVolumeFaces(data, data_size))
+        // <3T:TommyTheTerrible> Mesh decode worker pool, stage timing
+        //if (volume->unpackVolumeFaces(data, data_size))
+        LLSD mdl;
+        bool decoded = decode_mesh_block(mdl, data, data_size) == LLUZipHelper::ZR_OK;
+        const U64 build_start = LLTimer::getTotalTime();
+        if (decoded && volume->unpackVolumeFaces(mdl))
+        // </3T:TommyTheTerrible>
         {
             d->mPhysicsShapeMesh.clear();
 
@@ -2561,6 +2817,7 @@ EMeshProcessingResult LLMeshRepoThread::physicsShapeReceived(const LLUUID& mesh_
                     norm.push_back(LLVector3(face.mNormals[idx].getF32ptr()));
                 }
             }
+            LLMeshRepository::sDecodeStats.record(LLMeshDecodeStats::STAGE_BUILD, LLTimer::getTotalTime() - build_start); // <3T:TommyTheTerrible>
         }
     }
 
@@ -3889,7 +4146,7 @@ void LLMeshLODHandler::processData(LLCore::BufferArray * /* body */, S32 /* body
         && ((data != NULL) == (data_size > 0))) // if we have data but no size or have size but no data, something is wrong
     {
         LLMeshHandlerBase::ptr_t shrd_handler = shared_from_this();
-        bool posted = gMeshRepo.mThread->mMeshThreadPool->getQueue().post(
+        bool posted = gMeshRepo.mThread->postDecode( // <3T:TommyTheTerrible> Mesh decode worker pool
             [shrd_handler, data, data_size]
             ()
         {
@@ -4002,7 +4259,7 @@ void LLMeshSkinInfoHandler::processData(LLCore::BufferArray * /* body */, S32 /*
         && ((data != NULL) == (data_size > 0))) // if we have data but no size or have size but no data, something is wrong
     {
         LLMeshHandlerBase::ptr_t shrd_handler = shared_from_this();
-        bool posted = gMeshRepo.mThread->mMeshThreadPool->getQueue().post(
+        bool posted = gMeshRepo.mThread->postDecode( // <3T:TommyTheTerrible> Mesh decode worker pool
             [shrd_handler, data, data_size]
             ()
         {
@@ -4051,13 +4308,49 @@ void LLMeshDecompositionHandler::processFailure(LLCore::HttpStatus status)
     // request unfulfilled rather than retry forever.
 }
 
+// <3T:TommyTheTerrible> Mesh decode worker pool
 void LLMeshDecompositionHandler::processData(LLCore::BufferArray * /* body */, S32 /* body_offset */,
                                              U8 * data, S32 data_size)
 {
     LL_PROFILE_ZONE_SCOPED;
     if ((!MESH_DECOMP_PROCESS_FAILED)
-        && ((data != NULL) == (data_size > 0)) // if we have data but no size or have size but no data, something is wrong
-        && gMeshRepo.mThread->decompositionReceived(mMeshID, data, data_size))
+        && ((data != NULL) == (data_size > 0))) // if we have data but no size or have size but no data, something is wrong
+    {
+        LLMeshHandlerBase::ptr_t shrd_handler = shared_from_this();
+        bool posted = gMeshRepo.mThread->postDecode(
+            [shrd_handler, data, data_size]
+            ()
+        {
+            LLMeshDecompositionHandler* handler = (LLMeshDecompositionHandler*)shrd_handler.get();
+            handler->processDecomposition(data, data_size);
+            delete[] data;
+        });
+
+        if (posted)
+        {
+            // ownership of data was passed to the lambda
+            mHasDataOwnership = false;
+        }
+        else
+        {
+            // mesh thread dies later than event queue, so this is normal
+            LL_INFOS_ONCE(LOG_MESH) << "Failed to post work into mMeshThreadPool" << LL_ENDL;
+            processDecomposition(data, data_size);
+        }
+    }
+    else
+    {
+        LL_WARNS(LOG_MESH) << "Error during mesh decomposition processing.  ID:  " << mMeshID
+                           << ", Unknown reason.  Not retrying."
+                           << LL_ENDL;
+        // *TODO:  Mark mesh unavailable on error
+    }
+}
+
+void LLMeshDecompositionHandler::processDecomposition(U8* data, S32 data_size)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    if (gMeshRepo.mThread->decompositionReceived(mMeshID, data, data_size))
     {
         // good fetch from sim, write to cache
         LLFileSystem file(mMeshID, LLAssetType::AT_MESH, LLFileSystem::READ_WRITE);
@@ -4129,8 +4422,43 @@ void LLMeshPhysicsShapeHandler::processData(LLCore::BufferArray * /* body */, S3
 {
     LL_PROFILE_ZONE_SCOPED;
     if ((!MESH_PHYS_SHAPE_PROCESS_FAILED)
-        && ((data != NULL) == (data_size > 0)) // if we have data but no size or have size but no data, something is wrong
-        && gMeshRepo.mThread->physicsShapeReceived(mMeshID, data, data_size) == MESH_OK)
+        && ((data != NULL) == (data_size > 0))) // if we have data but no size or have size but no data, something is wrong
+    {
+        LLMeshHandlerBase::ptr_t shrd_handler = shared_from_this();
+        bool posted = gMeshRepo.mThread->postDecode(
+            [shrd_handler, data, data_size]
+            ()
+        {
+            LLMeshPhysicsShapeHandler* handler = (LLMeshPhysicsShapeHandler*)shrd_handler.get();
+            handler->processPhysicsShape(data, data_size);
+            delete[] data;
+        });
+
+        if (posted)
+        {
+            // ownership of data was passed to the lambda
+            mHasDataOwnership = false;
+        }
+        else
+        {
+            // mesh thread dies later than event queue, so this is normal
+            LL_INFOS_ONCE(LOG_MESH) << "Failed to post work into mMeshThreadPool" << LL_ENDL;
+            processPhysicsShape(data, data_size);
+        }
+    }
+    else
+    {
+        LL_WARNS(LOG_MESH) << "Error during mesh physics shape processing.  ID:  " << mMeshID
+                           << ", Unknown reason.  Not retrying."
+                           << LL_ENDL;
+        // *TODO:  Mark mesh unavailable on error
+    }
+}
+
+void LLMeshPhysicsShapeHandler::processPhysicsShape(U8* data, S32 data_size)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    if (gMeshRepo.mThread->physicsShapeReceived(mMeshID, data, data_size) == MESH_OK)
     {
         // good fetch from sim, write to cache for caching
         LLFileSystem file(mMeshID, LLAssetType::AT_MESH, LLFileSystem::READ_WRITE);
@@ -4179,6 +4507,7 @@ void LLMeshPhysicsShapeHandler::processData(LLCore::BufferArray * /* body */, S3
         // *TODO:  Mark mesh unavailable on error
     }
 }
+// </3T:TommyTheTerrible>
 
 LLMeshRepository::LLMeshRepository()
 : mMeshMutex(NULL),
@@ -4513,6 +4842,11 @@ void LLMeshRepository::notifyLoadedMeshes()
     }
     // </FS:Ansariel> [UDP Assets]
 
+    // <3T:TommyTheTerrible> Mesh decode worker pool back-pressure
+    static LLCachedControl<U32> mesh_decode_queue_limit(gSavedSettings, "FSMeshDecodeQueueLimit");
+    LLMeshRepoThread::sDecodeQueueLimit.store(mesh_decode_queue_limit());
+    // </3T:TommyTheTerrible>
+
     //clean up completed upload threads
     for (std::vector<LLMeshUploadThread*>::iterator iter = mUploads.begin(); iter != mUploads.end(); )
     {
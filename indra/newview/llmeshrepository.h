@@ -267,6 +267,44 @@ private:
     EMeshRequestType mRequestType;
 };
 
+// <3T:TommyTheTerrible> Mesh decode worker pool latency histograms.
+// Lock-free log2 histograms of per-stage decode latency, written from
+// the MeshLodProcessing pool and read by the stats displays.
+class LLMeshDecodeStats
+{
+public:
+    typedef enum e_stage
+    {
+        STAGE_QUEUED = 0,   // posted to pool -> picked up by a worker
+        STAGE_INFLATE,      // zlib inflate of the block
+        STAGE_PARSE,        // binary LLSD parse
+        STAGE_BUILD,        // LLVolume faces, skin info or decomposition
+        NUM_STAGES
+    } EStage;
+
+    // bucket i holds samples in [2^(i-1), 2^i) microseconds, last bucket is open ended
+    static constexpr U32 NUM_BUCKETS = 24;
+
+    LLMeshDecodeStats();
+
+    void record(EStage stage, U64 usec);
+    void reset();
+
+    U64 getCount(EStage stage) const { return mCount[stage].load(std::memory_order_relaxed); }
+    F64 getMeanMsec(EStage stage) const;
+    // approximate, resolved to the upper bound of the containing bucket
+    F64 getPercentileMsec(EStage stage, F32 percentile) const;
+
+    static const char* getStageName(EStage stage);
+    std::string asString() const;
+
+private:
+    std::atomic<U64> mCount[NUM_STAGES];
+    std::atomic<U64> mTotalUsec[NUM_STAGES];
+    std::atomic<U64> mBuckets[NUM_STAGES][NUM_BUCKETS];
+};
+// </3T:TommyTheTerrible>
+
 class LLMeshHeader
 {
 public:
@@ -393,6 +431,10 @@ public:
     static S32 sRequestLowWater;
     static S32 sRequestHighWater;
     static S32 sRequestWaterLevel;          // Stats-use only, may read outside of thread
+    // <3T:TommyTheTerrible> Mesh decode worker pool
+    static std::atomic<S32> sDecodeQueueDepth;  // Decode jobs posted but not yet started
+    static std::atomic<U32> sDecodeQueueLimit;  // Stop scheduling fetches while sDecodeQueueDepth is at or above this
+    // </3T:TommyTheTerrible>
 
     LLMutex*    mMutex;
     LLMutex*    mHeaderMutex;
@@ -505,6 +547,8 @@ public:
     // workqueue for processing generic requests
     LL::WorkQueue mWorkQueue;
     // lods have their own thread due to costly cacheOptimize() calls
+    // <3T:TommyTheTerrible> LOD, skin and physics decoding all run here, sized by
+    // ThreadPoolSizes["MeshLodProcessing"], see LLAppViewer::initThreads().
     std::unique_ptr<LL::ThreadPool> mMeshThreadPool;
 
     // llcorehttp library interface objects.
@@ -549,6 +593,17 @@ public:
     void notifyLoadedMeshes();
     S32 getActualMeshLOD(const LLVolumeParams& mesh_params, S32 lod);
 
+    // <3T:TommyTheTerrible> Mesh decode worker pool
+    // Post decode work to mMeshThreadPool, tracking queue latency and depth.
+    // Returns false if the pool is closed, in which case the work was not run.
+    // Threads:  any
+    bool postDecode(const LL::WorkQueue::Work& work);
+
+    // True while the decode backlog is at or above sDecodeQueueLimit.  The repo
+    // thread holds off issuing new fetches until the workers catch up.
+    static bool isDecodeBackedUp();
+    // </3T:TommyTheTerrible>
+
     void loadMeshSkinInfo(const LLUUID& mesh_id);
     void loadMeshDecomposition(const LLUUID& mesh_id);
     void loadMeshPhysicsShape(const LLUUID& mesh_id);
@@ -782,6 +837,7 @@ public:
     static U32 sCacheReads;
     static std::atomic<U32> sCacheWrites;
     static U32 sMaxLockHoldoffs;                // Maximum sequential locking failures
+    static LLMeshDecodeStats sDecodeStats;      // <3T:TommyTheTerrible> Per-stage decode latencies
 
     static LLDeadmanTimer sQuiescentTimer;      // Time-to-complete-mesh-downloads after significant events
 
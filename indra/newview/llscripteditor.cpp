@@ -241,7 +241,8 @@ void LLScriptEditor::drawSelectionBackground()
     // Draw selection even if we don't have keyboard focus for search/replace
     if( hasSelection() && !mLineInfoList.empty())
     {
-        std::vector<LLRect> selection_rects = getSelectionRects();
+        //std::vector<LLRect> selection_rects = getSelectionRects();
+        LLFrameVector<LLRect> selection_rects = getSelectionRects(); // <3T:TommyTheTerrible/>
 
         gGL.getTexUnit(0)->unbind(LLTexUnit::TT_TEXTURE);
         const LLColor4& color = mReadOnly ? mReadOnlyFgColor : mFgColor;
@@ -254,7 +255,8 @@ void LLScriptEditor::drawSelectionBackground()
                                  alpha);
         LLRect content_display_rect = getVisibleDocumentRect();
 
-        for (std::vector<LLRect>::iterator rect_it = selection_rects.begin();
+        //for (std::vector<LLRect>::iterator rect_it = selection_rects.begin();
+        for (LLFrameVector<LLRect>::iterator rect_it = selection_rects.begin(); // <3T:TommyTheTerrible/>
              rect_it != selection_rects.end();
              ++rect_it)
         {
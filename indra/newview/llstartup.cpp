@@ -382,6 +382,7 @@ void do_startup_frame()
                 break;
             }
         }
+        apply_decoded_object_updates(); // <3T:TommyTheTerrible/>
         if (needs_drain || gMessageSystem->mPacketRing.getNumBufferedPackets() > 0)
         {
              gMessageSystem->drainUdpSocket();
@@ -404,6 +405,7 @@ void pump_idle_startup_network(void)
             display_startup();
             ++num_messages;
         }
+        apply_decoded_object_updates(); // <3T:TommyTheTerrible/>
         lmc.processAcks();
     }
     // finally call one last display_startup()
@@ -949,6 +951,7 @@ bool idle_startup()
 
             F32 dropPercent = gSavedSettings.getF32("PacketDropPercentage");
             msg->mPacketRing.setDropPercentage(dropPercent);
+            msg->mPacketRing.setBatchedReceive(gSavedSettings.getBOOL("FSBatchedUDPReceive")); // <3T:TommyTheTerrible/>
         }
 
         LL_INFOS("AppInit") << "Message System Initialized." << LL_ENDL;
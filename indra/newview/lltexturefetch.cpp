@@ -63,6 +63,7 @@
 #include "llcorehttputil.h"
 #include "llhttpretrypolicy.h"
 #include "fsassetblacklist.h" //For Asset blacklist
+#include "fstexturefetchtracer.h" // <3T:TommyTheTerrible> Fetch stage tracer
 #include "llviewermenu.h"
 #include "llviewernetwork.h" // <FS:Ansariel> OpenSim compatibility
 
@@ -572,6 +573,7 @@ private:
     LLTimer mCacheWriteTimer;
     LLTimer mFetchTimer;
     LLTimer mStateTimer;
+    U64 mTraceStateStart; // <3T:TommyTheTerrible> Fetch stage tracer, 0 when not tracing
     F32 mCacheReadTime; // time for cache read only
     F32 mDecodeTime;    // time for decode only
     F32 mCacheWriteTime;
@@ -928,6 +930,7 @@ LLTextureFetchWorker::LLTextureFetchWorker(LLTextureFetch* fetcher,
       mDesiredSize(TEXTURE_CACHE_ENTRY_SIZE),
       mFileSize(0),
       mSkippedStatesTime(0),
+      mTraceStateStart(0), // <3T:TommyTheTerrible/>
       mCachedSize(0),
       mLoaded(false),
       mSentRequest(UNSENT),
@@ -967,6 +970,13 @@ LLTextureFetchWorker::LLTextureFetchWorker(LLTextureFetch* fetcher,
     mCanUseNET = !LLGridManager::instance().isInSecondLife() && mUrl.empty() ;
 
     mType = host.isOk() ? LLImageBase::TYPE_AVATAR_BAKE : LLImageBase::TYPE_NORMAL;
+    // <3T:TommyTheTerrible> Fetch stage tracer
+    if (FSTextureFetchTracer::isEnabled())
+    {
+        mTraceStateStart = LLTimer::getTotalTime();
+        FSTextureFetchTracer::record(mID, FSTextureFetchTracer::STATE_REQUESTED, mTraceStateStart, mTraceStateStart, discard);
+    }
+    // </3T:TommyTheTerrible>
 //  LL_INFOS(LOG_TXT) << "Create: " << mID << " mHost:" << host << " Discard=" << discard << LL_ENDL;
     if (!mFetcher->mDebugPause)
     {
@@ -2262,6 +2272,8 @@ void LLTextureFetchWorker::finishWork(S32 param, bool completed)
         mFetcher->mTextureCache->writeComplete(mCacheWriteHandle, true);
         mCacheWriteHandle = LLTextureCache::nullHandle();
     }
+
+    mFetcher->mCompletedQueue.enqueue(mID); // <3T:TommyTheTerrible/> Finished or aborted, tell the main thread
 }
 
 // LLQueuedThread's update() method is asking if it's okay to
@@ -3155,6 +3167,30 @@ bool LLTextureFetch::getRequestFinished(const LLUUID& id, S32& discard_level, S3
     return res;
 }
 
+// <3T:TommyTheTerrible> Completion handoff to the main thread
+// Threads:  Tmain
+size_t LLTextureFetch::getCompletedRequests(std::vector<LLUUID>& ids)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    constexpr size_t CHUNK = 256;
+
+    ids.clear();
+    size_t count = 0;
+    do
+    {
+        ids.resize(count + CHUNK);
+        size_t got = mCompletedQueue.try_dequeue_bulk(ids.begin() + count, CHUNK);
+        count += got;
+        if (got < CHUNK)
+        {
+            break;
+        }
+    } while (true);
+    ids.resize(count);
+    return count;
+}
+// </3T:TommyTheTerrible>
+
 // Threads:  T*
 bool LLTextureFetch::updateRequestPriority(const LLUUID& id, F32 priority)
 {
@@ -3627,8 +3663,39 @@ void LLTextureFetchWorker::setState(e_state new_state)
         }
     }
 
+    // <3T:TommyTheTerrible> Fetch stage tracer
+    if (FSTextureFetchTracer::isEnabled())
+    {
+        U64 now = LLTimer::getTotalTime();
+        if (mTraceStateStart)
+        {
+            FSTextureFetchTracer::record(mID, mState, mTraceStateStart, now, mDesiredDiscard);
+        }
+        mTraceStateStart = now;
+        if (new_state == DONE)
+        {
+            // Nothing else closes DONE, mark it as it happens. A later
+            // re-request starts over from the next state.
+            FSTextureFetchTracer::record(mID, FSTextureFetchTracer::STATE_FINISHED, now, now, mDesiredDiscard);
+            mTraceStateStart = 0;
+        }
+    }
+    else
+    {
+        mTraceStateStart = 0;
+    }
+    // </3T:TommyTheTerrible>
+
     mStateTimer.reset();
     mState = new_state;
+
+    // <3T:TommyTheTerrible> Decoded data is ready before the cache write
+    // finishes, let the main thread pick it up now.
+    if (new_state == WAIT_ON_WRITE)
+    {
+        mFetcher->mCompletedQueue.enqueue(mID);
+    }
+    // </3T:TommyTheTerrible>
 }
 
 LLViewerRegion* LLTextureFetchWorker::getRegion()
@@ -42,6 +42,7 @@
 #include "httphandler.h"
 #include "lltrace.h"
 #include "llviewertexture.h"
+#include "concurrentqueue.h" // <3T:TommyTheTerrible/>
 
 class LLViewerTexture;
 class LLTextureFetchWorker;
@@ -107,6 +108,16 @@ public:
                             LLPointer<LLImageRaw>& raw, LLPointer<LLImageRaw>& aux,
                             LLCore::HttpStatus& last_http_get_status);
 
+    // <3T:TommyTheTerrible> Completion handoff to the main thread
+    // Moves the IDs of requests that finished, were aborted or have
+    // decoded data ready since the last call into ids (cleared first).
+    // An ID may show up more than once. Lock free, so the texture list
+    // only has to call getRequestFinished() for those instead of polling
+    // every fetching texture.
+    // Threads:  Tmain
+    size_t getCompletedRequests(std::vector<LLUUID>& ids);
+    // </3T:TommyTheTerrible>
+
     // Threads:  T*
     bool updateRequestPriority(const LLUUID& id, F32 priority);
 
@@ -378,6 +389,11 @@ private:
     typedef std::vector<TFRequest *> command_queue_t;
     command_queue_t mCommands;                                          // Mfq
 
+    // <3T:TommyTheTerrible> Requests with news for the main thread, see
+    // getCompletedRequests(). Pushed by the fetch thread, drained by Tmain.
+    moodycamel::ConcurrentQueue<LLUUID> mCompletedQueue;                // <none>
+    // </3T:TommyTheTerrible>
+
     // If true, modifies some behaviors that help with QA tasks.
     const bool mQAMode;
 
@@ -29,6 +29,7 @@
 #include "llviewerassetstorage.h"
 
 #include "llfilesystem.h"
+#include "llasyncfilesystem.h" // <3T:TommyTheTerrible/>
 #include "message.h"
 
 #include "llagent.h"
@@ -604,16 +605,36 @@ void LLViewerAssetStorage::assetRequestCoro(
             // case.
             LLUUID temp_id;
             temp_id.generate();
-            LLFileSystem vf(temp_id, atype, LLFileSystem::WRITE);
+            // <3T:TommyTheTerrible> Write the cache file without blocking the main coroutine
+            //LLFileSystem vf(temp_id, atype, LLFileSystem::WRITE);
             bytes_fetched = size;
-            if (!vf.write(raw.data(),size))
+            LLAsyncFileSystem* files = LLAsyncFileSystem::getInstance();
+            bool wrote = files ? files->write(temp_id, atype, raw.data(), size)
+                               : LLFileSystem(temp_id, atype, LLFileSystem::WRITE).write(raw.data(), size);
+            if (LLApp::isExiting() || !gAssetStorage)
+            {
+                // Bail out if shutdown started while the file was written.
+                return;
+            }
+            // The write suspended this coroutine, the service may be gone.
+            files = LLAsyncFileSystem::getInstance();
+            bool renamed = wrote && (files ? files->rename(temp_id, atype, uuid, atype)
+                                           : LLFileSystem::renameFile(temp_id, atype, uuid, atype));
+            if (LLApp::isExiting() || !gAssetStorage)
+            {
+                return;
+            }
+            //if (!vf.write(raw.data(),size))
+            if (!wrote)
             {
                 // TODO asset-http: handle error
                 LL_WARNS("ViewerAsset") << "Failure in vf.write()" << LL_ENDL;
                 result_code = LL_ERR_ASSET_REQUEST_FAILED;
                 ext_status = LLExtStat::CACHE_CORRUPT;
             }
-            else if (!vf.rename(uuid, atype))
+            //else if (!vf.rename(uuid, atype))
+            else if (!renamed)
+            // </3T:TommyTheTerrible>
             {
                 LL_WARNS("ViewerAsset") << "rename failed" << LL_ENDL;
                 result_code = LL_ERR_ASSET_REQUEST_FAILED;
@@ -117,6 +117,12 @@
 #include "llviewerregion.h"
 #include "NACLantispam.h"
 #include "nd/ndlogthrottle.h"
+#include "fstexturefetchtracer.h" // <3T:TommyTheTerrible/>
+#include "llsdarena.h" // <3T:TommyTheTerrible/>
+#include "llsdserialize.h" // <3T:TommyTheTerrible/>
+#include "lltraceallocprofiler.h" // <3T:TommyTheTerrible/>
+#include "lltraceprofilecapture.h" // <3T:TommyTheTerrible/>
+#include "llversioninfo.h" // <3T:TommyTheTerrible/>
 // <FS:Zi> Run Prio 0 default bento pose in the background to fix splayed hands, open mouths, etc.
 #include "llanimationstates.h"
 
@@ -1223,6 +1229,84 @@ void handleBandwidthChanged(const LLSD& newValue)
 }
 // </FS:Ansariel>
 
+// <3T:TommyTheTerrible> Texture fetch stage tracer
+static void handleTextureFetchTraceChanged(const LLSD& newvalue)
+{
+    if (newvalue.asBoolean())
+    {
+        FSTextureFetchTracer::start(gSavedSettings.getU32("FSTextureFetchTraceCapacity"));
+    }
+    else
+    {
+        FSTextureFetchTracer::stop();
+    }
+}
+// </3T:TommyTheTerrible>
+
+// <3T:TommyTheTerrible> Block timer profile capture
+static void handleProfileCaptureFramesChanged(const LLSD& newvalue)
+{
+    U32 frames = (U32)newvalue.asInteger();
+    if (frames > 0)
+    {
+        // named like the shader profiles, so profile_cmp.py finds the latest
+        std::ostringstream name;
+        name << "frames.v" << LLVersionInfo::instance().getBuild()
+             << ".t" << LLDate::now().toHTTPDateString("%Y-%m-%dT%H-%M-%S") << ".llprof";
+        LLTrace::ProfileCapture::start(frames, gDirUtilp->getExpandedFilename(LL_PATH_LOGS, name.str()));
+    }
+    else if (LLTrace::ProfileCapture::isCapturing())
+    {
+        LLTrace::ProfileCapture::stop();
+    }
+}
+// </3T:TommyTheTerrible>
+
+// <3T:TommyTheTerrible> Sampled allocation profiler
+static void handleAllocationSampleIntervalChanged(const LLSD& newvalue)
+{
+    U32 interval = (U32)newvalue.asInteger();
+    if (!interval && LLTrace::AllocationProfiler::getFrameCount())
+    {
+        LLTrace::AllocationProfiler::setSampleInterval(0);
+        LLTrace::AllocationProfiler::writeReport(gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "allocation_profile.txt"));
+        LLTrace::AllocationProfiler::reset();
+    }
+    LLTrace::AllocationProfiler::setSampleInterval(interval);
+}
+// </3T:TommyTheTerrible>
+
+// <3T:TommyTheTerrible> LLSD parse arena
+static void handleLLSDParseArenaChanged(const LLSD& newvalue)
+{
+    LLSDArena::setParseArenaEnabled(newvalue.asBoolean());
+}
+// </3T:TommyTheTerrible>
+
+// <3T:TommyTheTerrible> Batched UDP receive
+static void handleBatchedUDPReceiveChanged(const LLSD& newvalue)
+{
+    if (gMessageSystem)
+    {
+        gMessageSystem->mPacketRing.setBatchedReceive(newvalue.asBoolean());
+    }
+}
+// </3T:TommyTheTerrible>
+
+// <3T:TommyTheTerrible> Asynchronous logging
+static void handleAsyncLoggingChanged(const LLSD& newvalue)
+{
+    LLError::setAsyncLogging(newvalue.asBoolean());
+}
+// </3T:TommyTheTerrible>
+
+// <3T:TommyTheTerrible> In-place LLSD parsers
+static void handleLLSDBufferParseChanged(const LLSD& newvalue)
+{
+    LLSDParser::setBufferParseEnabled(newvalue.asBoolean());
+}
+// </3T:TommyTheTerrible>
+
 // <FS:Zi> Handle IME text input getting enabled or disabled
 #if LL_SDL2
 static bool handleSDL2IMEEnabledChanged(const LLSD& newvalue)
@@ -1547,6 +1631,31 @@ void settings_setup_listeners()
     setting_setup_signal_listener(gSavedSettings, "FSDiskCacheLowWaterPercent", handleDiskCacheLowWaterPctChanged);
     // </FS:Beq>
 
+    // <3T:TommyTheTerrible> Texture fetch stage tracer
+    setting_setup_signal_listener(gSavedSettings, "FSTextureFetchTrace", handleTextureFetchTraceChanged);
+
+    // <3T:TommyTheTerrible> LLSD parse arena
+    setting_setup_signal_listener(gSavedSettings, "FSLLSDParseArena", handleLLSDParseArenaChanged);
+    LLSDArena::setParseArenaEnabled(gSavedSettings.getBOOL("FSLLSDParseArena"));
+
+    // <3T:TommyTheTerrible> In-place LLSD parsers
+    setting_setup_signal_listener(gSavedSettings, "FSLLSDBufferParse", handleLLSDBufferParseChanged);
+    LLSDParser::setBufferParseEnabled(gSavedSettings.getBOOL("FSLLSDBufferParse"));
+
+    // <3T:TommyTheTerrible> Batched UDP receive; applied when the message system starts
+    setting_setup_signal_listener(gSavedSettings, "FSBatchedUDPReceive", handleBatchedUDPReceiveChanged);
+
+    // <3T:TommyTheTerrible> Asynchronous logging
+    setting_setup_signal_listener(gSavedSettings, "FSAsyncLogging", handleAsyncLoggingChanged);
+    LLError::setAsyncLogging(gSavedSettings.getBOOL("FSAsyncLogging"));
+
+    // <3T:TommyTheTerrible> Block timer profile capture; starts from the debug settings, never from a saved value
+    setting_setup_signal_listener(gSavedSettings, "FSProfileCaptureFrames", handleProfileCaptureFramesChanged);
+
+    // <3T:TommyTheTerrible> Sampled allocation profiler
+    setting_setup_signal_listener(gSavedSettings, "FSAllocationSampleInterval", handleAllocationSampleIntervalChanged);
+    LLTrace::AllocationProfiler::setSampleInterval(gSavedSettings.getU32("FSAllocationSampleInterval"));
+
     // <FS:Zi> Handle IME text input getting enabled or disabled
 #if LL_SDL2
     setting_setup_signal_listener(gSavedSettings, "SDL2IMEEnabled", handleSDL2IMEEnabledChanged);
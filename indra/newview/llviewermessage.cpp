@@ -147,6 +147,7 @@
 #include "fskeywords.h" // <FS:PP> FIRE-10178: Keyword Alerts in group IM do not work unless the group is in the foreground
 #include "fslslbridge.h"
 #include "fsmoneytracker.h"
+#include "fstextureprefetch.h" // <3T:TommyTheTerrible/>
 #include "llattachmentsmgr.h"
 #include "lleconomy.h"
 #include "llfloaterbump.h"
@@ -3947,6 +3948,10 @@ void process_agent_movement_complete(LLMessageSystem* msg, void**)
 
     send_agent_update(true, true);
 
+    // <3T:TommyTheTerrible> Prefetch textures from the destination's object cache around the arrival point
+    FSTexturePrefetch::instance().onAgentArrival(regionp, agent_pos);
+    // </3T:TommyTheTerrible>
+
     if (gAgent.getRegion()->getBlockFly())
     {
         gAgent.setFlying(gAgent.canFly());
@@ -4419,6 +4424,25 @@ void clear_expired_postponed_sounds()
 // this hack.
 extern U32Bits gObjectData;
 
+// <3T:TommyTheTerrible> Parallel object update decoding
+// Applies the object updates still queued for decoding, so the message being
+// handled sees the objects as they were when it arrived.
+void apply_decoded_object_updates()
+{
+    if (!gObjectList.hasPendingObjectUpdates())
+    {
+        return;
+    }
+
+    S32 old_num_objects = gObjectList.mNumNewObjects;
+    gObjectList.applyDecodedObjectUpdates();
+    if (old_num_objects != gObjectList.mNumNewObjects)
+    {
+        update_attached_sounds();
+    }
+}
+// </3T:TommyTheTerrible>
+
 void process_object_update(LLMessageSystem *mesgsys, void **user_data)
 {
     // Update the data counters
@@ -4431,6 +4455,8 @@ void process_object_update(LLMessageSystem *mesgsys, void **user_data)
         gObjectData += (U32Bytes)mesgsys->getReceiveSize();
     }
 
+    apply_decoded_object_updates(); // <3T:TommyTheTerrible/>
+
     // Update the object...
     S32 old_num_objects = gObjectList.mNumNewObjects;
     gObjectList.processObjectUpdate(mesgsys, user_data, OUT_FULL);
@@ -4452,6 +4478,8 @@ void process_compressed_object_update(LLMessageSystem *mesgsys, void **user_data
         gObjectData += (U32Bytes)mesgsys->getReceiveSize();
     }
 
+    apply_decoded_object_updates(); // <3T:TommyTheTerrible/>
+
     // Update the object...
     S32 old_num_objects = gObjectList.mNumNewObjects;
     gObjectList.processCompressedObjectUpdate(mesgsys, user_data, OUT_FULL_COMPRESSED);
@@ -4473,6 +4501,8 @@ void process_cached_object_update(LLMessageSystem *mesgsys, void **user_data)
         gObjectData += (U32Bytes)mesgsys->getReceiveSize();
     }
 
+    apply_decoded_object_updates(); // <3T:TommyTheTerrible/>
+
     // Update the object...
     gObjectList.processCachedObjectUpdate(mesgsys, user_data, OUT_FULL_CACHED);
 }
@@ -4489,6 +4519,13 @@ void process_terse_object_update_improved(LLMessageSystem *mesgsys, void **user_
         gObjectData += (U32Bytes)mesgsys->getReceiveSize();
     }
 
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    if (gObjectList.queueObjectUpdate(mesgsys))
+    {
+        return;
+    }
+    // </3T:TommyTheTerrible>
+
     S32 old_num_objects = gObjectList.mNumNewObjects;
     gObjectList.processCompressedObjectUpdate(mesgsys, user_data, OUT_TERSE_IMPROVED);
     if (old_num_objects != gObjectList.mNumNewObjects)
@@ -4501,6 +4538,8 @@ void process_kill_object(LLMessageSystem *mesgsys, void **user_data)
 {
     LL_PROFILE_ZONE_SCOPED;
 
+    apply_decoded_object_updates(); // <3T:TommyTheTerrible/>
+
     LLUUID      id;
 
     U32 ip = mesgsys->getSenderIP();
@@ -90,6 +90,7 @@ void process_chat_from_simulator(LLMessageSystem *mesgsys, void **user_data);
 
 //void process_agent_to_new_region(LLMessageSystem *mesgsys, void **user_data);
 void send_agent_update(bool force_send, bool send_reliable = false);
+void apply_decoded_object_updates(); // <3T:TommyTheTerrible/>
 void process_object_update(LLMessageSystem *mesgsys, void **user_data);
 void process_compressed_object_update(LLMessageSystem *mesgsys, void **user_data);
 void process_cached_object_update(LLMessageSystem *mesgsys, void **user_data);
@@ -125,6 +125,7 @@
 
 bool        LLViewerObject::sVelocityInterpolate = true;
 bool        LLViewerObject::sPingInterpolate = true;
+const LLViewerObject::UpdateSource* LLViewerObject::sUpdateSource = nullptr; // <3T:TommyTheTerrible/>
 
 U32         LLViewerObject::sNumZombieObjects = 0;
 S32         LLViewerObject::sNumObjects = 0;
@@ -1244,9 +1245,21 @@ U32 LLViewerObject::processUpdateMessage(LLMessageSystem *mesgsys,
     // Coordinates of objects on simulators are region-local.
     U64 region_handle = 0;
 
-    if(mesgsys != NULL)
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    const UpdateSource* source = sUpdateSource;
+    //if(mesgsys != NULL)
+    if (mesgsys != NULL || source)
     {
-        mesgsys->getU64Fast(_PREHASH_RegionData, _PREHASH_RegionHandle, region_handle);
+        //mesgsys->getU64Fast(_PREHASH_RegionData, _PREHASH_RegionHandle, region_handle);
+        if (source)
+        {
+            region_handle = source->mRegionHandle;
+        }
+        else
+        {
+            mesgsys->getU64Fast(_PREHASH_RegionData, _PREHASH_RegionHandle, region_handle);
+        }
+        // </3T:TommyTheTerrible>
         LLViewerRegion* regionp = LLWorld::getInstance()->getRegionFromHandle(region_handle);
         if(regionp != mRegionp && regionp && mRegionp)//region cross
         {
@@ -1284,10 +1297,21 @@ U32 LLViewerObject::processUpdateMessage(LLMessageSystem *mesgsys,
     }
 
     F32 time_dilation = 1.f;
-    if(mesgsys != NULL)
+    //if(mesgsys != NULL)
+    if (mesgsys != NULL || source) // <3T:TommyTheTerrible/>
     {
         U16 time_dilation16;
-        mesgsys->getU16Fast(_PREHASH_RegionData, _PREHASH_TimeDilation, time_dilation16);
+        // <3T:TommyTheTerrible> Parallel object update decoding
+        //mesgsys->getU16Fast(_PREHASH_RegionData, _PREHASH_TimeDilation, time_dilation16);
+        if (source)
+        {
+            time_dilation16 = source->mTimeDilation;
+        }
+        else
+        {
+            mesgsys->getU16Fast(_PREHASH_RegionData, _PREHASH_TimeDilation, time_dilation16);
+        }
+        // </3T:TommyTheTerrible>
         time_dilation = ((F32) time_dilation16) / 65535.f;
         mRegionp->setTimeDilation(time_dilation);
     }
@@ -2302,9 +2326,14 @@ U32 LLViewerObject::processUpdateMessage(LLMessageSystem *mesgsys,
 
     new_rot.normQuat();
 
-    if (sPingInterpolate && mesgsys != NULL)
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    //if (sPingInterpolate && mesgsys != NULL)
+    //{
+    //    LLCircuitData *cdp = gMessageSystem->mCircuitInfo.findCircuit(mesgsys->getSender());
+    if (sPingInterpolate && (mesgsys != NULL || source))
     {
-        LLCircuitData *cdp = gMessageSystem->mCircuitInfo.findCircuit(mesgsys->getSender());
+        LLCircuitData *cdp = gMessageSystem->mCircuitInfo.findCircuit(source ? source->mSender : mesgsys->getSender());
+    // </3T:TommyTheTerrible>
         if (cdp)
         {
             // Note: delay is U32 and usually less then second,
@@ -2327,9 +2356,11 @@ U32 LLViewerObject::processUpdateMessage(LLMessageSystem *mesgsys,
 
     // If we're going to skip this message, why are we
     // doing all the parenting, etc above?
-    if(mesgsys != NULL)
+    //if(mesgsys != NULL)
+    if (mesgsys != NULL || source) // <3T:TommyTheTerrible/>
     {
-    U32 packet_id = mesgsys->getCurrentRecvPacketID();
+    //U32 packet_id = mesgsys->getCurrentRecvPacketID();
+    U32 packet_id = source ? source->mPacketID : mesgsys->getCurrentRecvPacketID(); // <3T:TommyTheTerrible/>
     if (packet_id < mLatestRecvPacketID &&
         mLatestRecvPacketID - packet_id < 65536)
     {
@@ -33,6 +33,7 @@
 
 #include "llassetstorage.h"
 #include "llhudicon.h" // <FS:Ansariel> Changed to get the attached icon
+#include "llhost.h" // <3T:TommyTheTerrible/>
 #include "llinventory.h"
 #include "llrefcount.h"
 #include "llprimitive.h"
@@ -188,6 +189,24 @@ public:
                                         const EObjectUpdateType update_type,
                                         LLDataPacker *dp);
 
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    // The message fields an update needs once its message is gone. While
+    // sUpdateSource is set, processUpdateMessage() is called without a
+    // message system and takes these instead (see FSObjectUpdateDecoder).
+    struct UpdateSource
+    {
+        U64             mRegionHandle{ 0 };
+        U16             mTimeDilation{ 0 };
+        LLHost          mSender;
+        U32             mPacketID{ 0 };
+        LLTEContents*   mTextureEntry{ nullptr };   // parsed TextureEntry of a terse update
+        S32             mTextureEntryResult{ 0 };   // what LLPrimitive::parseTEMessage() returned
+        const U8*       mTextureEntryData{ nullptr };   // the TextureEntry as sent, when it was not parsed
+        S32             mTextureEntrySize{ 0 };
+    };
+    static const UpdateSource* sUpdateSource;
+    // </3T:TommyTheTerrible>
+
 
     virtual bool    isActive() const; // Whether this object needs to do an idleUpdate.
     bool            onActiveList() const                {return mOnActiveList;}
@@ -441,7 +441,11 @@ LLViewerObject* LLViewerObjectList::processObjectUpdateFromCache(LLVOCacheEntry*
 void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
                                              void **user_data,
                                              const EObjectUpdateType update_type,
-                                             bool compressed)
+                                             // <3T:TommyTheTerrible> Parallel object update decoding
+                                             //bool compressed)
+                                             bool compressed,
+                                             const FSDecodedObjectUpdate* decoded)
+                                             // </3T:TommyTheTerrible>
 {
     LL_RECORD_BLOCK_TIME(FTM_PROCESS_OBJECTS);
 
@@ -456,7 +460,13 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
     // Coordinates in simulators are region-local
     // Until we get region-locality working on viewer we
     // have to transform to absolute coordinates.
-    num_objects = mesgsys->getNumberOfBlocksFast(_PREHASH_ObjectData);
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    // A decoded update comes without its message; it carries what the
+    // message system would have been asked for.
+    //num_objects = mesgsys->getNumberOfBlocksFast(_PREHASH_ObjectData);
+    num_objects = decoded ? (S32)decoded->mBlocks.size() : mesgsys->getNumberOfBlocksFast(_PREHASH_ObjectData);
+    const LLHost sender = decoded ? decoded->mSender : gMessageSystem->getSender();
+    // </3T:TommyTheTerrible>
 
     // I don't think this case is ever hit.  TODO* Test this.
     if (!compressed && update_type != OUT_FULL)
@@ -495,7 +505,17 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
     }
 
     U64 region_handle;
-    mesgsys->getU64Fast(_PREHASH_RegionData, _PREHASH_RegionHandle, region_handle);
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    //mesgsys->getU64Fast(_PREHASH_RegionData, _PREHASH_RegionHandle, region_handle);
+    if (decoded)
+    {
+        region_handle = decoded->mRegionHandle;
+    }
+    else
+    {
+        mesgsys->getU64Fast(_PREHASH_RegionData, _PREHASH_RegionHandle, region_handle);
+    }
+    // </3T:TommyTheTerrible>
 
     LLViewerRegion *regionp = LLWorld::getInstance()->getRegionFromHandle(region_handle);
 
@@ -514,6 +534,31 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
         bool justCreated = false;
         bool update_cache = false; //update object cache if it is a full-update or terse update
 
+        // <3T:TommyTheTerrible> Parallel object update decoding
+        const FSDecodedObjectUpdate::Block* block = decoded ? &decoded->mBlocks[i] : nullptr;
+        if (block)
+        {
+            // Same buffer as below, with the header the worker unpacked skipped.
+            S32 uncompressed_length = (S32)block->mData.size();
+            if (uncompressed_length > 0)
+            {
+                memcpy(compressed_dpbuffer, block->mData.data(), uncompressed_length);
+            }
+            compressed_dp.assignBuffer(compressed_dpbuffer, uncompressed_length);
+            compressed_dp.shift(block->mHeaderSize);
+            local_id = block->mLocalID;
+
+            // only terse updates are queued
+            update_cache = true;
+            getUUIDFromLocal(fullid, local_id, sender.getAddress(), sender.getPort());
+            if (fullid.isNull())
+            {
+                LL_DEBUGS() << "update for unknown localid " << local_id << " host " << sender << LL_ENDL;
+                mNumUnknownUpdates++;
+            }
+        }
+        else
+        // </3T:TommyTheTerrible>
         if (compressed)
         {
             compressed_dp.reset();
@@ -626,8 +671,12 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
             removeFromLocalIDTable(objectp);
             setUUIDAndLocal(fullid,
                             local_id,
-                            gMessageSystem->getSenderIP(),
-                            gMessageSystem->getSenderPort(),
+                            // <3T:TommyTheTerrible> Parallel object update decoding
+                            //gMessageSystem->getSenderIP(),
+                            //gMessageSystem->getSenderPort(),
+                            sender.getAddress(),
+                            sender.getPort(),
+                            // </3T:TommyTheTerrible>
                             objectp);
 
             if (objectp->mLocalID != local_id)
@@ -688,7 +737,8 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
             }
             // </FS:Ansariel>
 
-            objectp = createObject(pcode, regionp, fullid, local_id, gMessageSystem->getSender());
+            //objectp = createObject(pcode, regionp, fullid, local_id, gMessageSystem->getSender());
+            objectp = createObject(pcode, regionp, fullid, local_id, sender); // <3T:TommyTheTerrible/>
 
             LL_DEBUGS("ObjectUpdate") << "creating object " << fullid << " result " << objectp << LL_ENDL;
 
@@ -719,7 +769,30 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
             {
                 objectp->mLocalID = local_id;
             }
-            processUpdateCore(objectp, user_data, i, update_type, &compressed_dp, justCreated);
+            // <3T:TommyTheTerrible> Parallel object update decoding
+            //processUpdateCore(objectp, user_data, i, update_type, &compressed_dp, justCreated);
+            if (block)
+            {
+                // There is no message to read, so go through the path cached
+                // updates take and hand over the fields it would have read.
+                LLViewerObject::UpdateSource source;
+                source.mRegionHandle = decoded->mRegionHandle;
+                source.mTimeDilation = decoded->mTimeDilation;
+                source.mSender = decoded->mSender;
+                source.mPacketID = decoded->mPacketID;
+                source.mTextureEntry = block->mTEContents.get();
+                source.mTextureEntryData = block->mTextureEntry.data();
+                source.mTextureEntrySize = (S32)block->mTextureEntry.size();
+                source.mTextureEntryResult = block->mTextureEntryResult;
+                LLViewerObject::sUpdateSource = &source;
+                processUpdateCore(objectp, user_data, i, update_type, &compressed_dp, justCreated, true);
+                LLViewerObject::sUpdateSource = nullptr;
+            }
+            else
+            {
+                processUpdateCore(objectp, user_data, i, update_type, &compressed_dp, justCreated);
+            }
+            // </3T:TommyTheTerrible>
 
 #if 0
             if (update_type != OUT_TERSE_IMPROVED) // OUT_FULL_COMPRESSED only?
@@ -758,6 +831,34 @@ void LLViewerObjectList::processCompressedObjectUpdate(LLMessageSystem *mesgsys,
     processObjectUpdate(mesgsys, user_data, update_type, true);
 }
 
+// <3T:TommyTheTerrible> Parallel object update decoding
+bool LLViewerObjectList::queueObjectUpdate(LLMessageSystem *mesgsys)
+{
+    if (!FSObjectUpdateDecoder::isEnabled())
+    {
+        // Anything queued earlier still goes first.
+        applyDecodedObjectUpdates();
+        return false;
+    }
+    mUpdateDecoder.queue(mesgsys);
+    return true;
+}
+
+void LLViewerObjectList::applyDecodedObjectUpdates()
+{
+    if (!mUpdateDecoder.hasPending())
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    while (FSObjectUpdateDecoder::update_ptr_t update = mUpdateDecoder.popDecoded())
+    {
+        processObjectUpdate(NULL, NULL, OUT_TERSE_IMPROVED, true, update.get());
+    }
+}
+// </3T:TommyTheTerrible>
+
 void LLViewerObjectList::processCachedObjectUpdate(LLMessageSystem *mesgsys,
                                              void **user_data,
                                              const EObjectUpdateType update_type)
@@ -981,6 +1082,8 @@ void LLViewerObjectList::update(LLAgent &agent)
     static LLCachedControl<bool> freezeTime(gSavedSettings, "FreezeTime");
     // </FS:Ansariel> Speed up debug settings
 
+    applyDecodedObjectUpdates(); // <3T:TommyTheTerrible/>
+
     // Update globals
     // </FS:Ansariel> Speed up debug settings
     //LLViewerObject::setVelocityInterpolate( gSavedSettings.getBOOL("VelocityInterpolate") );
@@ -1624,6 +1727,13 @@ void LLViewerObjectList::killObjects(LLViewerRegion *regionp)
         }
     }
 
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    if (regionp)
+    {
+        mUpdateDecoder.discard(regionp->getHandle());
+    }
+    // </3T:TommyTheTerrible>
+
     // Have to clean right away because the region is becoming invalid.
     cleanDeadObjects(false);
 }
@@ -1633,6 +1743,7 @@ void LLViewerObjectList::killAllObjects()
     // Used only on global destruction.
 
     // Mass cleanup to not clear lists one item at a time
+    mUpdateDecoder.clear(); // <3T:TommyTheTerrible/>
     mIndexAndLocalIDToUUID.clear();
     mActiveObjects.clear();
     mMapObjects.clear();
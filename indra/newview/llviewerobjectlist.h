@@ -36,6 +36,7 @@
 
 // project includes
 #include "llviewerobject.h"
+#include "fsobjectupdatedecoder.h" // <3T:TommyTheTerrible/>
 #include "lleventcoro.h"
 #include "llcoros.h"
 
@@ -86,9 +87,23 @@ public:
     void processUpdateCore(LLViewerObject* objectp, void** data, U32 block, const EObjectUpdateType update_type,
                            LLDataPacker* dpp, bool justCreated, bool from_cache = false);
     LLViewerObject* processObjectUpdateFromCache(LLVOCacheEntry* entry, LLViewerRegion* regionp);
-    void processObjectUpdate(LLMessageSystem *mesgsys, void **user_data, EObjectUpdateType update_type, bool compressed=false);
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    //void processObjectUpdate(LLMessageSystem *mesgsys, void **user_data, EObjectUpdateType update_type, bool compressed=false);
+    void processObjectUpdate(LLMessageSystem *mesgsys, void **user_data, EObjectUpdateType update_type, bool compressed=false,
+                             const FSDecodedObjectUpdate* decoded = nullptr);
+    // </3T:TommyTheTerrible>
     void processCompressedObjectUpdate(LLMessageSystem *mesgsys, void **user_data, EObjectUpdateType update_type);
     void processCachedObjectUpdate(LLMessageSystem *mesgsys, void **user_data, EObjectUpdateType update_type);
+    // <3T:TommyTheTerrible> Parallel object update decoding
+    // ImprovedTerseObjectUpdate is queued and decoded on the "General" pool,
+    // then applied in arrival order by applyDecodedObjectUpdates(). Anything
+    // that needs the objects current (other object messages, the per-frame
+    // update) applies the queue first.
+    bool queueObjectUpdate(LLMessageSystem *mesgsys);
+    void applyDecodedObjectUpdates();
+    bool hasPendingObjectUpdates() const { return mUpdateDecoder.hasPending(); }
+    const FSObjectUpdateDecoder& getObjectUpdateDecoder() const { return mUpdateDecoder; }
+    // </3T:TommyTheTerrible>
     // <FS:minerjr> [FIRE-35081] Blurry prims not changing with graphics settings
     //void updateApparentAngles(LLAgent &agent);
     // Added time limit on processing of objects as they affect the texture system
@@ -242,6 +257,8 @@ protected:
 
     std::map<U64, LLUUID> mIndexAndLocalIDToUUID;
 
+    FSObjectUpdateDecoder mUpdateDecoder; // <3T:TommyTheTerrible/>
+
     friend class LLViewerObject;
 
 private:
@@ -87,6 +87,7 @@
 #include <boost/regex.hpp>
 
 // Firestorm includes
+#include "fstextureprefetch.h" // <3T:TommyTheTerrible/>
 #include "lfsimfeaturehandler.h"
 #include "llviewermenu.h"
 #include "llviewernetwork.h"
@@ -848,6 +849,8 @@ void LLViewerRegion::loadObjectCache()
         mCacheDirty = !vocache.readFromCache(mHandle, mImpl->mCacheID, mImpl->mCacheMap);
         vocache.readGenericExtrasFromCache(mHandle, mImpl->mCacheID, mImpl->mGLTFOverridesLLSD, mImpl->mCacheMap);
 
+        FSTexturePrefetch::instance().onObjectCacheLoaded(this, mImpl->mCacheMap); // <3T:TommyTheTerrible> Teleport texture prefetch
+
         if (mImpl->mCacheMap.empty())
         {
             mCacheDirty = true;
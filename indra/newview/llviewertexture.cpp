@@ -2007,6 +2007,10 @@ bool LLViewerFetchedTexture::updateFetch()
     //      This was originally in LLViewerTextureList::updateImageDecodePriority, which is called less frequently now.
     processTextureStats();
     //</3T>
+    // <3T:TommyTheTerrible> Remember what this update saw, see isFetchIdle().
+    mFetchUpdateVirtualSize = mMaxVirtualSize;
+    mFetchUpdateDiscard = mDesiredDiscardLevel;
+    // </3T:TommyTheTerrible>
 
     mFetchState = 0;
     mFetchPriority = 0;
@@ -446,6 +446,10 @@ public:
 
     bool        hasFetcher() const { return mHasFetcher;}
     bool        isFetching() const { return mIsFetching;}
+    // <3T:TommyTheTerrible> A request is in flight and neither the virtual size nor the
+    // desired discard has changed since the last updateFetch().
+    bool        isFetchIdle() const { return mIsFetching && mMaxVirtualSize == mFetchUpdateVirtualSize && mDesiredDiscardLevel == mFetchUpdateDiscard; }
+    // </3T:TommyTheTerrible>
     void        setCanUseHTTP(bool can_use_http) {mCanUseHTTP = can_use_http;}
 
     void        forceToDeleteRequest();
@@ -521,6 +525,8 @@ protected:
     bool mIsRawImageValid;
     bool mHasFetcher;               // We've made a fecth request
     bool mIsFetching;               // Fetch request is active
+    F32 mFetchUpdateVirtualSize = 0.f;  // <3T:TommyTheTerrible/> mMaxVirtualSize at the last updateFetch()
+    S8  mFetchUpdateDiscard = -1;       // <3T:TommyTheTerrible/> mDesiredDiscardLevel at the last updateFetch()
     bool mCanUseHTTP;              //This texture can be fetched through http if true.
     LLCore::HttpStatus mLastHttpGetStatus; // Result of the most recently completed http request for this texture.
 
@@ -1506,13 +1506,67 @@ F32 LLViewerTextureList::updateImagesFetchTextures(F32 max_time)
         mLastUpdateKey = LLTextureKey(last_imagep->getID(), (ETexListType)last_imagep->getTextureListType());
     }
     S32 fetch_count = 256 - gTextureList.aDecodingCount;
+
+    // <3T:TommyTheTerrible> Let the fetcher tell us which requests changed
+    // instead of asking every fetching texture each frame. Textures without
+    // an active request, or whose size or desired discard moved, are still
+    // updated every frame so new requests and priority changes go out at
+    // once; only requests that are in flight and untouched wait for their
+    // completion to be queued. Every FSTextureFetchPollInterval seconds the
+    // sweep covers everything, to drive idle timeouts, progress stats and
+    // anything that slipped between the queue and the worker flags.
+    static LLCachedControl<bool> use_completion_queue(gSavedSettings, "FSTextureFetchCompletionQueue", true);
+    static LLCachedControl<F32> poll_interval(gSavedSettings, "FSTextureFetchPollInterval", 0.25f);
+    static LLFrameTimer poll_timer;
+    static std::vector<LLUUID> completed;
+
+    LLAppViewer::getTextureFetch()->getCompletedRequests(completed);
+    if (use_completion_queue)
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_TEXTURE("vtluift - completed");
+        std::sort(completed.begin(), completed.end());
+        completed.erase(std::unique(completed.begin(), completed.end()), completed.end());
+        for (const LLUUID& id : completed)
+        {
+            for (ETexListType tex_type : { TEX_LIST_STANDARD, TEX_LIST_SCALE })
+            {
+                LLViewerFetchedTexture* imagep = findImage(id, tex_type);
+                if (imagep && imagep->isActive() && mFetchingTextures.count(imagep))
+                {
+                    fetch_count -= imagep->updateFetch();
+                }
+            }
+        }
+    }
+    else
+    {
+        completed.clear();
+    }
+
+    bool full_sweep = !use_completion_queue || poll_timer.getElapsedTimeF32() >= poll_interval;
+    if (full_sweep)
+    {
+        poll_timer.reset();
+    }
     for (auto iter = mFetchingTextures.begin();
         mFetchingTextures.size() > 0 && iter != mFetchingTextures.end() && timer.getElapsedTimeF32() < max_time && fetch_count > 0;)
     {
         LLViewerFetchedTexture* imagep = *iter++;
-        if (imagep && imagep->isActive())
-            fetch_count -= imagep->updateFetch();
+        if (!imagep || !imagep->isActive())
+        {
+            continue;
+        }
+        if (!full_sweep && imagep->isFetchIdle())
+        {
+            continue;
+        }
+        if (std::binary_search(completed.begin(), completed.end(), imagep->getID()))
+        {
+            continue; // already updated above
+        }
+        fetch_count -= imagep->updateFetch();
     }
+    // </3T:TommyTheTerrible>
 
     return timer.getElapsedTimeF32();
 }
@@ -770,6 +770,14 @@ public:
                 ypos += y_inc;
                 // </FS:Ansariel>
 
+                // <3T:TommyTheTerrible> Mesh decode worker pool
+                addText(xpos, ypos, llformat("%d Mesh Decodes Queued", LLMeshRepoThread::sDecodeQueueDepth.load()));
+                ypos += y_inc;
+
+                addText(xpos, ypos, "Mesh Decode ms (mean/p50/p95): " + LLMeshRepository::sDecodeStats.asString());
+                ypos += y_inc;
+                // </3T:TommyTheTerrible>
+
                 addText(xpos, ypos, llformat("%.3f/%.3f MB Mesh Cache Read/Write ", LLMeshRepository::sCacheBytesRead/(1024.f*1024.f), LLMeshRepository::sCacheBytesWritten/(1024.f*1024.f)));
                 ypos += y_inc;
 
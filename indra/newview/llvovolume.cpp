@@ -645,6 +645,38 @@ U32 LLVOVolume::processUpdateMessage(LLMessageSystem *mesgsys,
                 unpackParticleSource(*dp, mOwnerID, false);
             }
         }
+        // <3T:TommyTheTerrible> Parallel object update decoding
+        else if (sUpdateSource)
+        {
+            // TextureEntry parsed off the main thread, or left for this
+            // object when the main thread decoded the update itself
+            S32 result = sUpdateSource->mTextureEntryResult;
+            if (result == 1 && sUpdateSource->mTextureEntry)
+            {
+                LLTEContents& tec = *sUpdateSource->mTextureEntry;
+                tec.face_count = llmin((U32)getNumTEs(), (U32)LLTEContents::MAX_TES);
+                result = applyParsedTEMessage(tec);
+            }
+            else if (!sUpdateSource->mTextureEntry && sUpdateSource->mTextureEntrySize > 0)
+            {
+                U8                          tdpbuffer[1024] = {};
+                LLDataPackerBinaryBuffer    tdp(tdpbuffer, 1024);
+                memcpy(tdpbuffer, sUpdateSource->mTextureEntryData, llmin(sUpdateSource->mTextureEntrySize, 1024));
+                result = unpackTEMessage(tdp);
+            }
+            if (result & teDirtyBits)
+            {
+                if (mDrawable)
+                { //on the fly TE updates break batches, isolate in octree
+                    shrinkWrap();
+                }
+            }
+            if (result & TEM_CHANGE_MEDIA)
+            {
+                retval |= MEDIA_FLAGS_CHANGED;
+            }
+        }
+        // </3T:TommyTheTerrible>
         else
         {
             S32 texture_length = mesgsys->getSizeFast(_PREHASH_ObjectData, block_num, _PREHASH_TextureEntry);
@@ -1278,6 +1278,7 @@ void LLWorld::printPacketsLost()
         }
     }
     LL_INFOS() << "Packets dropped by Packet Ring: " << gMessageSystem->mPacketRing.getNumDroppedPackets() << LL_ENDL;
+    LL_INFOS() << "Packets per receive call: " << gMessageSystem->mPacketRing.getPacketsPerReceiveCall() << LL_ENDL; // <3T:TommyTheTerrible/>
 }
 
 void LLWorld::processCoarseUpdate(LLMessageSystem* msg, void** user_data)
@@ -10195,7 +10195,10 @@ void LLPipeline::renderShadow(const glm::mat4& view, const glm::mat4& proj, LLCa
     LLPipeline::sShadowRender = false;
 }
 
-bool LLPipeline::getVisiblePointCloud(LLCamera& camera, LLVector3& min, LLVector3& max, std::vector<LLVector3>& fp, LLVector3 light_dir)
+// <3T:TommyTheTerrible> Shadow culling scratch comes from the frame arena.
+//bool LLPipeline::getVisiblePointCloud(LLCamera& camera, LLVector3& min, LLVector3& max, std::vector<LLVector3>& fp, LLVector3 light_dir)
+bool LLPipeline::getVisiblePointCloud(LLCamera& camera, LLVector3& min, LLVector3& max, LLFrameVector<LLVector3>& fp, LLVector3 light_dir)
+// </3T:TommyTheTerrible>
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
     //get point cloud of intersection of frust and min, max
@@ -10215,7 +10218,8 @@ bool LLPipeline::getVisiblePointCloud(LLCamera& camera, LLVector3& min, LLVector
         LLPlane(max, LLVector3(0,0,1))};
 
     //potential points
-    std::vector<LLVector3> pp;
+    //std::vector<LLVector3> pp;
+    LLFrameVector<LLVector3> pp; // <3T:TommyTheTerrible/>
 
     //add corners of AABB
     pp.push_back(LLVector3(min.mV[0], min.mV[1], min.mV[2]));
@@ -10566,7 +10570,8 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
     F32 near_clip = 0.f;
     {
         //get visible point cloud
-        std::vector<LLVector3> fp;
+        //std::vector<LLVector3> fp;
+        LLFrameVector<LLVector3> fp; // <3T:TommyTheTerrible/>
 
         main_camera.calcAgentFrustumPlanes(main_camera.mAgentFrustum);
 
@@ -10706,7 +10711,8 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
                 mShadowCamera[j] = shadow_cam;
             }
 
-            std::vector<LLVector3> fp;
+            //std::vector<LLVector3> fp;
+            LLFrameVector<LLVector3> fp; // <3T:TommyTheTerrible/>
 
             if (!gPipeline.getVisiblePointCloud(shadow_cam, min, max, fp, lightDir)
                 || j > RenderShadowSplits)
@@ -10736,7 +10742,10 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
             {
                 mShadowExtents[j][0] = min;
                 mShadowExtents[j][1] = max;
-                mShadowFrustPoints[j] = fp;
+                // <3T:TommyTheTerrible> fp lives in the frame arena; the debug copy outlives the frame
+                //mShadowFrustPoints[j] = fp;
+                mShadowFrustPoints[j].assign(fp.begin(), fp.end());
+                // </3T:TommyTheTerrible>
             }
 
 
@@ -10746,7 +10755,9 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
             //get a temporary view projection
             view[j] = look(camera.getOrigin(), lightDir, -up);
 
-            std::vector<LLVector3> wpf;
+            //std::vector<LLVector3> wpf;
+            LLFrameVector<LLVector3> wpf; // <3T:TommyTheTerrible/>
+            wpf.reserve(fp.size()); // <3T:TommyTheTerrible/>
 
             for (U32 i = 0; i < fp.size(); i++)
             {
@@ -40,6 +40,7 @@
 #include "llrendertarget.h"
 #include "llreflectionmapmanager.h"
 #include "llheroprobemanager.h"
+#include "llframearena.h" // <3T:TommyTheTerrible/>
 
 #include <stack>
 
@@ -264,7 +265,10 @@ public:
     void updateMove();
     bool visibleObjectsInFrustum(LLCamera& camera);
     bool getVisibleExtents(LLCamera& camera, LLVector3 &min, LLVector3& max);
-    bool getVisiblePointCloud(LLCamera& camera, LLVector3 &min, LLVector3& max, std::vector<LLVector3>& fp, LLVector3 light_dir = LLVector3(0,0,0));
+    // <3T:TommyTheTerrible> Shadow culling scratch comes from the frame arena.
+    //bool getVisiblePointCloud(LLCamera& camera, LLVector3 &min, LLVector3& max, std::vector<LLVector3>& fp, LLVector3 light_dir = LLVector3(0,0,0));
+    bool getVisiblePointCloud(LLCamera& camera, LLVector3 &min, LLVector3& max, LLFrameVector<LLVector3>& fp, LLVector3 light_dir = LLVector3(0,0,0));
+    // </3T:TommyTheTerrible>
 
     // Populate given LLCullResult with results of a frustum cull of the entire scene against the given LLCamera
     void updateCull(LLCamera& camera, LLCullResult& result, bool hud_attachments = false);
@@ -0,0 +1,233 @@
+/**
+ * @file fsobjectupdatedecoder_test.cpp
+ * @brief Test for fsobjectupdatedecoder.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../fsobjectupdatedecoder.h"
+
+#include "llcontrol.h"
+#include "lldatapacker.h"
+#include "llstring.h"
+#include "../test/lltut.h"
+
+#include <chrono>
+#include <iostream>
+
+LLControlGroup gSavedSettings("Global");
+
+namespace
+{
+    // The Data field of an ImprovedTerseObjectUpdate block: local ID, then
+    // the motion data processUpdateMessage() reads.
+    std::vector<U8> terse_data(U32 local_id)
+    {
+        std::vector<U8> data(60, 0);
+        LLDataPackerBinaryBuffer dp(data.data(), (S32)data.size());
+        dp.packU32(local_id, "LocalID");
+        for (U8 i = 4; i < data.size(); ++i)
+        {
+            data[i] = i;
+        }
+        return data;
+    }
+
+    std::vector<U8> texture_entry(const LLPrimitive& prim)
+    {
+        std::vector<U8> te(FSDecodedObjectUpdate::MAX_TEXTURE_ENTRY_SIZE, 0);
+        LLDataPackerBinaryBuffer dp(te.data(), (S32)te.size());
+        prim.packTEMessage(dp);
+        te.resize(dp.getCurrentSize());
+        return te;
+    }
+
+    void make_prim(LLPrimitive& prim, U8 faces, U32 seed)
+    {
+        prim.setNumTEs(faces);
+        for (U8 face = 0; face < faces; ++face)
+        {
+            LLUUID image;
+            image.generate(llformat("fsobjectupdatedecoder %u %u", seed, face));
+            prim.setTETexture(face, image);
+            prim.setTEColor(face, LLColor4(face / 10.f, 0.5f, 0.25f, 1.f));
+            prim.setTEScale(face, 1.f + face, 2.f);
+        }
+    }
+}
+
+namespace tut
+{
+    struct objectupdatedecoder_data
+    {
+    };
+    typedef test_group<objectupdatedecoder_data> objectupdatedecoder_group;
+    typedef objectupdatedecoder_group::object object;
+    objectupdatedecoder_group objectupdatedecodergrp("FSObjectUpdateDecoder");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("terse block without a texture entry");
+        FSDecodedObjectUpdate update;
+        update.mBlocks.resize(2);
+        update.mBlocks[0].mData = terse_data(1234567);
+        update.mBlocks[1].mData = terse_data(42);
+
+        ensure("pending", !update.isDecoded());
+        update.decode();
+        ensure("decoded", update.isDecoded());
+        ensure_equals("first local id", update.mBlocks[0].mLocalID, 1234567);
+        ensure_equals("second local id", update.mBlocks[1].mLocalID, 42);
+        ensure_equals("motion data follows the local id", update.mBlocks[0].mHeaderSize, 4);
+        ensure("no texture entry", !update.mBlocks[0].mTEContents);
+
+        // a second decode, as popDecoded() does after a worker, changes nothing
+        update.mBlocks[1].mLocalID = 7;
+        update.waitDecoded();
+        ensure_equals("not decoded twice", update.mBlocks[1].mLocalID, 7);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("texture entry matches the prim it came from");
+        LLPrimitive prim;
+        make_prim(prim, 6, 1);
+
+        FSDecodedObjectUpdate update;
+        update.mBlocks.resize(1);
+        update.mBlocks[0].mData = terse_data(99);
+        update.mBlocks[0].mTextureEntry = texture_entry(prim);
+        update.decode();
+
+        const FSDecodedObjectUpdate::Block& block = update.mBlocks[0];
+        ensure("texture entry parsed", block.mTEContents != nullptr);
+        ensure_equals("parse result", block.mTextureEntryResult, 1);
+        for (U8 face = 0; face < 6; ++face)
+        {
+            ensure_equals("texture", block.mTEContents->image_data[face], prim.getTE(face)->getID());
+            ensure_equals("scale", block.mTEContents->scale_s[face], 1.f + face);
+        }
+
+        // applying the parsed entry gives the same faces as unpacking in place
+        LLPrimitive applied;
+        applied.setNumTEs(6);
+        block.mTEContents->face_count = 6;
+        applied.applyParsedTEMessage(*block.mTEContents);
+        for (U8 face = 0; face < 6; ++face)
+        {
+            ensure("same face", *applied.getTE(face) == *prim.getTE(face));
+        }
+
+        // decoded on the main thread, the entry is left for the object, which
+        // unpacks only the faces it has
+        FSDecodedObjectUpdate inline_update;
+        inline_update.mBlocks.resize(1);
+        inline_update.mBlocks[0].mData = terse_data(99);
+        inline_update.mBlocks[0].mTextureEntry = texture_entry(prim);
+        inline_update.waitDecoded();
+        ensure("decoded inline", inline_update.isDecoded());
+        ensure_equals("local id", inline_update.mBlocks[0].mLocalID, 99);
+        ensure("entry not parsed", !inline_update.mBlocks[0].mTEContents);
+        ensure_equals("entry kept", inline_update.mBlocks[0].mTextureEntry.size(), block.mTextureEntry.size());
+
+        LLPrimitive unpacked;
+        unpacked.setNumTEs(6);
+        U8 tdpbuffer[FSDecodedObjectUpdate::MAX_TEXTURE_ENTRY_SIZE] = {};
+        memcpy(tdpbuffer, inline_update.mBlocks[0].mTextureEntry.data(), inline_update.mBlocks[0].mTextureEntry.size());
+        LLDataPackerBinaryBuffer tdp(tdpbuffer, FSDecodedObjectUpdate::MAX_TEXTURE_ENTRY_SIZE);
+        unpacked.unpackTEMessage(tdp);
+        for (U8 face = 0; face < 6; ++face)
+        {
+            ensure("same face unpacked", *unpacked.getTE(face) == *prim.getTE(face));
+        }
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("terse decode vs compressed header");
+        std::string env = LLStringUtil::getenv("LL_OBJECT_UPDATE_BENCH_BLOCKS");
+        if (env.empty())
+        {
+            skip("set LL_OBJECT_UPDATE_BENCH_BLOCKS to run");
+        }
+        size_t blocks = std::stoul(env);
+
+        LLPrimitive prim;
+        make_prim(prim, 8, 2);
+        const std::vector<U8> te = texture_entry(prim);
+
+        // What the worker takes off the main thread for a terse update.
+        FSDecodedObjectUpdate terse;
+        terse.mBlocks.resize(blocks);
+        auto copy_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < blocks; ++i)
+        {
+            terse.mBlocks[i].mData = terse_data((U32)i);
+            terse.mBlocks[i].mTextureEntry = te;
+        }
+        double terse_copy_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - copy_start).count();
+        auto decode_start = std::chrono::steady_clock::now();
+        terse.decode();
+        double terse_decode_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decode_start).count();
+
+        // What it would take off for a compressed one: the full ID, local ID
+        // and PCode at the front of a payload a few hundred bytes long.
+        std::vector<U8> compressed(400, 0);
+        LLDataPackerBinaryBuffer pack(compressed.data(), (S32)compressed.size());
+        pack.packUUID(prim.getTE(0)->getID(), "ID");
+        pack.packU32(1, "LocalID");
+        pack.packU8(LL_PCODE_VOLUME, "PCode");
+        std::vector<std::vector<U8>> copies(blocks);
+        copy_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < blocks; ++i)
+        {
+            copies[i] = compressed;
+        }
+        double compressed_copy_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - copy_start).count();
+        U64 checksum = 0;
+        decode_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < blocks; ++i)
+        {
+            LLDataPackerBinaryBuffer dp(copies[i].data(), (S32)copies[i].size());
+            LLUUID id;
+            U32 local_id;
+            U8 pcode;
+            dp.unpackUUID(id, "ID");
+            dp.unpackU32(local_id, "LocalID");
+            dp.unpackU8(pcode, "PCode");
+            checksum += local_id + pcode + id.mData[0];
+        }
+        double compressed_header_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decode_start).count();
+
+        ensure("terse decoded", terse.isDecoded());
+        ensure("headers read", checksum > 0);
+        std::cout << "\n" << blocks << " blocks: terse copy " << terse_copy_ms << " ms, terse decode "
+                  << terse_decode_ms << " ms; compressed copy " << compressed_copy_ms << " ms, compressed header "
+                  << compressed_header_ms << " ms" << std::endl;
+    }
+}
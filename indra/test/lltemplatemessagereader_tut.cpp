@@ -0,0 +1,503 @@
+/**
+ * @file lltemplatemessagereader_tut.cpp
+ * @brief Tests for decoding template messages.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include <tut/tut.hpp>
+#include "linden_common.h"
+#include "lltut.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "llapr.h"
+#include "llmessagetemplate.h"
+#include "lltemplatemessagebuilder.h"
+#include "lltemplatemessagereader.h"
+#include "message.h"
+#include "message_prehash.h"
+#include "stringize.h"
+
+namespace
+{
+    char* prehash(const char* name)
+    {
+        return const_cast<char*>(name);
+    }
+
+    struct VariableSpec
+    {
+        const char* mName;
+        EMsgVariableType mType;
+        S32 mSize;
+    };
+
+    // The variables of an ObjectUpdate ObjectData block, as in
+    // message_template.msg. A function rather than a table: the _PREHASH_
+    // names are set during static initialization in another file.
+    std::vector<VariableSpec> object_update_data()
+    {
+        return {
+            { _PREHASH_ID, MVT_U32, 4 },
+            { _PREHASH_State, MVT_U8, 1 },
+            { _PREHASH_FullID, MVT_LLUUID, 16 },
+            { _PREHASH_CRC, MVT_U32, 4 },
+            { _PREHASH_PCode, MVT_U8, 1 },
+            { _PREHASH_Material, MVT_U8, 1 },
+            { _PREHASH_ClickAction, MVT_U8, 1 },
+            { _PREHASH_Scale, MVT_LLVector3, 12 },
+            { _PREHASH_ObjectData, MVT_VARIABLE, 1 },
+            { _PREHASH_ParentID, MVT_U32, 4 },
+            { _PREHASH_UpdateFlags, MVT_U32, 4 },
+            { _PREHASH_PathCurve, MVT_U8, 1 },
+            { _PREHASH_ProfileCurve, MVT_U8, 1 },
+            { _PREHASH_PathBegin, MVT_U16, 2 },
+            { _PREHASH_PathEnd, MVT_U16, 2 },
+            { _PREHASH_TextureEntry, MVT_VARIABLE, 2 },
+            { _PREHASH_TextureAnim, MVT_VARIABLE, 1 },
+            { _PREHASH_NameValue, MVT_VARIABLE, 2 },
+            { _PREHASH_Data, MVT_VARIABLE, 2 },
+            { _PREHASH_Text, MVT_VARIABLE, 1 },
+            { _PREHASH_TextColor, MVT_FIXED, 4 },
+            { _PREHASH_MediaURL, MVT_VARIABLE, 1 },
+            { _PREHASH_PSBlock, MVT_VARIABLE, 1 },
+            { _PREHASH_ExtraParams, MVT_VARIABLE, 1 },
+            { _PREHASH_Sound, MVT_LLUUID, 16 },
+            { _PREHASH_OwnerID, MVT_LLUUID, 16 },
+            { _PREHASH_Gain, MVT_F32, 4 },
+            { _PREHASH_Flags, MVT_U8, 1 },
+            { _PREHASH_Radius, MVT_F32, 4 },
+            { _PREHASH_JointType, MVT_U8, 1 },
+            { _PREHASH_JointPivot, MVT_LLVector3, 12 },
+            { _PREHASH_JointAxisOrAnchor, MVT_LLVector3, 12 },
+        };
+    }
+
+    std::vector<VariableSpec> terse_update_data()
+    {
+        return {
+            { _PREHASH_Data, MVT_VARIABLE, 1 },
+            { _PREHASH_TextureEntry, MVT_VARIABLE, 2 },
+        };
+    }
+
+    const U32 OBJECT_UPDATE_NUMBER = 12;
+    const U32 TERSE_UPDATE_NUMBER = 15;
+
+    void ignore_message(LLMessageSystem*, void**)
+    {
+    }
+
+    LLMessageTemplate* make_update_template(const char* name, U32 number,
+                                            const std::vector<VariableSpec>& variables)
+    {
+        LLMessageTemplate* update = new LLMessageTemplate(name, number, MFT_HIGH);
+        LLMessageBlock* region = new LLMessageBlock(prehash(_PREHASH_RegionData), MBT_SINGLE);
+        region->addVariable(prehash(_PREHASH_RegionHandle), MVT_U64, 8);
+        region->addVariable(prehash(_PREHASH_TimeDilation), MVT_U16, 2);
+        update->addBlock(region);
+        LLMessageBlock* objects = new LLMessageBlock(prehash(_PREHASH_ObjectData), MBT_VARIABLE);
+        for (const VariableSpec& variable : variables)
+        {
+            objects->addVariable(prehash(variable.mName), variable.mType, variable.mSize);
+        }
+        update->addBlock(objects);
+        update->setHandlerFunc(ignore_message, NULL);
+        return update;
+    }
+
+    struct Random
+    {
+        U32 mState;
+        U32 next()
+        {
+            mState = mState * 1103515245u + 12345u;
+            return mState >> 8;
+        }
+    };
+
+    // Builds one update with object_count ObjectData blocks of made up
+    // content: variable fields are sometimes empty, sometimes long.
+    S32 build_update(LLMessageTemplate& update, U32 object_count, U32 seed,
+                     U8* buffer, S32 buffer_size)
+    {
+        LLTemplateMessageBuilder::message_template_name_map_t names;
+        names[update.mName] = &update;
+        LLTemplateMessageBuilder builder(names);
+        builder.newMessage(update.mName);
+        builder.nextBlock(_PREHASH_RegionData);
+        builder.addU64(_PREHASH_RegionHandle, 0x0003e80000040000ULL + seed);
+        builder.addU16(_PREHASH_TimeDilation, 65535);
+
+        Random random{ seed };
+        std::vector<U8> bytes(300);
+        const LLMessageBlock* objects = update.getBlock(prehash(_PREHASH_ObjectData));
+        for (U32 i = 0; i < object_count; ++i)
+        {
+            builder.nextBlock(_PREHASH_ObjectData);
+            for (const LLMessageVariable* variable : objects->mMemberVariables)
+            {
+                S32 size = variable->getSize();
+                if (variable->getType() == MVT_VARIABLE)
+                {
+                    U32 pick = random.next() % 4;
+                    size = (pick == 0) ? 0 : (pick == 1) ? 1 + random.next() % 8 : 20 + random.next() % 100;
+                }
+                for (S32 b = 0; b < size; ++b)
+                {
+                    bytes[b] = (U8)random.next();
+                }
+                builder.addBinaryData(variable->getName(), bytes.data(), size);
+            }
+        }
+        memset(buffer, 0, buffer_size);
+        return builder.buildMessage(buffer, buffer_size, 0);
+    }
+
+    // How decodeData() worked before the decode tables, kept to check the
+    // reader against: a block and a map entry allocated for every value.
+    LLMsgData* reference_decode(const LLMessageTemplate& message, const U8* buffer, S32 size)
+    {
+        S32 decode_pos = LL_PACKET_ID_SIZE + (S32)message.mFrequency + buffer[PHL_OFFSET];
+        LLMsgData* data = new LLMsgData(message.mName);
+        for (const LLMessageBlock* block : message.mMemberBlocks)
+        {
+            S32 repeat_number = 1;
+            if (block->mType == MBT_MULTIPLE)
+            {
+                repeat_number = block->mNumber;
+            }
+            else if (block->mType == MBT_VARIABLE)
+            {
+                repeat_number = (decode_pos >= size) ? 0 : buffer[decode_pos++];
+            }
+            for (S32 i = 0; i < repeat_number; ++i)
+            {
+                LLMsgBlkData* block_data = new LLMsgBlkData(block->mName, repeat_number);
+                block_data->mName = block->mName + i;
+                data->addBlock(block_data);
+                for (const LLMessageVariable* variable : block->mMemberVariables)
+                {
+                    block_data->addVariable(variable->getName(), variable->getType());
+                    if (variable->getType() == MVT_VARIABLE)
+                    {
+                        S32 data_size = variable->getSize();
+                        U32 tsize = 0;
+                        if (decode_pos + data_size <= size)
+                        {
+                            memcpy(&tsize, &buffer[decode_pos], data_size);
+                        }
+                        decode_pos += data_size;
+                        block_data->addData(variable->getName(), &buffer[decode_pos], tsize, variable->getType());
+                        decode_pos += tsize;
+                    }
+                    else
+                    {
+                        std::vector<U8> zeros(variable->getSize(), 0);
+                        const U8* from = (decode_pos + variable->getSize() > size) ? zeros.data() : &buffer[decode_pos];
+                        block_data->addData(variable->getName(), from, variable->getSize(), variable->getType());
+                        decode_pos += variable->getSize();
+                    }
+                }
+            }
+        }
+        return data;
+    }
+
+    // Reads a value out of reference_decode() output the way the reader's
+    // getters used to.
+    S32 reference_get(LLMsgData& data, const char* block, const char* variable, S32 blocknum, U8* out)
+    {
+        LLMsgData::msg_blk_data_map_t::const_iterator it = data.mMemberBlocks.find((char*)block + blocknum);
+        if (it == data.mMemberBlocks.end())
+        {
+            return LL_BLOCK_NOT_IN_MESSAGE;
+        }
+        LLMsgVarData& value = it->second->mMemberVarData[(char*)variable];
+        if (value.getSize())
+        {
+            memcpy(out, value.getData(), value.getSize());
+        }
+        return value.getSize();
+    }
+
+    // Every value of every block of the reader's current message matches
+    // reference_decode() on the same bytes.
+    void ensure_same_values(const std::string& what, LLTemplateMessageReader& reader,
+                            const LLMessageTemplate& message, LLMsgData& reference)
+    {
+        std::vector<U8> expected(70000);
+        std::vector<U8> actual(70000);
+        for (const LLMessageBlock* block : message.mMemberBlocks)
+        {
+            S32 count = reader.getNumberOfBlocks(block->mName);
+            LLMsgData::msg_blk_data_map_t::const_iterator it = reference.mMemberBlocks.find(block->mName);
+            S32 expected_count = (it == reference.mMemberBlocks.end()) ? 0 : it->second->mBlockNumber;
+            tut::ensure_equals(what + " block count", count, expected_count);
+            for (S32 blocknum = 0; blocknum < count; ++blocknum)
+            {
+                for (const LLMessageVariable* variable : block->mMemberVariables)
+                {
+                    S32 expected_size = reference_get(reference, block->mName, variable->getName(), blocknum, expected.data());
+                    S32 size = reader.getSize(block->mName, blocknum, variable->getName());
+                    tut::ensure_equals(STRINGIZE(what << ' ' << variable->getName() << " #" << blocknum << " size"),
+                                       size, expected_size);
+                    reader.getBinaryData(block->mName, variable->getName(), actual.data(), 0, blocknum, (S32)actual.size());
+                    tut::ensure(STRINGIZE(what << ' ' << variable->getName() << " #" << blocknum << " value"),
+                                !size || !memcmp(actual.data(), expected.data(), size));
+                }
+            }
+        }
+    }
+}
+
+namespace tut
+{
+    static LLTemplateMessageReader::message_template_number_map_t numberMap;
+
+    struct LLTemplateMessageReaderTestData
+    {
+        std::unique_ptr<LLMessageTemplate> mObjectUpdate;
+        std::unique_ptr<LLMessageTemplate> mTerseUpdate;
+
+        LLTemplateMessageReaderTestData()
+        {
+            if (!gMessageSystem)
+            {
+                ll_init_apr();
+                const F32 circuit_heartbeat_interval = 5;
+                const F32 circuit_timeout = 100;
+                start_messaging_system("notafile", 13035,
+                                       1,
+                                       0,
+                                       0,
+                                       false,
+                                       "notasharedsecret",
+                                       NULL,
+                                       false,
+                                       circuit_heartbeat_interval,
+                                       circuit_timeout);
+            }
+            mObjectUpdate.reset(make_update_template(_PREHASH_ObjectUpdate, OBJECT_UPDATE_NUMBER,
+                                                     object_update_data()));
+            mTerseUpdate.reset(make_update_template(_PREHASH_ImprovedTerseObjectUpdate, TERSE_UPDATE_NUMBER,
+                                                    terse_update_data()));
+            numberMap[OBJECT_UPDATE_NUMBER] = mObjectUpdate.get();
+            numberMap[TERSE_UPDATE_NUMBER] = mTerseUpdate.get();
+        }
+
+        ~LLTemplateMessageReaderTestData()
+        {
+            numberMap.clear();
+        }
+    };
+
+    typedef test_group<LLTemplateMessageReaderTestData> LLTemplateMessageReaderTestGroup;
+    typedef LLTemplateMessageReaderTestGroup::object LLTemplateMessageReaderTestObject;
+    LLTemplateMessageReaderTestGroup templateMessageReaderTestGroup("LLTemplateMessageReader");
+
+    template<> template<>
+    void LLTemplateMessageReaderTestObject::test<1>()
+        // same values as the per-block maps
+    {
+        const S32 buffer_size = 70000;
+        std::vector<U8> buffer(buffer_size);
+        LLTemplateMessageReader reader(numberMap);
+        for (LLMessageTemplate* update : { mObjectUpdate.get(), mTerseUpdate.get() })
+        {
+            for (U32 objects : { 0, 1, 2, 7, 40 })
+            {
+                S32 size = build_update(*update, objects, objects + 1, buffer.data(), buffer_size);
+                std::string what = STRINGIZE(update->mName << " with " << objects << " objects");
+                ensure(what + " valid", reader.validateMessage(buffer.data(), size, LLHost()));
+                ensure(what + " read", reader.readMessage(buffer.data(), LLHost()));
+                std::unique_ptr<LLMsgData> reference(reference_decode(*update, buffer.data(), size));
+                ensure_same_values(what, reader, *update, *reference);
+                reader.clearMessage();
+            }
+        }
+
+        // Lookups in any order, not just the order of the template.
+        S32 size = build_update(*mObjectUpdate, 3, 99, buffer.data(), buffer_size);
+        reader.validateMessage(buffer.data(), size, LLHost());
+        reader.readMessage(buffer.data(), LLHost());
+        U32 crc_last = 0, crc_first = 0, id_first = 0;
+        reader.getU32(_PREHASH_ObjectData, _PREHASH_CRC, crc_last, 2);
+        reader.getU32(_PREHASH_ObjectData, _PREHASH_ID, id_first, 0);
+        U64 handle = 0;
+        reader.getU64(_PREHASH_RegionData, _PREHASH_RegionHandle, handle);
+        reader.getU32(_PREHASH_ObjectData, _PREHASH_CRC, crc_first, 0);
+        std::unique_ptr<LLMsgData> reference(reference_decode(*mObjectUpdate, buffer.data(), size));
+        U32 expected = 0;
+        reference_get(*reference, _PREHASH_ObjectData, _PREHASH_CRC, 2, (U8*)&expected);
+        ensure_equals("CRC #2", crc_last, expected);
+        reference_get(*reference, _PREHASH_ObjectData, _PREHASH_CRC, 0, (U8*)&expected);
+        ensure_equals("CRC #0", crc_first, expected);
+        reference_get(*reference, _PREHASH_ObjectData, _PREHASH_ID, 0, (U8*)&expected);
+        ensure_equals("ID #0", id_first, expected);
+        ensure_equals("region handle", handle, 0x0003e80000040000ULL + 99);
+        ensure_equals("not in block", reader.getSize(_PREHASH_ObjectData, 0, _PREHASH_RegionHandle),
+                      (S32)LL_VARIABLE_NOT_IN_BLOCK);
+        ensure_equals("not in message", reader.getSize(_PREHASH_TestBlock1, 0, _PREHASH_ID),
+                      (S32)LL_BLOCK_NOT_IN_MESSAGE);
+        ensure_equals("past the last block", reader.getSize(_PREHASH_ObjectData, 3, _PREHASH_ID),
+                      (S32)LL_BLOCK_NOT_IN_MESSAGE);
+        ensure_equals("single block size", reader.getSize(_PREHASH_RegionData, _PREHASH_TimeDilation), 2);
+        reader.clearMessage();
+    }
+
+    template<> template<>
+    void LLTemplateMessageReaderTestObject::test<2>()
+        // packets cut short decode as they did before
+    {
+        const S32 buffer_size = 70000;
+        std::vector<U8> buffer(buffer_size);
+        LLTemplateMessageReader reader(numberMap);
+        S32 full_size = build_update(*mObjectUpdate, 4, 7, buffer.data(), buffer_size);
+        for (S32 size = LL_MINIMUM_VALID_PACKET_SIZE; size <= full_size; ++size)
+        {
+            std::string what = STRINGIZE("cut to " << size << " of " << full_size);
+            ensure(what + " valid", reader.validateMessage(buffer.data(), size, LLHost()));
+            reader.readMessage(buffer.data(), LLHost());
+            std::unique_ptr<LLMsgData> reference(reference_decode(*mObjectUpdate, buffer.data(), size));
+            ensure_same_values(what, reader, *mObjectUpdate, *reference);
+            reader.clearMessage();
+        }
+    }
+
+    template<> template<>
+    void LLTemplateMessageReaderTestObject::test<3>()
+        // copyToBuilder() builds the same packet again
+    {
+        const S32 buffer_size = 70000;
+        std::vector<U8> buffer(buffer_size);
+        std::vector<U8> copy(buffer_size);
+        LLTemplateMessageReader reader(numberMap);
+        S32 size = build_update(*mObjectUpdate, 5, 3, buffer.data(), buffer_size);
+        reader.validateMessage(buffer.data(), size, LLHost());
+        reader.readMessage(buffer.data(), LLHost());
+
+        LLTemplateMessageBuilder::message_template_name_map_t names;
+        names[mObjectUpdate->mName] = mObjectUpdate.get();
+        LLTemplateMessageBuilder builder(names);
+        builder.newMessage(mObjectUpdate->mName);
+        reader.copyToBuilder(builder);
+        S32 copy_size = builder.buildMessage(copy.data(), buffer_size, 0);
+        ensure_equals("same size", copy_size, size);
+        ensure("same bytes", !memcmp(copy.data() + LL_PACKET_ID_SIZE, buffer.data() + LL_PACKET_ID_SIZE,
+                                     size - LL_PACKET_ID_SIZE));
+        reader.clearMessage();
+    }
+
+    template<> template<>
+    void LLTemplateMessageReaderTestObject::test<4>()
+        // decode benchmark
+    {
+        // Not a pass/fail test: best of several runs decoding the same
+        // updates and reading every field back, through the per-block maps
+        // and through the reader. These packets are generated here to the
+        // shape of the real ones, not captured from a region.
+        const S32 buffer_size = 70000;
+        const U32 packet_count = 64;
+        std::string env = LLStringUtil::getenv("LL_TEMPLATE_READER_BENCH_ROUNDS");
+        if (env.empty())
+        {
+            skip("set LL_TEMPLATE_READER_BENCH_ROUNDS to run");
+        }
+        U32 rounds = llmax((U32)std::stoul(env), 1U);
+
+        using clock = std::chrono::steady_clock;
+        std::vector<U8> out(buffer_size);
+        std::cout << "\nLLTemplateMessageReader: " << packet_count << " packets x " << rounds
+                  << " rounds, best of 5, every field read back\n";
+        for (LLMessageTemplate* update : { mObjectUpdate.get(), mTerseUpdate.get() })
+        {
+            std::vector<std::vector<U8>> packets;
+            for (U32 i = 0; i < packet_count; ++i)
+            {
+                std::vector<U8> packet(buffer_size);
+                packet.resize(build_update(*update, 1 + i % 12, i, packet.data(), buffer_size));
+                packets.push_back(packet);
+            }
+
+            auto best_of = [&](bool use_reader)
+            {
+                LLTemplateMessageReader reader(numberMap);
+                auto best = clock::duration::max();
+                for (S32 pass = 0; pass < 5; ++pass)
+                {
+                    auto start = clock::now();
+                    for (U32 round = 0; round < rounds; ++round)
+                    {
+                        for (std::vector<U8>& packet : packets)
+                        {
+                            if (use_reader)
+                            {
+                                reader.validateMessage(packet.data(), (S32)packet.size(), LLHost());
+                                reader.readMessage(packet.data(), LLHost());
+                            }
+                            std::unique_ptr<LLMsgData> reference(use_reader ? NULL :
+                                reference_decode(*update, packet.data(), (S32)packet.size()));
+                            for (const LLMessageBlock* block : update->mMemberBlocks)
+                            {
+                                S32 count = use_reader ? reader.getNumberOfBlocks(block->mName) :
+                                    reference->mMemberBlocks.find(block->mName)->second->mBlockNumber;
+                                for (S32 blocknum = 0; blocknum < count; ++blocknum)
+                                {
+                                    for (const LLMessageVariable* variable : block->mMemberVariables)
+                                    {
+                                        if (use_reader)
+                                        {
+                                            reader.getBinaryData(block->mName, variable->getName(), out.data(),
+                                                                 0, blocknum, buffer_size);
+                                        }
+                                        else
+                                        {
+                                            reference_get(*reference, block->mName, variable->getName(),
+                                                          blocknum, out.data());
+                                        }
+                                    }
+                                }
+                            }
+                            if (use_reader)
+                            {
+                                reader.clearMessage();
+                            }
+                        }
+                    }
+                    best = std::min(best, clock::now() - start);
+                }
+                return std::chrono::duration<F64>(best).count();
+            };
+
+            const F64 messages = (F64)packet_count * rounds;
+            const F64 maps = best_of(false);
+            const F64 tables = best_of(true);
+            std::cout << "  " << update->mName << ": per-block maps " << messages / maps
+                      << " msg/s, decode tables " << messages / tables << " msg/s" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""\
+@file   profile_capture.py
+@date   2026-10-18
+@brief  Read a block timer capture (FSProfileCaptureFrames) and convert it to
+        Chrome trace JSON or summarize it per timer.
+
+$LicenseInfo:firstyear=2026&license=viewerlgpl$
+Copyright (c) 2026, Linden Research, Inc.
+$/LicenseInfo$
+"""
+
+from bisect import bisect_left
+from collections import namedtuple
+import json
+from logsdir import Error, latest_file, logsdir
+from pathlib import Path
+import sys
+
+MAGIC = b'LLPROF1\n'
+
+Event = namedtuple('Event', ('timer', 'start', 'duration'))
+Thread = namedtuple('Thread', ('number', 'main', 'events'))
+Capture = namedtuple('Capture', ('path', 'frequency', 'start', 'frame_ends',
+                                 'timers', 'threads', 'dropped'))
+# times in seconds, per frame
+TimerStats = namedtuple('TimerStats', ('name', 'calls', 'total', 'self'))
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            if self.pos >= len(self.data):
+                raise Error('capture file is truncated')
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7f) << shift
+            if not byte & 0x80:
+                return value
+            shift += 7
+
+    def zigzag(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def bytes(self, count):
+        if self.pos + count > len(self.data):
+            raise Error('capture file is truncated')
+        value = self.data[self.pos:self.pos + count]
+        self.pos += count
+        return value
+
+def load(path):
+    """Read the file ProfileCapture (llcommon/lltraceprofilecapture.h) wrote"""
+    reader = Reader(Path(path).read_bytes())
+    if reader.bytes(len(MAGIC)) != MAGIC:
+        raise Error(f'{path} is not a block timer capture')
+
+    frequency = reader.varint()
+    start = reader.varint()
+
+    frame_ends = []
+    previous = start
+    for _ in range(reader.varint()):
+        previous += reader.varint()
+        frame_ends.append(previous)
+
+    timers = [reader.bytes(reader.varint()).decode('utf-8', 'replace')
+              for _ in range(reader.varint())]
+
+    threads = []
+    for _ in range(reader.varint()):
+        number = reader.varint()
+        main = bool(reader.varint() & 1)
+        events = []
+        previous = start
+        for _ in range(reader.varint()):
+            timer = reader.varint()
+            previous += reader.zigzag()
+            events.append(Event(timer, previous, reader.varint()))
+        threads.append(Thread(number, main, events))
+
+    dropped = reader.varint()
+    return Capture(str(path), frequency, start, frame_ends, timers, threads, dropped)
+
+def nested(events):
+    """
+    Yield (event, parent) for each event in start order, parent being the
+    innermost event that encloses it on the same thread, or None.
+    """
+    stack = []
+    # an outer timer starts no later and lasts no shorter than its children
+    for event in sorted(events, key=lambda e: (e.start, -e.duration)):
+        end = event.start + event.duration
+        while stack and stack[-1].start + stack[-1].duration < end:
+            stack.pop()
+        yield event, (stack[-1] if stack else None)
+        stack.append(event)
+
+def summarize(capture):
+    """Per timer calls, inclusive and self time, averaged over the frames"""
+    frames = max(len(capture.frame_ends), 1)
+    calls = [0] * len(capture.timers)
+    total = [0] * len(capture.timers)
+    own = [0] * len(capture.timers)
+    for thread in capture.threads:
+        for event, parent in nested(thread.events):
+            calls[event.timer] += 1
+            total[event.timer] += event.duration
+            own[event.timer] += event.duration
+            if parent is not None and parent.timer != event.timer:
+                own[parent.timer] -= event.duration
+    return {name: TimerStats(name, calls[i] / frames,
+                             total[i] / capture.frequency / frames,
+                             own[i] / capture.frequency / frames)
+            for i, name in enumerate(capture.timers) if calls[i]}
+
+def frame_of(capture, time):
+    """The number of the frame that time falls in"""
+    return bisect_left(capture.frame_ends, time)
+
+def chrome_trace(capture):
+    """The capture as Chrome trace (chrome://tracing, Perfetto) JSON"""
+    to_us = 1000000. / capture.frequency
+    trace = []
+    for thread in capture.threads:
+        name = 'main' if thread.main else f'thread {thread.number}'
+        trace.append(dict(ph='M', name='thread_name', pid=1, tid=thread.number,
+                          args=dict(name=name)))
+        for event in sorted(thread.events, key=lambda e: (e.start, -e.duration)):
+            trace.append(dict(ph='X', pid=1, tid=thread.number,
+                              name=capture.timers[event.timer],
+                              ts=(event.start - capture.start) * to_us,
+                              dur=event.duration * to_us,
+                              args=dict(frame=frame_of(capture, event.start + event.duration))))
+    main = next((t.number for t in capture.threads if t.main), 0)
+    for frame, end in enumerate(capture.frame_ends):
+        trace.append(dict(ph='i', s='g', pid=1, tid=main, name=f'frame {frame}',
+                          ts=(end - capture.start) * to_us))
+    return dict(traceEvents=trace, displayTimeUnit='ms',
+                otherData=dict(file=capture.path, frames=len(capture.frame_ends),
+                               dropped=capture.dropped))
+
+def main(*raw_args):
+    from argparse import ArgumentParser
+    parser = ArgumentParser(description="""
+%(prog)s reads a block timer capture written when the FSProfileCaptureFrames
+debug setting runs out, and writes it as Chrome trace JSON (load it in
+chrome://tracing or https://ui.perfetto.dev) or, with --summary, lists the
+timers by time per frame.
+""")
+    parser.add_argument('-o', '--output',
+                        help="""JSON file to write (default is the capture
+                        filename with .json)""")
+    parser.add_argument('-s', '--summary', action='store_true',
+                        help="""list timers by self time per frame instead""")
+    parser.add_argument('path', nargs='?',
+                        help="""capture file to read (default is most recent)""")
+    args = parser.parse_args(raw_args)
+
+    path = args.path or latest_file(logsdir(), 'frames.*.llprof')
+    capture = load(path)
+    # print path to sys.stderr in case user is redirecting stdout
+    print(f'{path}: {len(capture.frame_ends)} frames, {len(capture.threads)} threads, '
+          f'{capture.dropped} timer calls dropped', file=sys.stderr)
+
+    if args.summary:
+        stats = sorted(summarize(capture).values(), key=lambda s: s.self, reverse=True)
+        namelen = max((len(s.name) for s in stats), default=0)
+        print(f'{"timer".ljust(namelen)}  calls/frame  ms/frame   self ms')
+        for s in stats:
+            print(f'{s.name.ljust(namelen)} {s.calls:12.1f} {s.total*1000:9.3f} {s.self*1000:9.3f}')
+        return
+
+    output = args.output or str(Path(path).with_suffix('.json'))
+    with open(output, 'w') as outf:
+        json.dump(chrome_trace(capture), outf)
+    print(output)
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main(*sys.argv[1:]))
+    except (Error, OSError) as err:
+        sys.exit(str(err))
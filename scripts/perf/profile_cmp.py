@@ -4,6 +4,7 @@
 @author Nat Goodspeed
 @date   2024-09-13
 @brief  Compare a frame profile stats file with a similar baseline file.
+        Also compares two block timer captures (see profile_capture.py).
 
 $LicenseInfo:firstyear=2024&license=viewerlgpl$
 Copyright (c) 2024, Linden Research, Inc.
@@ -14,6 +15,7 @@ from datetime import datetime
 import json
 from logsdir import Error, latest_file, logsdir
 from pathlib import Path
+import profile_capture
 import sys
 
 # variance that's ignorable
@@ -24,6 +26,9 @@ def compare(baseline, test, epsilon=DEFAULT_EPSILON):
         print(f'{baseline} same as\n{test}\nAnalysis moot.')
         return
 
+    if Path(baseline).suffix == '.llprof':
+        return compare_captures(baseline, test, epsilon)
+
     with open(baseline) as inf:
         bdata = json.load(inf)
     with open(test) as inf:
@@ -78,12 +83,57 @@ def compare(baseline, test, epsilon=DEFAULT_EPSILON):
     for s in bunused:
         print(f'  {s}')
 
+# timers under this much time per frame in both captures are noise
+MIN_TIMER_SECONDS = 0.00001     # 10us
+
+def compare_captures(baseline, test, epsilon=DEFAULT_EPSILON):
+    bcapture = profile_capture.load(baseline)
+    tcapture = profile_capture.load(test)
+    print(f'baseline {baseline}\ntestfile {test}')
+    for name, capture in ('baseline', bcapture), ('testfile', tcapture):
+        print(f'{name} {len(capture.frame_ends)} frames, {len(capture.threads)} threads, '
+              f'{capture.dropped} timer calls dropped')
+
+    # Compare self time per frame, which doesn't count a change twice in
+    # every timer above the one that changed.
+    btimers = profile_capture.summarize(bcapture)
+    ttimers = profile_capture.summarize(tcapture)
+    deltas = []
+    for timer in set(btimers).intersection(ttimers):
+        bself = btimers[timer].self
+        tself = ttimers[timer].self
+        if max(bself, tself) < MIN_TIMER_SECONDS or bself <= 0:
+            continue
+        delta = (tself - bself)/bself
+        if abs(delta) > epsilon:
+            deltas.append((delta, timer, bself, tself))
+
+    # ascending order of time spent: biggest gains first
+    deltas.sort()
+    print(f'{len(deltas)} timers showed nontrivial differences '
+          '(self ms/frame):')
+    namelen = max(len(d[1]) for d in deltas) if deltas else 0
+    for delta, timer, bself, tself in deltas:
+        print(f'  {timer.rjust(namelen)} {delta*100:6.1f}% '
+              f'{bself*1000:8.3f} -> {tself*1000:8.3f}')
+
+    tunused = set(btimers).difference(ttimers)
+    print(f'{len(tunused)} baseline timers not seen in test:')
+    for t in sorted(tunused):
+        print(f'  {t}')
+    bunused = set(ttimers).difference(btimers)
+    print(f'{len(bunused)} timers newly seen in test:')
+    for t in sorted(bunused):
+        print(f'  {t}')
+
 def main(*raw_args):
     from argparse import ArgumentParser
     parser = ArgumentParser(description="""
 %(prog)s compares a baseline JSON file from Develop -> Render Tests -> Frame
 Profile to another such file from a more recent test. It identifies shaders
-that have gained and lost in throughput.
+that have gained and lost in throughput. Given a block timer capture (.llprof,
+from the FSProfileCaptureFrames debug setting) it compares that to another
+capture instead, timer by timer.
 """)
     parser.add_argument('-e', '--epsilon', type=float, default=int(DEFAULT_EPSILON*100),
                         help="""percent variance considered ignorable (default %(default)s%%)""")
@@ -93,8 +143,10 @@ that have gained and lost in throughput.
                         help="""test profile filename to compare
                         (default is most recent)""")
     args = parser.parse_args(raw_args)
+    latest = ('frames.*.llprof' if Path(args.baseline).suffix == '.llprof'
+              else 'profile.*.json')
     compare(args.baseline,
-            args.test or latest_file(logsdir(), 'profile.*.json'),
+            args.test or latest_file(logsdir(), latest),
             epsilon=(args.epsilon / 100.))
 
 if __name__ == "__main__":